@@ -0,0 +1,52 @@
+/**
+ * @file    FreeRTOS.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   主机端测试用FreeRTOS最小替身
+ *
+ * @details 只提供被测模块（heap_region.c、mempool.c等）用到的配置、断言与堆接口声明。
+ *          configASSERT失败时调用测试提供的vAssertCalled()计数而不终止，
+ *          以便测试断言路径本身。
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE           ((size_t)(8 * 1024))
+#endif
+#define configUSE_MALLOC_FAILED_HOOK    1
+#define portBYTE_ALIGNMENT              8
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+void vAssertCalled(const char *file, int line);
+#define configASSERT(x)                 do { if(!(x)) { vAssertCalled(__FILE__, __LINE__); } } while(0)
+
+#define traceMALLOC(p, size)
+#define traceFREE(p, size)
+
+typedef struct xHeapStats
+{
+  size_t xAvailableHeapSpaceInBytes;
+  size_t xSizeOfLargestFreeBlockInBytes;
+  size_t xSizeOfSmallestFreeBlockInBytes;
+  size_t xNumberOfFreeBlocks;
+  size_t xMinimumEverFreeBytesRemaining;
+  size_t xNumberOfSuccessfulAllocations;
+  size_t xNumberOfSuccessfulFrees;
+} HeapStats_t;
+
+void *pvPortMalloc(size_t xWantedSize);
+void *pvPortCalloc(size_t xNum, size_t xSize);
+void vPortFree(void *pv);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+void vPortGetHeapStats(HeapStats_t *pxHeapStats);
+void vPortInitialiseBlocks(void);
+
+#endif /* FREERTOS_H */
@@ -0,0 +1,18 @@
+/**
+ * @file    task.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   主机端测试用FreeRTOS任务接口替身
+ *
+ * @details 调度器挂起/恢复由测试实现，用于检查被测模块的挂起与恢复成对出现。
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "FreeRTOS.h"
+
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+
+#endif /* TASK_H */
@@ -0,0 +1,152 @@
+/**
+ * @file    test.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   主机端测试与基准公用宏
+ *
+ * @details 断言失败只记录并打印位置，不中止，main()末尾以TEST_REPORT()返回
+ *          失败数作为进程退出码，由CTest判定通过与否。
+ *          test_now_ns()以CLOCK_MONOTONIC计时，供基准计算ns/sample。
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+static int s_test_failures = 0;
+
+/**
+ * @brief 条件断言
+ */
+#define TEST_ASSERT(cond)                                                     \
+  do                                                                          \
+  {                                                                           \
+    if(!(cond))                                                               \
+    {                                                                         \
+      printf("%s:%d: FAIL: %s\n", __FILE__, __LINE__, #cond);                 \
+      s_test_failures++;                                                      \
+    }                                                                         \
+  } while(0)
+
+/**
+ * @brief 整数相等断言
+ */
+#define TEST_ASSERT_EQ(expect, actual)                                        \
+  do                                                                          \
+  {                                                                           \
+    long long e_ = (long long)(expect);                                       \
+    long long a_ = (long long)(actual);                                       \
+    if(e_ != a_)                                                              \
+    {                                                                         \
+      printf("%s:%d: FAIL: %s == %s (%lld != %lld)\n", __FILE__, __LINE__,    \
+             #expect, #actual, e_, a_);                                       \
+      s_test_failures++;                                                      \
+    }                                                                         \
+  } while(0)
+
+/**
+ * @brief 浮点近似相等断言（绝对误差）
+ */
+#define TEST_ASSERT_NEAR(expect, actual, tol)                                 \
+  do                                                                          \
+  {                                                                           \
+    double e_ = (double)(expect);                                             \
+    double a_ = (double)(actual);                                             \
+    if(!(fabs(e_ - a_) <= (double)(tol)))                                     \
+    {                                                                         \
+      printf("%s:%d: FAIL: %s ~ %s (%g vs %g, tol %g)\n", __FILE__, __LINE__, \
+             #expect, #actual, e_, a_, (double)(tol));                        \
+      s_test_failures++;                                                      \
+    }                                                                         \
+  } while(0)
+
+/**
+ * @brief 运行一个测试函数
+ */
+#define TEST_RUN(fn)                                                          \
+  do                                                                          \
+  {                                                                           \
+    int before_ = s_test_failures;                                            \
+    fn();                                                                     \
+    printf("%-40s %s\n", #fn, (s_test_failures == before_) ? "ok" : "FAILED"); \
+  } while(0)
+
+/**
+ * @brief 输出汇总并作为main()返回值
+ */
+#define TEST_REPORT()                                                         \
+  (printf("%d failure(s)\n", s_test_failures), (s_test_failures != 0))
+
+/**
+ * @brief   单调时钟（纳秒）
+ *
+ * @return  当前时间
+ */
+static inline uint64_t test_now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief   可复现的伪随机数（xorshift32）
+ *
+ * @param[in,out]   state  种子，不能为0
+ *
+ * @return  32位随机数
+ */
+static inline uint32_t test_rand(uint32_t *state)
+{
+  uint32_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+
+  return x;
+}
+
+/**
+ * @brief   读取录制的样本（CSV，每行第一列为ADC码值，非数字行跳过）
+ *
+ * @param[in]   path  文件路径
+ * @param[out]  buf   样本缓冲区
+ * @param[in]   max   缓冲区容量
+ *
+ * @return  读取的样本数，打开失败返回0
+ */
+static inline uint32_t test_load_csv(const char *path, uint16_t *buf, uint32_t max)
+{
+  FILE *fp = fopen(path, "r");
+  char line[128];
+  uint32_t n = 0;
+
+  if(fp == NULL)
+  {
+    printf("cannot open %s\n", path);
+    return 0;
+  }
+
+  while(n < max && fgets(line, sizeof(line), fp) != NULL)
+  {
+    unsigned int v;
+
+    if(sscanf(line, "%u", &v) == 1)
+    {
+      buf[n++] = (uint16_t)v;
+    }
+  }
+  fclose(fp);
+
+  return n;
+}
+
+#endif /* TEST_H */
@@ -0,0 +1,183 @@
+/**
+ * @file    test_adc_awd.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   ADC模拟看门狗主机端测试
+ *
+ * @details 基于drivers/posix下的比较器模型，覆盖：
+ *          - 窗口边界：low <= x <= high不告警，两端各越出1个码值告警
+ *          - 单次触发：进入回调后中断关闭，持续越限不再进入，adc_awd_arm()后恢复
+ *          - 状态锁存与清除、转换进行中/阈值颠倒时拒绝配置
+ *          - 中断次数：按应用策略（回调断开继电器、ALARM_REARM_MS后重新使能）
+ *            持续越限1秒，中断次数为1000/ALARM_REARM_MS，而不是每个转换一次
+ */
+
+#include "test.h"
+#include "drv_adc.h"
+#include "drv_adc_desc.h"
+#include <string.h>
+
+#define ADC_RATE_HZ     126262U
+#define ALARM_REARM_MS  100U
+#define BLOCK_LEN       512U
+
+static uint16_t s_dma[2 * BLOCK_LEN];
+static struct adc_desc s_adc = {.dma_buffer = s_dma, .buffer_len = 2 * BLOCK_LEN};
+
+static uint32_t s_cb_count;
+static adc_awd_t s_cb_awd;
+static bool s_relay_tripped;
+
+static void awd_callback(adc_desc_t adc, adc_awd_t awd, void *arg)
+{
+  (void)adc;
+  (void)arg;
+
+  s_cb_count++;
+  s_cb_awd = awd;
+  s_relay_tripped = true;
+}
+
+static uint32_t s_block_count;
+
+static void block_callback(adc_desc_t adc, const uint16_t *block, uint16_t len, void *arg)
+{
+  (void)adc;
+  (void)block;
+  (void)arg;
+
+  if(len == BLOCK_LEN)
+  {
+    s_block_count++;
+  }
+}
+
+static void reset(void)
+{
+  adc_init(&s_adc);
+  s_cb_count = 0;
+  s_cb_awd = ADC_AWD_NUM;
+  s_relay_tripped = false;
+  s_block_count = 0;
+}
+
+static void feed_one(uint16_t x)
+{
+  adc_host_feed(&s_adc, &x, 1);
+}
+
+/* 阈值包含在窗口内，越出1个码值才告警 */
+static void test_window_boundary(void)
+{
+  reset();
+  TEST_ASSERT_EQ(0, adc_awd_config(&s_adc, ADC_AWD_2, 2000, 63000, awd_callback, NULL));
+  adc_start_dma(&s_adc);
+
+  feed_one(2000);
+  feed_one(63000);
+  feed_one(32768);
+  TEST_ASSERT_EQ(0, s_cb_count);
+  TEST_ASSERT_EQ(0, adc_awd_get_status(&s_adc));
+
+  feed_one(63001);
+  TEST_ASSERT_EQ(1, s_cb_count);
+  TEST_ASSERT_EQ(ADC_AWD_2, s_cb_awd);
+  TEST_ASSERT_EQ(1U << ADC_AWD_2, adc_awd_get_status(&s_adc));
+
+  adc_awd_arm(&s_adc, ADC_AWD_2);
+  feed_one(1999);
+  TEST_ASSERT_EQ(2, s_cb_count);
+}
+
+/* 回调后中断关闭，持续越限不再进入；重新使能后再次触发 */
+static void test_one_shot(void)
+{
+  reset();
+  TEST_ASSERT_EQ(0, adc_awd_config(&s_adc, ADC_AWD_1, 0, 62000, awd_callback, NULL));
+  adc_start_dma(&s_adc);
+
+  for(uint32_t i = 0; i < 1000; i++)
+  {
+    feed_one(65535);
+  }
+  TEST_ASSERT_EQ(1, s_cb_count);
+  TEST_ASSERT_EQ(1, s_adc.awd_irq_count);
+  TEST_ASSERT(s_relay_tripped);
+
+  // 锁存状态不随信号恢复清除
+  feed_one(1000);
+  TEST_ASSERT_EQ(1U << ADC_AWD_1, adc_awd_get_status(&s_adc));
+  adc_awd_clear_status(&s_adc, 1U << ADC_AWD_1);
+  TEST_ASSERT_EQ(0, adc_awd_get_status(&s_adc));
+
+  // 关闭期间越限不进入回调，使能后下一次越限才触发
+  adc_awd_disarm(&s_adc, ADC_AWD_1);
+  adc_awd_arm(&s_adc, ADC_AWD_1);
+  adc_awd_disarm(&s_adc, ADC_AWD_1);
+  feed_one(65535);
+  TEST_ASSERT_EQ(1, s_cb_count);
+  adc_awd_arm(&s_adc, ADC_AWD_1);
+  feed_one(65535);
+  TEST_ASSERT_EQ(2, s_cb_count);
+}
+
+/* 参数校验：阈值颠倒、编号越界、转换进行中 */
+static void test_config_reject(void)
+{
+  reset();
+  TEST_ASSERT_EQ(-1, adc_awd_config(&s_adc, ADC_AWD_1, 3000, 2000, awd_callback, NULL));
+  TEST_ASSERT_EQ(-1, adc_awd_config(&s_adc, ADC_AWD_NUM, 0, 100, awd_callback, NULL));
+  TEST_ASSERT_EQ(-1, adc_awd_config(NULL, ADC_AWD_1, 0, 100, awd_callback, NULL));
+  TEST_ASSERT_EQ(0, adc_awd_config(&s_adc, ADC_AWD_1, 100, 100, awd_callback, NULL));
+
+  adc_start_dma(&s_adc);
+  TEST_ASSERT_EQ(-1, adc_awd_config(&s_adc, ADC_AWD_3, 0, 100, awd_callback, NULL));
+  adc_stop_dma(&s_adc);
+  TEST_ASSERT_EQ(0, adc_awd_config(&s_adc, ADC_AWD_3, 0, 100, awd_callback, NULL));
+}
+
+/* 持续越限1秒：按告警任务策略重新使能，中断次数由重新使能间隔决定；数据块照常交付 */
+static void test_storm_rate(void)
+{
+  const uint32_t rearm_samples = ADC_RATE_HZ * ALARM_REARM_MS / 1000U;
+  const uint32_t total = ADC_RATE_HZ;
+  uint32_t since_trip = 0;
+  bool waiting = false;
+
+  reset();
+  adc_set_block_callback(&s_adc, block_callback, NULL);
+  TEST_ASSERT_EQ(0, adc_awd_config(&s_adc, ADC_AWD_1, 0, 62000, awd_callback, NULL));
+  adc_start_dma(&s_adc);
+
+  for(uint32_t i = 0; i < total; i++)
+  {
+    uint32_t before = s_cb_count;
+
+    feed_one(64000);
+    if(s_cb_count != before)
+    {
+      waiting = true;
+      since_trip = 0;
+    }
+    else if(waiting && ++since_trip >= rearm_samples)
+    {
+      waiting = false;
+      adc_awd_arm(&s_adc, ADC_AWD_1);
+    }
+  }
+
+  printf("  %lu conversions out of range, %lu AWD interrupts\n",
+         (unsigned long)total, (unsigned long)s_adc.awd_irq_count);
+  TEST_ASSERT_EQ(1000U / ALARM_REARM_MS, s_adc.awd_irq_count);
+  TEST_ASSERT_EQ(total / BLOCK_LEN, s_block_count);
+}
+
+int main(void)
+{
+  TEST_RUN(test_window_boundary);
+  TEST_RUN(test_one_shot);
+  TEST_RUN(test_config_reject);
+  TEST_RUN(test_storm_rate);
+
+  return TEST_REPORT();
+}
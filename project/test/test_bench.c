@@ -0,0 +1,152 @@
+/**
+ * @file    test_bench.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   common/bench主机端运行：全部内核ns/sample与黄金校验
+ *
+ * @details 与目标板共用bench.c，周期计数函数换成CLOCK_MONOTONIC纳秒计数（cpu_hz = 1 GHz），
+ *          运行5轮取各内核最小耗时。任一内核校验和与黄金值不符即失败，
+ *          内核行为改动后主机端即可发现黄金值失效，无需上板。
+ *          黄金校验只针对固定的4096点合成数据；另以16倍长度的合成数据与可选的录制数据
+ *          报告ns/sample（4096点在缓存中，长数据反映流式处理的耗时）。
+ *
+ *          用法：test_bench [recording.csv]
+ */
+
+#include "test.h"
+#include "bench.h"
+#include <string.h>
+
+#define BENCH_ROUNDS    5
+#define HOST_CYCLE_HZ   1000000000UL
+#define LARGE_LEN       (16U * BENCH_DATA_LEN)
+#define RECORD_MAX      (1U << 20)
+
+static uint16_t s_input[RECORD_MAX];
+static int32_t s_work[2 * RECORD_MAX];
+static uint32_t s_record_len;
+
+/* 纳秒计数，32位回绕（单个内核远小于4.29 s） */
+static uint32_t host_cycles(void)
+{
+  return (uint32_t)test_now_ns();
+}
+
+/* 运行BENCH_ROUNDS轮取各内核最小耗时，校验和须与轮次无关 */
+static void run_best(uint32_t len, Bench_Result_t best[BENCH_KERNEL_NUM])
+{
+  const Bench_Buffer_t buf = {s_input, s_work};
+  Bench_Result_t results[BENCH_KERNEL_NUM];
+
+  for(uint32_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    TEST_ASSERT_EQ(0, Bench_RunData(&buf, len, host_cycles, results));
+    for(uint32_t k = 0; k < BENCH_KERNEL_NUM; k++)
+    {
+      if(r == 0 || results[k].cycles < best[k].cycles)
+      {
+        best[k] = results[k];
+      }
+      TEST_ASSERT_EQ(best[k].checksum, results[k].checksum);
+    }
+  }
+}
+
+static void print_best(const Bench_Result_t best[BENCH_KERNEL_NUM])
+{
+  printf("  %-12s %8s %10s %12s\n", "kernel", "samples", "ns/sample", "checksum");
+  for(uint32_t k = 0; k < BENCH_KERNEL_NUM; k++)
+  {
+    printf("  %-12s %8lu %10.2f   0x%08lX\n", best[k].name, (unsigned long)best[k].samples,
+           (double)Bench_NsPerSample(&best[k], HOST_CYCLE_HZ), (unsigned long)best[k].checksum);
+  }
+}
+
+static void test_golden(void)
+{
+  const Bench_Buffer_t buf = {s_input, s_work};
+  Bench_Result_t results[BENCH_KERNEL_NUM];
+  Bench_Result_t best[BENCH_KERNEL_NUM];
+
+  TEST_ASSERT_EQ(-1, Bench_Run(NULL, host_cycles, results));
+  TEST_ASSERT_EQ(-1, Bench_Run(&buf, NULL, results));
+
+  for(uint32_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    TEST_ASSERT_EQ(0, Bench_Run(&buf, host_cycles, results));
+    for(uint32_t k = 0; k < BENCH_KERNEL_NUM; k++)
+    {
+      if(r == 0 || results[k].cycles < best[k].cycles)
+      {
+        best[k] = results[k];
+      }
+      // 每轮重新初始化，结果与轮次无关
+      TEST_ASSERT_EQ(best[k].checksum, results[k].checksum);
+    }
+  }
+
+  printf("  %-12s %8s %10s %12s %12s\n", "kernel", "samples", "ns/sample", "checksum", "golden");
+  for(uint32_t k = 0; k < BENCH_KERNEL_NUM; k++)
+  {
+    printf("  %-12s %8lu %10.2f   0x%08lX   0x%08lX %s\n", best[k].name,
+           (unsigned long)best[k].samples, (double)Bench_NsPerSample(&best[k], HOST_CYCLE_HZ),
+           (unsigned long)best[k].checksum, (unsigned long)best[k].golden,
+           best[k].pass ? "" : "FAIL");
+    TEST_ASSERT(best[k].pass);
+    TEST_ASSERT_EQ(best[k].golden, best[k].checksum);
+  }
+}
+
+/* 16倍长度合成数据：前BENCH_DATA_LEN点与黄金数据相同 */
+static void test_large_synthetic(void)
+{
+  const Bench_Buffer_t buf = {s_input, s_work};
+  Bench_Result_t best[BENCH_KERNEL_NUM];
+  uint16_t golden_input[BENCH_DATA_LEN];
+
+  TEST_ASSERT_EQ(-1, Bench_RunData(&buf, 0, host_cycles, best));
+  TEST_ASSERT_EQ(-1, Bench_RunData(&buf, LARGE_LEN, NULL, best));
+
+  Bench_Generate(golden_input, BENCH_DATA_LEN);
+  Bench_Generate(s_input, LARGE_LEN);
+  TEST_ASSERT(memcmp(golden_input, s_input, sizeof(golden_input)) == 0);
+
+  run_best(LARGE_LEN, best);
+  print_best(best);
+  for(uint32_t k = 0; k < BENCH_KERNEL_NUM; k++)
+  {
+    TEST_ASSERT_EQ(LARGE_LEN, best[k].samples);
+    TEST_ASSERT(best[k].pass);
+  }
+}
+
+/* 录制数据（命令行给出时） */
+static void test_recording(void)
+{
+  Bench_Result_t best[BENCH_KERNEL_NUM];
+
+  run_best(s_record_len, best);
+  print_best(best);
+  for(uint32_t k = 0; k < BENCH_KERNEL_NUM; k++)
+  {
+    TEST_ASSERT_EQ(s_record_len, best[k].samples);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  TEST_RUN(test_golden);
+  TEST_RUN(test_large_synthetic);
+
+  if(argc > 1)
+  {
+    s_record_len = test_load_csv(argv[1], s_input, RECORD_MAX);
+    TEST_ASSERT(s_record_len > 0);
+    if(s_record_len > 0)
+    {
+      TEST_RUN(test_recording);
+    }
+  }
+
+  return TEST_REPORT();
+}
@@ -0,0 +1,326 @@
+/**
+ * @file    test_biquad.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   定点biquad主机端测试
+ *
+ * @details 以双精度浮点为参考：
+ *          - 频响：正弦激励稳态后按同相/正交分量求幅度，与设计系数的H(e^jw)比较，
+ *            覆盖低通/高通/陷波/带通、Q15/Q31、DF1/DF2T
+ *          - 时域：Q31输出与双精度DF1逐样本误差不超过数个LSB
+ *          - 块处理与逐样本路径逐位一致
+ *          - 溢出：高Q谐振被满量程方波激励，输出饱和在±BIQUAD_Q31_DATA_MAX内；
+ *            本测试以-fsanitize=signed-integer-overflow构建，累加溢出即失败
+ */
+
+#include "test.h"
+#include "biquad.h"
+#include <string.h>
+
+#define PI          3.14159265358979323846
+#define FS          1000.0
+#define SETTLE      4000U
+#define MEASURE     5000U
+
+/* 双精度参考：设计系数的频响幅度 */
+static double ref_gain(const Biquad_Design_t *d, uint8_t stages, double f)
+{
+  double w = 2.0 * PI * f / FS;
+  double gain = 1.0;
+
+  for(uint8_t i = 0; i < stages; i++)
+  {
+    double nr = d[i].b0 + d[i].b1 * cos(w) + d[i].b2 * cos(2.0 * w);
+    double ni = -d[i].b1 * sin(w) - d[i].b2 * sin(2.0 * w);
+    double dr = 1.0 + d[i].a1 * cos(w) + d[i].a2 * cos(2.0 * w);
+    double di = -d[i].a1 * sin(w) - d[i].a2 * sin(2.0 * w);
+
+    gain *= sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+  }
+
+  return gain;
+}
+
+/* 按频率f的同相/正交分量求幅度（MEASURE点为整数个周期时无泄漏） */
+static double tone_amplitude(const double *y, uint32_t n, double f, uint32_t t0)
+{
+  double re = 0.0;
+  double im = 0.0;
+
+  for(uint32_t i = 0; i < n; i++)
+  {
+    double w = 2.0 * PI * f * (double)(t0 + i) / FS;
+
+    re += y[i] * cos(w);
+    im += y[i] * sin(w);
+  }
+
+  return 2.0 * sqrt(re * re + im * im) / n;
+}
+
+static double measure_q31(const Biquad_Design_t *d, uint8_t stages, Biquad_Form_t form,
+                          double f, double amp)
+{
+  static double y[MEASURE];
+  BiquadQ31_Handle_t filt;
+
+  BiquadQ31_Init(&filt, form, d, stages);
+  for(uint32_t i = 0; i < SETTLE + MEASURE; i++)
+  {
+    int32_t x = (int32_t)lround(amp * sin(2.0 * PI * f * i / FS));
+    int32_t out = BiquadQ31_Update(&filt, x);
+
+    if(i >= SETTLE)
+    {
+      y[i - SETTLE] = out;
+    }
+  }
+
+  return tone_amplitude(y, MEASURE, f, SETTLE) / amp;
+}
+
+static double measure_q15(const Biquad_Design_t *d, uint8_t stages, Biquad_Form_t form,
+                          double f, double amp)
+{
+  static double y[MEASURE];
+  BiquadQ15_Handle_t filt;
+
+  BiquadQ15_Init(&filt, form, d, stages);
+  for(uint32_t i = 0; i < SETTLE + MEASURE; i++)
+  {
+    int16_t x = (int16_t)lround(amp * sin(2.0 * PI * f * i / FS));
+    int16_t out = BiquadQ15_Update(&filt, x);
+
+    if(i >= SETTLE)
+    {
+      y[i - SETTLE] = out;
+    }
+  }
+
+  return tone_amplitude(y, MEASURE, f, SETTLE) / amp;
+}
+
+static void test_design_args(void)
+{
+  Biquad_Design_t d;
+  BiquadQ31_Handle_t q31;
+
+  TEST_ASSERT_EQ(-1, Biquad_DesignLowPass(&d, FS, 0.0, 0.707));
+  TEST_ASSERT_EQ(-1, Biquad_DesignLowPass(&d, FS, FS / 2.0, 0.707));
+  TEST_ASSERT_EQ(-1, Biquad_DesignNotch(&d, FS, 50.0, 0.0));
+  TEST_ASSERT_EQ(-1, Biquad_DesignBandPass(NULL, FS, 50.0, 1.0));
+  TEST_ASSERT_EQ(0, Biquad_DesignLowPass(&d, FS, 100.0, 0.707));
+  TEST_ASSERT_EQ(-1, BiquadQ31_Init(&q31, BIQUAD_DF1, &d, 0));
+  TEST_ASSERT_EQ(-1, BiquadQ31_Init(&q31, BIQUAD_DF1, &d, BIQUAD_MAX_STAGES + 1));
+
+  // 系数超出[-2, 2)
+  d.a1 = -2.0;
+  TEST_ASSERT_EQ(0, BiquadQ31_Init(&q31, BIQUAD_DF1, &d, 1));
+  d.a1 = 2.0;
+  TEST_ASSERT_EQ(-1, BiquadQ31_Init(&q31, BIQUAD_DF1, &d, 1));
+}
+
+/* 各类型频响与双精度参考一致（线性幅度绝对误差） */
+static void test_frequency_response(void)
+{
+  // 测试频率取整数个周期/MEASURE点：f * MEASURE / FS为整数
+  static const double freqs[] = {2.0, 10.0, 25.0, 50.0, 60.0, 100.0, 150.0, 250.0, 400.0};
+  Biquad_Design_t lp4[2];
+  Biquad_Design_t hp;
+  Biquad_Design_t notch;
+  Biquad_Design_t bp;
+  static const struct
+  {
+    const char *name;
+    uint8_t idx;
+    uint8_t stages;
+  } cases[] =
+  {
+    {"lowpass4", 0, 2},
+    {"highpass", 2, 1},
+    {"notch50",  3, 1},
+    {"bandpass", 4, 1},
+  };
+  const Biquad_Design_t *designs[5];
+
+  Biquad_DesignLowPass(&lp4[0], FS, 100.0, 0.5412);
+  Biquad_DesignLowPass(&lp4[1], FS, 100.0, 1.3066);
+  Biquad_DesignHighPass(&hp, FS, 30.0, 0.7071);
+  Biquad_DesignNotch(&notch, FS, 50.0, 5.0);
+  Biquad_DesignBandPass(&bp, FS, 150.0, 2.0);
+  designs[0] = lp4;
+  designs[2] = &hp;
+  designs[3] = &notch;
+  designs[4] = &bp;
+
+  for(uint32_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+  {
+    const Biquad_Design_t *d = designs[cases[c].idx];
+    double err31 = 0.0;
+    double err15 = 0.0;
+
+    for(uint32_t k = 0; k < sizeof(freqs) / sizeof(freqs[0]); k++)
+    {
+      double ref = ref_gain(d, cases[c].stages, freqs[k]);
+
+      for(int form = BIQUAD_DF1; form <= BIQUAD_DF2T; form++)
+      {
+        double g31 = measure_q31(d, cases[c].stages, (Biquad_Form_t)form, freqs[k], 1 << 24);
+        double g15 = measure_q15(d, cases[c].stages, (Biquad_Form_t)form, freqs[k], 16000.0);
+
+        err31 = fmax(err31, fabs(g31 - ref));
+        err15 = fmax(err15, fabs(g15 - ref));
+      }
+    }
+
+    printf("  %-9s max |H| error: Q31 %.2e  Q15 %.2e\n", cases[c].name, err31, err15);
+    TEST_ASSERT(err31 < 1e-5);
+    TEST_ASSERT(err15 < 5e-3);
+  }
+
+  // 陷波中心衰减
+  TEST_ASSERT(measure_q31(&notch, 1, BIQUAD_DF1, 50.0, 1 << 24) < 1e-3);
+}
+
+/* Q31与双精度DF1逐样本比较（随机宽带输入） */
+static void test_time_domain(void)
+{
+  Biquad_Design_t d[2];
+  BiquadQ31_Handle_t filt;
+  double s[2][4] = {{0}};
+  double max_err = 0.0;
+  uint32_t seed = 31;
+
+  Biquad_DesignLowPass(&d[0], FS, 80.0, 0.5412);
+  Biquad_DesignLowPass(&d[1], FS, 80.0, 1.3066);
+  BiquadQ31_Init(&filt, BIQUAD_DF2T, d, 2);
+
+  for(uint32_t i = 0; i < 20000; i++)
+  {
+    int32_t x = (int32_t)(test_rand(&seed) % (1U << 24)) - (1 << 23);
+    double y = x;
+
+    for(uint32_t k = 0; k < 2; k++)
+    {
+      double out = d[k].b0 * y + d[k].b1 * s[k][0] + d[k].b2 * s[k][1]
+                   - d[k].a1 * s[k][2] - d[k].a2 * s[k][3];
+
+      s[k][1] = s[k][0];
+      s[k][0] = y;
+      s[k][3] = s[k][2];
+      s[k][2] = out;
+      y = out;
+    }
+    max_err = fmax(max_err, fabs(BiquadQ31_Update(&filt, x) - y));
+  }
+
+  printf("  Q31 vs double max error %.2f LSB\n", max_err);
+  TEST_ASSERT(max_err < 8.0);
+}
+
+/* 块处理与逐样本逐位一致（随机块长、原地处理） */
+static void test_process_equivalence(void)
+{
+  static int32_t in31[8192];
+  static int32_t out31[8192];
+  static int16_t in15[8192];
+  static int16_t out15[8192];
+  Biquad_Design_t d[2];
+  uint32_t seed = 7;
+
+  Biquad_DesignLowPass(&d[0], FS, 120.0, 0.7071);
+  Biquad_DesignNotch(&d[1], FS, 50.0, 3.0);
+  for(uint32_t i = 0; i < 8192; i++)
+  {
+    in15[i] = (int16_t)test_rand(&seed);
+    in31[i] = (int32_t)(test_rand(&seed) % (2U * BIQUAD_Q31_DATA_MAX)) - BIQUAD_Q31_DATA_MAX;
+  }
+
+  for(int form = BIQUAD_DF1; form <= BIQUAD_DF2T; form++)
+  {
+    BiquadQ31_Handle_t r31;
+    BiquadQ31_Handle_t p31;
+    BiquadQ15_Handle_t r15;
+    BiquadQ15_Handle_t p15;
+    uint32_t diff = 0;
+
+    BiquadQ31_Init(&r31, (Biquad_Form_t)form, d, 2);
+    BiquadQ31_Init(&p31, (Biquad_Form_t)form, d, 2);
+    BiquadQ15_Init(&r15, (Biquad_Form_t)form, d, 2);
+    BiquadQ15_Init(&p15, (Biquad_Form_t)form, d, 2);
+    memcpy(out31, in31, sizeof(in31));
+    memcpy(out15, in15, sizeof(in15));
+
+    for(uint32_t i = 0, n = 0; i < 8192; i += n)
+    {
+      n = test_rand(&seed) % 100;
+      n = (n > 8192 - i) ? 8192 - i : n;
+      BiquadQ31_Process(&p31, &out31[i], &out31[i], n);
+      BiquadQ15_Process(&p15, &out15[i], &out15[i], n);
+    }
+    for(uint32_t i = 0; i < 8192; i++)
+    {
+      diff += (BiquadQ31_Update(&r31, in31[i]) != out31[i]);
+      diff += (BiquadQ15_Update(&r15, in15[i]) != out15[i]);
+    }
+    TEST_ASSERT_EQ(0, diff);
+  }
+}
+
+/*
+ * 反馈状态饱和时累加不溢出：
+ * - 高Q谐振（极点半径约0.9994）4节级联被满量程方波激励
+ * - 系数取Q30范围边缘（b0 = b1 = b2 ≈ 2），满量程直流输入，5个乘积同号
+ */
+static void test_q31_saturation(void)
+{
+  Biquad_Design_t d[BIQUAD_MAX_STAGES];
+  const Biquad_Design_t edge = {1.999, 1.999, 1.999, -1.999, 0.9995};
+  int32_t peak = 0;
+
+  for(uint32_t k = 0; k < BIQUAD_MAX_STAGES; k++)
+  {
+    Biquad_DesignLowPass(&d[k], FS, 5.0, 50.0);
+  }
+
+  for(int form = BIQUAD_DF1; form <= BIQUAD_DF2T; form++)
+  {
+    BiquadQ31_Handle_t filt;
+    int32_t block[100];
+
+    TEST_ASSERT_EQ(0, BiquadQ31_Init(&filt, (Biquad_Form_t)form, d, BIQUAD_MAX_STAGES));
+    for(uint32_t i = 0; i < 200; i++)
+    {
+      for(uint32_t k = 0; k < 100; k++)
+      {
+        block[k] = ((i % 2) == 0) ? INT32_MAX : INT32_MIN;
+      }
+      BiquadQ31_Process(&filt, block, block, 100);
+      for(uint32_t k = 0; k < 100; k++)
+      {
+        TEST_ASSERT(block[k] >= -BIQUAD_Q31_DATA_MAX && block[k] <= BIQUAD_Q31_DATA_MAX);
+        peak = (block[k] > peak) ? block[k] : peak;
+      }
+    }
+
+    TEST_ASSERT_EQ(0, BiquadQ31_Init(&filt, (Biquad_Form_t)form, &edge, 1));
+    for(uint32_t i = 0; i < 1000; i++)
+    {
+      TEST_ASSERT_EQ(BIQUAD_Q31_DATA_MAX, BiquadQ31_Update(&filt, INT32_MAX));
+    }
+  }
+
+  // 确实进入饱和
+  TEST_ASSERT_EQ(BIQUAD_Q31_DATA_MAX, peak);
+}
+
+int main(void)
+{
+  TEST_RUN(test_design_args);
+  TEST_RUN(test_frequency_response);
+  TEST_RUN(test_time_domain);
+  TEST_RUN(test_process_equivalence);
+  TEST_RUN(test_q31_saturation);
+
+  return TEST_REPORT();
+}
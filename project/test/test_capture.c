@@ -0,0 +1,254 @@
+/**
+ * @file    test_capture.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   波形捕获主机端测试与触发检测速率测量
+ *
+ * @details 功能测试覆盖配置校验、电平/斜率/窗口触发位置与预触发历史布局、槽位耗尽。
+ *          速率测量按固件参数（512点块）对录制数据逐块调用Capture_Feed，
+ *          触发阈值设为不可达（每个样本都要比较，最坏情况），输出每秒样本数，
+ *          须不低于两路ADC合计采样率。
+ *
+ *          用法：test_capture [recording.csv]，不给文件时使用合成数据（正弦+噪声+尖峰）
+ */
+
+#include "test.h"
+#include "capture.h"
+#include <string.h>
+
+#define ADC_RATE_HZ     126262.0
+#define ADC_CHANNELS    2
+#define RATE_BLOCK_LEN  512
+#define RATE_SAMPLES    (1U << 20)
+
+static uint16_t s_storage[4 * 16 * RATE_BLOCK_LEN];
+static uint16_t s_recording[RATE_SAMPLES];
+static uint32_t s_recording_len;
+
+/* 生成第b块：ramp为块内递增序列，便于核对顺序 */
+static void make_block(uint16_t *blk, uint16_t len, uint32_t b)
+{
+  for(uint16_t i = 0; i < len; i++)
+  {
+    blk[i] = (uint16_t)(1000 + b * 16 + i);
+  }
+}
+
+static void test_init_range(void)
+{
+  Capture_Handle_t cap;
+  Capture_Config_t cfg = {s_storage, 512, 4, 12, 4};
+
+  TEST_ASSERT_EQ(0, Capture_Init(&cap, &cfg));
+  TEST_ASSERT_EQ(-1, Capture_Init(NULL, &cfg));
+
+  // 4096 * 16 = 65536个样本，trigger_index与文件寄存器号溢出
+  cfg.block_len = 4096;
+  TEST_ASSERT_EQ(-1, Capture_Init(&cap, &cfg));
+
+  // 恰为上限
+  cfg.block_len = (uint16_t)CAPTURE_MAX_RECORD_LEN;
+  cfg.pre_blocks = 0;
+  cfg.post_blocks = 1;
+  TEST_ASSERT_EQ(0, Capture_Init(&cap, &cfg));
+  cfg.block_len = (uint16_t)(CAPTURE_MAX_RECORD_LEN + 1U);
+  TEST_ASSERT_EQ(-1, Capture_Init(&cap, &cfg));
+
+  cfg = (Capture_Config_t){s_storage, 8, 2, 0, 1};
+  TEST_ASSERT_EQ(-1, Capture_Init(&cap, &cfg));
+  cfg.post_blocks = 1;
+  cfg.slot_count = CAPTURE_MAX_SLOTS + 1;
+  TEST_ASSERT_EQ(-1, Capture_Init(&cap, &cfg));
+}
+
+/* 电平触发：记录为触发块前2块 + 触发块起3块，trigger_index指向越过阈值的样本 */
+static void test_level_trigger(void)
+{
+  Capture_Handle_t cap;
+  const Capture_Config_t cfg = {s_storage, 8, 2, 3, 2};
+  const Capture_Trigger_t trig = {.type = CAPTURE_TRIG_LEVEL, .edge = CAPTURE_EDGE_RISING,
+                                  .level = 1000 + 6 * 16 + 5};
+  Capture_Record_t rec;
+  uint16_t blk[8];
+  uint16_t out[5 * 8];
+  uint32_t b;
+  bool done = false;
+
+  Capture_Init(&cap, &cfg);
+  Capture_SetTrigger(&cap, &trig);
+
+  for(b = 0; b < 20 && !done; b++)
+  {
+    make_block(blk, 8, b);
+    done = Capture_Feed(&cap, blk);
+  }
+
+  // 触发块为第6块，之后再写2块完成
+  TEST_ASSERT(done);
+  TEST_ASSERT_EQ(9, b);
+  TEST_ASSERT_EQ(0, Capture_GetRecord(&cap, 0, &rec));
+  TEST_ASSERT_EQ(2 * 8 + 5, rec.trigger_index);
+  TEST_ASSERT_EQ(5, rec.block_count);
+  TEST_ASSERT_EQ(7, rec.block_seq);
+  TEST_ASSERT_EQ(CAPTURE_TRIG_LEVEL, rec.trigger_type);
+
+  TEST_ASSERT_EQ(0, Capture_Read(&cap, 0, 0, out, 5 * 8));
+  for(uint32_t i = 0; i < 5 * 8; i++)
+  {
+    TEST_ASSERT_EQ(1000 + (4 + i / 8) * 16 + i % 8, out[i]);
+  }
+  TEST_ASSERT_EQ(trig.level, out[rec.trigger_index]);
+
+  // 越界读取
+  TEST_ASSERT_EQ(-1, Capture_Read(&cap, 0, 1, out, 5 * 8));
+}
+
+/* 斜率与窗口触发位置，跨块边沿 */
+static void test_slope_window(void)
+{
+  Capture_Handle_t cap;
+  const Capture_Config_t cfg = {s_storage, 8, 1, 1, 1};
+  Capture_Trigger_t trig = {.type = CAPTURE_TRIG_SLOPE, .edge = CAPTURE_EDGE_FALLING, .slope = 100};
+  Capture_Record_t rec;
+  uint16_t blk[8] = {500, 500, 500, 500, 500, 500, 500, 500};
+
+  Capture_Init(&cap, &cfg);
+  Capture_SetTrigger(&cap, &trig);
+  TEST_ASSERT(!Capture_Feed(&cap, blk));
+
+  // 块首样本相对上一块末样本下降150
+  blk[0] = 350;
+  TEST_ASSERT(Capture_Feed(&cap, blk));
+  TEST_ASSERT_EQ(0, Capture_GetRecord(&cap, 0, &rec));
+  TEST_ASSERT_EQ(8 + 0, rec.trigger_index);
+
+  Capture_Release(&cap, 0);
+  trig = (Capture_Trigger_t){.type = CAPTURE_TRIG_WINDOW, .low = 400, .high = 600};
+  Capture_SetTrigger(&cap, &trig);
+  blk[0] = 500;
+  TEST_ASSERT(!Capture_Feed(&cap, blk));
+  blk[6] = 601;
+  TEST_ASSERT(Capture_Feed(&cap, blk));
+  TEST_ASSERT_EQ(0, Capture_GetRecord(&cap, 0, &rec));
+  TEST_ASSERT_EQ(8 + 6, rec.trigger_index);
+  TEST_ASSERT_EQ(CAPTURE_TRIG_WINDOW, rec.trigger_type);
+}
+
+/* 槽位全部等待读取时丢弃数据块，释放后恢复 */
+static void test_slots_exhausted(void)
+{
+  Capture_Handle_t cap;
+  const Capture_Config_t cfg = {s_storage, 4, 0, 1, 2};
+  uint16_t blk[4] = {1, 2, 3, 4};
+
+  Capture_Init(&cap, &cfg);
+  Capture_Force(&cap);
+  TEST_ASSERT(Capture_Feed(&cap, blk));
+  Capture_Force(&cap);
+  TEST_ASSERT(Capture_Feed(&cap, blk));
+  Capture_Force(&cap);
+  TEST_ASSERT(!Capture_Feed(&cap, blk));
+  TEST_ASSERT_EQ(1, cap.missed);
+
+  TEST_ASSERT_EQ(0, Capture_Release(&cap, 1));
+  TEST_ASSERT_EQ(-1, Capture_Release(&cap, 1));
+  TEST_ASSERT(Capture_Feed(&cap, blk));
+}
+
+/* 合成录制数据：50 Hz正弦 + 噪声 + 偶发尖峰 */
+static void make_recording(void)
+{
+  uint32_t seed = 2024;
+
+  for(uint32_t i = 0; i < RATE_SAMPLES; i++)
+  {
+    double v = 32768.0 + 12000.0 * sin(2.0 * 3.14159265358979 * 50.0 * i / ADC_RATE_HZ);
+
+    v += (double)(test_rand(&seed) % 400) - 200.0;
+    if(test_rand(&seed) % 5000 == 0)
+    {
+      v += 20000.0;
+    }
+    // 限幅低于满量程，电平触发阈值65535不可达
+    s_recording[i] = (uint16_t)(v < 0.0 ? 0.0 : v > 65000.0 ? 65000.0 : v);
+  }
+  s_recording_len = RATE_SAMPLES;
+}
+
+/* 逐块输入录制数据，返回每秒样本数；missed为因触发后槽位占满而未检测的块数 */
+static double feed_rate(const Capture_Trigger_t *trig, uint32_t *missed)
+{
+  static Capture_Handle_t cap;
+  const Capture_Config_t cfg = {s_storage, RATE_BLOCK_LEN, 4, 12, 4};
+  const uint32_t blocks = s_recording_len / RATE_BLOCK_LEN;
+  const uint32_t rounds = 8;
+  uint64_t t0;
+  uint64_t t1;
+
+  Capture_Init(&cap, &cfg);
+  Capture_SetTrigger(&cap, trig);
+
+  t0 = test_now_ns();
+  for(uint32_t r = 0; r < rounds; r++)
+  {
+    for(uint32_t b = 0; b < blocks; b++)
+    {
+      Capture_Feed(&cap, &s_recording[b * RATE_BLOCK_LEN]);
+    }
+  }
+  t1 = test_now_ns();
+  *missed = cap.missed;
+
+  return (double)rounds * blocks * RATE_BLOCK_LEN * 1e9 / (double)(t1 - t0);
+}
+
+static void test_trigger_rate(void)
+{
+  static const struct
+  {
+    const char *name;
+    Capture_Trigger_t trig;
+  } cases[] =
+  {
+    {"none",   {.type = CAPTURE_TRIG_NONE}},
+    {"level",  {.type = CAPTURE_TRIG_LEVEL, .edge = CAPTURE_EDGE_BOTH, .level = 65535}},
+    {"slope",  {.type = CAPTURE_TRIG_SLOPE, .edge = CAPTURE_EDGE_BOTH, .slope = 65535}},
+    {"window", {.type = CAPTURE_TRIG_WINDOW, .low = 0, .high = 65535}},
+  };
+  const double required = ADC_RATE_HZ * ADC_CHANNELS;
+
+  for(uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+  {
+    uint32_t missed;
+    double rate = feed_rate(&cases[i].trig, &missed);
+
+    printf("  %-8s %8.1f Msample/s  %7.1fx ADC rate  (%lu blocks skipped)\n", cases[i].name,
+           rate / 1e6, rate / required, (unsigned long)missed);
+    TEST_ASSERT(rate >= required);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  TEST_RUN(test_init_range);
+  TEST_RUN(test_level_trigger);
+  TEST_RUN(test_slope_window);
+  TEST_RUN(test_slots_exhausted);
+
+  if(argc > 1)
+  {
+    s_recording_len = test_load_csv(argv[1], s_recording, RATE_SAMPLES);
+    s_recording_len -= s_recording_len % RATE_BLOCK_LEN;
+    TEST_ASSERT(s_recording_len > 0);
+  }
+  else
+  {
+    make_recording();
+  }
+  if(s_recording_len > 0)
+  {
+    TEST_RUN(test_trigger_rate);
+  }
+
+  return TEST_REPORT();
+}
@@ -0,0 +1,274 @@
+/**
+ * @file    test_cic.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   CIC抽取器主机端测试与基准
+ *
+ * @details 功能测试：
+ *          - 参数与位宽校验
+ *          - 直流输入稳态输出为x << CIC_OUTPUT_FRAC_BITS
+ *          - 与双精度参考（N级R点滑动和、抽取、除以R^N）逐点比较，误差小于1/2^8 LSB
+ *          - 块处理随机分块与逐样本路径逐位一致
+ *          - 通带增益：未补偿时符合sinc^N下垂，补偿后下垂减小
+ *          基准：按固件配置（N = 3，R = 64）及各级数测量块处理/逐样本每秒输入样本数，
+ *          须不低于两路ADC合计采样率。
+ */
+
+#include "test.h"
+#include "cic.h"
+#include <string.h>
+
+#define PI              3.14159265358979323846
+#define ADC_RATE_HZ     126262.0
+#define ADC_CHANNELS    2
+#define DATA_LEN        (1U << 18)
+
+static uint16_t s_input[DATA_LEN];
+static int32_t s_out_a[DATA_LEN / 2 + 1];
+static int32_t s_out_b[DATA_LEN / 2 + 1];
+static volatile int32_t s_sink;
+
+static void test_init_args(void)
+{
+  CIC_Handle_t cic;
+
+  TEST_ASSERT_EQ(-1, CIC_Init(NULL, 3, 64, false));
+  TEST_ASSERT_EQ(-1, CIC_Init(&cic, 0, 64, false));
+  TEST_ASSERT_EQ(-1, CIC_Init(&cic, CIC_MAX_ORDER + 1, 64, false));
+  TEST_ASSERT_EQ(-1, CIC_Init(&cic, 3, 1, false));
+
+  // 16 + 5 * 8 + 8 = 64 > 63
+  TEST_ASSERT_EQ(-1, CIC_Init(&cic, 5, 256, false));
+  TEST_ASSERT_EQ(0, CIC_Init(&cic, 5, 128, false));
+  TEST_ASSERT_EQ(0, CIC_Init(&cic, 3, 64, true));
+}
+
+/* 直流：N个输出后稳态 */
+static void test_dc(void)
+{
+  static const uint16_t ratios[] = {2, 10, 64, 100};
+  static const uint16_t levels[] = {0, 1, 12345, 65535};
+
+  for(uint8_t order = 1; order <= CIC_MAX_ORDER; order++)
+  {
+    for(uint32_t r = 0; r < sizeof(ratios) / sizeof(ratios[0]); r++)
+    {
+      for(uint32_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++)
+      {
+        CIC_Handle_t cic;
+        int32_t out = 0;
+        uint32_t produced = 0;
+
+        TEST_ASSERT_EQ(0, CIC_Init(&cic, order, ratios[r], true));
+        for(uint32_t i = 0; i < (uint32_t)(order + 3) * ratios[r]; i++)
+        {
+          produced += CIC_Update(&cic, levels[l], &out);
+        }
+        TEST_ASSERT_EQ(order + 3, produced);
+        TEST_ASSERT_EQ((int32_t)levels[l] << CIC_OUTPUT_FRAC_BITS, out);
+      }
+    }
+  }
+}
+
+/* 参考：N级R点滑动和（全精度整数），每R个输入取一个，除以R^N */
+static void test_reference(void)
+{
+  const uint8_t order = 3;
+  const uint16_t ratio = 10;
+  const uint32_t n = 20000;
+  static double stage[CIC_MAX_ORDER + 1][20000];
+  CIC_Handle_t cic;
+  uint32_t seed = 3;
+  uint32_t k = 0;
+  double max_err = 0.0;
+
+  for(uint32_t i = 0; i < n; i++)
+  {
+    s_input[i] = (uint16_t)test_rand(&seed);
+    stage[0][i] = s_input[i];
+  }
+  for(uint8_t s = 1; s <= order; s++)
+  {
+    for(uint32_t i = 0; i < n; i++)
+    {
+      double acc = 0.0;
+
+      for(uint32_t j = 0; j < ratio && j <= i; j++)
+      {
+        acc += stage[s - 1][i - j];
+      }
+      stage[s][i] = acc;
+    }
+  }
+
+  CIC_Init(&cic, order, ratio, false);
+  for(uint32_t i = 0; i < n; i++)
+  {
+    int32_t out;
+
+    if(CIC_Update(&cic, s_input[i], &out))
+    {
+      double ref = stage[order][i] / 1000.0 * (1 << CIC_OUTPUT_FRAC_BITS);
+
+      max_err = fmax(max_err, fabs(out - ref));
+      k++;
+    }
+  }
+
+  TEST_ASSERT_EQ(n / ratio, k);
+  // 截断到1/2^8 LSB
+  TEST_ASSERT(max_err < 1.0);
+}
+
+/* 块处理与逐样本逐位一致 */
+static void test_process_equivalence(void)
+{
+  static const uint16_t ratios[] = {2, 7, 64, 100};
+  uint32_t seed = 11;
+
+  for(uint32_t i = 0; i < DATA_LEN; i++)
+  {
+    s_input[i] = (uint16_t)test_rand(&seed);
+  }
+
+  for(uint8_t order = 1; order <= CIC_MAX_ORDER; order++)
+  {
+    for(uint32_t r = 0; r < sizeof(ratios) / sizeof(ratios[0]); r++)
+    {
+      CIC_Handle_t ref;
+      CIC_Handle_t blk;
+      uint32_t count_a = 0;
+      uint32_t count_b = 0;
+      const uint32_t n = 50000;
+
+      CIC_Init(&ref, order, ratios[r], (r & 1U) != 0);
+      CIC_Init(&blk, order, ratios[r], (r & 1U) != 0);
+      for(uint32_t i = 0; i < n; i++)
+      {
+        count_a += CIC_Update(&ref, s_input[i], &s_out_a[count_a]);
+      }
+      for(uint32_t i = 0, len = 0; i < n; i += len)
+      {
+        len = test_rand(&seed) % 300;
+        len = (len > n - i) ? n - i : len;
+        count_b += CIC_Process(&blk, &s_input[i], len, &s_out_b[count_b]);
+      }
+
+      TEST_ASSERT_EQ(count_a, count_b);
+      TEST_ASSERT(memcmp(s_out_a, s_out_b, count_a * sizeof(int32_t)) == 0);
+    }
+  }
+}
+
+/* 以输出采样率fo下频率f的正弦测量增益（输入幅度a，直流偏置32768） */
+static double measure_gain(uint8_t order, uint16_t ratio, bool comp, double f_over_fo)
+{
+  CIC_Handle_t cic;
+  const double amp = 20000.0;
+  const uint32_t settle = 64;
+  uint32_t count = 0;
+  double re = 0.0;
+  double im = 0.0;
+
+  CIC_Init(&cic, order, ratio, comp);
+  for(uint32_t i = 0; i < DATA_LEN; i++)
+  {
+    double t = (double)i / ratio;
+    s_input[i] = (uint16_t)lround(32768.0 + amp * sin(2.0 * PI * f_over_fo * t));
+  }
+  count = CIC_Process(&cic, s_input, DATA_LEN, s_out_a);
+
+  for(uint32_t k = settle; k < count; k++)
+  {
+    double y = s_out_a[k] / (double)(1 << CIC_OUTPUT_FRAC_BITS) - 32768.0;
+
+    re += y * cos(2.0 * PI * f_over_fo * k);
+    im += y * sin(2.0 * PI * f_over_fo * k);
+  }
+
+  return 2.0 * sqrt(re * re + im * im) / (count - settle) / amp;
+}
+
+/* 通带下垂：未补偿与sinc^N一致，补偿后更接近1 */
+static void test_passband(void)
+{
+  const uint8_t order = 3;
+  const uint16_t ratio = 64;
+  // 约4000个输出样本，非整数周期带来的泄漏可忽略
+  static const double freqs[] = {0.05, 0.1, 0.2};
+
+  for(uint32_t k = 0; k < sizeof(freqs) / sizeof(freqs[0]); k++)
+  {
+    double f = freqs[k];
+    double x = PI * f / ratio;
+    double sinc = pow(sin(ratio * x) / (ratio * sin(x)), order);
+    double raw = measure_gain(order, ratio, false, f);
+    double comp = measure_gain(order, ratio, true, f);
+
+    printf("  f/fo=%.2f  sinc^N %.4f  raw %.4f  compensated %.4f\n", f, sinc, raw, comp);
+    TEST_ASSERT_NEAR(sinc, raw, 2e-3);
+    TEST_ASSERT(fabs(comp - 1.0) < fabs(raw - 1.0));
+  }
+}
+
+/* 每秒输入样本数：固件配置与各级数 */
+static void test_bench_rate(void)
+{
+  const double required = ADC_RATE_HZ * ADC_CHANNELS;
+  const uint32_t block = 512;
+  uint32_t seed = 1;
+
+  for(uint32_t i = 0; i < DATA_LEN; i++)
+  {
+    s_input[i] = (uint16_t)(test_rand(&seed) & 0xFFFFU);
+  }
+
+  printf("  %-12s %16s %16s\n", "config", "update Msmp/s", "process Msmp/s");
+  for(uint8_t order = 1; order <= CIC_MAX_ORDER; order++)
+  {
+    CIC_Handle_t cic;
+    double best_update = 1e30;
+    double best_process = 1e30;
+
+    CIC_Init(&cic, order, 64, true);
+    for(uint32_t r = 0; r < 5; r++)
+    {
+      uint64_t t0 = test_now_ns();
+      uint32_t count = 0;
+
+      for(uint32_t i = 0; i < DATA_LEN; i++)
+      {
+        count += CIC_Update(&cic, s_input[i], &s_out_a[count]);
+      }
+      best_update = fmin(best_update, (double)(test_now_ns() - t0));
+
+      t0 = test_now_ns();
+      count = 0;
+      for(uint32_t i = 0; i < DATA_LEN; i += block)
+      {
+        count += CIC_Process(&cic, &s_input[i], block, &s_out_a[count]);
+      }
+      best_process = fmin(best_process, (double)(test_now_ns() - t0));
+      s_sink = s_out_a[0];
+    }
+
+    printf("  N=%u R=64%-4s %16.1f %16.1f\n", order, (order == 3) ? " *" : "",
+           DATA_LEN * 1e3 / best_update, DATA_LEN * 1e3 / best_process);
+    TEST_ASSERT(DATA_LEN * 1e9 / best_process >= required);
+  }
+  printf("  * firmware configuration; required %.3f Msmp/s (%d channels)\n",
+         required / 1e6, ADC_CHANNELS);
+}
+
+int main(void)
+{
+  TEST_RUN(test_init_args);
+  TEST_RUN(test_dc);
+  TEST_RUN(test_reference);
+  TEST_RUN(test_process_equivalence);
+  TEST_RUN(test_passband);
+  TEST_RUN(test_bench_rate);
+
+  return TEST_REPORT();
+}
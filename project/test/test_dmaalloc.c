@@ -0,0 +1,222 @@
+/**
+ * @file    test_dmaalloc.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   DMA流分配算法主机端测试
+ *
+ * @details - 固定流：正常占用、重复指定冲突、不属于允许的控制器、编号越界
+ *          - 自动分配：按优先级从高到低取编号最小的空闲流，同优先级按表中顺序，
+ *            绕开已被固定流占用的流
+ *          - 耗尽：流不足时优先级最低的请求失败，其余照常分配
+ *          - 随机请求表：结果不重复、属于允许的控制器、固定流被保留，
+ *            控制器组合相同的自动请求中优先级高者流编号更小
+ */
+
+#include "test.h"
+#include "dmaalloc.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define RANDOM_ROUNDS   20000U
+
+#define ALL_CTRL        (DMAALLOC_CTRL_DMA1 | DMAALLOC_CTRL_DMA2 | DMAALLOC_CTRL_BDMA)
+
+/* 参数错误 */
+static void test_invalid(void)
+{
+  DmaAlloc_Request_t reqs[DMAALLOC_STREAM_NUM + 1];
+  int8_t streams[DMAALLOC_STREAM_NUM + 1];
+
+  memset(reqs, 0, sizeof(reqs));
+  TEST_ASSERT_EQ(-1, DmaAlloc_Assign(NULL, 1, streams));
+  TEST_ASSERT_EQ(-1, DmaAlloc_Assign(reqs, 1, NULL));
+  TEST_ASSERT_EQ(-1, DmaAlloc_Assign(reqs, DMAALLOC_STREAM_NUM + 1, streams));
+  TEST_ASSERT_EQ(0, DmaAlloc_Assign(reqs, 0, streams));
+}
+
+/* 固定流与冲突：失败的请求为DMAALLOC_NONE，其余请求照常分配 */
+static void test_fixed(void)
+{
+  const DmaAlloc_Request_t reqs[] =
+  {
+    {DMAALLOC_CTRL_DMA1, 3,            0},
+    {DMAALLOC_CTRL_DMA1, 3,            9},  // 与上一项冲突
+    {DMAALLOC_CTRL_DMA2, 3,            0},  // 流3属于DMA1
+    {ALL_CTRL,           24,           0},  // 越界
+    {ALL_CTRL,           -2,           0},  // 越界
+    {DMAALLOC_CTRL_BDMA, 16,           0},
+    {DMAALLOC_CTRL_DMA1, DMAALLOC_ANY, 0},
+  };
+  int8_t streams[7];
+
+  TEST_ASSERT_EQ(-1, DmaAlloc_Assign(reqs, 7, streams));
+  TEST_ASSERT_EQ(3, streams[0]);
+  TEST_ASSERT_EQ(DMAALLOC_NONE, streams[1]);
+  TEST_ASSERT_EQ(DMAALLOC_NONE, streams[2]);
+  TEST_ASSERT_EQ(DMAALLOC_NONE, streams[3]);
+  TEST_ASSERT_EQ(DMAALLOC_NONE, streams[4]);
+  TEST_ASSERT_EQ(16, streams[5]);
+  TEST_ASSERT_EQ(0, streams[6]);
+
+  // 去掉冲突项后全部成功
+  TEST_ASSERT_EQ(0, DmaAlloc_Assign(&reqs[5], 2, streams));
+}
+
+/* 优先级顺序：高优先级得到靠前的流，同优先级按表中顺序，跳过固定流 */
+static void test_priority(void)
+{
+  const DmaAlloc_Request_t reqs[] =
+  {
+    {DMAALLOC_CTRL_DMA1, DMAALLOC_ANY, 1},
+    {DMAALLOC_CTRL_DMA1, DMAALLOC_ANY, 5},
+    {DMAALLOC_CTRL_DMA1, 1,            0},
+    {DMAALLOC_CTRL_DMA1, DMAALLOC_ANY, 3},
+    {DMAALLOC_CTRL_DMA1, DMAALLOC_ANY, 3},
+    {DMAALLOC_CTRL_DMA2 | DMAALLOC_CTRL_DMA1, DMAALLOC_ANY, 9},
+    {DMAALLOC_CTRL_DMA2, DMAALLOC_ANY, 0},
+    {DMAALLOC_CTRL_BDMA, DMAALLOC_ANY, 0},
+  };
+  int8_t streams[8];
+
+  TEST_ASSERT_EQ(0, DmaAlloc_Assign(reqs, 8, streams));
+  TEST_ASSERT_EQ(0, streams[5]);   // 优先级9，两个控制器中编号最小
+  TEST_ASSERT_EQ(2, streams[1]);   // 优先级5，流0已被占用、流1固定
+  TEST_ASSERT_EQ(1, streams[2]);
+  TEST_ASSERT_EQ(3, streams[3]);   // 优先级3，表中靠前
+  TEST_ASSERT_EQ(4, streams[4]);
+  TEST_ASSERT_EQ(5, streams[0]);
+  TEST_ASSERT_EQ(8, streams[6]);
+  TEST_ASSERT_EQ(16, streams[7]);
+}
+
+/* 耗尽：9个只允许DMA1的请求，优先级最低者失败 */
+static void test_exhaustion(void)
+{
+  DmaAlloc_Request_t reqs[DMAALLOC_STREAM_NUM];
+  int8_t streams[DMAALLOC_STREAM_NUM];
+
+  for(uint32_t i = 0; i < 9; i++)
+  {
+    reqs[i].controllers = DMAALLOC_CTRL_DMA1;
+    reqs[i].stream = DMAALLOC_ANY;
+    reqs[i].priority = (uint8_t)((i + 4) % 9);
+  }
+  TEST_ASSERT_EQ(-1, DmaAlloc_Assign(reqs, 9, streams));
+  for(uint32_t i = 0; i < 9; i++)
+  {
+    if(reqs[i].priority == 0)
+    {
+      TEST_ASSERT_EQ(DMAALLOC_NONE, streams[i]);
+    }
+    else
+    {
+      TEST_ASSERT_EQ(8 - reqs[i].priority, streams[i]);
+    }
+  }
+
+  // 允许全部控制器时24个请求恰好分完，第25个由参数检查拒绝
+  for(uint32_t i = 0; i < DMAALLOC_STREAM_NUM; i++)
+  {
+    reqs[i].controllers = ALL_CTRL;
+    reqs[i].stream = DMAALLOC_ANY;
+    reqs[i].priority = 0;
+  }
+  TEST_ASSERT_EQ(0, DmaAlloc_Assign(reqs, DMAALLOC_STREAM_NUM, streams));
+  for(uint32_t i = 0; i < DMAALLOC_STREAM_NUM; i++)
+  {
+    TEST_ASSERT_EQ(i, streams[i]);
+  }
+
+  // 一个固定流占去BDMA通道0后，只允许BDMA的第9个请求失败
+  reqs[0].controllers = DMAALLOC_CTRL_BDMA;
+  reqs[0].stream = 16;
+  for(uint32_t i = 1; i < 9; i++)
+  {
+    reqs[i].controllers = DMAALLOC_CTRL_BDMA;
+  }
+  TEST_ASSERT_EQ(-1, DmaAlloc_Assign(reqs, 9, streams));
+  TEST_ASSERT_EQ(16, streams[0]);
+  TEST_ASSERT_EQ(23, streams[7]);
+  TEST_ASSERT_EQ(DMAALLOC_NONE, streams[8]);
+}
+
+/* 随机请求表的性质检查 */
+static void test_random(void)
+{
+  static const uint8_t masks[] =
+  {
+    DMAALLOC_CTRL_DMA1, DMAALLOC_CTRL_DMA2, DMAALLOC_CTRL_BDMA,
+    DMAALLOC_CTRL_DMA1 | DMAALLOC_CTRL_DMA2, ALL_CTRL
+  };
+  uint32_t seed = 46;
+  uint32_t failed = 0;
+
+  for(uint32_t round = 0; round < RANDOM_ROUNDS; round++)
+  {
+    DmaAlloc_Request_t reqs[DMAALLOC_STREAM_NUM];
+    int8_t streams[DMAALLOC_STREAM_NUM];
+    uint32_t count = test_rand(&seed) % (DMAALLOC_STREAM_NUM + 1);
+    uint32_t used = 0;
+    bool all = true;
+    int ret;
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+      reqs[i].controllers = masks[test_rand(&seed) % 5];
+      reqs[i].priority = (uint8_t)(test_rand(&seed) % 4);
+      reqs[i].stream = (test_rand(&seed) % 6 == 0) ?
+                       (int8_t)(test_rand(&seed) % DMAALLOC_STREAM_NUM) : DMAALLOC_ANY;
+    }
+
+    ret = DmaAlloc_Assign(reqs, count, streams);
+    for(uint32_t i = 0; i < count; i++)
+    {
+      int8_t s = streams[i];
+
+      if(s == DMAALLOC_NONE)
+      {
+        all = false;
+        continue;
+      }
+      TEST_ASSERT(s >= 0 && s < DMAALLOC_STREAM_NUM);
+      TEST_ASSERT((used & (1UL << s)) == 0U);
+      TEST_ASSERT((reqs[i].controllers & DMAALLOC_CTRL_OF(s)) != 0U);
+      TEST_ASSERT(reqs[i].stream == DMAALLOC_ANY || reqs[i].stream == s);
+      used |= 1UL << s;
+
+      // 控制器组合相同的自动请求：优先级高者流编号更小，失败者优先级不高于成功者
+      for(uint32_t j = 0; j < count; j++)
+      {
+        if(j == i || reqs[j].stream != DMAALLOC_ANY || reqs[i].stream != DMAALLOC_ANY ||
+           reqs[j].controllers != reqs[i].controllers)
+        {
+          continue;
+        }
+        if(streams[j] == DMAALLOC_NONE)
+        {
+          TEST_ASSERT(reqs[j].priority <= reqs[i].priority);
+        }
+        else if(reqs[i].priority > reqs[j].priority ||
+                (reqs[i].priority == reqs[j].priority && i < j))
+        {
+          TEST_ASSERT(s < streams[j]);
+        }
+      }
+    }
+    TEST_ASSERT_EQ(all ? 0 : -1, ret);
+    failed += !all;
+  }
+
+  printf("  %u rounds, %u with unassigned requests\n", RANDOM_ROUNDS, failed);
+}
+
+int main(void)
+{
+  TEST_RUN(test_invalid);
+  TEST_RUN(test_fixed);
+  TEST_RUN(test_priority);
+  TEST_RUN(test_exhaustion);
+  TEST_RUN(test_random);
+
+  return TEST_REPORT();
+}
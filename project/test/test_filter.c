@@ -0,0 +1,331 @@
+/**
+ * @file    test_filter.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   移动平均/加权移动平均主机端测试与基准
+ *
+ * @details 功能测试：初始化参数校验，随机数据下逐样本结果与逐项求和的参考实现一致；
+ *          块处理（*_Process）按随机分块长度（含奇数与0）、原地处理时与逐样本路径逐位一致。
+ *          基准：窗口长度N取4~361，测量MAF_Update/WMAF_Update每样本耗时，
+ *          与逐项求和（O(N)）对照，递推实现的耗时不随N增长；
+ *          并以64点块输出逐样本与块处理两种路径的每秒样本数。
+ */
+
+#include "test.h"
+#include "filter.h"
+#include <string.h>
+
+#define DATA_LEN        (1U << 16)
+#define BENCH_ROUNDS    5
+
+static uint16_t s_input[DATA_LEN];
+static uint16_t s_window[WMAF_WINDOW_MAX];
+static volatile uint32_t s_sink;
+
+static void make_input(uint32_t seed)
+{
+  for(uint32_t i = 0; i < DATA_LEN; i++)
+  {
+    s_input[i] = (uint16_t)test_rand(&seed);
+  }
+}
+
+/* 参考实现：窗口内逐项求和，窗口未满部分按0计 */
+static uint16_t ref_maf(const uint16_t *x, uint32_t i, uint16_t size)
+{
+  uint32_t sum = 0;
+
+  for(uint32_t k = 0; k < size && k <= i; k++)
+  {
+    sum += x[i - k];
+  }
+
+  return (uint16_t)(sum / size);
+}
+
+static uint16_t ref_wmaf(const uint16_t *x, uint32_t i, uint16_t size)
+{
+  uint64_t sum = 0;
+
+  for(uint32_t k = 0; k < size && k <= i; k++)
+  {
+    sum += (uint64_t)(size - k) * x[i - k];
+  }
+
+  return (uint16_t)(sum / ((uint32_t)size * (size + 1) / 2));
+}
+
+static void test_init_args(void)
+{
+  MAF_Handle_t maf;
+  WMAF_Handle_t wmaf;
+
+  TEST_ASSERT_EQ(0, MAF_Init(&maf, s_window, 1));
+  TEST_ASSERT_EQ(0, MAF_Init(&maf, s_window, 65535));
+  TEST_ASSERT_EQ(-1, MAF_Init(&maf, s_window, 0));
+  TEST_ASSERT_EQ(-1, MAF_Init(&maf, NULL, 16));
+  TEST_ASSERT_EQ(-1, MAF_Init(NULL, s_window, 16));
+
+  TEST_ASSERT_EQ(0, WMAF_Init(&wmaf, s_window, WMAF_WINDOW_MAX));
+  TEST_ASSERT_EQ(-1, WMAF_Init(&wmaf, s_window, WMAF_WINDOW_MAX + 1));
+  TEST_ASSERT_EQ(-1, WMAF_Init(&wmaf, s_window, 0));
+  TEST_ASSERT_EQ(-1, WMAF_Init(&wmaf, NULL, 16));
+  TEST_ASSERT_EQ(-1, WMAF_Init(NULL, s_window, 16));
+}
+
+/* 递推结果与逐项求和逐样本一致（含满量程输入） */
+static void test_reference(void)
+{
+  static const uint16_t sizes[] = {1, 2, 7, 16, 100, WMAF_WINDOW_MAX};
+  const uint32_t n = 4096;
+
+  make_input(1234);
+  for(uint32_t i = 0; i < 600; i++)
+  {
+    s_input[1000 + i] = 65535;
+  }
+
+  for(uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+  {
+    MAF_Handle_t maf;
+    WMAF_Handle_t wmaf;
+    uint16_t wbuf[WMAF_WINDOW_MAX];
+    uint32_t maf_err = 0;
+    uint32_t wmaf_err = 0;
+
+    MAF_Init(&maf, s_window, sizes[s]);
+    WMAF_Init(&wmaf, wbuf, sizes[s]);
+    for(uint32_t i = 0; i < n; i++)
+    {
+      maf_err += (MAF_Update(&maf, s_input[i]) != ref_maf(s_input, i, sizes[s]));
+      wmaf_err += (WMAF_Update(&wmaf, s_input[i]) != ref_wmaf(s_input, i, sizes[s]));
+    }
+    TEST_ASSERT_EQ(0, maf_err);
+    TEST_ASSERT_EQ(0, wmaf_err);
+  }
+}
+
+/* 取BENCH_ROUNDS次中的最小值，减小调度干扰 */
+static double bench_maf(uint16_t size)
+{
+  double best = 1e30;
+  MAF_Handle_t maf;
+
+  for(uint32_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint32_t acc = 0;
+    uint64_t t0;
+
+    MAF_Init(&maf, s_window, size);
+    t0 = test_now_ns();
+    for(uint32_t i = 0; i < DATA_LEN; i++)
+    {
+      acc += MAF_Update(&maf, s_input[i]);
+    }
+    s_sink = acc;
+    best = fmin(best, (double)(test_now_ns() - t0) / DATA_LEN);
+  }
+
+  return best;
+}
+
+static double bench_wmaf(uint16_t size)
+{
+  double best = 1e30;
+  WMAF_Handle_t wmaf;
+
+  for(uint32_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint32_t acc = 0;
+    uint64_t t0;
+
+    WMAF_Init(&wmaf, s_window, size);
+    t0 = test_now_ns();
+    for(uint32_t i = 0; i < DATA_LEN; i++)
+    {
+      acc += WMAF_Update(&wmaf, s_input[i]);
+    }
+    s_sink = acc;
+    best = fmin(best, (double)(test_now_ns() - t0) / DATA_LEN);
+  }
+
+  return best;
+}
+
+static double bench_naive_wmaf(uint16_t size)
+{
+  double best = 1e30;
+
+  for(uint32_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint32_t acc = 0;
+    uint64_t t0 = test_now_ns();
+
+    for(uint32_t i = 0; i < DATA_LEN; i++)
+    {
+      acc += ref_wmaf(s_input, i, size);
+    }
+    s_sink = acc;
+    best = fmin(best, (double)(test_now_ns() - t0) / DATA_LEN);
+  }
+
+  return best;
+}
+
+/* 每样本耗时与N无关：最大/最小比值远小于N的变化（4 → 361） */
+static void test_bench_window(void)
+{
+  static const uint16_t sizes[] = {4, 16, 64, 256, WMAF_WINDOW_MAX};
+  double maf_min = 1e30;
+  double maf_max = 0.0;
+  double wmaf_min = 1e30;
+  double wmaf_max = 0.0;
+
+  make_input(99);
+  printf("  %5s %12s %12s %14s\n", "N", "MAF ns/smp", "WMAF ns/smp", "naive ns/smp");
+  for(uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+  {
+    double maf = bench_maf(sizes[s]);
+    double wmaf = bench_wmaf(sizes[s]);
+
+    printf("  %5u %12.2f %12.2f %14.2f\n", sizes[s], maf, wmaf, bench_naive_wmaf(sizes[s]));
+    maf_min = fmin(maf_min, maf);
+    maf_max = fmax(maf_max, maf);
+    wmaf_min = fmin(wmaf_min, wmaf);
+    wmaf_max = fmax(wmaf_max, wmaf);
+  }
+
+  TEST_ASSERT(maf_max < 3.0 * maf_min);
+  TEST_ASSERT(wmaf_max < 3.0 * wmaf_min);
+}
+
+/* 随机分块（0~67点）块处理，与逐样本路径逐位一致；奇数次分块原地处理 */
+static void test_process_equivalence(void)
+{
+  static const uint16_t sizes[] = {1, 3, 16, 64, WMAF_WINDOW_MAX};
+  static uint16_t ref_maf_out[DATA_LEN];
+  static uint16_t ref_wmaf_out[DATA_LEN];
+  static uint16_t maf_out[DATA_LEN];
+  static uint16_t wmaf_out[DATA_LEN];
+  const uint32_t block_max = 67;
+
+  make_input(4321);
+  for(uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+  {
+    MAF_Handle_t maf_ref;
+    MAF_Handle_t maf;
+    WMAF_Handle_t wmaf_ref;
+    WMAF_Handle_t wmaf;
+    uint16_t buf[4][WMAF_WINDOW_MAX];
+    uint32_t seed = 77 + s;
+    uint32_t chunk = 0;
+
+    MAF_Init(&maf_ref, buf[0], sizes[s]);
+    MAF_Init(&maf, buf[1], sizes[s]);
+    WMAF_Init(&wmaf_ref, buf[2], sizes[s]);
+    WMAF_Init(&wmaf, buf[3], sizes[s]);
+
+    for(uint32_t i = 0; i < DATA_LEN; i++)
+    {
+      ref_maf_out[i] = MAF_Update(&maf_ref, s_input[i]);
+      ref_wmaf_out[i] = WMAF_Update(&wmaf_ref, s_input[i]);
+    }
+
+    for(uint32_t i = 0; i < DATA_LEN; i += chunk, seed++)
+    {
+      chunk = test_rand(&seed) % (block_max + 1);
+      if(chunk > DATA_LEN - i)
+      {
+        chunk = DATA_LEN - i;
+      }
+
+      if(seed & 1U)
+      {
+        memcpy(&maf_out[i], &s_input[i], chunk * sizeof(uint16_t));
+        memcpy(&wmaf_out[i], &s_input[i], chunk * sizeof(uint16_t));
+        MAF_Process(&maf, &maf_out[i], &maf_out[i], chunk);
+        WMAF_Process(&wmaf, &wmaf_out[i], &wmaf_out[i], chunk);
+      }
+      else
+      {
+        MAF_Process(&maf, &s_input[i], &maf_out[i], chunk);
+        WMAF_Process(&wmaf, &s_input[i], &wmaf_out[i], chunk);
+      }
+    }
+
+    TEST_ASSERT(memcmp(ref_maf_out, maf_out, sizeof(maf_out)) == 0);
+    TEST_ASSERT(memcmp(ref_wmaf_out, wmaf_out, sizeof(wmaf_out)) == 0);
+    TEST_ASSERT_EQ(maf_ref.sum, maf.sum);
+    TEST_ASSERT_EQ(maf_ref.index, maf.index);
+    TEST_ASSERT_EQ(wmaf_ref.weighted_sum, wmaf.weighted_sum);
+    TEST_ASSERT_EQ(wmaf_ref.index, wmaf.index);
+  }
+}
+
+/* 64点块（DMA块长度量级）：逐样本调用与块处理的每秒样本数 */
+static void test_bench_process(void)
+{
+  static uint16_t out[DATA_LEN];
+  const uint32_t block = 64;
+  double maf_update = 1e30;
+  double maf_process = 1e30;
+  double wmaf_update = 1e30;
+  double wmaf_process = 1e30;
+  uint16_t maf_buf[MAF_WINDOW_SIZE];
+  uint16_t wmaf_buf[WMAF_WINDOW_SIZE];
+  MAF_Handle_t maf;
+  WMAF_Handle_t wmaf;
+
+  make_input(5);
+  MAF_Init(&maf, maf_buf, MAF_WINDOW_SIZE);
+  WMAF_Init(&wmaf, wmaf_buf, WMAF_WINDOW_SIZE);
+
+  for(uint32_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint64_t t0;
+
+    t0 = test_now_ns();
+    for(uint32_t i = 0; i < DATA_LEN; i++)
+    {
+      out[i] = MAF_Update(&maf, s_input[i]);
+    }
+    maf_update = fmin(maf_update, (double)(test_now_ns() - t0));
+
+    t0 = test_now_ns();
+    for(uint32_t i = 0; i < DATA_LEN; i += block)
+    {
+      MAF_Process(&maf, &s_input[i], &out[i], block);
+    }
+    maf_process = fmin(maf_process, (double)(test_now_ns() - t0));
+
+    t0 = test_now_ns();
+    for(uint32_t i = 0; i < DATA_LEN; i++)
+    {
+      out[i] = WMAF_Update(&wmaf, s_input[i]);
+    }
+    wmaf_update = fmin(wmaf_update, (double)(test_now_ns() - t0));
+
+    t0 = test_now_ns();
+    for(uint32_t i = 0; i < DATA_LEN; i += block)
+    {
+      WMAF_Process(&wmaf, &s_input[i], &out[i], block);
+    }
+    wmaf_process = fmin(wmaf_process, (double)(test_now_ns() - t0));
+    s_sink = out[DATA_LEN - 1];
+  }
+
+  printf("  Msample/s  %10s %14s\n", "update", "process(64)");
+  printf("  %-10s %10.1f %14.1f\n", "MAF", DATA_LEN * 1e3 / maf_update, DATA_LEN * 1e3 / maf_process);
+  printf("  %-10s %10.1f %14.1f\n", "WMAF", DATA_LEN * 1e3 / wmaf_update, DATA_LEN * 1e3 / wmaf_process);
+}
+
+int main(void)
+{
+  TEST_RUN(test_init_args);
+  TEST_RUN(test_reference);
+  TEST_RUN(test_process_equivalence);
+  TEST_RUN(test_bench_window);
+  TEST_RUN(test_bench_process);
+
+  return TEST_REPORT();
+}
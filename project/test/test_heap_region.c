@@ -0,0 +1,404 @@
+/**
+ * @file    test_heap_region.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   分区域堆主机端随机测试
+ *
+ * @details heap_region.c与固件同一份源码，FreeRTOS接口由test/stub替身提供，
+ *          各区域堆存储为主机上的静态数组。两个目标：
+ *          - test_heap_region：编译时启用AXI/D2/D3区域，随机分配/释放（随机大小与区域标志），
+ *            每步校验区域选择顺序、对齐、块不重叠（填充图案）、统计守恒，
+ *            全部释放后每个区域合并回单个空闲块；另测重复释放与非堆指针的断言
+ *          - test_heap_region_default：默认配置（AXI/D2/D3为0），只有DTCM参与分配
+ */
+
+#include "test.h"
+#include "heap_region.h"
+#include "FreeRTOS.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define LIVE_MAX        256U
+#define RANDOM_OPS      40000U
+#define SIZE_MAX_SMALL  600U
+
+typedef struct
+{
+  uint8_t *p;
+  size_t size;
+  size_t used;                          /* 区域剩余量的减少值（含块头与对齐） */
+  uint8_t region;
+  uint8_t tag;
+} live_t;
+
+static live_t s_live[LIVE_MAX];
+static uint32_t s_live_count;
+static uint32_t s_asserts;
+static uint32_t s_malloc_failed;
+static int32_t s_suspend_depth;
+
+/* ==================== FreeRTOS替身 ==================== */
+
+void vAssertCalled(const char *file, int line)
+{
+  (void)file;
+  (void)line;
+  s_asserts++;
+}
+
+void vApplicationMallocFailedHook(void)
+{
+  s_malloc_failed++;
+}
+
+void vTaskSuspendAll(void)
+{
+  s_suspend_depth++;
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+  s_suspend_depth--;
+  return 0;
+}
+
+/* ==================== 辅助 ==================== */
+
+static void read_stats(HeapRegion_Stats_t stats[HEAP_REGION_NUM])
+{
+  for(uint32_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    vPortGetRegionHeapStats((HeapRegion_Id_t)i, &stats[i]);
+  }
+}
+
+static bool check_fill(const live_t *l)
+{
+  for(size_t k = 0; k < l->size; k++)
+  {
+    if(l->p[k] != l->tag)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+#if HEAP_REGION_D2_SIZE > 0
+/* 与heap_region.h中表格一致的候选顺序，以HEAP_REGION_NUM结尾 */
+static const uint8_t *candidates(uint32_t flags)
+{
+  static const uint8_t any[] = {HEAP_REGION_DTCM, HEAP_REGION_D2, HEAP_REGION_AXI, HEAP_REGION_D3,
+                                HEAP_REGION_NUM};
+  static const uint8_t fast[] = {HEAP_REGION_DTCM, HEAP_REGION_AXI, HEAP_REGION_NUM};
+  static const uint8_t dma[] = {HEAP_REGION_D2, HEAP_REGION_AXI, HEAP_REGION_D3, HEAP_REGION_NUM};
+  static const uint8_t dma_fast[] = {HEAP_REGION_AXI, HEAP_REGION_NUM};
+  static const uint8_t bdma[] = {HEAP_REGION_D3, HEAP_REGION_NUM};
+
+  switch(flags)
+  {
+    case REGION_FAST:
+      return fast;
+    case REGION_DMA:
+      return dma;
+    case REGION_DMA | REGION_FAST:
+      return dma_fast;
+    case REGION_BDMA:
+      return bdma;
+    default:
+      return any;
+  }
+}
+
+/* 分配一块并校验区域、对齐与统计 */
+static void do_alloc(size_t size, uint32_t flags, uint8_t tag)
+{
+  HeapRegion_Stats_t before[HEAP_REGION_NUM];
+  HeapRegion_Stats_t after[HEAP_REGION_NUM];
+  const uint8_t *order = candidates(flags);
+  size_t failures_before = 0;
+  size_t failures_after = 0;
+  uint32_t region = HEAP_REGION_NUM;
+  uint8_t *p;
+
+  read_stats(before);
+  p = pvPortMallocRegion(size, flags);
+  read_stats(after);
+  TEST_ASSERT_EQ(0, s_suspend_depth);
+
+  for(uint32_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    failures_before += before[i].failures;
+    failures_after += after[i].failures;
+    if(after[i].free != before[i].free)
+    {
+      TEST_ASSERT(region == HEAP_REGION_NUM);
+      region = i;
+    }
+  }
+
+  if(p == NULL)
+  {
+    TEST_ASSERT_EQ(HEAP_REGION_NUM, region);
+    TEST_ASSERT_EQ(failures_before + 1, failures_after);
+    // 任一候选区域都没有足够大的空闲块
+    for(const uint8_t *c = order; *c != HEAP_REGION_NUM; c++)
+    {
+      TEST_ASSERT(before[*c].largest < size + 64U);
+    }
+    return;
+  }
+
+  TEST_ASSERT(region < HEAP_REGION_NUM);
+  TEST_ASSERT_EQ(flags, after[region].caps & flags);
+  TEST_ASSERT_EQ(before[region].allocs + 1, after[region].allocs);
+  TEST_ASSERT(before[region].free - after[region].free >= size);
+  TEST_ASSERT(after[region].min_free <= after[region].free);
+
+  // 排在前面的候选区域放不下（块头与对齐开销不超过64字节）
+  for(const uint8_t *c = order; *c != region; c++)
+  {
+    TEST_ASSERT(*c != HEAP_REGION_NUM);
+    if(*c == HEAP_REGION_NUM)
+    {
+      break;
+    }
+    TEST_ASSERT(before[*c].largest < size + 64U);
+  }
+
+  if((after[region].caps & REGION_DMA) != 0U)
+  {
+    TEST_ASSERT_EQ(0, (uintptr_t)p % 32U);
+    TEST_ASSERT_EQ(0, (before[region].free - after[region].free) % 32U);
+  }
+  else
+  {
+    TEST_ASSERT_EQ(0, (uintptr_t)p % portBYTE_ALIGNMENT);
+  }
+
+  memset(p, tag, size);
+  s_live[s_live_count].p = p;
+  s_live[s_live_count].size = size;
+  s_live[s_live_count].used = before[region].free - after[region].free;
+  s_live[s_live_count].region = (uint8_t)region;
+  s_live[s_live_count].tag = tag;
+  s_live_count++;
+}
+#endif
+
+/* 释放一块：图案未被其他分配覆盖，剩余量恢复分配时的减少值 */
+static void do_free(uint32_t index)
+{
+  HeapRegion_Stats_t before;
+  HeapRegion_Stats_t after;
+  live_t l = s_live[index];
+
+  TEST_ASSERT(check_fill(&l));
+  vPortGetRegionHeapStats((HeapRegion_Id_t)l.region, &before);
+  vPortFree(l.p);
+  vPortGetRegionHeapStats((HeapRegion_Id_t)l.region, &after);
+  TEST_ASSERT_EQ(0, s_suspend_depth);
+  TEST_ASSERT_EQ(before.free + l.used, after.free);
+  TEST_ASSERT_EQ(before.frees + 1, after.frees);
+
+  s_live[index] = s_live[--s_live_count];
+}
+
+static void free_all(void)
+{
+  HeapRegion_Stats_t stats[HEAP_REGION_NUM];
+
+  while(s_live_count > 0)
+  {
+    do_free(s_live_count - 1);
+  }
+
+  // 全部释放后相邻空闲块合并为一个
+  read_stats(stats);
+  for(uint32_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    TEST_ASSERT_EQ(stats[i].total, stats[i].free);
+    TEST_ASSERT_EQ((stats[i].total != 0) ? 1 : 0, stats[i].free_blocks);
+    TEST_ASSERT_EQ(0, stats[i].fragmentation);
+    TEST_ASSERT_EQ(stats[i].allocs, stats[i].frees);
+  }
+}
+
+/* ==================== 测试 ==================== */
+
+static void test_region_sizes(void)
+{
+  static const size_t sizes[HEAP_REGION_NUM] =
+  {
+    configTOTAL_HEAP_SIZE, HEAP_REGION_AXI_SIZE, HEAP_REGION_D2_SIZE, HEAP_REGION_D3_SIZE
+  };
+  HeapRegion_Stats_t stats[HEAP_REGION_NUM];
+  HeapRegion_Stats_t bad;
+
+  read_stats(stats);
+  for(uint32_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    printf("  %-5s total %6lu / %6lu\n", stats[i].name, (unsigned long)stats[i].total,
+           (unsigned long)sizes[i]);
+    TEST_ASSERT(stats[i].name != NULL);
+    TEST_ASSERT(stats[i].total <= sizes[i]);
+    TEST_ASSERT((sizes[i] == 0) ? (stats[i].total == 0) : (stats[i].total + 64U > sizes[i]));
+  }
+
+  vPortGetRegionHeapStats(HEAP_REGION_NUM, &bad);
+  TEST_ASSERT(bad.name == NULL);
+  TEST_ASSERT_EQ(0, bad.total);
+}
+
+#if HEAP_REGION_D2_SIZE > 0
+/* 各区域：剩余 + 已分配 = 总量 */
+static void check_conservation(void)
+{
+  HeapRegion_Stats_t stats[HEAP_REGION_NUM];
+  size_t used[HEAP_REGION_NUM] = {0};
+
+  read_stats(stats);
+  for(uint32_t i = 0; i < s_live_count; i++)
+  {
+    used[s_live[i].region] += s_live[i].used;
+  }
+  for(uint32_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    TEST_ASSERT_EQ(stats[i].total, stats[i].free + used[i]);
+    TEST_ASSERT(stats[i].free == 0 || stats[i].largest <= stats[i].free);
+  }
+}
+
+/* 随机大小、随机标志、随机顺序释放 */
+static void test_random(void)
+{
+  static const uint32_t flags[] = {REGION_ANY, REGION_FAST, REGION_DMA,
+                                   REGION_DMA | REGION_FAST, REGION_BDMA};
+  uint32_t seed = 2026;
+  uint32_t allocs = 0;
+  uint32_t nulls = 0;
+
+  for(uint32_t op = 0; op < RANDOM_OPS; op++)
+  {
+    uint32_t r = test_rand(&seed);
+
+    if(s_live_count < LIVE_MAX && (s_live_count == 0 || (r & 3U) < 2U))
+    {
+      size_t size = 1U + test_rand(&seed) % SIZE_MAX_SMALL;
+      uint32_t live = s_live_count;
+
+      if((r & 0xF0U) == 0U)
+      {
+        size = 1U + test_rand(&seed) % (HEAP_REGION_D2_SIZE / 2U + 1U);
+      }
+      do_alloc(size, flags[test_rand(&seed) % 5U], (uint8_t)(op | 1U));
+      allocs++;
+      nulls += (s_live_count == live);
+    }
+    else
+    {
+      do_free(test_rand(&seed) % s_live_count);
+    }
+
+    if((op & 255U) == 0U)
+    {
+      check_conservation();
+    }
+  }
+
+  printf("  %u allocations, %u failed, %u live at end\n", allocs, nulls, s_live_count);
+  free_all();
+  TEST_ASSERT_EQ(0, s_asserts);
+}
+#endif
+
+/* 内核接口只用DTCM：calloc清零与溢出，分配失败调用钩子 */
+static void test_kernel_api(void)
+{
+  HeapStats_t heap;
+  uint8_t *p;
+  uint32_t hook = s_malloc_failed;
+
+  p = pvPortCalloc(16, 8);
+  TEST_ASSERT(p != NULL);
+  for(uint32_t i = 0; i < 128; i++)
+  {
+    TEST_ASSERT_EQ(0, p[i]);
+  }
+  vPortGetHeapStats(&heap);
+  TEST_ASSERT_EQ(xPortGetFreeHeapSize(), heap.xAvailableHeapSpaceInBytes);
+  TEST_ASSERT(xPortGetMinimumEverFreeHeapSize() <= xPortGetFreeHeapSize());
+
+  TEST_ASSERT(pvPortCalloc(SIZE_MAX / 2U, 4U) == NULL);
+  TEST_ASSERT(pvPortMalloc(configTOTAL_HEAP_SIZE) == NULL);
+  TEST_ASSERT_EQ(hook + 1, s_malloc_failed);
+  TEST_ASSERT(pvPortMalloc(0) == NULL);
+
+  vPortFree(p);
+  vPortFree(NULL);
+  TEST_ASSERT_EQ(0, s_suspend_depth);
+  free_all();
+}
+
+/* 重复释放与非堆指针：断言并忽略，不破坏空闲链表 */
+static void test_invalid_free(void)
+{
+  HeapRegion_Stats_t before;
+  HeapRegion_Stats_t after;
+  uint32_t local = 0;
+  void *p;
+
+  p = pvPortMallocRegion(100, REGION_FAST);
+  TEST_ASSERT(p != NULL);
+  vPortFree(p);
+
+  vPortGetRegionHeapStats(HEAP_REGION_DTCM, &before);
+  s_asserts = 0;
+  vPortFree(p);
+  TEST_ASSERT(s_asserts > 0);
+  vPortFree(&local);
+  TEST_ASSERT(s_asserts > 1);
+  vPortGetRegionHeapStats(HEAP_REGION_DTCM, &after);
+  TEST_ASSERT_EQ(before.free, after.free);
+  TEST_ASSERT_EQ(before.frees, after.frees);
+  TEST_ASSERT_EQ(before.free_blocks, after.free_blocks);
+  s_asserts = 0;
+}
+
+#if HEAP_REGION_D2_SIZE == 0
+/* 默认配置：只有DTCM，DMA/BDMA请求失败并计入首选区域 */
+static void test_default_disabled(void)
+{
+  HeapRegion_Stats_t stats;
+  void *p;
+
+  TEST_ASSERT(pvPortMallocRegion(64, REGION_DMA) == NULL);
+  TEST_ASSERT(pvPortMallocRegion(64, REGION_BDMA) == NULL);
+  vPortGetRegionHeapStats(HEAP_REGION_D2, &stats);
+  TEST_ASSERT_EQ(1, stats.failures);
+  TEST_ASSERT_EQ(0, stats.total);
+  vPortGetRegionHeapStats(HEAP_REGION_D3, &stats);
+  TEST_ASSERT_EQ(1, stats.failures);
+
+  p = pvPortMallocRegion(64, REGION_ANY);
+  TEST_ASSERT(p != NULL);
+  vPortGetRegionHeapStats(HEAP_REGION_DTCM, &stats);
+  TEST_ASSERT_EQ(1, stats.allocs);
+  vPortFree(p);
+}
+#endif
+
+int main(void)
+{
+  TEST_RUN(test_region_sizes);
+#if HEAP_REGION_D2_SIZE > 0
+  TEST_RUN(test_random);
+#else
+  TEST_RUN(test_default_disabled);
+#endif
+  TEST_RUN(test_kernel_api);
+  TEST_RUN(test_invalid_free);
+
+  return TEST_REPORT();
+}
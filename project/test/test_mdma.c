@@ -0,0 +1,325 @@
+/**
+ * @file    test_mdma.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   MDMA异步复制服务主机端测试（POSIX工作线程实现）
+ *
+ * @details drivers/posix/drv_mdma.c以工作线程模拟MDMA通道，接口与目标板相同：
+ *          - 短作业与首尾不满cache行部分由CPU在提交者上下文中完成
+ *          - 长作业排队异步执行，按提交顺序完成，回调在通道线程中调用
+ *          - 作业进行中重复提交、空指针返回-1，等待超时与传输错误返回-1
+ *          - 按main.c中AdcBlockPost()的用法，在完成回调中把数据块投递给消费者
+ *          - 两个线程同时提交（对应任务与ADC中断同时提交），每个作业恰好完成一次
+ */
+
+#include "test.h"
+#include "drv_mdma.h"
+#include "drv_mdma_host.h"
+#include <pthread.h>
+#include <string.h>
+
+#define BIG_LEN         (200U * 1024U)
+#define ORDER_JOBS      8
+#define BLOCK_LEN       512
+#define BLOCK_NUM       64
+#define SUBMIT_THREADS  2
+#define SUBMIT_JOBS     500
+#define SUBMIT_LEN      1024
+
+static uint8_t s_src[BIG_LEN + 64];
+static uint8_t s_dst[BIG_LEN + 64];
+
+typedef struct
+{
+  pthread_t thread;
+  uint32_t calls;
+} cb_record_t;
+
+static void record_cb(mdma_job_t *job, void *arg)
+{
+  cb_record_t *rec = arg;
+
+  (void)job;
+  rec->thread = pthread_self();
+  rec->calls++;
+}
+
+static void fill_src(uint32_t seed)
+{
+  for(uint32_t i = 0; i < sizeof(s_src); i++)
+  {
+    s_src[i] = (uint8_t)(test_rand(&seed) >> 8);
+  }
+}
+
+/* 短作业由CPU立即完成，回调在提交者线程中调用 */
+static void test_short_sync(void)
+{
+  mdma_job_t job = {0};
+  cb_record_t rec = {0};
+
+  fill_src(1);
+  memset(s_dst, 0, sizeof(s_dst));
+  TEST_ASSERT_EQ(0, mdma_memcpy(&job, s_dst, s_src, MDMA_CPU_THRESHOLD - 1, record_cb, &rec));
+  TEST_ASSERT_EQ(MDMA_JOB_DONE, job.state);
+  TEST_ASSERT_EQ(1, rec.calls);
+  TEST_ASSERT(pthread_equal(rec.thread, pthread_self()));
+  TEST_ASSERT(memcmp(s_dst, s_src, MDMA_CPU_THRESHOLD - 1) == 0);
+  TEST_ASSERT_EQ(0, s_dst[MDMA_CPU_THRESHOLD - 1]);
+  TEST_ASSERT_EQ(0, mdma_wait(&job, 0));
+
+  // 长度为0
+  TEST_ASSERT_EQ(0, mdma_memset(&job, s_dst, 0x5A, 0, NULL, NULL));
+  TEST_ASSERT(mdma_job_done(&job));
+}
+
+/* 长作业异步完成：多种长度与错位，超过64KB分段，首尾之外的字节不被改写 */
+static void test_async_copy(void)
+{
+  static const uint32_t lens[] = {MDMA_CPU_THRESHOLD, 1000, 4096 + 7, 65536, BIG_LEN};
+  mdma_job_t job = {0};
+  cb_record_t rec = {0};
+
+  fill_src(2);
+  for(uint32_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++)
+  {
+    for(uint32_t shift = 0; shift < 32; shift += 13)
+    {
+      uint32_t len = lens[i];
+
+      memset(s_dst, 0xEE, sizeof(s_dst));
+      rec.calls = 0;
+      TEST_ASSERT_EQ(0, mdma_memcpy(&job, s_dst + shift, s_src + 3, len, record_cb, &rec));
+      TEST_ASSERT_EQ(0, mdma_wait(&job, 1000));
+      TEST_ASSERT_EQ(1, rec.calls);
+      TEST_ASSERT(memcmp(s_dst + shift, s_src + 3, len) == 0);
+      TEST_ASSERT(shift == 0 || s_dst[shift - 1] == 0xEE);
+      TEST_ASSERT_EQ(0xEE, s_dst[shift + len]);
+    }
+  }
+
+  // 异步部分的回调在通道线程中调用
+  TEST_ASSERT(!pthread_equal(rec.thread, pthread_self()));
+
+  memset(s_dst, 0, sizeof(s_dst));
+  TEST_ASSERT_EQ(0, mdma_memset(&job, s_dst + 5, 0xA5, BIG_LEN, NULL, NULL));
+  TEST_ASSERT_EQ(0, mdma_wait(&job, 1000));
+  TEST_ASSERT_EQ(0, s_dst[4]);
+  TEST_ASSERT_EQ(0xA5, s_dst[5]);
+  TEST_ASSERT_EQ(0xA5, s_dst[5 + BIG_LEN / 2]);
+  TEST_ASSERT_EQ(0xA5, s_dst[4 + BIG_LEN]);
+  TEST_ASSERT_EQ(0, s_dst[5 + BIG_LEN]);
+}
+
+static uint32_t s_order[ORDER_JOBS];
+static uint32_t s_order_count;
+
+static void order_cb(mdma_job_t *job, void *arg)
+{
+  (void)job;
+  s_order[s_order_count++] = (uint32_t)(uintptr_t)arg;
+}
+
+/* 按提交顺序完成；进行中的作业不能重复提交；等待超时；传输错误 */
+static void test_queue(void)
+{
+  mdma_job_t jobs[ORDER_JOBS] = {0};
+  uint32_t chunk = BIG_LEN / ORDER_JOBS;
+
+  s_order_count = 0;
+  mdma_host_hold(true);
+  for(uint32_t i = 0; i < ORDER_JOBS; i++)
+  {
+    TEST_ASSERT_EQ(0, mdma_memset(&jobs[i], s_dst + i * chunk, (uint8_t)i, chunk,
+                                  order_cb, (void *)(uintptr_t)i));
+  }
+  TEST_ASSERT(!mdma_job_done(&jobs[0]));
+  TEST_ASSERT_EQ(-1, mdma_memcpy(&jobs[0], s_dst, s_src, chunk, NULL, NULL));
+  TEST_ASSERT_EQ(-1, mdma_wait(&jobs[ORDER_JOBS - 1], 20));
+
+  mdma_host_hold(false);
+  TEST_ASSERT_EQ(0, mdma_wait(&jobs[ORDER_JOBS - 1], 1000));
+  TEST_ASSERT_EQ(ORDER_JOBS, s_order_count);
+  for(uint32_t i = 0; i < ORDER_JOBS; i++)
+  {
+    TEST_ASSERT_EQ(i, s_order[i]);
+    TEST_ASSERT_EQ(i, s_dst[i * chunk + chunk / 2]);
+  }
+
+  mdma_host_fail_next();
+  TEST_ASSERT_EQ(0, mdma_memcpy(&jobs[0], s_dst, s_src, chunk, NULL, NULL));
+  TEST_ASSERT_EQ(-1, mdma_wait(&jobs[0], 1000));
+  TEST_ASSERT_EQ(MDMA_JOB_ERROR, jobs[0].state);
+  TEST_ASSERT(mdma_job_done(&jobs[0]));
+
+  // 出错后的作业可以重新提交
+  TEST_ASSERT_EQ(0, mdma_memcpy(&jobs[0], s_dst, s_src, chunk, NULL, NULL));
+  TEST_ASSERT_EQ(0, mdma_wait(&jobs[0], 1000));
+}
+
+/* 参数错误 */
+static void test_invalid(void)
+{
+  mdma_job_t job = {0};
+
+  TEST_ASSERT_EQ(-1, mdma_memcpy(NULL, s_dst, s_src, 16, NULL, NULL));
+  TEST_ASSERT_EQ(-1, mdma_memcpy(&job, NULL, s_src, 16, NULL, NULL));
+  TEST_ASSERT_EQ(-1, mdma_memcpy(&job, s_dst, NULL, 16, NULL, NULL));
+  TEST_ASSERT_EQ(-1, mdma_memset(&job, NULL, 0, 16, NULL, NULL));
+  TEST_ASSERT_EQ(-1, mdma_wait(NULL, 10));
+  TEST_ASSERT(!mdma_job_done(NULL));
+}
+
+/* 与main.c相同的数据块交接：DMA半区 → 复制作业 → 完成回调投递 → 消费者 */
+typedef struct
+{
+  uint32_t seq;
+  mdma_job_t job;
+  uint16_t samples[BLOCK_LEN];
+} block_t;
+
+static block_t s_blocks[BLOCK_NUM];
+static block_t *s_ring[BLOCK_NUM];
+static uint32_t s_ring_count;
+static uint32_t s_ring_drops;
+static pthread_mutex_t s_ring_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void block_copied(mdma_job_t *job, void *arg)
+{
+  pthread_mutex_lock(&s_ring_lock);
+  if(job->state == MDMA_JOB_DONE)
+  {
+    s_ring[s_ring_count++] = arg;
+  }
+  else
+  {
+    s_ring_drops++;
+  }
+  pthread_mutex_unlock(&s_ring_lock);
+}
+
+static void test_block_handoff(void)
+{
+  static uint16_t dma_buf[2][BLOCK_LEN];
+  uint64_t start;
+  uint64_t elapsed;
+
+  s_ring_count = 0;
+  s_ring_drops = 0;
+  start = test_now_ns();
+  for(uint32_t n = 0; n < BLOCK_NUM; n++)
+  {
+    uint16_t *half = dma_buf[n & 1U];
+    block_t *blk = &s_blocks[n];
+
+    // 上一次提交的同一半区复制完成前不得覆盖（目标板上由4ms半周期保证）
+    if(n >= 2)
+    {
+      TEST_ASSERT_EQ(0, mdma_wait(&s_blocks[n - 2].job, 1000));
+    }
+    for(uint32_t i = 0; i < BLOCK_LEN; i++)
+    {
+      half[i] = (uint16_t)(n * BLOCK_LEN + i);
+    }
+    blk->seq = n;
+    blk->job.state = MDMA_JOB_IDLE;
+    TEST_ASSERT_EQ(0, mdma_memcpy(&blk->job, blk->samples, half, sizeof(blk->samples),
+                                  block_copied, blk));
+  }
+  TEST_ASSERT_EQ(0, mdma_wait(&s_blocks[BLOCK_NUM - 1].job, 1000));
+  elapsed = test_now_ns() - start;
+
+  TEST_ASSERT_EQ(BLOCK_NUM, s_ring_count);
+  TEST_ASSERT_EQ(0, s_ring_drops);
+  for(uint32_t n = 0; n < s_ring_count; n++)
+  {
+    TEST_ASSERT_EQ(n, s_ring[n]->seq);
+    TEST_ASSERT_EQ(n * BLOCK_LEN, s_ring[n]->samples[0]);
+    TEST_ASSERT_EQ(n * BLOCK_LEN + BLOCK_LEN - 1, s_ring[n]->samples[BLOCK_LEN - 1]);
+  }
+  printf("  %d blocks x %u B handed off in %.1f us\n", BLOCK_NUM,
+         (unsigned)sizeof(s_blocks[0].samples), (double)elapsed / 1000.0);
+}
+
+/* 两个线程同时提交 */
+typedef struct
+{
+  mdma_job_t jobs[SUBMIT_JOBS];
+  uint8_t src[SUBMIT_LEN];
+  uint8_t dst[SUBMIT_JOBS][SUBMIT_LEN];
+  volatile uint32_t done[SUBMIT_JOBS];
+  uint32_t errors;
+} submitter_t;
+
+static submitter_t s_submitters[SUBMIT_THREADS];
+static pthread_barrier_t s_submit_start;
+
+static void submit_cb(mdma_job_t *job, void *arg)
+{
+  volatile uint32_t *done = arg;
+
+  (void)job;
+  (*done)++;
+}
+
+static void *submit_worker(void *arg)
+{
+  submitter_t *sub = arg;
+
+  pthread_barrier_wait(&s_submit_start);
+  for(uint32_t i = 0; i < SUBMIT_JOBS; i++)
+  {
+    sub->errors += (mdma_memcpy(&sub->jobs[i], sub->dst[i], sub->src, SUBMIT_LEN,
+                                submit_cb, (void *)&sub->done[i]) != 0);
+  }
+
+  return NULL;
+}
+
+static void test_concurrent_submit(void)
+{
+  pthread_t threads[SUBMIT_THREADS];
+
+  pthread_barrier_init(&s_submit_start, NULL, SUBMIT_THREADS);
+  for(uint32_t t = 0; t < SUBMIT_THREADS; t++)
+  {
+    submitter_t *sub = &s_submitters[t];
+
+    memset(sub, 0, sizeof(*sub));
+    memset(sub->src, 0x30 + (int)t, sizeof(sub->src));
+    pthread_create(&threads[t], NULL, submit_worker, sub);
+  }
+  for(uint32_t t = 0; t < SUBMIT_THREADS; t++)
+  {
+    pthread_join(threads[t], NULL);
+  }
+  pthread_barrier_destroy(&s_submit_start);
+
+  for(uint32_t t = 0; t < SUBMIT_THREADS; t++)
+  {
+    submitter_t *sub = &s_submitters[t];
+
+    TEST_ASSERT_EQ(0, sub->errors);
+    for(uint32_t i = 0; i < SUBMIT_JOBS; i++)
+    {
+      TEST_ASSERT_EQ(0, mdma_wait(&sub->jobs[i], 1000));
+      TEST_ASSERT_EQ(1, sub->done[i]);
+      TEST_ASSERT(memcmp(sub->dst[i], sub->src, SUBMIT_LEN) == 0);
+    }
+  }
+}
+
+int main(void)
+{
+  TEST_ASSERT_EQ(0, mdma_init());
+  TEST_ASSERT_EQ(0, mdma_init());
+
+  TEST_RUN(test_short_sync);
+  TEST_RUN(test_async_copy);
+  TEST_RUN(test_queue);
+  TEST_RUN(test_invalid);
+  TEST_RUN(test_block_handoff);
+  TEST_RUN(test_concurrent_submit);
+
+  return TEST_REPORT();
+}
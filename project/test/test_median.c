@@ -0,0 +1,239 @@
+/**
+ * @file    test_median.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   滑动中值与Hampel主机端测试与基准
+ *
+ * @details 参考实现每个样本复制窗口并插入排序：
+ *          - 中值滤波随机数据（含大量重复值）逐样本一致，窗口1~255
+ *          - Hampel预热期间中值与MAD只统计已写入样本，填满后与全窗口一致
+ *          - 基准：双堆与逐样本排序的ns/sample随窗口长度的变化
+ */
+
+#include "test.h"
+#include "median.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define DATA_LEN        (1U << 15)
+#define WINDOW_MAX      255U
+
+static uint16_t s_input[DATA_LEN];
+static uint16_t s_work[HAMPEL_WORK_LEN(WINDOW_MAX) > MEDIAN_WORK_LEN(WINDOW_MAX) ?
+                       HAMPEL_WORK_LEN(WINDOW_MAX) : MEDIAN_WORK_LEN(WINDOW_MAX)];
+static volatile uint32_t s_sink;
+
+static void make_input(uint32_t seed, uint16_t range)
+{
+  for(uint32_t i = 0; i < DATA_LEN; i++)
+  {
+    s_input[i] = (uint16_t)(test_rand(&seed) % range);
+  }
+}
+
+static void insertion_sort(uint16_t *buf, uint32_t n)
+{
+  for(uint32_t i = 1; i < n; i++)
+  {
+    uint16_t v = buf[i];
+    uint32_t j = i;
+
+    while(j > 0 && buf[j - 1] > v)
+    {
+      buf[j] = buf[j - 1];
+      j--;
+    }
+    buf[j] = v;
+  }
+}
+
+/* 参考中值：窗口未填满时按已有样本计算，偶数个样本取上中值 */
+static uint16_t ref_median(const uint16_t *x, uint32_t t, uint16_t size)
+{
+  uint16_t buf[WINDOW_MAX];
+  const uint32_t n = (t + 1 < size) ? t + 1 : size;
+
+  for(uint32_t k = 0; k < n; k++)
+  {
+    buf[k] = x[t - k];
+  }
+  insertion_sort(buf, n);
+
+  return buf[n / 2];
+}
+
+/* 参考Hampel：只统计已写入的min(t+1, N)个样本，中心样本延迟N - 1 - (N-1)/2 */
+static uint16_t ref_hampel(const uint16_t *x, uint32_t t, uint16_t size, uint16_t k_q8,
+                           bool *replaced)
+{
+  uint16_t buf[WINDOW_MAX];
+  const uint32_t n = (t + 1 < size) ? t + 1 : size;
+  const uint32_t delay = size - 1U - (size - 1U) / 2U;
+  uint16_t med;
+  uint16_t center;
+  uint32_t dev;
+
+  *replaced = false;
+  if(t < delay)
+  {
+    return 0;
+  }
+  center = x[t - delay];
+
+  for(uint32_t k = 0; k < n; k++)
+  {
+    buf[k] = x[t - k];
+  }
+  insertion_sort(buf, n);
+  med = buf[n / 2];
+
+  for(uint32_t k = 0; k < n; k++)
+  {
+    uint16_t v = x[t - k];
+    buf[k] = (v > med) ? (uint16_t)(v - med) : (uint16_t)(med - v);
+  }
+  insertion_sort(buf, n);
+
+  dev = (center > med) ? (uint32_t)(center - med) : (uint32_t)(med - center);
+  if(((uint64_t)dev << 16) > (uint64_t)k_q8 * 380U * buf[(n - 1) / 2])
+  {
+    *replaced = true;
+    return med;
+  }
+
+  return center;
+}
+
+static void test_median_reference(void)
+{
+  static const uint16_t sizes[] = {1, 2, 3, 4, 5, 8, 15, 16, 63, WINDOW_MAX};
+  static const uint16_t ranges[] = {4, 1000, 65535};
+
+  for(uint32_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++)
+  {
+    make_input(100 + r, ranges[r]);
+    for(uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+      Median_Handle_t med;
+      uint32_t err = 0;
+
+      TEST_ASSERT_EQ(0, Median_Init(&med, s_work, sizes[s]));
+      for(uint32_t i = 0; i < 4000; i++)
+      {
+        err += (Median_Update(&med, s_input[i]) != ref_median(s_input, i, sizes[s]));
+      }
+      TEST_ASSERT_EQ(0, err);
+    }
+  }
+
+  TEST_ASSERT_EQ(-1, Median_Init(NULL, s_work, 5));
+  TEST_ASSERT_EQ(-1, Median_Init(&(Median_Handle_t){0}, s_work, 0));
+}
+
+/* 随机输入逐样本与参考一致，含预热阶段 */
+static void test_hampel_reference(void)
+{
+  static const uint16_t sizes[] = {3, 4, 7, 15, 16, HAMPEL_WINDOW_MAX};
+  uint32_t seed = 5;
+
+  for(uint32_t i = 0; i < DATA_LEN; i++)
+  {
+    s_input[i] = (uint16_t)(30000 + test_rand(&seed) % 200);
+    if(test_rand(&seed) % 50 == 0)
+    {
+      s_input[i] = (uint16_t)(test_rand(&seed) % 65536);
+    }
+  }
+
+  for(uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+  {
+    Hampel_Handle_t h;
+    uint32_t err = 0;
+    uint32_t replaced = 0;
+
+    TEST_ASSERT_EQ(0, Hampel_Init(&h, s_work, sizes[s], 768));
+    for(uint32_t i = 0; i < 4000; i++)
+    {
+      bool rep;
+
+      err += (Hampel_Update(&h, s_input[i]) != ref_hampel(s_input, i, sizes[s], 768, &rep));
+      replaced += rep;
+    }
+    TEST_ASSERT_EQ(0, err);
+    TEST_ASSERT_EQ(replaced, h.replaced);
+    TEST_ASSERT(replaced > 0);
+  }
+}
+
+/*
+ * 预热期间的尖峰：N = 15，首样本为尖峰，第8个样本到达时它成为中心样本。
+ * 若按全部15个位置统计，7个初始0使MAD约等于信号电平，尖峰不会被剔除。
+ */
+static void test_hampel_warmup_spike(void)
+{
+  Hampel_Handle_t h;
+  uint16_t out[8];
+  const uint16_t x[8] = {5000, 1000, 1002, 999, 1001, 1000, 998, 1003};
+
+  TEST_ASSERT_EQ(0, Hampel_Init(&h, s_work, 15, 768));
+  for(uint32_t i = 0; i < 8; i++)
+  {
+    out[i] = Hampel_Update(&h, x[i]);
+  }
+
+  // 中心样本尚未写入时输出0
+  TEST_ASSERT_EQ(0, out[6]);
+  TEST_ASSERT_EQ(1001, out[7]);
+  TEST_ASSERT_EQ(1, h.replaced);
+}
+
+/* 双堆O(log N)与逐样本复制排序O(N)对照 */
+static void test_bench_sort(void)
+{
+  static const uint16_t sizes[] = {5, 15, 31, 63, 127, WINDOW_MAX};
+  const uint32_t n = DATA_LEN;
+
+  make_input(42, 4096);
+  printf("  %5s %14s %14s %8s\n", "N", "heap ns/smp", "sort ns/smp", "speedup");
+  for(uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+  {
+    Median_Handle_t med;
+    uint32_t acc = 0;
+    uint64_t t0;
+    double heap_ns;
+    double sort_ns;
+    const uint32_t sort_n = n / 8;
+
+    Median_Init(&med, s_work, sizes[s]);
+    t0 = test_now_ns();
+    for(uint32_t i = 0; i < n; i++)
+    {
+      acc += Median_Update(&med, s_input[i]);
+    }
+    heap_ns = (double)(test_now_ns() - t0) / n;
+
+    t0 = test_now_ns();
+    for(uint32_t i = 0; i < sort_n; i++)
+    {
+      acc += ref_median(s_input, i, sizes[s]);
+    }
+    sort_ns = (double)(test_now_ns() - t0) / sort_n;
+    s_sink = acc;
+
+    printf("  %5u %14.1f %14.1f %7.1fx\n", sizes[s], heap_ns, sort_ns, sort_ns / heap_ns);
+    if(sizes[s] >= 31)
+    {
+      TEST_ASSERT(heap_ns < sort_ns);
+    }
+  }
+}
+
+int main(void)
+{
+  TEST_RUN(test_median_reference);
+  TEST_RUN(test_hampel_reference);
+  TEST_RUN(test_hampel_warmup_spike);
+  TEST_RUN(test_bench_sort);
+
+  return TEST_REPORT();
+}
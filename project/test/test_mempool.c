@@ -0,0 +1,369 @@
+/**
+ * @file    test_mempool.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   固定块内存池主机端测试与多线程基准
+ *
+ * @details 功能测试：参数校验、耗尽与失败计数、峰值、重复释放与非法指针
+ *          （占用位图，非POISON构建同样检出）；POISON构建另测释放后写入。
+ *          并发测试：多个线程随机分配/释放，块内写入线程专属图案，释放前校验，
+ *          任一块同时交给两个线程即图案被改写。
+ *          基准：同样的分配/释放序列分别用内存池与heap_4式首次适配堆
+ *          （heap_region.c的DTCM路径，调度器挂起替换为全局互斥锁）运行，比较ns/op。
+ */
+
+#include "test.h"
+#include "mempool.h"
+#include "FreeRTOS.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BLOCK_SIZE      64U
+#define THREAD_MAX      8U
+#define LOCAL_LIVE      8U
+#define POOL_COUNT      (THREAD_MAX * LOCAL_LIVE)
+#define STRESS_OPS      200000U
+#define BENCH_OPS       400000U
+
+static MemPool_t s_pool;
+static uint64_t s_storage[MEMPOOL_STORAGE_SIZE(BLOCK_SIZE, POOL_COUNT) / sizeof(uint64_t)];
+static pthread_mutex_t s_heap_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile uint32_t s_corrupt;
+
+/* ==================== FreeRTOS替身 ==================== */
+
+void vAssertCalled(const char *file, int line)
+{
+  printf("  assert %s:%d\n", file, line);
+}
+
+void vApplicationMallocFailedHook(void)
+{
+}
+
+/* heap_4以挂起调度器保护，多线程主机上等价于一把全局锁 */
+void vTaskSuspendAll(void)
+{
+  pthread_mutex_lock(&s_heap_lock);
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+  pthread_mutex_unlock(&s_heap_lock);
+  return 0;
+}
+
+/* ==================== 功能测试 ==================== */
+
+static void test_init_args(void)
+{
+  uint64_t unaligned[4];
+
+  TEST_ASSERT_EQ(-1, MemPool_Init(NULL, "p", s_storage, BLOCK_SIZE, 4));
+  TEST_ASSERT_EQ(-1, MemPool_Init(&s_pool, "p", NULL, BLOCK_SIZE, 4));
+  TEST_ASSERT_EQ(-1, MemPool_Init(&s_pool, "p", s_storage, 0, 4));
+  TEST_ASSERT_EQ(-1, MemPool_Init(&s_pool, "p", s_storage, BLOCK_SIZE, 0));
+  TEST_ASSERT_EQ(-1, MemPool_Init(&s_pool, "p", s_storage, BLOCK_SIZE, MEMPOOL_MAX_BLOCKS + 1U));
+  TEST_ASSERT_EQ(-1, MemPool_Init(&s_pool, "p", (uint8_t *)unaligned + 4, 8, 2));
+
+  TEST_ASSERT(MemPool_Alloc(NULL) == NULL);
+  TEST_ASSERT_EQ(-1, MemPool_Free(NULL, s_storage));
+  TEST_ASSERT_EQ(8, MEMPOOL_MAP_SIZE(1));
+  TEST_ASSERT_EQ(8, MEMPOOL_MAP_SIZE(64));
+  TEST_ASSERT_EQ(16, MEMPOOL_MAP_SIZE(65));
+}
+
+/* 耗尽、顺序、峰值与失败计数 */
+static void test_exhaust(void)
+{
+  void *blocks[POOL_COUNT];
+  MemPool_Stats_t stats;
+
+  TEST_ASSERT_EQ(0, MemPool_Init(&s_pool, "test", s_storage, BLOCK_SIZE - 3U, POOL_COUNT));
+  for(uint32_t i = 0; i < POOL_COUNT; i++)
+  {
+    blocks[i] = MemPool_Alloc(&s_pool);
+    TEST_ASSERT(blocks[i] == (uint8_t *)s_storage + i * BLOCK_SIZE);
+  }
+  TEST_ASSERT(MemPool_Alloc(&s_pool) == NULL);
+
+  MemPool_GetStats(&s_pool, &stats);
+  TEST_ASSERT(strcmp(stats.name, "test") == 0);
+  TEST_ASSERT_EQ(BLOCK_SIZE, stats.block_size);
+  TEST_ASSERT_EQ(POOL_COUNT, stats.in_use);
+  TEST_ASSERT_EQ(POOL_COUNT, stats.peak);
+  TEST_ASSERT_EQ(1, stats.failures);
+
+  for(uint32_t i = 0; i < POOL_COUNT; i++)
+  {
+    TEST_ASSERT_EQ(0, MemPool_Free(&s_pool, blocks[i]));
+  }
+  // LIFO：最后释放的块最先分配
+  TEST_ASSERT(MemPool_Alloc(&s_pool) == blocks[POOL_COUNT - 1]);
+  MemPool_GetStats(&s_pool, &stats);
+  TEST_ASSERT_EQ(1, stats.in_use);
+  TEST_ASSERT_EQ(POOL_COUNT, stats.peak);
+  TEST_ASSERT_EQ(0, stats.errors);
+}
+
+/* 重复释放与非法指针：返回-1、计入错误，池状态不变 */
+static void test_invalid_free(void)
+{
+  MemPool_Stats_t stats;
+  uint8_t *a;
+  uint8_t *b;
+  uint64_t other;
+
+  MemPool_Init(&s_pool, "test", s_storage, BLOCK_SIZE, 4);
+  a = MemPool_Alloc(&s_pool);
+  b = MemPool_Alloc(&s_pool);
+
+  // 首字写成与空闲链表相同的形式，占用位图仍能区分
+  memset(a, 0, BLOCK_SIZE);
+  TEST_ASSERT_EQ(0, MemPool_Free(&s_pool, a));
+  TEST_ASSERT_EQ(-1, MemPool_Free(&s_pool, a));
+  TEST_ASSERT_EQ(-1, MemPool_Free(&s_pool, b + 8));
+  TEST_ASSERT_EQ(-1, MemPool_Free(&s_pool, &other));
+  TEST_ASSERT_EQ(-1, MemPool_Free(&s_pool, (uint8_t *)s_storage + 4 * BLOCK_SIZE));
+
+  MemPool_GetStats(&s_pool, &stats);
+  TEST_ASSERT_EQ(4, stats.errors);
+  TEST_ASSERT_EQ(1, stats.in_use);
+
+  // 重复释放未进入空闲链表：只能再分配出3块
+  TEST_ASSERT(MemPool_Alloc(&s_pool) == a);
+  TEST_ASSERT(MemPool_Alloc(&s_pool) != NULL);
+  TEST_ASSERT(MemPool_Alloc(&s_pool) != NULL);
+  TEST_ASSERT(MemPool_Alloc(&s_pool) == NULL);
+}
+
+#if MEMPOOL_POISON
+/* 释放后写入：下次分配该块时计入错误；新块以MEMPOOL_POISON_ALLOC填充 */
+static void test_poison(void)
+{
+  MemPool_Stats_t stats;
+  uint8_t *a;
+
+  MemPool_Init(&s_pool, "test", s_storage, BLOCK_SIZE, 2);
+  a = MemPool_Alloc(&s_pool);
+  TEST_ASSERT_EQ(MEMPOOL_POISON_ALLOC, a[BLOCK_SIZE - 1U]);
+  MemPool_Free(&s_pool, a);
+  TEST_ASSERT_EQ(MEMPOOL_POISON_FREE, a[BLOCK_SIZE - 1U]);
+
+  a[20] = 0x55;
+  TEST_ASSERT(MemPool_Alloc(&s_pool) == a);
+  MemPool_GetStats(&s_pool, &stats);
+  TEST_ASSERT_EQ(1, stats.errors);
+}
+#endif
+
+/* ==================== 并发 ==================== */
+
+typedef struct
+{
+  uint32_t id;
+  uint32_t ops;
+  bool use_heap;
+  uint64_t ns;
+} worker_t;
+
+static void *block_alloc(bool use_heap)
+{
+  return use_heap ? pvPortMalloc(BLOCK_SIZE) : MemPool_Alloc(&s_pool);
+}
+
+static void block_free(bool use_heap, void *p)
+{
+  if(use_heap)
+  {
+    vPortFree(p);
+  }
+  else
+  {
+    MemPool_Free(&s_pool, p);
+  }
+}
+
+/* 压力：每块写满线程专属图案，释放前校验 */
+static void *stress_worker(void *arg)
+{
+  worker_t *w = arg;
+  uint32_t *live[LOCAL_LIVE];
+  uint32_t count = 0;
+  uint32_t seed = w->id * 7919U + 1U;
+
+  for(uint32_t op = 0; op < w->ops; op++)
+  {
+    if(count < LOCAL_LIVE && (count == 0 || (test_rand(&seed) & 1U)))
+    {
+      uint32_t *p = block_alloc(w->use_heap);
+
+      if(p != NULL)
+      {
+        for(uint32_t k = 0; k < BLOCK_SIZE / 4U; k++)
+        {
+          p[k] = (w->id << 24) | op;
+        }
+        p[0] = op;
+        live[count++] = p;
+      }
+    }
+    else
+    {
+      uint32_t i = test_rand(&seed) % count;
+      uint32_t *p = live[i];
+
+      for(uint32_t k = 1; k < BLOCK_SIZE / 4U; k++)
+      {
+        if(p[k] != ((w->id << 24) | p[0]))
+        {
+          __atomic_add_fetch(&s_corrupt, 1U, __ATOMIC_RELAXED);
+          break;
+        }
+      }
+      block_free(w->use_heap, p);
+      live[i] = live[--count];
+    }
+  }
+
+  while(count > 0)
+  {
+    block_free(w->use_heap, live[--count]);
+  }
+
+  return NULL;
+}
+
+/* 基准：与压力测试相同的随机分配/释放序列，不写图案，只计分配器本身 */
+static void *bench_worker(void *arg)
+{
+  worker_t *w = arg;
+  void *live[LOCAL_LIVE];
+  uint32_t count = 0;
+  uint32_t seed = w->id * 7919U + 1U;
+  uint64_t t0 = test_now_ns();
+
+  for(uint32_t op = 0; op < w->ops; op++)
+  {
+    if(count < LOCAL_LIVE && (count == 0 || (test_rand(&seed) & 1U)))
+    {
+      void *p = block_alloc(w->use_heap);
+
+      if(p != NULL)
+      {
+        live[count++] = p;
+      }
+    }
+    else
+    {
+      uint32_t i = test_rand(&seed) % count;
+
+      block_free(w->use_heap, live[i]);
+      live[i] = live[--count];
+    }
+  }
+  w->ns = test_now_ns() - t0;
+
+  while(count > 0)
+  {
+    block_free(w->use_heap, live[--count]);
+  }
+
+  return NULL;
+}
+
+static double run_threads(uint32_t threads, bool use_heap, uint32_t ops, void *(*fn)(void *))
+{
+  pthread_t tid[THREAD_MAX];
+  worker_t w[THREAD_MAX];
+  uint64_t longest = 0;
+
+  for(uint32_t i = 0; i < threads; i++)
+  {
+    w[i] = (worker_t){.id = i + 1U, .ops = ops, .use_heap = use_heap, .ns = 0};
+    pthread_create(&tid[i], NULL, fn, &w[i]);
+  }
+  for(uint32_t i = 0; i < threads; i++)
+  {
+    pthread_join(tid[i], NULL);
+    longest = (w[i].ns > longest) ? w[i].ns : longest;
+  }
+
+  // 总吞吐：全部操作数 / 最慢线程耗时
+  return (double)longest / ((double)ops * threads);
+}
+
+static void test_concurrent(void)
+{
+  MemPool_Stats_t stats;
+  void *blocks[POOL_COUNT];
+
+  MemPool_Init(&s_pool, "test", s_storage, BLOCK_SIZE, POOL_COUNT);
+  s_corrupt = 0;
+  run_threads(THREAD_MAX, false, STRESS_OPS, stress_worker);
+  TEST_ASSERT_EQ(0, s_corrupt);
+
+  MemPool_GetStats(&s_pool, &stats);
+  TEST_ASSERT_EQ(0, stats.in_use);
+  TEST_ASSERT_EQ(0, stats.errors);
+  TEST_ASSERT_EQ(0, stats.failures);
+  TEST_ASSERT(stats.peak <= POOL_COUNT);
+
+  // 空闲链表完整：全部块都能再分配出来且互不相同
+  for(uint32_t i = 0; i < POOL_COUNT; i++)
+  {
+    blocks[i] = MemPool_Alloc(&s_pool);
+    TEST_ASSERT(blocks[i] != NULL);
+    for(uint32_t k = 0; k < i; k++)
+    {
+      TEST_ASSERT(blocks[k] != blocks[i]);
+    }
+  }
+  TEST_ASSERT(MemPool_Alloc(&s_pool) == NULL);
+}
+
+/* 内存池与heap_4式全局锁首次适配堆的ns/op */
+static void test_bench(void)
+{
+  static const uint32_t threads[] = {1, 2, 4, 8};
+  HeapStats_t heap;
+
+  // 单核主机上线程不会真正并发，锁几乎无竞争，两者差距主要来自原子操作次数
+  printf("  %ld online CPU(s)\n", sysconf(_SC_NPROCESSORS_ONLN));
+  printf("  %-8s %14s %14s %8s\n", "threads", "mempool ns/op", "heap_4 ns/op", "ratio");
+  for(uint32_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+  {
+    double pool_ns = 1e30;
+    double heap_ns = 1e30;
+
+    for(uint32_t r = 0; r < 3; r++)
+    {
+      MemPool_Init(&s_pool, "bench", s_storage, BLOCK_SIZE, POOL_COUNT);
+      pool_ns = fmin(pool_ns, run_threads(threads[t], false, BENCH_OPS, bench_worker));
+      heap_ns = fmin(heap_ns, run_threads(threads[t], true, BENCH_OPS, bench_worker));
+    }
+
+    printf("  %-8u %14.1f %14.1f %7.1fx\n", threads[t], pool_ns, heap_ns, heap_ns / pool_ns);
+  }
+
+  // 基准结束后堆合并回单个空闲块
+  vPortGetHeapStats(&heap);
+  TEST_ASSERT_EQ(1, heap.xNumberOfFreeBlocks);
+  TEST_ASSERT_EQ(heap.xNumberOfSuccessfulAllocations, heap.xNumberOfSuccessfulFrees);
+}
+
+int main(void)
+{
+  TEST_RUN(test_init_args);
+  TEST_RUN(test_exhaust);
+  TEST_RUN(test_invalid_free);
+#if MEMPOOL_POISON
+  TEST_RUN(test_poison);
+#endif
+  TEST_RUN(test_concurrent);
+  TEST_RUN(test_bench);
+
+  return TEST_REPORT();
+}
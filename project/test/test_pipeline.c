@@ -0,0 +1,188 @@
+/**
+ * @file    test_pipeline.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   滤波流水线主机端测试与CSV回放
+ *
+ * @details 按应用层默认描述符表（CIC 64倍抽取 → 5点中值 → 50 Hz低通 → mV → 统计）
+ *          与ADC半缓冲区长度BOARD_ADC_BLOCK_LEN逐块处理：
+ *          - 超出block_len的输入计入truncated
+ *          - 中值/MAF/WMAF窗口长度为0或超出工作区时配置失败
+ *          - 合成信号（直流 + 200 Hz干扰 + 尖峰）输出均值与纹波符合设计
+ *          - 给出录制文件时回放并输出每个流水线输出样本，便于与离线分析比较
+ *
+ *          用法：test_pipeline [recording.csv [output.csv]]
+ *          输出CSV每行：输入样本序号,输出值（流水线输出单位，默认为mV）
+ */
+
+#include "test.h"
+#include "pipeline.h"
+#include <string.h>
+
+/* 与drivers/board.h中BOARD_ADC_BLOCK_LEN一致（board.h依赖HAL，主机端不直接包含） */
+#define BOARD_ADC_BLOCK_LEN     512
+
+#define PI              3.14159265358979323846
+#define ADC_RATE_HZ     126262.0f
+#define RECORD_MAX      (1U << 20)
+
+/* 与app/main.c中的默认流水线一致 */
+static const Pipeline_StageDesc_t s_default[PIPELINE_MAX_STAGES] =
+{
+  {PIPE_STAGE_CIC,    {3, 64, 1}},
+  {PIPE_STAGE_MEDIAN, {5, 0, 0}},
+  {PIPE_STAGE_IIR,    {PIPE_IIR_LOWPASS | (1U << 8), 50, 71}},
+  {PIPE_STAGE_SCALE,  {0, 3300, 16}},
+  {PIPE_STAGE_STATS,  {0, 0, 0}},
+};
+
+static Pipeline_Handle_t s_pipe;
+static int32_t s_buf[2 * BOARD_ADC_BLOCK_LEN];
+static uint16_t s_record[RECORD_MAX];
+static uint32_t s_record_len;
+
+/* 空流水线直通；超出block_len的部分丢弃并计数 */
+static void test_truncation(void)
+{
+  uint16_t in[20];
+  const int32_t *out = NULL;
+
+  for(uint32_t i = 0; i < 20; i++)
+  {
+    in[i] = (uint16_t)(100 + i);
+  }
+
+  TEST_ASSERT_EQ(0, Pipeline_Init(&s_pipe, s_buf, 8, ADC_RATE_HZ));
+  TEST_ASSERT_EQ(8, Pipeline_Process(&s_pipe, in, 20, &out));
+  TEST_ASSERT_EQ(12, s_pipe.truncated);
+  TEST_ASSERT_EQ(107, out[7]);
+  TEST_ASSERT_EQ(8, Pipeline_Process(&s_pipe, in, 8, &out));
+  TEST_ASSERT_EQ(12, s_pipe.truncated);
+}
+
+/* 窗口长度越界（0或超出工作区）的中值/MAF/WMAF级被拒绝，原配置保持不变 */
+static void test_window_limits(void)
+{
+  static const uint16_t types[] = {PIPE_STAGE_MEDIAN, PIPE_STAGE_MAF, PIPE_STAGE_WMAF};
+  static const uint16_t max[] = {PIPELINE_MEDIAN_MAX, PIPELINE_WORK_LEN, PIPELINE_WORK_LEN};
+  Pipeline_StageDesc_t desc = {PIPE_STAGE_NONE, {0, 0, 0}};
+
+  TEST_ASSERT_EQ(0, Pipeline_Init(&s_pipe, s_buf, BOARD_ADC_BLOCK_LEN, ADC_RATE_HZ));
+  TEST_ASSERT_EQ(0, Pipeline_Configure(&s_pipe, s_default, PIPELINE_MAX_STAGES));
+  for(uint32_t i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+  {
+    desc.type = types[i];
+    desc.param[0] = 0;
+    TEST_ASSERT_EQ(-1, Pipeline_Configure(&s_pipe, &desc, 1));
+    desc.param[0] = (uint16_t)(max[i] + 1U);
+    TEST_ASSERT_EQ(-1, Pipeline_Configure(&s_pipe, &desc, 1));
+    TEST_ASSERT_EQ(PIPELINE_MAX_STAGES, s_pipe.count);
+    desc.param[0] = max[i];
+    TEST_ASSERT_EQ(0, Pipeline_Configure(&s_pipe, &desc, 1));
+    TEST_ASSERT_EQ(0, Pipeline_Configure(&s_pipe, s_default, PIPELINE_MAX_STAGES));
+  }
+}
+
+/* 按BOARD_ADC_BLOCK_LEN逐块处理，回调每个输出样本 */
+static uint32_t run_blocks(const uint16_t *x, uint32_t len, FILE *fp)
+{
+  uint32_t produced = 0;
+
+  for(uint32_t i = 0; i + BOARD_ADC_BLOCK_LEN <= len; i += BOARD_ADC_BLOCK_LEN)
+  {
+    const int32_t *out;
+    uint32_t n = Pipeline_Process(&s_pipe, &x[i], BOARD_ADC_BLOCK_LEN, &out);
+
+    for(uint32_t k = 0; k < n && fp != NULL; k++)
+    {
+      // 输出样本对应的输入位置（抽取后均匀分布在块内）
+      fprintf(fp, "%lu,%ld\n", (unsigned long)(i + (k + 1) * BOARD_ADC_BLOCK_LEN / n - 1),
+              (long)out[k]);
+    }
+    produced += n;
+  }
+
+  return produced;
+}
+
+/* 1650 mV直流 + 200 Hz（约100 mV幅度）+ 稀疏尖峰：低通后纹波约为1/16，尖峰被中值去除 */
+static void test_default_synthetic(void)
+{
+  const uint32_t len = 64U * BOARD_ADC_BLOCK_LEN * 4U;
+  Pipeline_Stats_t stats;
+  uint32_t seed = 17;
+
+  for(uint32_t i = 0; i < len; i++)
+  {
+    double v = 32768.0 + 2000.0 * sin(2.0 * PI * 200.0 * i / ADC_RATE_HZ);
+
+    v += (double)(test_rand(&seed) % 64) - 32.0;
+    if(i % 5000 == 2500)
+    {
+      v = 65535.0;
+    }
+    s_record[i] = (uint16_t)v;
+  }
+
+  TEST_ASSERT_EQ(0, Pipeline_Init(&s_pipe, s_buf, BOARD_ADC_BLOCK_LEN, ADC_RATE_HZ));
+  TEST_ASSERT_EQ(0, Pipeline_Configure(&s_pipe, s_default, PIPELINE_MAX_STAGES));
+  TEST_ASSERT_NEAR(ADC_RATE_HZ / 64.0f, s_pipe.out_rate, 1.0);
+
+  // 前1/4用于建立，丢弃统计
+  TEST_ASSERT_EQ(len / 4 / 64, run_blocks(s_record, len / 4, NULL));
+  Pipeline_GetStats(&s_pipe, &stats);
+  TEST_ASSERT_EQ(len * 3 / 4 / 64, run_blocks(&s_record[len / 4], len * 3 / 4, NULL));
+  TEST_ASSERT_EQ(0, Pipeline_GetStats(&s_pipe, &stats));
+
+  printf("  mean %ld mV, min %ld, max %ld, std %ld\n", (long)stats.mean, (long)stats.min,
+         (long)stats.max, (long)stats.std);
+  TEST_ASSERT_NEAR(1650, stats.mean, 2);
+  TEST_ASSERT(stats.max - stats.min < 20);
+  TEST_ASSERT_EQ(0, s_pipe.truncated);
+}
+
+/* 回放录制数据，输出写入CSV（未给出输出文件时只打印统计） */
+static void run_recording(const char *out_path)
+{
+  Pipeline_Stats_t stats;
+  FILE *fp = NULL;
+  uint32_t produced;
+
+  if(out_path != NULL)
+  {
+    fp = fopen(out_path, "w");
+    TEST_ASSERT(fp != NULL);
+  }
+
+  Pipeline_Init(&s_pipe, s_buf, BOARD_ADC_BLOCK_LEN, ADC_RATE_HZ);
+  Pipeline_Configure(&s_pipe, s_default, PIPELINE_MAX_STAGES);
+  produced = run_blocks(s_record, s_record_len, fp);
+
+  printf("  %lu samples in, %lu out (%.1f Hz)\n", (unsigned long)s_record_len,
+         (unsigned long)produced, (double)s_pipe.out_rate);
+  if(Pipeline_GetStats(&s_pipe, &stats) == 0)
+  {
+    printf("  mean %ld, min %ld, max %ld, std %ld\n", (long)stats.mean, (long)stats.min,
+           (long)stats.max, (long)stats.std);
+  }
+  if(fp != NULL)
+  {
+    fclose(fp);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  TEST_RUN(test_truncation);
+  TEST_RUN(test_window_limits);
+  TEST_RUN(test_default_synthetic);
+
+  if(argc > 1)
+  {
+    s_record_len = test_load_csv(argv[1], s_record, RECORD_MAX);
+    TEST_ASSERT(s_record_len >= BOARD_ADC_BLOCK_LEN);
+    run_recording((argc > 2) ? argv[2] : NULL);
+  }
+
+  return TEST_REPORT();
+}
@@ -0,0 +1,175 @@
+/**
+ * @file    test_rs485.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   RS485换向时序主机端模型
+ *
+ * @details 按drv_uart.c的两种方向控制方式生成一帧发送的DE波形（单位ns），逐位检查：
+ *          - 硬件DE：外设在起始位前de_assert、最后一个停止位后de_deassert个采样时钟
+ *            （16倍过采样，1/16位）翻转DE；uartcfg接受的0-31范围内DE覆盖每一位，
+ *            释放间隔不超过2位时间
+ *          - GPIO方式：发送前置位，TC中断中复位，释放间隔为中断响应时间
+ *          两者的释放间隔均须小于一个字符时间（10位），主站才能按T3.5满速轮询
+ */
+
+#include "test.h"
+#include "uartcfg.h"
+#include <stdbool.h>
+
+#define OVERSAMPLING        16U
+#define CHAR_BITS           10U     /**< 起始位+8数据位+停止位 */
+#define FRAME_CHARS         8U      /**< 模拟帧长（Modbus RTU最短响应） */
+
+/**
+ * @brief GPIO方式TC中断响应上限（假设）
+ * @note  串口中断优先级5，会被FreeRTOS临界区屏蔽，按10us计；阻塞发送在HAL轮询TC后
+ *        立即复位，延迟远小于该值
+ */
+#define GPIO_TC_LATENCY_NS  10000U
+
+/**
+ * @brief GPIO方式置位DE到写入首字节的间隔（置位后立即启动HAL发送）
+ */
+#define GPIO_LEAD_NS        1000U
+
+/**
+ * @brief 一帧发送的DE波形
+ */
+typedef struct
+{
+  double start_ns;                      /**< 首个起始位开始 */
+  double end_ns;                        /**< 最后一个停止位结束 */
+  double de_on_ns;                      /**< DE置位 */
+  double de_off_ns;                     /**< DE复位 */
+} de_wave_t;
+
+static double bit_ns(uint32_t baud)
+{
+  return 1e9 / (double)baud;
+}
+
+/* 硬件DE：DE翻转由外设按采样时钟计时 */
+static de_wave_t wave_hw(uint32_t baud, uint32_t de_assert, uint32_t de_deassert)
+{
+  double sample = bit_ns(baud) / OVERSAMPLING;
+  de_wave_t w;
+
+  w.de_on_ns = 0.0;
+  w.start_ns = de_assert * sample;
+  w.end_ns = w.start_ns + FRAME_CHARS * CHAR_BITS * bit_ns(baud);
+  w.de_off_ns = w.end_ns + de_deassert * sample;
+
+  return w;
+}
+
+/* GPIO方式：发送前置位，TC（最后停止位结束）后经中断响应复位 */
+static de_wave_t wave_gpio(uint32_t baud, uint32_t latency_ns)
+{
+  de_wave_t w;
+
+  w.de_on_ns = 0.0;
+  w.start_ns = GPIO_LEAD_NS;
+  w.end_ns = w.start_ns + FRAME_CHARS * CHAR_BITS * bit_ns(baud);
+  w.de_off_ns = w.end_ns + latency_ns;
+
+  return w;
+}
+
+/* 逐位检查DE覆盖每一位的起止（收发器在DE为低时不驱动总线，位会被截断） */
+static bool wave_covers_bits(const de_wave_t *w, uint32_t baud)
+{
+  for(uint32_t bit = 0; bit < FRAME_CHARS * CHAR_BITS; bit++)
+  {
+    double begin = w->start_ns + bit * bit_ns(baud);
+    double end = begin + bit_ns(baud);
+
+    if(begin < w->de_on_ns || end > w->de_off_ns)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* 释放间隔：最后停止位结束到DE复位 */
+static double release_ns(const de_wave_t *w)
+{
+  return w->de_off_ns - w->end_ns;
+}
+
+/* 硬件DE：uartcfg接受的全部提前/保持时间都满足覆盖与小于2位时间 */
+static void test_hw_de_range(void)
+{
+  static const uint32_t bauds[] = {9600, 19200, 38400, 115200, 921600};
+  UartCfg_t cfg =
+  {
+    .port = 0, .tx_gpio = 0, .rx_gpio = 0, .rs485 = true, .de_gpio = 0
+  };
+
+  for(uint32_t b = 0; b < sizeof(bauds) / sizeof(bauds[0]); b++)
+  {
+    double bit = bit_ns(bauds[b]);
+
+    for(uint32_t t = 0; t <= UARTCFG_DE_TIME_MAX + 1U; t++)
+    {
+      de_wave_t w = wave_hw(bauds[b], t, t);
+
+      cfg.de_assert = t;
+      cfg.de_deassert = t;
+      if(UartCfg_Validate(&cfg) != 0)
+      {
+        // 超出寄存器位宽的值由uart_init()拒绝
+        TEST_ASSERT_EQ(UARTCFG_DE_TIME_MAX + 1U, t);
+        continue;
+      }
+
+      TEST_ASSERT(wave_covers_bits(&w, bauds[b]));
+      TEST_ASSERT(w.start_ns - w.de_on_ns < 2.0 * bit);
+      TEST_ASSERT(release_ns(&w) < 2.0 * bit);
+      TEST_ASSERT(release_ns(&w) < CHAR_BITS * bit);
+    }
+  }
+}
+
+/* 各1位时间（board.c中PA1接DE时的推荐配置）：提前与释放间隔均为1位 */
+static void test_hw_de_one_bit(void)
+{
+  de_wave_t w = wave_hw(115200, 16, 16);
+
+  TEST_ASSERT_NEAR(8680.6, release_ns(&w), 0.1);
+  TEST_ASSERT_NEAR(8680.6, w.start_ns - w.de_on_ns, 0.1);
+}
+
+/* GPIO方式：Modbus常用波特率下释放间隔小于一个字符，10us中断响应下的上限低于1 Mbaud */
+static void test_gpio_turnaround(void)
+{
+  static const uint32_t bauds[] = {9600, 19200, 38400, 57600, 115200, 230400, 460800};
+  de_wave_t max_gpio;
+
+  printf("  %8s %10s %12s %12s\n", "baud", "char us", "hw DE us", "gpio us");
+  for(uint32_t b = 0; b < sizeof(bauds) / sizeof(bauds[0]); b++)
+  {
+    de_wave_t hw = wave_hw(bauds[b], 16, 16);
+    de_wave_t gpio = wave_gpio(bauds[b], GPIO_TC_LATENCY_NS);
+    double char_ns = CHAR_BITS * bit_ns(bauds[b]);
+
+    printf("  %8lu %10.1f %12.1f %12.1f\n", (unsigned long)bauds[b], char_ns / 1000.0,
+           release_ns(&hw) / 1000.0, release_ns(&gpio) / 1000.0);
+    TEST_ASSERT(wave_covers_bits(&gpio, bauds[b]));
+    TEST_ASSERT(release_ns(&gpio) < char_ns);
+  }
+
+  // 中断响应10us对应的上限：字符时间须大于响应时间，即低于1 Mbaud
+  max_gpio = wave_gpio(1000000, GPIO_TC_LATENCY_NS);
+  TEST_ASSERT(release_ns(&max_gpio) >= CHAR_BITS * bit_ns(1000000));
+}
+
+int main(void)
+{
+  TEST_RUN(test_hw_de_range);
+  TEST_RUN(test_hw_de_one_bit);
+  TEST_RUN(test_gpio_turnaround);
+
+  return TEST_REPORT();
+}
@@ -0,0 +1,282 @@
+/**
+ * @file    test_runstats.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   运行时统计主机端测试（POSIX后端）
+ *
+ * @details runstats.c与目标板同一份源码，后端换成drivers/posix/drv_runstats.c：
+ *          - 以可控的模拟周期计数校验64位扩展、任务/中断负载、滑动平均与峰值、
+ *            任务删除后释放槽位、寄存器镜像布局与文本报告
+ *          - 以clock_gettime周期源校验窗口长度，多线程并发读取64位计数保持单调
+ */
+
+#include "test.h"
+#include "runstats.h"
+#include "runstats_port.h"
+#include "drv_runstats_host.h"
+#include <pthread.h>
+#include <string.h>
+
+#define FAKE_HZ         1000000U
+#define THREAD_NUM      4
+#define THREAD_READS    200000U
+
+static uint32_t s_fake;
+static RunStats_PortTask_t s_tasks[3];
+static char s_text[1024];
+
+/* printf库的字符输出（主机端未使用printf_，仅满足链接） */
+void _putchar(char character)
+{
+  putchar(character);
+}
+
+static uint32_t fake_cycles(void)
+{
+  return s_fake;
+}
+
+/* 模拟一个窗口：各任务运行给定周期数 */
+static void run_window(uint32_t window, const uint32_t run[3])
+{
+  s_fake += window;
+  for(uint32_t i = 0; i < 3; i++)
+  {
+    s_tasks[i].run_time += run[i];
+  }
+  RunStats_Sample();
+}
+
+static void setup_tasks(void)
+{
+  const RunStats_PortTask_t tasks[3] =
+  {
+    {"IDLE",  1, 0,  0, true},
+    {"App",   2, 24, 0, false},
+    {"Stats", 3, 8,  0, false},
+  };
+
+  memcpy(s_tasks, tasks, sizeof(s_tasks));
+  runstats_host_set_tasks(s_tasks, 3);
+  s_fake = 0;
+  RunStats_Init(fake_cycles, FAKE_HZ);
+  RunStats_Start();
+}
+
+/* 32位计数回绕后高位加1 */
+static void test_cycles64_wrap(void)
+{
+  RunStats_Init(NULL, FAKE_HZ);
+  TEST_ASSERT_EQ(0, RunStats_GetCycles64());
+
+  RunStats_Init(fake_cycles, FAKE_HZ);
+  s_fake = 0xFFFFFF00U;
+  TEST_ASSERT_EQ(0xFFFFFF00ULL, RunStats_GetCycles64());
+  s_fake = 0x100U;
+  TEST_ASSERT_EQ(0x100000100ULL, RunStats_GetCycles64());
+  s_fake = 0x200U;
+  TEST_ASSERT_EQ(0x100000200ULL, RunStats_GetCycles64());
+}
+
+/* 任务负载、CPU负载（1 - IDLE）、平均与峰值，删除任务释放槽位 */
+static void test_task_load(void)
+{
+  RunStats_Summary_t summary;
+  RunStats_TaskInfo_t info;
+
+  setup_tasks();
+  run_window(10000, (const uint32_t[3]){6000, 3000, 1000});
+  TEST_ASSERT_EQ(0, RunStats_GetSummary(&summary));
+  TEST_ASSERT_EQ(1, summary.windows);
+  TEST_ASSERT_EQ(10000, summary.window_cycles);
+  TEST_ASSERT_EQ(3, summary.task_count);
+  TEST_ASSERT_EQ(400, summary.cpu.now);
+
+  TEST_ASSERT_EQ(0, RunStats_GetTask(1, &info));
+  TEST_ASSERT(strcmp(info.name, "App") == 0);
+  TEST_ASSERT_EQ(2, info.id);
+  TEST_ASSERT_EQ(24, info.priority);
+  TEST_ASSERT_EQ(300, info.load.now);
+
+  run_window(10000, (const uint32_t[3]){9000, 500, 500});
+  RunStats_GetSummary(&summary);
+  TEST_ASSERT_EQ(100, summary.cpu.now);
+  TEST_ASSERT_EQ(250, summary.cpu.avg);
+  TEST_ASSERT_EQ(400, summary.cpu.peak);
+  RunStats_GetTask(1, &info);
+  TEST_ASSERT_EQ(50, info.load.now);
+  TEST_ASSERT_EQ(175, info.load.avg);
+  TEST_ASSERT_EQ(300, info.load.peak);
+  TEST_ASSERT_EQ(3500, info.run_cycles);
+
+  // 删除Stats任务
+  runstats_host_set_tasks(s_tasks, 2);
+  run_window(10000, (const uint32_t[3]){5000, 5000, 0});
+  RunStats_GetSummary(&summary);
+  TEST_ASSERT_EQ(2, summary.task_count);
+  TEST_ASSERT_EQ(-1, RunStats_GetTask(2, &info));
+
+  // 任务数超过RUNSTATS_MAX_TASKS时保留上一次结果
+  runstats_host_set_tasks(s_tasks, RUNSTATS_MAX_TASKS + 1);
+  run_window(10000, (const uint32_t[3]){0, 0, 0});
+  RunStats_GetSummary(&summary);
+  TEST_ASSERT_EQ(2, summary.task_count);
+
+  RunStats_Reset();
+  RunStats_GetSummary(&summary);
+  TEST_ASSERT_EQ(0, summary.cpu.peak);
+}
+
+/* 中断计时：负载、次数与单次最长 */
+static void test_irq(void)
+{
+  RunStats_IrqInfo_t info;
+  uint32_t stamp;
+
+  setup_tasks();
+  TEST_ASSERT_EQ(-1, RunStats_SetIrqName(RUNSTATS_MAX_IRQS, "X"));
+  TEST_ASSERT_EQ(0, RunStats_SetIrqName(0, "UART"));
+  TEST_ASSERT_EQ(-1, RunStats_GetIrq(1, &info));
+
+  s_fake = 100;
+  stamp = RunStats_IrqEnter();
+  s_fake = 600;
+  RunStats_IrqExit(0, stamp);
+  stamp = RunStats_IrqEnter();
+  s_fake = 800;
+  RunStats_IrqExit(0, stamp);
+  // 越界编号忽略
+  RunStats_IrqExit(RUNSTATS_MAX_IRQS, stamp);
+
+  s_fake = 0;
+  run_window(10000, (const uint32_t[3]){5000, 5000, 0});
+  TEST_ASSERT_EQ(0, RunStats_GetIrq(0, &info));
+  TEST_ASSERT_EQ(70, info.load.now);
+  TEST_ASSERT_EQ(2, info.count);
+  TEST_ASSERT_EQ(2, info.rate);
+  TEST_ASSERT_EQ(500, info.max_cycles);
+
+  run_window(10000, (const uint32_t[3]){5000, 5000, 0});
+  RunStats_GetIrq(0, &info);
+  TEST_ASSERT_EQ(0, info.rate);
+  TEST_ASSERT_EQ(2, info.count);
+  TEST_ASSERT_EQ(35, info.load.avg);
+
+  RunStats_Reset();
+  RunStats_GetIrq(0, &info);
+  TEST_ASSERT_EQ(0, info.max_cycles);
+}
+
+/* 寄存器镜像布局与文本报告 */
+static void test_export_format(void)
+{
+  uint16_t regs[RUNSTATS_REG_COUNT + 4];
+  uint16_t *task;
+  uint16_t *irq;
+  uint32_t len;
+
+  setup_tasks();
+  RunStats_SetIrqName(1, "ADC");
+  run_window(10000, (const uint32_t[3]){6000, 3000, 1000});
+
+  memset(regs, 0xFF, sizeof(regs));
+  RunStats_Export(regs, RUNSTATS_REG_COUNT + 4);
+  TEST_ASSERT_EQ(1, regs[0]);
+  TEST_ASSERT_EQ(10, regs[1]);
+  TEST_ASSERT_EQ(400, regs[2]);
+  TEST_ASSERT_EQ(3, regs[6]);
+  TEST_ASSERT_EQ(1, regs[7]);
+
+  task = &regs[RUNSTATS_REG_HEADER_LEN + RUNSTATS_REG_TASK_LEN];
+  TEST_ASSERT_EQ(2, task[0]);
+  TEST_ASSERT_EQ(300, task[1]);
+  TEST_ASSERT_EQ(('A' << 8) | 'p', task[6]);
+  TEST_ASSERT_EQ('p' << 8, task[7]);
+
+  irq = &regs[RUNSTATS_REG_HEADER_LEN + RUNSTATS_MAX_TASKS * RUNSTATS_REG_TASK_LEN +
+              RUNSTATS_REG_IRQ_LEN];
+  TEST_ASSERT_EQ(0, irq[3]);
+  TEST_ASSERT_EQ(0, regs[RUNSTATS_REG_COUNT + 3]);
+
+  len = RunStats_Format(s_text, sizeof(s_text));
+  TEST_ASSERT_EQ(strlen(s_text), len);
+  TEST_ASSERT(strstr(s_text, "cpu 40.0%") != NULL);
+  TEST_ASSERT(strstr(s_text, "Stats") != NULL);
+  TEST_ASSERT(strstr(s_text, "ADC") != NULL);
+
+  TEST_ASSERT_EQ(15, RunStats_Format(s_text, 16));
+  TEST_ASSERT_EQ(15, strlen(s_text));
+}
+
+/* clock_gettime周期源：窗口长度与实际间隔一致 */
+static void test_posix_clock(void)
+{
+  const struct timespec delay = {0, 20000000L};
+  RunStats_Summary_t summary;
+
+  TEST_ASSERT_EQ(1000000000U, RunStats_PortCycleHz());
+  RunStats_Init(RunStats_PortCycles, RunStats_PortCycleHz());
+  runstats_host_set_tasks(NULL, 0);
+  RunStats_Start();
+  nanosleep(&delay, NULL);
+  RunStats_Sample();
+
+  RunStats_GetSummary(&summary);
+  printf("  20 ms sleep -> window %lu ns\n", (unsigned long)summary.window_cycles);
+  TEST_ASSERT(summary.window_cycles >= 20000000U);
+  TEST_ASSERT(summary.window_cycles < 40000000U);
+}
+
+static void *reader(void *arg)
+{
+  uint64_t last = 0;
+  uint32_t *errors = arg;
+
+  for(uint32_t i = 0; i < THREAD_READS; i++)
+  {
+    uint64_t now = RunStats_GetCycles64();
+
+    *errors += (now < last);
+    last = now;
+  }
+
+  return NULL;
+}
+
+/* 多线程并发读取：临界区保证64位扩展不会重复进位或倒退 */
+static void test_posix_concurrent(void)
+{
+  pthread_t threads[THREAD_NUM];
+  uint32_t errors[THREAD_NUM] = {0};
+  uint64_t start;
+  uint64_t end;
+
+  RunStats_Init(RunStats_PortCycles, RunStats_PortCycleHz());
+  start = RunStats_GetCycles64();
+  for(uint32_t i = 0; i < THREAD_NUM; i++)
+  {
+    pthread_create(&threads[i], NULL, reader, &errors[i]);
+  }
+  for(uint32_t i = 0; i < THREAD_NUM; i++)
+  {
+    pthread_join(threads[i], NULL);
+    TEST_ASSERT_EQ(0, errors[i]);
+  }
+  end = RunStats_GetCycles64();
+
+  // 测试耗时远小于一个回绕周期（4.29 s），高位最多进位一次
+  TEST_ASSERT(end > start);
+  TEST_ASSERT(end - start < 0x100000000ULL);
+}
+
+int main(void)
+{
+  TEST_RUN(test_cycles64_wrap);
+  TEST_RUN(test_task_load);
+  TEST_RUN(test_irq);
+  TEST_RUN(test_export_format);
+  TEST_RUN(test_posix_clock);
+  TEST_RUN(test_posix_concurrent);
+
+  return TEST_REPORT();
+}
@@ -0,0 +1,266 @@
+/**
+ * @file    test_spectrum.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   振动频谱分析主机端校验
+ *
+ * @details 参考频谱以double按同一流程（块平均抽取 → 去直流 → 周期Hann窗 → 直接DFT）
+ *          计算，与spectrum.c的单精度FFT结果比较频带RMS、总RMS与峰值；
+ *          另以bin中心频率的正弦检查峰值频率与幅度的物理含义。
+ */
+
+#include "test.h"
+#include "spectrum.h"
+#include <string.h>
+
+#define FS_IN           126262.0
+#define DECIMATION      64
+#define BLOCK_LEN       512
+#define N               SPECTRUM_FFT_SIZE
+/* 512 + 3 * 256个抽取后样本：恰好结束于第4帧 */
+#define DECIM_TOTAL     (N + 3 * SPECTRUM_HOP_SIZE)
+#define INPUT_LEN       (DECIM_TOTAL * DECIMATION)
+
+#define PI_D            3.14159265358979323846
+
+typedef struct
+{
+  double band_rms[SPECTRUM_MAX_BANDS];
+  double total_rms;
+  double peak_freq;
+  double peak_amp;
+} ref_result_t;
+
+static uint16_t s_input[INPUT_LEN];
+static double s_decim[DECIM_TOTAL];
+
+static const Spectrum_Config_t s_config =
+{
+  .sample_rate = (float)FS_IN,
+  .decimation = DECIMATION,
+  .scale = 0.5f,
+  .band_count = 4,
+  .bands =
+  {
+    {10.0f, 100.0f},
+    {100.0f, 300.0f},
+    {300.0f, 600.0f},
+    {600.0f, 980.0f},
+  },
+};
+
+/* 参考实现：对最近N个抽取后样本做直接DFT */
+static void ref_spectrum(const double *x, const Spectrum_Config_t *cfg, ref_result_t *out)
+{
+  static double w[N];
+  static double v[N];
+  double fs = (double)cfg->sample_rate / cfg->decimation;
+  double mean = 0.0;
+  double cg = 0.0;
+  double wp = 0.0;
+  double peak_power = 0.0;
+  uint32_t peak_bin = 0;
+  double band_ms[SPECTRUM_MAX_BANDS] = {0.0};
+  double total_ms = 0.0;
+
+  for(uint32_t n = 0; n < N; n++)
+  {
+    w[n] = 0.5 - 0.5 * cos(2.0 * PI_D * n / N);
+    cg += w[n];
+    wp += w[n] * w[n];
+    mean += x[n];
+  }
+  cg /= N;
+  wp /= N;
+  mean /= N;
+
+  for(uint32_t n = 0; n < N; n++)
+  {
+    v[n] = (x[n] - mean) * w[n];
+  }
+
+  for(uint32_t k = 1; k <= N / 2; k++)
+  {
+    double re = 0.0;
+    double im = 0.0;
+
+    for(uint32_t n = 0; n < N; n++)
+    {
+      double a = 2.0 * PI_D * (double)((k * n) % N) / N;
+      re += v[n] * cos(a);
+      im -= v[n] * sin(a);
+    }
+
+    double power = re * re + im * im;
+    double ms = ((k == N / 2) ? 1.0 : 2.0) * power / ((double)N * N * wp);
+    double freq = k * fs / N;
+
+    total_ms += ms;
+    for(uint32_t b = 0; b < cfg->band_count; b++)
+    {
+      if(freq >= cfg->bands[b].f_low && freq < cfg->bands[b].f_high)
+      {
+        band_ms[b] += ms;
+      }
+    }
+    if(power > peak_power)
+    {
+      peak_power = power;
+      peak_bin = k;
+    }
+  }
+
+  for(uint32_t b = 0; b < SPECTRUM_MAX_BANDS; b++)
+  {
+    out->band_rms[b] = sqrt(band_ms[b]) * cfg->scale;
+  }
+  out->total_rms = sqrt(total_ms) * cfg->scale;
+  out->peak_freq = peak_bin * fs / N;
+  out->peak_amp = 2.0 * sqrt(peak_power) / (N * cg) * cfg->scale;
+}
+
+/* 生成输入并按块平均得到抽取后序列 */
+static void make_input(const double *freq, const double *amp, uint32_t tones, double noise)
+{
+  uint32_t seed = 12345;
+
+  for(uint32_t i = 0; i < INPUT_LEN; i++)
+  {
+    double v = 32768.0;
+
+    for(uint32_t t = 0; t < tones; t++)
+    {
+      v += amp[t] * sin(2.0 * PI_D * freq[t] * i / FS_IN);
+    }
+    v += noise * (((double)(test_rand(&seed) & 0xFFFF) / 65536.0) - 0.5);
+    s_input[i] = (uint16_t)lround(v);
+  }
+
+  for(uint32_t d = 0; d < DECIM_TOTAL; d++)
+  {
+    uint32_t sum = 0;
+
+    for(uint32_t i = 0; i < DECIMATION; i++)
+    {
+      sum += s_input[d * DECIMATION + i];
+    }
+    s_decim[d] = (double)sum / DECIMATION;
+  }
+}
+
+/* 按ADC块喂入，返回产生结果的次数 */
+static uint32_t feed_blocks(Spectrum_Handle_t *spec)
+{
+  uint32_t updates = 0;
+
+  for(uint32_t i = 0; i < INPUT_LEN; i += BLOCK_LEN)
+  {
+    if(Spectrum_Feed(spec, &s_input[i], BLOCK_LEN))
+    {
+      updates++;
+    }
+  }
+
+  return updates;
+}
+
+static void compare(const Spectrum_Result_t *res, const ref_result_t *ref)
+{
+  double tol = 1e-3 * ref->total_rms + 1e-3;
+
+  for(uint32_t b = 0; b < SPECTRUM_MAX_BANDS; b++)
+  {
+    TEST_ASSERT_NEAR(ref->band_rms[b], res->band_rms[b], tol);
+  }
+  TEST_ASSERT_NEAR(ref->total_rms, res->total_rms, tol);
+  TEST_ASSERT_NEAR(ref->peak_freq, res->peak_freq, 1e-2);
+  TEST_ASSERT_NEAR(ref->peak_amp, res->peak_amp, 1e-3 * ref->peak_amp + 1e-3);
+}
+
+static void test_init_args(void)
+{
+  Spectrum_Handle_t spec;
+  Spectrum_Config_t cfg = s_config;
+
+  TEST_ASSERT_EQ(0, Spectrum_Init(&spec, &s_config));
+  TEST_ASSERT_EQ(-1, Spectrum_Init(NULL, &s_config));
+  TEST_ASSERT_EQ(-1, Spectrum_Init(&spec, NULL));
+  cfg.decimation = 0;
+  TEST_ASSERT_EQ(-1, Spectrum_Init(&spec, &cfg));
+  cfg = s_config;
+  cfg.band_count = SPECTRUM_MAX_BANDS + 1;
+  TEST_ASSERT_EQ(-1, Spectrum_Init(&spec, &cfg));
+}
+
+/* bin中心正弦：峰值频率为该bin，幅度为输入幅度乘块平均的sinc衰减 */
+static void test_single_tone(void)
+{
+  static Spectrum_Handle_t spec;
+  Spectrum_Result_t res;
+  ref_result_t ref;
+  double fs = FS_IN / DECIMATION;
+  double f = 50.0 * fs / N;
+  double a = 8000.0;
+  double x = PI_D * f / FS_IN;
+  double sinc = sin(DECIMATION * x) / (DECIMATION * sin(x));
+
+  make_input(&f, &a, 1, 0.0);
+  Spectrum_Init(&spec, &s_config);
+
+  TEST_ASSERT_EQ(4, feed_blocks(&spec));
+  Spectrum_GetResult(&spec, &res);
+  TEST_ASSERT_EQ(4, res.frame_count);
+
+  ref_spectrum(&s_decim[DECIM_TOTAL - N], &s_config, &ref);
+  compare(&res, &ref);
+
+  TEST_ASSERT_NEAR(f, res.peak_freq, 1e-2);
+  TEST_ASSERT_NEAR(a * sinc * s_config.scale, res.peak_amp, 0.01 * a * s_config.scale);
+  // 纯正弦：总RMS = A/sqrt(2)，能量集中在100-300 Hz频带
+  TEST_ASSERT_NEAR(a * sinc * s_config.scale / sqrt(2.0), res.total_rms, 0.01 * a * s_config.scale);
+  TEST_ASSERT(res.band_rms[1] > 0.99 * res.total_rms);
+}
+
+/* 多音加噪声：各频带与参考频谱一致 */
+static void test_multi_tone_noise(void)
+{
+  static Spectrum_Handle_t spec;
+  Spectrum_Result_t res;
+  ref_result_t ref;
+  const double f[] = {47.3, 251.0, 420.5, 777.7};
+  const double a[] = {1500.0, 3000.0, 800.0, 2200.0};
+
+  make_input(f, a, 4, 2000.0);
+  Spectrum_Init(&spec, &s_config);
+
+  TEST_ASSERT_EQ(4, feed_blocks(&spec));
+  Spectrum_GetResult(&spec, &res);
+
+  ref_spectrum(&s_decim[DECIM_TOTAL - N], &s_config, &ref);
+  compare(&res, &ref);
+  TEST_ASSERT(fabs(res.peak_freq - 251.0) < 2.0 * (FS_IN / DECIMATION / N));
+}
+
+/* 常数输入：去直流后各频带为0 */
+static void test_dc_only(void)
+{
+  static Spectrum_Handle_t spec;
+  Spectrum_Result_t res;
+
+  make_input(NULL, NULL, 0, 0.0);
+  Spectrum_Init(&spec, &s_config);
+  feed_blocks(&spec);
+  Spectrum_GetResult(&spec, &res);
+
+  TEST_ASSERT_NEAR(0.0, res.total_rms, 1e-3);
+}
+
+int main(void)
+{
+  TEST_RUN(test_init_args);
+  TEST_RUN(test_single_tone);
+  TEST_RUN(test_multi_tone_noise);
+  TEST_RUN(test_dc_only);
+
+  return TEST_REPORT();
+}
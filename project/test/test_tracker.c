@@ -0,0 +1,307 @@
+/**
+ * @file    test_tracker.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   卡尔曼/alpha-beta跟踪器主机端测试及与MAF/WMAF的滞后、噪声对照
+ *
+ * @details 输入为阶跃/斜坡叠加高斯噪声，对每种滤波器测量：
+ *          - 噪声比：稳态输出标准差 / 输入噪声标准差，与理论值比较
+ *            （MAF 1/sqrt(N)，WMAF线性权重，卡尔曼 sqrt(K/(2-K))，alpha-beta闭式解）
+ *          - 阶跃90%上升样本数（无噪声）
+ *          - 斜坡稳态滞后（无噪声），alpha-beta应无滞后
+ *          卡尔曼Q/R按与N = 16的MAF噪声比相同选取（K = 2/(N+1)），对照在同等降噪下的滞后。
+ */
+
+#include "test.h"
+#include "filter.h"
+#include "tracker.h"
+
+#define PI              3.14159265358979323846
+#define WINDOW          16U
+#define BASE            20000
+#define STEP            4000
+#define NOISE_SIGMA     200.0
+#define SETTLE          2000U
+#define DATA_LEN        (1U << 16)
+
+/* 卡尔曼稳态增益K满足Q/R = K^2/(1-K)；K = 2/17时Q/R = 4/255 */
+#define KALMAN_Q        (4U * 256U)
+#define KALMAN_R        (255U * 256U)
+
+/* alpha-beta：lambda = 0.01 */
+#define AB_Q            256U
+#define AB_R            (10000U * 256U)
+
+typedef struct
+{
+  const char *name;
+  void (*reset)(void);
+  int32_t (*update)(int32_t x);
+} filter_t;
+
+static uint16_t s_maf_buf[WINDOW];
+static uint16_t s_wmaf_buf[WINDOW];
+static MAF_Handle_t s_maf;
+static WMAF_Handle_t s_wmaf;
+static Kalman_Handle_t s_kalman;
+static AlphaBeta_Handle_t s_ab;
+static int32_t s_input[DATA_LEN];
+
+static void maf_reset(void)
+{
+  MAF_Init(&s_maf, s_maf_buf, WINDOW);
+}
+
+static int32_t maf_update(int32_t x)
+{
+  return MAF_Update(&s_maf, (uint16_t)x);
+}
+
+static void wmaf_reset(void)
+{
+  WMAF_Init(&s_wmaf, s_wmaf_buf, WINDOW);
+}
+
+static int32_t wmaf_update(int32_t x)
+{
+  return WMAF_Update(&s_wmaf, (uint16_t)x);
+}
+
+static void kalman_reset(void)
+{
+  Kalman_Init(&s_kalman, KALMAN_Q, KALMAN_R);
+}
+
+static int32_t kalman_update(int32_t x)
+{
+  return Kalman_Update(&s_kalman, x);
+}
+
+static void ab_reset(void)
+{
+  AlphaBeta_Init(&s_ab, AB_Q, AB_R);
+}
+
+static int32_t ab_update(int32_t x)
+{
+  return AlphaBeta_Update(&s_ab, x);
+}
+
+static const filter_t s_filters[] =
+{
+  {"MAF",        maf_reset,    maf_update},
+  {"WMAF",       wmaf_reset,   wmaf_update},
+  {"Kalman",     kalman_reset, kalman_update},
+  {"AlphaBeta",  ab_reset,     ab_update},
+};
+
+#define FILTER_NUM      (sizeof(s_filters) / sizeof(s_filters[0]))
+
+/* Box-Muller高斯噪声 */
+static double gauss(uint32_t *seed)
+{
+  double u1 = (test_rand(seed) + 1.0) / 4294967297.0;
+  double u2 = (test_rand(seed) + 1.0) / 4294967297.0;
+
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * PI * u2);
+}
+
+/* 理论噪声比（输出标准差 / 输入标准差） */
+static double theory_noise(uint32_t f)
+{
+  const double n = WINDOW;
+
+  switch(f)
+  {
+    case 0:
+      return sqrt(1.0 / n);
+    case 1:
+      // 权重1..N：sum(w^2) / sum(w)^2
+      return sqrt(2.0 * (2.0 * n + 1.0) / (3.0 * n * (n + 1.0)));
+    case 2:
+    {
+      double k = 2.0 / (n + 1.0);
+      return sqrt(k / (2.0 - k));
+    }
+    default:
+    {
+      double a = s_ab.alpha / 65536.0;
+      double b = s_ab.beta / 65536.0;
+      return sqrt((2.0 * a * a + 2.0 * b - 3.0 * a * b) / (a * (4.0 - 2.0 * a - b)));
+    }
+  }
+}
+
+/* 稳态噪声：常值加噪声，前SETTLE个样本丢弃 */
+static double measure_noise(const filter_t *f)
+{
+  uint32_t seed = 99;
+  double sum = 0.0;
+  double sum2 = 0.0;
+  const uint32_t n = DATA_LEN - SETTLE;
+
+  f->reset();
+  for(uint32_t i = 0; i < DATA_LEN; i++)
+  {
+    int32_t y = f->update((int32_t)lround(BASE + NOISE_SIGMA * gauss(&seed)));
+
+    if(i >= SETTLE)
+    {
+      sum += y;
+      sum2 += (double)y * y;
+    }
+  }
+
+  return sqrt(sum2 / n - (sum / n) * (sum / n)) / NOISE_SIGMA;
+}
+
+/* 无噪声阶跃：从阶跃起到输出达到90%的样本数 */
+static uint32_t measure_rise(const filter_t *f)
+{
+  f->reset();
+  for(uint32_t i = 0; i < SETTLE; i++)
+  {
+    f->update(BASE);
+  }
+  for(uint32_t i = 1; i < SETTLE; i++)
+  {
+    if(f->update(BASE + STEP) >= BASE + STEP * 9 / 10)
+    {
+      return i;
+    }
+  }
+
+  return SETTLE;
+}
+
+/* 无噪声斜坡（每样本slope）稳态滞后，单位为样本 */
+static double measure_ramp_lag(const filter_t *f, int32_t slope)
+{
+  double lag = 0.0;
+  const uint32_t avg = 256;
+
+  f->reset();
+  for(uint32_t i = 0; i < SETTLE + avg; i++)
+  {
+    int32_t x = BASE + slope * (int32_t)i;
+    int32_t y = f->update(x);
+
+    if(i >= SETTLE)
+    {
+      lag += (double)(x - y) / slope;
+    }
+  }
+
+  return lag / avg;
+}
+
+/* 卡尔曼首样本初值与稳态增益 */
+static void test_kalman_gain(void)
+{
+  const double k = 2.0 / (WINDOW + 1.0);
+  int32_t y = 0;
+
+  kalman_reset();
+  TEST_ASSERT_EQ(BASE, Kalman_Update(&s_kalman, BASE));
+  for(uint32_t i = 0; i < SETTLE; i++)
+  {
+    Kalman_Update(&s_kalman, BASE);
+  }
+
+  // 稳态后单步响应比例即K
+  y = Kalman_Update(&s_kalman, BASE + 10000);
+  TEST_ASSERT_NEAR(k * 10000.0, y - BASE, 2.0);
+}
+
+/* alpha-beta：Kalata增益与斜坡无滞后 */
+static void test_alphabeta_ramp(void)
+{
+  const double lambda = sqrt((double)AB_Q / AB_R);
+  const double s = (4.0 + lambda - sqrt(8.0 * lambda + lambda * lambda)) / 4.0;
+  const double alpha = 1.0 - s * s;
+
+  ab_reset();
+  TEST_ASSERT_NEAR(alpha * 65536.0, s_ab.alpha, 1.0);
+  TEST_ASSERT_NEAR(2.0 * (2.0 - alpha) - 4.0 * sqrt(1.0 - alpha), s_ab.beta / 65536.0, 1e-4);
+  TEST_ASSERT(fabs(measure_ramp_lag(&s_filters[3], 3)) < 0.1);
+}
+
+/* 滞后/噪声对照表，并校验各项与理论一致 */
+static void test_compare(void)
+{
+  const double n = WINDOW;
+  const double k = 2.0 / (n + 1.0);
+  // 斜坡稳态滞后理论值：MAF (N-1)/2，WMAF (N-1)/3，卡尔曼(1-K)/K，alpha-beta 0
+  const double lag_ref[FILTER_NUM] = {(n - 1.0) / 2.0, (n - 1.0) / 3.0, (1.0 - k) / k, 0.0};
+  double noise[FILTER_NUM];
+  uint32_t rise[FILTER_NUM];
+
+  printf("  step %d + N(0, %.0f), window %u, Kalman K = 2/(N+1)\n", STEP, NOISE_SIGMA, WINDOW);
+  printf("  %-10s %10s %10s %10s %10s %10s\n", "filter", "noise", "theory", "rise90",
+         "ramp lag", "theory");
+  for(uint32_t f = 0; f < FILTER_NUM; f++)
+  {
+    double lag = measure_ramp_lag(&s_filters[f], 2);
+    double ref;
+
+    noise[f] = measure_noise(&s_filters[f]);
+    rise[f] = measure_rise(&s_filters[f]);
+    ref = theory_noise(f);
+
+    printf("  %-10s %10.3f %10.3f %10u %10.2f %10.2f\n", s_filters[f].name, noise[f], ref,
+           rise[f], lag, lag_ref[f]);
+    TEST_ASSERT_NEAR(ref, noise[f], ref * 0.1);
+    // MAF/WMAF向下取整引入约0.5/slope的额外滞后
+    TEST_ASSERT_NEAR(lag_ref[f], lag, 0.5);
+  }
+
+  // 同等降噪下，矩形窗阶跃上升快于一阶卡尔曼
+  TEST_ASSERT_NEAR(noise[0], noise[2], noise[0] * 0.1);
+  TEST_ASSERT(rise[0] < rise[2]);
+  TEST_ASSERT(rise[1] < rise[0]);
+}
+
+/* 每样本耗时 */
+static void test_bench(void)
+{
+  uint32_t seed = 7;
+  volatile int32_t sink = 0;
+
+  for(uint32_t i = 0; i < DATA_LEN; i++)
+  {
+    s_input[i] = (int32_t)lround(BASE + NOISE_SIGMA * gauss(&seed));
+  }
+
+  printf("  %-10s %12s\n", "filter", "ns/sample");
+  for(uint32_t f = 0; f < FILTER_NUM; f++)
+  {
+    double best = 1e30;
+
+    for(uint32_t r = 0; r < 5; r++)
+    {
+      uint64_t t0;
+      int32_t acc = 0;
+
+      s_filters[f].reset();
+      t0 = test_now_ns();
+      for(uint32_t i = 0; i < DATA_LEN; i++)
+      {
+        acc += s_filters[f].update(s_input[i]);
+      }
+      best = fmin(best, (double)(test_now_ns() - t0));
+      sink = acc;
+    }
+    printf("  %-10s %12.2f\n", s_filters[f].name, best / DATA_LEN);
+  }
+  (void)sink;
+}
+
+int main(void)
+{
+  TEST_RUN(test_kalman_gain);
+  TEST_RUN(test_alphabeta_ramp);
+  TEST_RUN(test_compare);
+  TEST_RUN(test_bench);
+
+  return TEST_REPORT();
+}
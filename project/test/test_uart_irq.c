@@ -0,0 +1,215 @@
+/**
+ * @file    test_uart_irq.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   串口接收/发送中断次数主机端模型与基准
+ *
+ * @details 按drv_uart.c三种接收方式逐字节推进事件，统计每KB中断次数与溢出字节：
+ *          - 逐字节：RXNE每字节一次中断，接收寄存器只有1字节，中断响应超过一个字符即溢出
+ *          - FIFO：接收FIFO（16字节）达到阈值时中断并读空，帧尾由IDLE中断读取，
+ *            中断响应可延迟到FIFO填满（16 - 阈值 + 1个字符）
+ *          - DMA：循环接收，半传输/传输完成与IDLE各一次中断，每帧IDLE后重启
+ *          发送按HAL行为计：逐字节每字节一次TXE加一次TC；FIFO按阈值8_8每次填16字节加一次TC；
+ *          DMA为半传输、传输完成与串口TC各一次。
+ *
+ *          结论用于board.c中uart1_rs232的配置：9600波特率短报文下FIFO方式的中断次数
+ *          与DMA相同，约为逐字节的1/9，且不占DMA流；中断响应容限由1个字符放宽到5个字符。
+ */
+
+#include "test.h"
+#include <stdbool.h>
+
+#define FIFO_DEPTH          16U
+#define FIFO_THRESHOLD      12U     /**< UART_RXFIFO_THRESHOLD_3_4 */
+#define TX_FIFO_BATCH       16U     /**< UART_TXFIFO_THRESHOLD_8_8：FIFO空时填满 */
+#define DMA_RX_LEN          256U    /**< 与uart2的DMA接收缓冲区相同 */
+#define CHAR_BITS           10U
+#define FRAME_GAP_CHARS     10U     /**< 帧间空闲（大于Modbus T3.5） */
+#define KB                  1024U
+
+/**
+ * @brief 接收方式
+ */
+typedef enum
+{
+  RX_BYTE = 0,
+  RX_FIFO,
+  RX_DMA
+} rx_mode_t;
+
+/**
+ * @brief 模拟结果
+ */
+typedef struct
+{
+  uint32_t bytes;                       /**< 到达字节数 */
+  uint32_t irqs;                        /**< 中断次数 */
+  uint32_t overruns;                    /**< 溢出丢弃的字节数 */
+} rx_result_t;
+
+/**
+ * @brief   模拟接收frames帧、每帧len字节
+ *
+ * @details 中断在触发后latency_ns执行，执行时读空接收寄存器/FIFO（执行时间计为0）；
+ *          已有未执行的中断时新的触发条件合并到同一次中断
+ */
+static rx_result_t rx_simulate(rx_mode_t mode, uint32_t baud, uint32_t len, uint32_t frames,
+                               double latency_ns)
+{
+  double char_ns = 1e9 * CHAR_BITS / (double)baud;
+  uint32_t depth = (mode == RX_BYTE) ? 1U : FIFO_DEPTH;
+  uint32_t threshold = (mode == RX_BYTE) ? 1U : FIFO_THRESHOLD;
+  rx_result_t r = {0, 0, 0};
+  double isr_at = -1.0;
+  uint32_t level = 0;
+  double t = 0.0;
+
+  for(uint32_t f = 0; f < frames; f++)
+  {
+    for(uint32_t k = 0; k < len; k++)
+    {
+      t += char_ns;
+      r.bytes++;
+
+      // 到达前已执行的中断读空FIFO
+      if(isr_at >= 0.0 && isr_at <= t)
+      {
+        level = 0;
+        isr_at = -1.0;
+      }
+
+      if(mode == RX_DMA)
+      {
+        // DMA每字节搬走，半传输/传输完成时中断（每帧重启，计数从帧首开始）
+        if((k + 1U) % (DMA_RX_LEN / 2U) == 0U)
+        {
+          r.irqs++;
+        }
+        continue;
+      }
+
+      if(level == depth)
+      {
+        r.overruns++;
+        continue;
+      }
+      level++;
+      if(level >= threshold && isr_at < 0.0)
+      {
+        isr_at = t + latency_ns;
+        r.irqs++;
+      }
+    }
+
+    // 最后一个字节后一个字符时间置IDLE
+    t += char_ns;
+    if(isr_at >= 0.0 && isr_at <= t)
+    {
+      level = 0;
+      isr_at = -1.0;
+    }
+    if(isr_at < 0.0)
+    {
+      isr_at = t + latency_ns;
+      r.irqs++;
+    }
+    t += (FRAME_GAP_CHARS - 1U) * char_ns;
+  }
+
+  return r;
+}
+
+/* 发送一帧的中断次数 */
+static uint32_t tx_irqs(rx_mode_t mode, uint32_t len)
+{
+  switch(mode)
+  {
+    case RX_BYTE: return len + 1U;
+    case RX_FIFO: return (len + TX_FIFO_BATCH - 1U) / TX_FIFO_BATCH + 1U;
+    default:      return 3U;
+  }
+}
+
+static double per_kb(uint32_t irqs, uint32_t bytes)
+{
+  return (double)irqs * KB / (double)bytes;
+}
+
+/* 零延迟下每帧中断次数与公式一致 */
+static void test_rx_counts(void)
+{
+  static const uint32_t lens[] = {1, 8, 12, 13, 64, 200};
+
+  for(uint32_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++)
+  {
+    uint32_t len = lens[i];
+    rx_result_t byte = rx_simulate(RX_BYTE, 9600, len, 10, 0.0);
+    rx_result_t fifo = rx_simulate(RX_FIFO, 9600, len, 10, 0.0);
+    rx_result_t dma = rx_simulate(RX_DMA, 9600, len, 10, 0.0);
+
+    TEST_ASSERT_EQ(10U * (len + 1U), byte.irqs);
+    TEST_ASSERT_EQ(10U * (len / FIFO_THRESHOLD + 1U), fifo.irqs);
+    TEST_ASSERT_EQ(10U * (len / (DMA_RX_LEN / 2U) + 1U), dma.irqs);
+    TEST_ASSERT_EQ(0, byte.overruns + fifo.overruns + dma.overruns);
+  }
+}
+
+/* 中断响应容限：逐字节超过1个字符溢出，FIFO（阈值12）可延迟到5个字符 */
+static void test_rx_latency(void)
+{
+  const double char_ns = 1e9 * CHAR_BITS / 9600.0;
+  rx_result_t r;
+
+  r = rx_simulate(RX_BYTE, 9600, 64, 10, 0.9 * char_ns);
+  TEST_ASSERT_EQ(0, r.overruns);
+  r = rx_simulate(RX_BYTE, 9600, 64, 10, 1.1 * char_ns);
+  TEST_ASSERT(r.overruns > 0);
+
+  r = rx_simulate(RX_FIFO, 9600, 64, 10, 4.9 * char_ns);
+  TEST_ASSERT_EQ(0, r.overruns);
+  r = rx_simulate(RX_FIFO, 9600, 64, 10, 5.1 * char_ns);
+  TEST_ASSERT(r.overruns > 0);
+}
+
+/* 每KB中断次数：uart1（9600，Modbus RTU短报文）FIFO与DMA相同，约为逐字节的1/9 */
+static void test_irq_per_kb(void)
+{
+  static const uint32_t lens[] = {8, 16, 32, 64, 256};
+  double rx[3];
+  double tx[3];
+
+  printf("  %6s | %-24s | %-24s\n", "frame", "rx irq/KB byte fifo dma", "tx irq/KB byte fifo dma");
+  for(uint32_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++)
+  {
+    uint32_t frames = KB / lens[i] + 1U;
+
+    for(uint32_t m = RX_BYTE; m <= RX_DMA; m++)
+    {
+      rx_result_t r = rx_simulate((rx_mode_t)m, 9600, lens[i], frames, 100000.0);
+
+      TEST_ASSERT_EQ(0, r.overruns);
+      rx[m] = per_kb(r.irqs, r.bytes);
+      tx[m] = per_kb(tx_irqs((rx_mode_t)m, lens[i]) * frames, lens[i] * frames);
+    }
+    printf("  %6lu | %6.0f %6.0f %6.0f     | %6.0f %6.0f %6.0f\n", (unsigned long)lens[i],
+           rx[RX_BYTE], rx[RX_FIFO], rx[RX_DMA], tx[RX_BYTE], tx[RX_FIFO], tx[RX_DMA]);
+
+    if(lens[i] < FIFO_THRESHOLD)
+    {
+      TEST_ASSERT_NEAR(rx[RX_DMA], rx[RX_FIFO], 0.5);
+      TEST_ASSERT(rx[RX_FIFO] * 8.0 < rx[RX_BYTE]);
+    }
+    TEST_ASSERT(rx[RX_FIFO] * 5.0 < rx[RX_BYTE]);
+    TEST_ASSERT(tx[RX_FIFO] * 4.0 < tx[RX_BYTE]);
+  }
+  printf("  (9600 baud, 100 us ISR latency)\n");
+}
+
+int main(void)
+{
+  TEST_RUN(test_rx_counts);
+  TEST_RUN(test_rx_latency);
+  TEST_RUN(test_irq_per_kb);
+
+  return TEST_REPORT();
+}
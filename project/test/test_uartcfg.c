@@ -0,0 +1,146 @@
+/**
+ * @file    test_uartcfg.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   串口描述符校验与编号映射主机端测试
+ *
+ * @details 地址取STM32H750参考手册的外设地址，与drv_uart.c中的实例表顺序相同：
+ *          - 实例地址 → 分发编号，不支持的实例返回-1
+ *          - GPIOA-GPIOK → 0-10，越界、未对齐与空指针返回-1
+ *          - 描述符校验逐项覆盖各失败条件
+ */
+
+#include "test.h"
+#include "uartcfg.h"
+#include <stddef.h>
+
+#define GPIOA_ADDR      0x58020000UL
+#define GPIO_STRIDE     0x400UL
+
+static const uintptr_t s_instances[] =
+{
+  0x40011000UL,   // USART1
+  0x40004400UL,   // USART2
+  0x40004800UL,   // USART3
+  0x40004C00UL,   // UART4
+  0x40005000UL,   // UART5
+  0x40011400UL,   // USART6
+  0x40007800UL,   // UART7
+  0x40007C00UL,   // UART8
+  0x58000C00UL,   // LPUART1
+};
+
+#define INSTANCE_NUM    (sizeof(s_instances) / sizeof(s_instances[0]))
+
+static uint8_t s_dma_buf[64];
+
+/* 实例地址映射 */
+static void test_port_index(void)
+{
+  for(uint32_t i = 0; i < INSTANCE_NUM; i++)
+  {
+    TEST_ASSERT_EQ(i, UartCfg_PortIndex(s_instances[i], s_instances, INSTANCE_NUM));
+  }
+
+  TEST_ASSERT_EQ(-1, UartCfg_PortIndex(0x40011800UL, s_instances, INSTANCE_NUM));   // SPI1
+  TEST_ASSERT_EQ(-1, UartCfg_PortIndex(0, s_instances, INSTANCE_NUM));
+  TEST_ASSERT_EQ(-1, UartCfg_PortIndex(s_instances[0], NULL, INSTANCE_NUM));
+  // 表项数限制查找范围
+  TEST_ASSERT_EQ(-1, UartCfg_PortIndex(s_instances[8], s_instances, 8));
+}
+
+/* GPIO端口编号即RCC->AHB4ENR中的位号 */
+static void test_gpio_index(void)
+{
+  for(uint32_t i = 0; i < UARTCFG_GPIO_PORTS; i++)
+  {
+    TEST_ASSERT_EQ(i, UartCfg_GpioIndex(GPIOA_ADDR + i * GPIO_STRIDE, GPIOA_ADDR, GPIO_STRIDE));
+  }
+
+  TEST_ASSERT_EQ(-1, UartCfg_GpioIndex(GPIOA_ADDR + UARTCFG_GPIO_PORTS * GPIO_STRIDE,
+                                       GPIOA_ADDR, GPIO_STRIDE));
+  TEST_ASSERT_EQ(-1, UartCfg_GpioIndex(GPIOA_ADDR + 0x10U, GPIOA_ADDR, GPIO_STRIDE));
+  TEST_ASSERT_EQ(-1, UartCfg_GpioIndex(GPIOA_ADDR - GPIO_STRIDE, GPIOA_ADDR, GPIO_STRIDE));
+  TEST_ASSERT_EQ(-1, UartCfg_GpioIndex(0, GPIOA_ADDR, GPIO_STRIDE));
+  TEST_ASSERT_EQ(-1, UartCfg_GpioIndex(GPIOA_ADDR, GPIOA_ADDR, 0));
+}
+
+static UartCfg_t valid_cfg(void)
+{
+  UartCfg_t cfg =
+  {
+    .port = 1,
+    .tx_gpio = 0,
+    .rx_gpio = 0,
+    .dma_rx = true,
+    .dma_rx_buf = s_dma_buf,
+    .dma_rx_len = sizeof(s_dma_buf),
+    .rs485 = true,
+    .de_gpio = 0,
+    .de_assert = 16,
+    .de_deassert = 16,
+  };
+
+  return cfg;
+}
+
+/* 描述符校验：每次只破坏一项 */
+static void test_validate(void)
+{
+  UartCfg_t cfg = valid_cfg();
+
+  TEST_ASSERT_EQ(0, UartCfg_Validate(&cfg));
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(NULL));
+
+  cfg = valid_cfg();
+  cfg.port = -1;
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(&cfg));
+
+  cfg = valid_cfg();
+  cfg.tx_gpio = -1;
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(&cfg));
+
+  cfg = valid_cfg();
+  cfg.rx_gpio = -1;
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(&cfg));
+
+  // 接收DMA缓冲区为空或长度为0
+  cfg = valid_cfg();
+  cfg.dma_rx_buf = NULL;
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(&cfg));
+  cfg.dma_rx_len = 0;
+  cfg.dma_rx_buf = s_dma_buf;
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(&cfg));
+
+  // 不使用接收DMA（FIFO或逐字节接收）时不要求缓冲区
+  cfg.dma_rx = false;
+  cfg.dma_rx_buf = NULL;
+  TEST_ASSERT_EQ(0, UartCfg_Validate(&cfg));
+
+  // RS485须有DE端口，不使用RS485时不要求
+  cfg = valid_cfg();
+  cfg.de_gpio = -1;
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(&cfg));
+  cfg.rs485 = false;
+  TEST_ASSERT_EQ(0, UartCfg_Validate(&cfg));
+
+  // 硬件DE时间0-31
+  cfg = valid_cfg();
+  cfg.de_assert = UARTCFG_DE_TIME_MAX;
+  cfg.de_deassert = 0;
+  TEST_ASSERT_EQ(0, UartCfg_Validate(&cfg));
+  cfg.de_assert = UARTCFG_DE_TIME_MAX + 1;
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(&cfg));
+  cfg.de_assert = 0;
+  cfg.de_deassert = UARTCFG_DE_TIME_MAX + 1;
+  TEST_ASSERT_EQ(-1, UartCfg_Validate(&cfg));
+}
+
+int main(void)
+{
+  TEST_RUN(test_port_index);
+  TEST_RUN(test_gpio_index);
+  TEST_RUN(test_validate);
+
+  return TEST_REPORT();
+}
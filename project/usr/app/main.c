@@ -14,10 +14,21 @@
 
 // 中间层
 #include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
 #include "printf.h"     // 开源printf库
+#include "rtos_static.h"
 
 // 组件
-#include "filter.h"
+#include "pipeline.h"
+#include "tracker.h"
+#include "spectrum.h"
+#include "capture.h"
+#include "bench.h"
+#include "runstats.h"
+#include "runstats_port.h"
+#include "stackmon.h"
+#include "mempool.h"
 
 // 设备层
 #include "led.h"
@@ -26,11 +37,15 @@
 
 // 驱动层
 #include "drv_system.h"
+#include "drv_mdma.h"
+#include "drv_dma.h"
 #include "drv_uart.h"
 #include "drv_adc.h"
 #include "board.h"
 
 
+// 创建任务并登记栈大小
+static osThreadId_t AppThreadNew(osThreadFunc_t func, const osThreadAttr_t *attr);
 // LED闪烁任务
 static void BlinkTask(void *argument);
 // Modbus从机任务
@@ -38,31 +53,295 @@ static void Modbus1Task(void *argument);
 static void Modbus2Task(void *argument);
 
 
-// // ADC采样打印任务，包含两级滤波
+// ADC滤波打印任务，按描述符表运行滤波流水线
 static void AdcPrintTask(void *argument);
+// 可写保持寄存器写入通知（滤波流水线、运行时统计命令）
+static void ModbusRegWrite(uint16_t index, uint16_t count, void *arg);
+// 过程量跟踪任务（压力/温度）
+static void ProcessTask(void *argument);
+// 运行时统计任务
+static void StatsTask(void *argument);
+
+/**
+ * @brief 滤波器基准开关：置1时启动后运行一次Bench_Run并打印每样本耗时与校验结果
+ */
+#define APP_BENCH_ENABLE        0
+
+#if APP_BENCH_ENABLE
+// 滤波器基准任务
+static void BenchTask(void *argument);
+RTOS_THREAD_DEFINE(s_bench_task, 512 * 4, MEM_DTCM);
+#endif
+// 振动频谱分析任务
+static void VibrationTask(void *argument);
+// ADC数据块回调（中断上下文）
+static void AdcBlockCallback(adc_desc_t adc, const uint16_t *block, uint16_t len, void *arg);
+// 模拟看门狗告警任务
+static void AlarmTask(void *argument);
+// 模拟看门狗告警回调（中断上下文）
+static void AdcAlarmCallback(adc_desc_t adc, adc_awd_t awd, void *arg);
+// 波形捕获Modbus文件记录接口
+static int CaptureFileRead(uint16_t file, uint16_t record, uint16_t *regs,
+                           uint16_t count, void *arg);
+static int CaptureFileWrite(uint16_t file, uint16_t record, const uint16_t *regs,
+                            uint16_t count, void *arg);
 
 // Modbus从机设备
 static modbus_dev_t g_modbus_1;
 static modbus_dev_t g_modbus_2;
-// Modbus保持寄存器（100个）
-static uint16_t g_modbus_regs[100] = {0};
+// Modbus保持寄存器（地址100-268）
+static uint16_t g_modbus_regs[MODBUS_REG_COUNT] = {0};
+// Modbus输入寄存器（地址100-518）
+static uint16_t g_modbus_input_regs[MODBUS_INPUT_REG_COUNT] = {0};
 
+/**
+ * @brief ADC数据块（中断 → 振动频谱任务、滤波打印任务）
+ * @note  DMA半区只在下一个半周期（约4ms）内有效，中断中提交MDMA复制到内存池块，
+ *        复制完成后才把块指针投递给队列，任务处理完后释放，任务滞后多块也不会读到被覆盖的数据
+ */
+typedef struct
+{
+  adc_desc_t adc;                         /**< 数据来源 */
+  uint16_t len;                           /**< 样本数 */
+  uint8_t consumer;                       /**< 消费者编号 */
+  osMessageQueueId_t queue;               /**< 消费者队列 */
+  mdma_job_t job;                         /**< 复制作业 */
+  uint16_t samples[BOARD_ADC_BLOCK_LEN];  /**< 样本副本 */
+} adc_block_t;
 
-int main(void)
+/**
+ * @brief ADC数据块的消费者（各有一个队列，各自持有块副本）
+ */
+#define ADC_CONSUMER_SPECTRUM   0   /**< 振动频谱任务 */
+#define ADC_CONSUMER_FILTER     1   /**< 滤波打印任务 */
+#define ADC_CONSUMER_NUM        2
+
+// ADC数据块消息队列（振动频谱任务、滤波打印任务各一个，消息为adc_block_t指针）
+static osMessageQueueId_t s_adc_block_queue = NULL;
+static osMessageQueueId_t s_adc_filter_queue = NULL;
+
+#define ADC_BLOCK_QUEUE_LEN     4
+
+/**
+ * @brief ADC数据块内存池：每个消费者队列满时另有一块正在处理
+ */
+#define ADC_BLOCK_POOL_COUNT    (ADC_CONSUMER_NUM * (ADC_BLOCK_QUEUE_LEN + 1))
+
+static MemPool_t s_adc_block_pool;
+static uint64_t s_adc_block_storage[MEMPOOL_STORAGE_SIZE(sizeof(adc_block_t), ADC_BLOCK_POOL_COUNT) /
+                                    sizeof(uint64_t)] MEM_DTCM;
+
+// 队列满或内存池空时丢弃的块数（按消费者），随运行时统计文本报告输出
+static volatile uint32_t s_adc_block_drops[ADC_CONSUMER_NUM];
+
+/**
+ * @brief 任务与消息队列的静态存储
+ * @note  控制块、栈与队列存储区只有CPU访问，全部放入DTCM（零等待、不经cache）
+ */
+RTOS_THREAD_DEFINE(s_blink_task, 128 * 4, MEM_DTCM);
+RTOS_THREAD_DEFINE(s_modbus1_task, 512 * 4, MEM_DTCM);
+RTOS_THREAD_DEFINE(s_modbus2_task, 512 * 4, MEM_DTCM);
+RTOS_THREAD_DEFINE(s_adc_print_task, 512 * 4, MEM_DTCM);
+RTOS_THREAD_DEFINE(s_vibration_task, 512 * 4, MEM_DTCM);
+RTOS_THREAD_DEFINE(s_process_task, 256 * 4, MEM_DTCM);
+RTOS_THREAD_DEFINE(s_stats_task, 384 * 4, MEM_DTCM);
+RTOS_THREAD_DEFINE(s_alarm_task, 128 * 4, MEM_DTCM);
+RTOS_QUEUE_DEFINE(s_adc_block, ADC_BLOCK_QUEUE_LEN, sizeof(adc_block_t *), MEM_DTCM);
+RTOS_QUEUE_DEFINE(s_adc_filter, ADC_BLOCK_QUEUE_LEN, sizeof(adc_block_t *), MEM_DTCM);
+
+/**
+ * @brief 波形捕获参数：ADC1每块512点（约4ms），预触发4块、触发后12块
+ * @note  每槽位16块 × 512点 + 16个头部寄存器 = 8208个文件记录，不超过Modbus上限10000
+ */
+#define CAPTURE_BLOCK_LEN       512
+#define CAPTURE_PRE_BLOCKS      4
+#define CAPTURE_POST_BLOCKS     12
+#define CAPTURE_SLOT_COUNT      4
+#define CAPTURE_STORAGE_LEN     (CAPTURE_SLOT_COUNT * (CAPTURE_PRE_BLOCKS + CAPTURE_POST_BLOCKS) * \
+                                 CAPTURE_BLOCK_LEN)
+
+/**
+ * @brief 波形捕获样本存储（64KB，AXI SRAM）
+ */
+static uint16_t s_capture_storage[CAPTURE_STORAGE_LEN] MEM_AXI;
+
+// ADC1波形捕获（Modbus文件号1-4对应槽位0-3）
+static Capture_Handle_t s_capture;
+
+/**
+ * @brief 模拟看门狗告警位（同时作为线程标志和120寄存器的状态位）
+ */
+#define ALARM_ADC1_TRIP         (1U << 0)   /**< ADC1越限，继电器1已断开 */
+#define ALARM_ADC2_LIMIT        (1U << 1)   /**< ADC2越限 */
+
+/**
+ * @brief 模拟看门狗阈值（码值）与重新使能间隔
+ */
+#define ALARM_ADC1_LOW          0
+#define ALARM_ADC1_HIGH         62000
+#define ALARM_ADC2_LOW          2000
+#define ALARM_ADC2_HIGH         63000
+#define ALARM_REARM_MS          100
+
+// 告警任务句柄，告警回调向其发送线程标志
+static osThreadId_t s_alarm_thread = NULL;
+
+// 滤波打印任务句柄，流水线寄存器写入后向其发送线程标志（bit n → 通道n）
+static osThreadId_t s_adc_filter_thread = NULL;
+
+// 运行时统计任务句柄，统计命令寄存器写入后向其发送线程标志
+static osThreadId_t s_stats_thread = NULL;
+
+/**
+ * @brief 运行时统计窗口长度与命令（268寄存器）
+ */
+#define STATS_PERIOD_MS         1000
+#define STATS_FLAG_CMD          (1U << 0)
+#define STATS_CMD_DUMP          1   /**< 文本报告输出到调试串口 */
+#define STATS_CMD_RESET         2   /**< 清除历史窗口、中断最长时间与串口链路统计 */
+#define STATS_CMD_STACK         3   /**< 栈/堆报告（含建议大小）输出到调试串口 */
+
+// 可写寄存器窗口：流水线描述起至运行时统计命令止
+#define MODBUS_WRITABLE_LEN     (MODBUS_REG_RUNSTATS_CMD + 1 - MODBUS_REG_PIPELINE_1)
+
+/**
+ * @brief 栈溢出故障记录（DTCM .noinit，复位后保留，上电后内容随机，以魔数判断有效）
+ */
+#define STACK_FAULT_MAGIC       0x53544B4FU   /**< "STKO" */
+
+typedef struct
 {
-  // 在系统初始化之前清零 AXI SRAM(D1)
-  memset((void*)0x24000000, 0, 512 * 1024);  // 清零整个 AXI SRAM (512KB)
-  
-  // 清缓冲区
-  memset(Uart1_dma_rx_buf, 0, sizeof(Uart1_dma_rx_buf));
-  memset(Uart2_dma_rx_buf, 0, sizeof(Uart2_dma_rx_buf));
+  uint32_t magic;                       /**< STACK_FAULT_MAGIC表示有记录 */
+  char name[configMAX_TASK_NAME_LEN];   /**< 溢出的任务名 */
+} StackFault_t;
+
+static StackFault_t s_stack_fault MEM_NOINIT;
+
+/**
+ * @brief   检查上次复位前的栈溢出记录
+ *
+ * @details 有记录时交给StackMon（栈/堆报告中输出），导出到输入寄存器514-518
+ *          （[0]为1表示有记录，[1-4]任务名前8个ASCII字符，高字节在前），然后清除魔数
+ *
+ * @param[out]  regs   输出寄存器
+ * @param[in]   count  寄存器数量
+ *
+ * @return  None
+ */
+static void StackFaultCheck(uint16_t *regs, uint16_t count)
+{
+  if(s_stack_fault.magic != STACK_FAULT_MAGIC)
+  {
+    return;
+  }
+
+  s_stack_fault.name[configMAX_TASK_NAME_LEN - 1] = '\0';
+  StackMon_SetOverflow(s_stack_fault.name);
+
+  if(count > 0)
+  {
+    regs[0] = 1;
+  }
+  for(uint16_t k = 0; k < 8 && s_stack_fault.name[k] != '\0' && 1U + k / 2U < count; k++)
+  {
+    regs[1 + k / 2] |= (uint16_t)((uint8_t)s_stack_fault.name[k] << ((k % 2U) ? 0 : 8));
+  }
+
+  s_stack_fault.magic = 0;
+}
 
-  // 系统初始化
+
+/**
+ * @brief   导出启动阶段时间戳
+ *
+ * @details 每阶段2个寄存器（高16位、低16位），为相对DRV_System_Init入口的微秒数，
+ *          顺序同DRV_BootPhase_t：入口、时钟、内存清零、驱动、调度器
+ *
+ * @param[out]  regs   输出寄存器
+ * @param[in]   count  寄存器数量
+ *
+ * @return  None
+ */
+static void BootTimeExport(uint16_t *regs, uint16_t count)
+{
+  for(uint16_t i = 0; i < DRV_BOOT_PHASE_NUM && (uint16_t)(2 * i + 1) < count; i++)
+  {
+    uint32_t us = DRV_System_GetBootTime((DRV_BootPhase_t)i);
+
+    regs[2 * i] = (uint16_t)(us >> 16);
+    regs[2 * i + 1] = (uint16_t)us;
+  }
+}
+
+/**
+ * @brief   导出串口链路统计
+ *
+ * @details 依次为uart1_rs232、uart2_rs485，每个串口UART_STATS_REG_LEN个寄存器，
+ *          uart_stats_t各成员按声明顺序逐个取出，按高16位、低16位展开：收/发字节、帧、
+ *          ORE、FE、NE、PE、覆盖丢弃字节、环形缓冲区峰值
+ *
+ * @param[out]  regs   输出寄存器
+ * @param[in]   count  寄存器数量
+ *
+ * @return  None
+ */
+static void UartStatsExport(uint16_t *regs, uint16_t count)
+{
+  const uart_desc_t ports[] = {uart1_rs232, uart2_rs485};
+
+  for(uint16_t p = 0; p < sizeof(ports) / sizeof(ports[0]); p++)
+  {
+    uart_stats_t stats;
+    uint16_t pos = (uint16_t)(p * UART_STATS_REG_LEN);
+
+    if(uart_get_stats(ports[p], &stats) != 0)
+    {
+      continue;
+    }
+
+    const uint32_t v[] =
+    {
+      stats.rx_bytes, stats.tx_bytes, stats.rx_frames, stats.ore, stats.fe,
+      stats.ne, stats.pe, stats.rx_dropped, stats.rx_peak
+    };
+
+    for(uint16_t i = 0; i < sizeof(v) / sizeof(v[0]) && pos + 1U < count; i++)
+    {
+      regs[pos++] = (uint16_t)(v[i] >> 16);
+      regs[pos++] = (uint16_t)v[i];
+    }
+  }
+}
+
+int main(void)
+{
+  // 系统初始化（含AXI/D2/D3区域变量清零，须为第一步）
   if(DRV_System_Init() != 0)
   {
     DRV_System_ErrorHandler();
   }
 
+  // MDMA异步复制服务
+  if(mdma_init() != 0)
+  {
+    DRV_System_ErrorHandler();
+  }
+
+  // 按请求表分配DMA流，须在外设初始化之前
+  if(dma_init(board_dma_requests, BOARD_DMA_NUM) != 0)
+  {
+    DRV_System_ErrorHandler();
+  }
+
+  // 运行时统计：DWT CYCCNT已在系统初始化中使能，须在启动调度器前初始化
+  RunStats_Init(RunStats_PortCycles, RunStats_PortCycleHz());
+  for(uint8_t i = 0; i < BOARD_IRQ_NUM; i++)
+  {
+    RunStats_SetIrqName(i, board_irq_names[i]);
+  }
+  StackMon_Init();
+  StackFaultCheck(&g_modbus_input_regs[MODBUS_INPUT_REG_FAULT], MODBUS_INPUT_REG_FAULT_LEN);
+
   // 外设初始化
   led_init(led1);
   relay_init(relay1);
@@ -72,20 +351,68 @@ int main(void)
   uart_init(uart1_rs232, Uart1_ringbuf_storage, sizeof(Uart1_ringbuf_storage));
   uart_init(uart2_rs485, Uart2_ringbuf_storage, sizeof(Uart2_ringbuf_storage));
 
-  // 初始化Modbus从机（地址145，寄存器地址100-199）
-  modbus_init(&g_modbus_1, uart1_rs232, 145, g_modbus_regs, 100, 100);
-  modbus_init(&g_modbus_2, uart2_rs485, 145, g_modbus_regs, 100, 100);
+  // 初始化Modbus从机（地址145，寄存器地址100-268）
+  modbus_init(&g_modbus_1, uart1_rs232, 145, g_modbus_regs, MODBUS_REG_COUNT, 100);
+  modbus_init(&g_modbus_2, uart2_rs485, 145, g_modbus_regs, MODBUS_REG_COUNT, 100);
   
   modbus_set_byte_timeout(&g_modbus_1, 250);  //设置字节间超时
   modbus_set_byte_timeout(&g_modbus_2, 250);
   modbus_set_read_timeout(&g_modbus_1, 600);  //设置读总超时
   modbus_set_read_timeout(&g_modbus_2, 600);
 
+  // 初始化ADC1波形捕获：离开窗口（接近量程两端）即触发
+  const Capture_Config_t capture_config =
+  {
+    .storage = s_capture_storage,
+    .block_len = CAPTURE_BLOCK_LEN,
+    .pre_blocks = CAPTURE_PRE_BLOCKS,
+    .post_blocks = CAPTURE_POST_BLOCKS,
+    .slot_count = CAPTURE_SLOT_COUNT,
+  };
+  const Capture_Trigger_t capture_trigger =
+  {
+    .type = CAPTURE_TRIG_WINDOW,
+    .low = 1000,
+    .high = 64000,
+  };
+  if(Capture_Init(&s_capture, &capture_config) != 0)
+  {
+    DRV_System_ErrorHandler();
+  }
+  Capture_SetTrigger(&s_capture, &capture_trigger);
+  modbus_set_file_handler(&g_modbus_1, CaptureFileRead, CaptureFileWrite, &s_capture);
+  modbus_set_file_handler(&g_modbus_2, CaptureFileRead, CaptureFileWrite, &s_capture);
+
+  // 滤波流水线（200-255）、跟踪器参数（256-267）与统计命令（268）寄存器可写，
+  // 写控制寄存器后重新配置流水线
+  modbus_set_write_handler(&g_modbus_1, MODBUS_REG_PIPELINE_1, MODBUS_WRITABLE_LEN,
+                           ModbusRegWrite, NULL);
+  modbus_set_write_handler(&g_modbus_2, MODBUS_REG_PIPELINE_1, MODBUS_WRITABLE_LEN,
+                           ModbusRegWrite, NULL);
+
+  // 运行时统计镜像（输入寄存器100-299）、栈/堆监视镜像（300-435）、启动时间戳（436-445）
+  // 串口链路统计（446-481）、堆区域统计（482-513）与栈溢出记录（514-518）
+  modbus_set_input_regs(&g_modbus_1, g_modbus_input_regs, MODBUS_INPUT_REG_COUNT, 100);
+  modbus_set_input_regs(&g_modbus_2, g_modbus_input_regs, MODBUS_INPUT_REG_COUNT, 100);
+
+  // ADC数据块内存池须在启动DMA之前初始化
+  if(MemPool_Init(&s_adc_block_pool, "AdcBlock", s_adc_block_storage, sizeof(adc_block_t),
+                  ADC_BLOCK_POOL_COUNT) != 0)
+  {
+    DRV_System_ErrorHandler();
+  }
+
   // 初始化ADC
   adc_init(adc1);
   adc_init(adc2);
+
+  // 模拟看门狗须在启动转换前配置
+  adc_awd_config(adc1, ADC_AWD_1, ALARM_ADC1_LOW, ALARM_ADC1_HIGH, AdcAlarmCallback, NULL);
+  adc_awd_config(adc2, ADC_AWD_1, ALARM_ADC2_LOW, ALARM_ADC2_HIGH, AdcAlarmCallback, NULL);
+
   adc_start_dma(adc1);  
   adc_start_dma(adc2);
+  DRV_System_BootMark(DRV_BOOT_DRIVERS);
   
   // 初始化RTOS内核
   osKernelInitialize();
@@ -94,40 +421,107 @@ int main(void)
   const osThreadAttr_t blinkTask_attributes =
   {
     .name = "BlinkTask",
-    .stack_size = 128 * 4,
+    RTOS_THREAD_MEM(s_blink_task),
     .priority = (osPriority_t)osPriorityNormal,
   };
-  osThreadNew(BlinkTask, NULL, &blinkTask_attributes);
+  AppThreadNew(BlinkTask, &blinkTask_attributes);
 
   // 创建Modbus1从机任务
   const osThreadAttr_t modbus1Task_attributes =
   {
     .name = "Modbus1Task",
-    .stack_size = 512 * 4,
+    RTOS_THREAD_MEM(s_modbus1_task),
     .priority = (osPriority_t)osPriorityNormal,
   };
 
-  osThreadNew(Modbus1Task, NULL, &modbus1Task_attributes);
+  AppThreadNew(Modbus1Task, &modbus1Task_attributes);
 
   // 创建Modbus2从机任务
   const osThreadAttr_t modbus2Task_attributes =
   {
     .name = "Modbus2Task",
-    .stack_size = 512 * 4,
+    RTOS_THREAD_MEM(s_modbus2_task),
     .priority = (osPriority_t)osPriorityNormal,
   };
 
-  osThreadNew(Modbus2Task, NULL, &modbus2Task_attributes);
+  AppThreadNew(Modbus2Task, &modbus2Task_attributes);
 
 
-  // 创建ADC打印任务（实时优先级）
+  // 创建ADC滤波打印任务，ADC数据块经消息队列交付
+  const osMessageQueueAttr_t adcFilterQueue_attributes =
+  {
+    .name = "AdcFilterQueue",
+    RTOS_QUEUE_MEM(s_adc_filter),
+  };
+  s_adc_filter_queue = osMessageQueueNew(ADC_BLOCK_QUEUE_LEN, sizeof(adc_block_t *),
+                                         &adcFilterQueue_attributes);
   const osThreadAttr_t adcPrintTask_attributes =
   {
     .name = "AdcPrintTask",
-    .stack_size = 512 * 4,
+    RTOS_THREAD_MEM(s_adc_print_task),
+    .priority = (osPriority_t)osPriorityNormal,
+  };
+  s_adc_filter_thread = AppThreadNew(AdcPrintTask, &adcPrintTask_attributes);
+
+  // 创建振动频谱分析任务，ADC数据块经消息队列交付
+  const osMessageQueueAttr_t adcBlockQueue_attributes =
+  {
+    .name = "AdcBlockQueue",
+    RTOS_QUEUE_MEM(s_adc_block),
+  };
+  s_adc_block_queue = osMessageQueueNew(ADC_BLOCK_QUEUE_LEN, sizeof(adc_block_t *),
+                                        &adcBlockQueue_attributes);
+  const osThreadAttr_t vibrationTask_attributes =
+  {
+    .name = "VibrationTask",
+    RTOS_THREAD_MEM(s_vibration_task),
+    .priority = (osPriority_t)osPriorityAboveNormal,
+  };
+  AppThreadNew(VibrationTask, &vibrationTask_attributes);
+  adc_set_block_callback(adc1, AdcBlockCallback, NULL);
+  adc_set_block_callback(adc2, AdcBlockCallback, NULL);
+
+  // 创建过程量跟踪任务
+  const osThreadAttr_t processTask_attributes =
+  {
+    .name = "ProcessTask",
+    RTOS_THREAD_MEM(s_process_task),
     .priority = (osPriority_t)osPriorityNormal,
   };
-  osThreadNew(AdcPrintTask, NULL, &adcPrintTask_attributes);
+  AppThreadNew(ProcessTask, &processTask_attributes);
+
+  // 创建运行时统计任务
+  const osThreadAttr_t statsTask_attributes =
+  {
+    .name = "StatsTask",
+    RTOS_THREAD_MEM(s_stats_task),
+    .priority = (osPriority_t)osPriorityAboveNormal,
+  };
+  s_stats_thread = AppThreadNew(StatsTask, &statsTask_attributes);
+
+#if APP_BENCH_ENABLE
+  // 创建滤波器基准任务（最低优先级，运行一次后退出）
+  const osThreadAttr_t benchTask_attributes =
+  {
+    .name = "BenchTask",
+    RTOS_THREAD_MEM(s_bench_task),
+    .priority = (osPriority_t)osPriorityLow,
+  };
+  AppThreadNew(BenchTask, &benchTask_attributes);
+#endif
+
+  // 创建模拟看门狗告警任务
+  const osThreadAttr_t alarmTask_attributes =
+  {
+    .name = "AlarmTask",
+    RTOS_THREAD_MEM(s_alarm_task),
+    .priority = (osPriority_t)osPriorityHigh,
+  };
+  s_alarm_thread = AppThreadNew(AlarmTask, &alarmTask_attributes);
+
+  // 启动阶段时间戳（输入寄存器436-445），此后不再变化
+  DRV_System_BootMark(DRV_BOOT_SCHEDULER);
+  BootTimeExport(&g_modbus_input_regs[MODBUS_INPUT_REG_BOOT], MODBUS_INPUT_REG_BOOT_LEN);
 
   // 启动RTOS调度器
   osKernelStart();
@@ -138,6 +532,26 @@ int main(void)
   }
 }
 
+/**
+ * @brief   创建任务并登记栈大小
+ *
+ * @param[in]   func  任务函数
+ * @param[in]   attr  任务属性（stack_size登记到栈监视）
+ *
+ * @return  任务句柄，失败返回NULL
+ */
+static osThreadId_t AppThreadNew(osThreadFunc_t func, const osThreadAttr_t *attr)
+{
+  osThreadId_t thread = osThreadNew(func, NULL, attr);
+
+  if(thread != NULL)
+  {
+    StackMon_SetSize(thread, attr->stack_size);
+  }
+
+  return thread;
+}
+
 /**
  * @brief   LED闪烁任务
  *
@@ -161,7 +575,7 @@ static void BlinkTask(void *argument)
  * @brief   Modbus从机任务
  *
  * @details 循环调用modbus_poll()处理Modbus请求，
- *          主机可通过功能码0x03读取保持寄存器
+ *          主机可通过功能码0x03/0x06/0x10读写保持寄存器
  *
  * @param[in]   argument  任务参数（未使用）
  *
@@ -183,7 +597,7 @@ static void Modbus1Task(void *argument)
  * @brief   Modbus从机任务
  *
  * @details 循环调用modbus_poll()处理Modbus请求，
- *          主机可通过功能码0x03读取保持寄存器
+ *          主机可通过功能码0x03/0x06/0x10读写保持寄存器
  *
  * @param[in]   argument  任务参数（未使用）
  *
@@ -201,40 +615,882 @@ static void Modbus2Task(void *argument)
   }
 }
 
-// 定义ADC滤波器
-static MAF_Handle_t s_adc_filter_1;
-static WMAF_Handle_t s_adc_filter_2;
+/**
+ * @brief ADC采样率(Hz)：50 MHz / (387.5 + 8.5) 周期
+ */
+#define ADC_SAMPLE_RATE_HZ      126262.0f
+
+/**
+ * @brief 滤波流水线寄存器块内偏移（每通道MODBUS_REG_PIPELINE_LEN个）
+ */
+#define PIPE_REG_CTRL           0   /**< 写PIPE_CTRL_APPLY应用级描述，处理后清零 */
+#define PIPE_REG_STATUS         1   /**< 0配置有效，1最近一次配置非法（保持原配置） */
+#define PIPE_REG_OUT_HI         2   /**< 最新输出（int32高16位） */
+#define PIPE_REG_OUT_LO         3   /**< 最新输出（int32低16位） */
+#define PIPE_REG_MEAN           4   /**< 统计级：均值（int16饱和） */
+#define PIPE_REG_MIN            5   /**< 统计级：最小值 */
+#define PIPE_REG_MAX            6   /**< 统计级：最大值 */
+#define PIPE_REG_STD            7   /**< 统计级：标准差 */
+#define PIPE_REG_STAGES         8   /**< 8-27：各级描述（类型、参数0-2） */
+
+#define PIPE_CTRL_APPLY         1
+#define PIPE_CHANNEL_NUM        2
+#define PIPE_STATS_PERIOD_MS    1000
+
+/**
+ * @brief 流水线调试输出开关：置1时每个ADC1数据块打印首个原始样本与流水线最新输出
+ */
+#define APP_PIPELINE_PRINT_ENABLE   0
+
+/**
+ * @brief 默认流水线：CIC 64倍抽取（约1973 Hz）→ 5点中值去尖峰 →
+ *        50 Hz二阶Butterworth低通 → 换算为mV → 统计
+ */
+static const Pipeline_StageDesc_t s_pipeline_default[PIPELINE_MAX_STAGES] =
+{
+  {PIPE_STAGE_CIC,    {3, 64, 1}},
+  {PIPE_STAGE_MEDIAN, {5, 0, 0}},
+  {PIPE_STAGE_IIR,    {PIPE_IIR_LOWPASS | (1U << 8), 50, 71}},
+  {PIPE_STAGE_SCALE,  {0, 3300, 16}},
+  {PIPE_STAGE_STATS,  {0, 0, 0}},
+};
+
+// 每通道一条流水线及其乒乓缓冲区：0 → ADC1，1 → ADC2
+static Pipeline_Handle_t s_pipeline[PIPE_CHANNEL_NUM];
+static int32_t s_pipeline_buf[PIPE_CHANNEL_NUM][2 * BOARD_ADC_BLOCK_LEN];
+static const uint16_t s_pipeline_reg[PIPE_CHANNEL_NUM] =
+{
+  MODBUS_REG_PIPELINE_1,
+  MODBUS_REG_PIPELINE_2,
+};
+
+/**
+ * @brief   int32饱和为int16后按寄存器格式存放
+ */
+static uint16_t PipelineReg16(int32_t value)
+{
+  if(value > INT16_MAX)
+  {
+    value = INT16_MAX;
+  }
+  else if(value < INT16_MIN)
+  {
+    value = INT16_MIN;
+  }
+
+  return (uint16_t)(int16_t)value;
+}
+
+/**
+ * @brief   按寄存器中的级描述重新配置流水线
+ *
+ * @param[in]   ch  通道号
+ *
+ * @return  None
+ */
+static void PipelineApply(uint8_t ch)
+{
+  uint16_t *regs = &g_modbus_regs[s_pipeline_reg[ch]];
+  Pipeline_StageDesc_t desc[PIPELINE_MAX_STAGES];
 
-static void AdcPrintTask(void *argument)
+  for(uint8_t i = 0; i < PIPELINE_MAX_STAGES; i++)
+  {
+    const uint16_t *r = &regs[PIPE_REG_STAGES + i * (1 + PIPELINE_STAGE_PARAMS)];
+
+    desc[i].type = r[0];
+    for(uint8_t k = 0; k < PIPELINE_STAGE_PARAMS; k++)
+    {
+      desc[i].param[k] = r[1 + k];
+    }
+  }
+
+  int ret = Pipeline_Configure(&s_pipeline[ch], desc, PIPELINE_MAX_STAGES);
+
+  regs[PIPE_REG_STATUS] = (ret == 0) ? 0 : 1;
+  regs[PIPE_REG_CTRL] = 0;
+}
+
+/**
+ * @brief   可写保持寄存器写入通知
+ *
+ * @details 运行于Modbus任务上下文，写入覆盖某通道控制寄存器时
+ *          通知滤波打印任务重新配置该通道；写入统计命令寄存器时
+ *          通知运行时统计任务执行命令
+ *
+ * @param[in]   index  起始寄存器索引
+ * @param[in]   count  寄存器数量
+ * @param[in]   arg    用户参数（未使用）
+ *
+ * @return  None
+ */
+static void ModbusRegWrite(uint16_t index, uint16_t count, void *arg)
 {
-  uint16_t *adc_buffer = NULL; /**< ADC DMA缓冲区指针 */
-  uint16_t adcx = 0;           /**< 一级滤波后的ADC值 */
-  uint16_t adcx2 = 0;          /**< 二级滤波后的ADC值 */
+  (void)arg;
+
+  if(MODBUS_REG_RUNSTATS_CMD >= index && MODBUS_REG_RUNSTATS_CMD < index + count &&
+     g_modbus_regs[MODBUS_REG_RUNSTATS_CMD] != 0 && s_stats_thread != NULL)
+  {
+    osThreadFlagsSet(s_stats_thread, STATS_FLAG_CMD);
+  }
+
+  for(uint8_t ch = 0; ch < PIPE_CHANNEL_NUM; ch++)
+  {
+    uint16_t ctrl = s_pipeline_reg[ch] + PIPE_REG_CTRL;
+
+    if(ctrl >= index && ctrl < index + count &&
+       g_modbus_regs[ctrl] == PIPE_CTRL_APPLY && s_adc_filter_thread != NULL)
+    {
+      osThreadFlagsSet(s_adc_filter_thread, 1U << ch);
+    }
+  }
+}
 
-  // uint16_t *adc2_buffer = NULL;
+/**
+ * @brief   ADC滤波打印任务
+ *
+ * @details 每个ADC通道运行一条滤波流水线，级联关系由200-255寄存器中的
+ *          描述符表决定，主机修改描述并向控制寄存器写1即可在线重新配置。
+ *          每块更新输出寄存器，每PIPE_STATS_PERIOD_MS更新一次统计寄存器。
+ *
+ * @param[in]   argument  任务参数（未使用）
+ *
+ * @return  None
+ */
+static void AdcPrintTask(void *argument)
+{
+  adc_block_t *blk;
+  uint32_t stats_tick = osKernelGetTickCount();
 
   (void)argument;
 
-  while(1)
+  // 默认描述写入寄存器镜像，主机可读回当前配置
+  for(uint8_t ch = 0; ch < PIPE_CHANNEL_NUM; ch++)
   {
-     // 获取adc2的值
-    // adc2_buffer = adc_get_dma_buffer(adc2);
-    // printf("adc2: %d\n", adc2_buffer[0]);
+    uint16_t *regs = &g_modbus_regs[s_pipeline_reg[ch] + PIPE_REG_STAGES];
+
+    for(uint8_t i = 0; i < PIPELINE_MAX_STAGES; i++)
+    {
+      regs[0] = s_pipeline_default[i].type;
+      for(uint8_t k = 0; k < PIPELINE_STAGE_PARAMS; k++)
+      {
+        regs[1 + k] = s_pipeline_default[i].param[k];
+      }
+      regs += 1 + PIPELINE_STAGE_PARAMS;
+    }
 
-    //osDelay(1000);
+    Pipeline_Init(&s_pipeline[ch], s_pipeline_buf[ch], BOARD_ADC_BLOCK_LEN, ADC_SAMPLE_RATE_HZ);
+    PipelineApply(ch);
+  }
 
-    // 获取DMA缓冲区数据
-    adc_buffer = adc_get_dma_buffer(adc1);
-    if(adc_buffer == NULL || adc_get_dma_length(adc1) == 0)
+  while(1)
+  {
+    if(osMessageQueueGet(s_adc_filter_queue, &blk, NULL, osWaitForever) != osOK)
     {
       continue;
     }
 
-    // 两级滤波处理：MAF -> WMAF
-    adcx = MAF_Update(&s_adc_filter_1, adc_buffer[0]);
-    adcx2 = WMAF_Update(&s_adc_filter_2, adcx);
+    // 处理主机下发的重新配置
+    uint32_t flags = osThreadFlagsWait((1U << PIPE_CHANNEL_NUM) - 1U, osFlagsWaitAny, 0);
+    if((flags & osFlagsError) == 0)
+    {
+      for(uint8_t ch = 0; ch < PIPE_CHANNEL_NUM; ch++)
+      {
+        if(flags & (1U << ch))
+        {
+          PipelineApply(ch);
+        }
+      }
+    }
 
-    printf("%d, %d, %d\n", adc_buffer[0], adcx, adcx2);
-    osDelay(1);
+    uint8_t ch = (blk->adc == adc1) ? 0 : 1;
+    uint16_t *regs = &g_modbus_regs[s_pipeline_reg[ch]];
+    const int32_t *out = NULL;
+    uint32_t n = Pipeline_Process(&s_pipeline[ch], blk->samples, blk->len, &out);
+
+    if(n > 0)
+    {
+      int32_t last = out[n - 1];
+
+      regs[PIPE_REG_OUT_HI] = (uint16_t)((uint32_t)last >> 16);
+      regs[PIPE_REG_OUT_LO] = (uint16_t)((uint32_t)last & 0xFFFFU);
+#if APP_PIPELINE_PRINT_ENABLE
+      if(ch == 0)
+      {
+        printf("%d, %ld\n", blk->samples[0], (long)last);
+      }
+#endif
+    }
+    MemPool_Free(&s_adc_block_pool, blk);
+
+    if(osKernelGetTickCount() - stats_tick >= PIPE_STATS_PERIOD_MS)
+    {
+      Pipeline_Stats_t stats;
+
+      stats_tick = osKernelGetTickCount();
+      for(uint8_t i = 0; i < PIPE_CHANNEL_NUM; i++)
+      {
+        if(Pipeline_GetStats(&s_pipeline[i], &stats) == 0)
+        {
+          uint16_t *r = &g_modbus_regs[s_pipeline_reg[i]];
+
+          r[PIPE_REG_MEAN] = PipelineReg16(stats.mean);
+          r[PIPE_REG_MIN] = PipelineReg16(stats.min);
+          r[PIPE_REG_MAX] = PipelineReg16(stats.max);
+          r[PIPE_REG_STD] = PipelineReg16(stats.std);
+        }
+      }
+    }
   }
 }
+
+
+/**
+ * @brief 振动传感器换算：16位ADC、3.3V参考、100mV/g
+ *        码值 → g*1000 = 3300mV / 65536 / 100mV/g * 1000
+ */
+#define VIB_COUNTS_TO_MILLI_G   (3300.0f / 65536.0f / 100.0f * 1000.0f)
+
+/**
+ * @brief 振动频谱配置：抽取64倍后约1973 Hz，512点FFT分辨率约3.9 Hz
+ */
+static const Spectrum_Config_t s_vib_config =
+{
+  .sample_rate = ADC_SAMPLE_RATE_HZ,
+  .decimation = 64,
+  .scale = VIB_COUNTS_TO_MILLI_G,
+  .band_count = 4,
+  .bands =
+  {
+    {10.0f, 100.0f},
+    {100.0f, 300.0f},
+    {300.0f, 600.0f},
+    {600.0f, 980.0f},
+  },
+};
+
+// 振动频谱分析器：ADC1 → X轴，ADC2 → Y轴
+static Spectrum_Handle_t s_vib_x;
+static Spectrum_Handle_t s_vib_y;
+
+/**
+ * @brief   ADC数据块复制完成回调
+ *
+ * @details 运行于MDMA中断上下文（块较短时在提交者的DMA中断中调用）。
+ *          把块指针投递给消费者队列，复制出错或队列已满时释放本块并计数
+ *
+ * @param[in]   job  复制作业
+ * @param[in]   arg  数据块
+ *
+ * @return  None
+ */
+static void AdcBlockCopied(mdma_job_t *job, void *arg)
+{
+  adc_block_t *blk = (adc_block_t *)arg;
+  uint8_t consumer = blk->consumer;
+
+  if(job->state != MDMA_JOB_DONE || osMessageQueuePut(blk->queue, &blk, 0, 0) != osOK)
+  {
+    MemPool_Free(&s_adc_block_pool, blk);
+    s_adc_block_drops[consumer]++;
+  }
+}
+
+/**
+ * @brief   复制ADC数据块并投递给一个消费者
+ *
+ * @details 运行于DMA中断上下文。样本由MDMA复制到内存池块，完成回调中投递；
+ *          1KB的块远在下一个半周期（约4ms）覆盖源半区之前复制完毕。
+ *          队列已满或内存池已空时丢弃本块并计数，不复制（超时必须为0）
+ *
+ * @param[in]   queue     消费者队列
+ * @param[in]   consumer  消费者编号（ADC_CONSUMER_xxx）
+ * @param[in]   adc       ADC描述符
+ * @param[in]   block     DMA缓冲区中的数据块
+ * @param[in]   len       样本数
+ *
+ * @return  None
+ */
+static void AdcBlockPost(osMessageQueueId_t queue, uint8_t consumer, adc_desc_t adc,
+                         const uint16_t *block, uint16_t len)
+{
+  adc_block_t *blk = NULL;
+
+  if(len <= BOARD_ADC_BLOCK_LEN && osMessageQueueGetSpace(queue) > 0)
+  {
+    blk = (adc_block_t *)MemPool_Alloc(&s_adc_block_pool);
+  }
+
+  if(blk == NULL)
+  {
+    s_adc_block_drops[consumer]++;
+    return;
+  }
+
+  blk->adc = adc;
+  blk->len = len;
+  blk->consumer = consumer;
+  blk->queue = queue;
+  // 内存池块内容未定义，提交前复位作业状态
+  blk->job.state = MDMA_JOB_IDLE;
+
+  if(mdma_memcpy(&blk->job, blk->samples, block, len * sizeof(uint16_t), AdcBlockCopied, blk) != 0)
+  {
+    MemPool_Free(&s_adc_block_pool, blk);
+    s_adc_block_drops[consumer]++;
+  }
+}
+
+/**
+ * @brief   ADC数据块回调
+ *
+ * @details 运行于DMA中断上下文，把数据块复制给各消费者，FFT与滤波在任务中完成
+ *
+ * @param[in]   adc    ADC描述符
+ * @param[in]   block  数据块指针
+ * @param[in]   len    样本数
+ * @param[in]   arg    用户参数（未使用）
+ *
+ * @return  None
+ */
+static void AdcBlockCallback(adc_desc_t adc, const uint16_t *block, uint16_t len, void *arg)
+{
+  (void)arg;
+
+  // 波形捕获必须在DMA覆盖该半区之前完成拷贝，直接在中断中处理
+  if(adc == adc1 && len == CAPTURE_BLOCK_LEN)
+  {
+    Capture_Feed(&s_capture, block);
+  }
+
+  AdcBlockPost(s_adc_block_queue, ADC_CONSUMER_SPECTRUM, adc, block, len);
+  AdcBlockPost(s_adc_filter_queue, ADC_CONSUMER_FILTER, adc, block, len);
+}
+
+/**
+ * @brief   将频谱结果写入保持寄存器
+ *
+ * @param[in]   result  频谱结果
+ * @param[in]   total   总振动寄存器索引
+ * @param[in]   base    频谱寄存器块起始索引
+ *
+ * @return  None
+ */
+static void VibrationPublish(const Spectrum_Result_t *result, uint16_t total, uint16_t base)
+{
+  uint16_t *regs = &g_modbus_regs[base];
+
+  for(uint32_t i = 0; i < SPECTRUM_MAX_BANDS; i++)
+  {
+    regs[i] = (result->band_rms[i] > 65535.0f) ? 65535U : (uint16_t)result->band_rms[i];
+  }
+  regs[SPECTRUM_MAX_BANDS] = (uint16_t)result->peak_freq;
+  regs[SPECTRUM_MAX_BANDS + 1] = (result->peak_amp > 65535.0f) ? 65535U : (uint16_t)result->peak_amp;
+  g_modbus_regs[total] = (result->total_rms > 65535.0f) ? 65535U : (uint16_t)result->total_rms;
+}
+
+/**
+ * @brief   振动频谱分析任务
+ *
+ * @details 接收ADC数据块，做抽取+50%重叠FFT，
+ *          每产生一帧结果即更新116/117和150-161寄存器
+ *
+ * @param[in]   argument  任务参数（未使用）
+ *
+ * @return  None
+ */
+static void VibrationTask(void *argument)
+{
+  adc_block_t *blk;
+  Spectrum_Result_t result;
+
+  (void)argument;
+
+  Spectrum_Init(&s_vib_x, &s_vib_config);
+  Spectrum_Init(&s_vib_y, &s_vib_config);
+
+  while(1)
+  {
+    if(osMessageQueueGet(s_adc_block_queue, &blk, NULL, osWaitForever) != osOK)
+    {
+      continue;
+    }
+
+    if(blk->adc == adc1 && Spectrum_Feed(&s_vib_x, blk->samples, blk->len))
+    {
+      Spectrum_GetResult(&s_vib_x, &result);
+      VibrationPublish(&result, MODBUS_REG_VIB_X, MODBUS_REG_SPECTRUM_X);
+    }
+    else if(blk->adc == adc2 && Spectrum_Feed(&s_vib_y, blk->samples, blk->len))
+    {
+      Spectrum_GetResult(&s_vib_y, &result);
+      VibrationPublish(&result, MODBUS_REG_VIB_Y, MODBUS_REG_SPECTRUM_Y);
+    }
+    MemPool_Free(&s_adc_block_pool, blk);
+  }
+}
+
+/**
+ * @brief   波形捕获文件读取（Modbus功能码0x14）
+ *
+ * @details 文件号1-CAPTURE_SLOT_COUNT对应捕获槽位，文件布局见Capture_FileRead
+ *
+ * @param[in]   file    文件号
+ * @param[in]   record  起始记录号
+ * @param[out]  regs    输出寄存器
+ * @param[in]   count   寄存器数量
+ * @param[in]   arg     捕获句柄
+ *
+ * @retval  0   成功
+ * @retval  -1  文件或记录不存在
+ */
+static int CaptureFileRead(uint16_t file, uint16_t record, uint16_t *regs,
+                           uint16_t count, void *arg)
+{
+  if(file == 0 || file > CAPTURE_SLOT_COUNT)
+  {
+    return -1;
+  }
+
+  return Capture_FileRead((Capture_Handle_t *)arg, (uint8_t)(file - 1), record, regs, count);
+}
+
+/**
+ * @brief   波形捕获文件写入（Modbus功能码0x15）
+ *
+ * @details 向记录0（槽位状态）写0释放该槽位，其余记录只读
+ *
+ * @param[in]   file    文件号
+ * @param[in]   record  起始记录号
+ * @param[in]   regs    写入的寄存器
+ * @param[in]   count   寄存器数量
+ * @param[in]   arg     捕获句柄
+ *
+ * @retval  0   成功
+ * @retval  -1  文件不存在、记录不可写或槽位未就绪
+ */
+static int CaptureFileWrite(uint16_t file, uint16_t record, const uint16_t *regs,
+                            uint16_t count, void *arg)
+{
+  if(file == 0 || file > CAPTURE_SLOT_COUNT || record != 0 || count != 1 ||
+     regs[0] != CAPTURE_SLOT_FREE)
+  {
+    return -1;
+  }
+
+  return Capture_Release((Capture_Handle_t *)arg, (uint8_t)(file - 1));
+}
+
+/**
+ * @brief   模拟看门狗告警回调
+ *
+ * @details 运行于ADC中断上下文：ADC1越限立即断开继电器1，
+ *          其余处理（锁存寄存器、重新使能）交给告警任务
+ *
+ * @param[in]   adc  ADC描述符
+ * @param[in]   awd  看门狗编号
+ * @param[in]   arg  用户参数（未使用）
+ *
+ * @return  None
+ */
+static void AdcAlarmCallback(adc_desc_t adc, adc_awd_t awd, void *arg)
+{
+  uint32_t flag = (adc == adc1) ? ALARM_ADC1_TRIP : ALARM_ADC2_LIMIT;
+
+  (void)awd;
+  (void)arg;
+
+  if(adc == adc1)
+  {
+    relay_off(relay1);
+  }
+
+  if(s_alarm_thread != NULL)
+  {
+    osThreadFlagsSet(s_alarm_thread, flag);
+  }
+}
+
+/**
+ * @brief   模拟看门狗告警任务
+ *
+ * @details 将告警锁存到120寄存器（主机读取后不自动清除），
+ *          间隔ALARM_REARM_MS后重新使能看门狗，避免持续越限时中断风暴。
+ *          继电器1跳闸后保持断开，需复位恢复。
+ *
+ * @param[in]   argument  任务参数（未使用）
+ *
+ * @return  None
+ */
+static void AlarmTask(void *argument)
+{
+  uint32_t pending = 0;
+
+  (void)argument;
+
+  // 任务创建前发生的告警只锁存在驱动中，先补发一次
+  if(adc_awd_get_status(adc1) != 0)
+  {
+    pending |= ALARM_ADC1_TRIP;
+  }
+  if(adc_awd_get_status(adc2) != 0)
+  {
+    pending |= ALARM_ADC2_LIMIT;
+  }
+  if(pending != 0)
+  {
+    osThreadFlagsSet(osThreadGetId(), pending);
+  }
+
+  while(1)
+  {
+    uint32_t flags = osThreadFlagsWait(ALARM_ADC1_TRIP | ALARM_ADC2_LIMIT,
+                                       osFlagsWaitAny, osWaitForever);
+    if(flags & osFlagsError)
+    {
+      continue;
+    }
+
+    g_modbus_regs[MODBUS_REG_ALARM] |= (uint16_t)flags;
+
+    osDelay(ALARM_REARM_MS);
+    if(flags & ALARM_ADC1_TRIP)
+    {
+      adc_awd_arm(adc1, ADC_AWD_1);
+    }
+    if(flags & ALARM_ADC2_LIMIT)
+    {
+      adc_awd_arm(adc2, ADC_AWD_1);
+    }
+  }
+}
+
+/**
+ * @brief 过程量跟踪周期与模型
+ */
+#define PROCESS_PERIOD_MS       100
+#define PROCESS_MODEL_KALMAN    0   /**< 标量卡尔曼：缓变量，平滑优先 */
+#define PROCESS_MODEL_AB        1   /**< alpha-beta：跟随斜坡无稳态滞后 */
+
+/**
+ * @brief 过程量跟踪器（112-115各一个）
+ */
+typedef struct
+{
+  Kalman_Handle_t kalman;
+  AlphaBeta_Handle_t alpha_beta;
+  uint16_t model;           /**< 当前模型 */
+  uint16_t q;               /**< 当前过程噪声方差，Q8 */
+  uint16_t r;               /**< 当前测量噪声方差 */
+} process_tracker_t;
+
+/**
+ * @brief 跟踪器默认参数（模型、Q(Q8)、R），对应256-267寄存器
+ *        压力：噪声约±2 Psi，卡尔曼；温度：变化平缓但有持续升温，alpha-beta
+ */
+static const uint16_t s_tracker_default[MODBUS_REG_PROCESS_LEN][3] =
+{
+  {PROCESS_MODEL_KALMAN, 64, 400},
+  {PROCESS_MODEL_KALMAN, 64, 400},
+  {PROCESS_MODEL_AB,     1,  25},
+  {PROCESS_MODEL_AB,     1,  25},
+};
+
+static process_tracker_t s_tracker[MODBUS_REG_PROCESS_LEN];
+
+/**
+ * @brief   按寄存器参数初始化或重新调整跟踪器
+ *
+ * @param[in]   trk     跟踪器
+ * @param[in]   params  参数寄存器（模型、Q、R）
+ *
+ * @return  None
+ */
+static void ProcessTune(process_tracker_t *trk, const uint16_t *params)
+{
+  uint16_t model = (params[0] == PROCESS_MODEL_AB) ? PROCESS_MODEL_AB : PROCESS_MODEL_KALMAN;
+  uint32_t r = (uint32_t)params[2] << 8;
+
+  if(model != trk->model)
+  {
+    // 切换模型时从下一个样本重新开始跟踪
+    Kalman_Init(&trk->kalman, params[1], r);
+    AlphaBeta_Init(&trk->alpha_beta, params[1], r);
+  }
+  else if(params[1] != trk->q || params[2] != trk->r)
+  {
+    Kalman_SetNoise(&trk->kalman, params[1], r);
+    AlphaBeta_SetNoise(&trk->alpha_beta, params[1], r);
+  }
+
+  trk->model = model;
+  trk->q = params[1];
+  trk->r = params[2];
+}
+
+/**
+ * @brief   过程量跟踪任务
+ *
+ * @details 每PROCESS_PERIOD_MS读取一次压力/温度原始值，经卡尔曼或alpha-beta
+ *          跟踪后直接写入112-115寄存器。模型与噪声参数取自256-267寄存器，
+ *          主机修改后下一周期生效，无需重启。
+ *
+ * @param[in]   argument  任务参数（未使用）
+ *
+ * @return  None
+ */
+static void ProcessTask(void *argument)
+{
+  uint16_t raw[MODBUS_REG_PROCESS_LEN];
+  uint16_t *params = &g_modbus_regs[MODBUS_REG_TRACKER];
+
+  (void)argument;
+
+  for(uint8_t i = 0; i < MODBUS_REG_PROCESS_LEN; i++)
+  {
+    params[i * 3 + 0] = s_tracker_default[i][0];
+    params[i * 3 + 1] = s_tracker_default[i][1];
+    params[i * 3 + 2] = s_tracker_default[i][2];
+
+    // 以非法模型强制首次初始化
+    s_tracker[i].model = 0xFFFF;
+    ProcessTune(&s_tracker[i], &params[i * 3]);
+  }
+
+  while(1)
+  {
+    modbus_get_process_raw(raw);
+
+    for(uint8_t i = 0; i < MODBUS_REG_PROCESS_LEN; i++)
+    {
+      process_tracker_t *trk = &s_tracker[i];
+      int32_t y;
+
+      ProcessTune(trk, &params[i * 3]);
+      y = (trk->model == PROCESS_MODEL_AB) ? AlphaBeta_Update(&trk->alpha_beta, raw[i])
+                                           : Kalman_Update(&trk->kalman, raw[i]);
+
+      g_modbus_regs[MODBUS_REG_PROCESS + i] = (y < 0) ? 0U : (y > 65535) ? 65535U : (uint16_t)y;
+    }
+
+    osDelay(PROCESS_PERIOD_MS);
+  }
+}
+
+/**
+ * @brief 运行时统计文本报告缓冲区（按需生成，放入D2 SRAM节省DTCM）
+ */
+static char s_stats_text[2048] MEM_D2;
+
+/**
+ * @brief   执行运行时统计命令
+ *
+ * @return  None
+ */
+static void StatsCommand(void)
+{
+  uint16_t cmd = g_modbus_regs[MODBUS_REG_RUNSTATS_CMD];
+
+  if(cmd == STATS_CMD_DUMP)
+  {
+    RunStats_Format(s_stats_text, sizeof(s_stats_text));
+    printf("%s", s_stats_text);
+    printf("adc block drops: spectrum %lu, filter %lu\n",
+           (unsigned long)s_adc_block_drops[ADC_CONSUMER_SPECTRUM],
+           (unsigned long)s_adc_block_drops[ADC_CONSUMER_FILTER]);
+    printf("pipeline truncated: ch1 %lu, ch2 %lu\n",
+           (unsigned long)s_pipeline[0].truncated, (unsigned long)s_pipeline[1].truncated);
+  }
+  else if(cmd == STATS_CMD_RESET)
+  {
+    RunStats_Reset();
+    uart_clear_stats(uart1_rs232);
+    uart_clear_stats(uart2_rs485);
+  }
+  else if(cmd == STATS_CMD_STACK)
+  {
+    StackMon_Format(s_stats_text, sizeof(s_stats_text));
+    printf("%s", s_stats_text);
+  }
+
+  g_modbus_regs[MODBUS_REG_RUNSTATS_CMD] = 0;
+}
+
+/**
+ * @brief   运行时统计任务
+ *
+ * @details 每STATS_PERIOD_MS结束一个统计窗口，计算各任务与中断负载，
+ *          采样各任务栈高水位与堆使用，刷新输入寄存器100-435、串口统计446-481
+ *          与堆区域统计482-513；
+ *          主机向268写命令后立即执行文本转储或清除。
+ *
+ * @param[in]   argument  任务参数（未使用）
+ *
+ * @return  None
+ */
+static void StatsTask(void *argument)
+{
+  uint32_t tick = osKernelGetTickCount();
+
+  (void)argument;
+
+  while(1)
+  {
+    uint32_t elapsed = osKernelGetTickCount() - tick;
+    uint32_t wait = (elapsed < STATS_PERIOD_MS) ? STATS_PERIOD_MS - elapsed : 0;
+    uint32_t flags = osThreadFlagsWait(STATS_FLAG_CMD, osFlagsWaitAny, wait);
+
+    if((flags & osFlagsError) == 0)
+    {
+      StatsCommand();
+      continue;
+    }
+
+    tick += STATS_PERIOD_MS;
+    RunStats_Sample();
+    RunStats_Export(&g_modbus_input_regs[MODBUS_INPUT_REG_RUNSTATS],
+                    MODBUS_INPUT_REG_STACK - MODBUS_INPUT_REG_RUNSTATS);
+    StackMon_Sample();
+    StackMon_Export(&g_modbus_input_regs[MODBUS_INPUT_REG_STACK],
+                    MODBUS_INPUT_REG_BOOT - MODBUS_INPUT_REG_STACK);
+    UartStatsExport(&g_modbus_input_regs[MODBUS_INPUT_REG_UART], MODBUS_INPUT_REG_UART_LEN);
+    StackMon_ExportRegions(&g_modbus_input_regs[MODBUS_INPUT_REG_HEAP], MODBUS_INPUT_REG_HEAP_LEN);
+  }
+}
+
+#if APP_BENCH_ENABLE
+/**
+ * @brief 基准数据缓冲区（AXI SRAM）
+ */
+static uint16_t s_bench_input[BENCH_DATA_LEN] MEM_AXI;
+static int32_t s_bench_work[2 * BENCH_DATA_LEN] MEM_AXI;
+
+/**
+ * @brief   滤波器基准任务
+ *
+ * @details 以DWT周期计数运行全部滤波内核两遍：先使能I/D-Cache，再关闭cache，
+ *          打印每样本周期数、纳秒数、cache加速比与黄金校验结果，随后恢复cache。
+ *          与其他任务并发运行，结果包含被抢占的时间，应在空闲时多次比较；
+ *          关闭cache期间全系统变慢，仅在调试时开启。
+ *
+ * @param[in]   argument  任务参数（未使用）
+ *
+ * @return  None
+ */
+static void BenchTask(void *argument)
+{
+  const Bench_Buffer_t buf = {s_bench_input, s_bench_work};
+  static Bench_Result_t cached[BENCH_KERNEL_NUM];
+  static Bench_Result_t uncached[BENCH_KERNEL_NUM];
+  uint32_t cpu_hz = DRV_System_GetCoreClock();
+
+  (void)argument;
+
+  int failed = Bench_Run(&buf, DRV_System_GetCycles, cached);
+
+  DRV_System_SetCache(false);
+  failed += Bench_Run(&buf, DRV_System_GetCycles, uncached);
+  DRV_System_SetCache(true);
+
+  printf("%-10s %14s %14s %8s\n", "kernel", "cache on", "cache off", "speedup");
+  for(uint32_t i = 0; i < BENCH_KERNEL_NUM; i++)
+  {
+    printf("%-10s %6lu cyc/smp %6lu cyc/smp %7.2fx %8.2f ns/sample %s\n", cached[i].name,
+           (unsigned long)(cached[i].cycles / cached[i].samples),
+           (unsigned long)(uncached[i].cycles / uncached[i].samples),
+           (double)uncached[i].cycles / (double)cached[i].cycles,
+           Bench_NsPerSample(&cached[i], cpu_hz),
+           (cached[i].pass && uncached[i].pass) ? "PASS" : "FAIL");
+  }
+  printf("bench: %d failed\n", failed);
+
+  osThreadExit();
+}
+#endif
+
+/**
+ * @brief   任务栈溢出钩子（configCHECK_FOR_STACK_OVERFLOW = 2）
+ *
+ * @details 在任务切换时检测到栈指针越界或栈底标记被改写时调用，
+ *          此时栈已损坏，不再尝试恢复。调试串口为阻塞发送，不能在此输出，
+ *          只将任务名写入.noinit故障记录后关中断停机，复位后由StackFaultCheck()报告
+ *
+ * @param[in]   xTask       溢出的任务句柄
+ * @param[in]   pcTaskName  溢出的任务名
+ *
+ * @return  None
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+  uint32_t i = 0;
+
+  (void)xTask;
+
+  // 任务切换中调用，已屏蔽可管理优先级的中断；停机前DRV_System_ErrorHandler()关全部中断
+  for(; pcTaskName != NULL && i < configMAX_TASK_NAME_LEN - 1U && pcTaskName[i] != '\0'; i++)
+  {
+    s_stack_fault.name[i] = pcTaskName[i];
+  }
+  s_stack_fault.name[i] = '\0';
+  s_stack_fault.magic = STACK_FAULT_MAGIC;
+
+  DRV_System_ErrorHandler();
+}
+
+/**
+ * @brief   内存分配失败钩子（configUSE_MALLOC_FAILED_HOOK = 1）
+ *
+ * @details 任务、队列均静态分配，正常运行不使用堆；
+ *          进入此处说明有对象未经rtos_static.h定义，输出当前与历史最小剩余后停机
+ *
+ * @return  None
+ */
+void vApplicationMallocFailedHook(void)
+{
+  printf("malloc failed: free %lu, min %lu\n", (unsigned long)xPortGetFreeHeapSize(),
+         (unsigned long)xPortGetMinimumEverFreeHeapSize());
+  DRV_System_ErrorHandler();
+}
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/**
+ * @brief IDLE与定时器任务的静态存储（大小与内核配置一致）
+ */
+RTOS_THREAD_DEFINE(s_idle_task, configMINIMAL_STACK_SIZE * sizeof(StackType_t), MEM_DTCM);
+RTOS_THREAD_DEFINE(s_timer_task, configTIMER_TASK_STACK_DEPTH * sizeof(StackType_t), MEM_DTCM);
+
+/**
+ * @brief   提供IDLE任务内存（configSUPPORT_STATIC_ALLOCATION = 1）
+ *
+ * @param[out]  ppxIdleTaskTCBBuffer    控制块
+ * @param[out]  ppxIdleTaskStackBuffer  栈
+ * @param[out]  pulIdleTaskStackSize    栈深度（字）
+ *
+ * @return  None
+ */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+  *ppxIdleTaskTCBBuffer = &s_idle_task_tcb;
+  *ppxIdleTaskStackBuffer = RTOS_THREAD_STACK(s_idle_task);
+  *pulIdleTaskStackSize = RTOS_THREAD_DEPTH(s_idle_task);
+}
+
+/**
+ * @brief   提供定时器任务内存（configSUPPORT_STATIC_ALLOCATION = 1）
+ *
+ * @param[out]  ppxTimerTaskTCBBuffer    控制块
+ * @param[out]  ppxTimerTaskStackBuffer  栈
+ * @param[out]  pulTimerTaskStackSize    栈深度（字）
+ *
+ * @return  None
+ */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+  *ppxTimerTaskTCBBuffer = &s_timer_task_tcb;
+  *ppxTimerTaskStackBuffer = RTOS_THREAD_STACK(s_timer_task);
+  *pulTimerTaskStackSize = RTOS_THREAD_DEPTH(s_timer_task);
+}
+#endif
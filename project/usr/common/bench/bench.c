@@ -0,0 +1,357 @@
+/**
+ * @file    bench.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   滤波器性能基准与黄金校验实现
+ *
+ * @details 每个内核先初始化（不计时），再对整段数据调用一次块处理接口（计时），
+ *          逐样本接口则在计时区内循环调用。输入转换等准备工作不计入耗时。
+ */
+
+#include "bench.h"
+#include <stddef.h>
+
+#include "filter.h"
+#include "median.h"
+#include "biquad.h"
+#include "cic.h"
+#include "tracker.h"
+#include "pipeline.h"
+
+/* ==================== 参数 ==================== */
+
+#define BENCH_SAMPLE_RATE       126262.0f
+#define BENCH_MAF_WINDOW        16
+#define BENCH_MEDIAN_WINDOW     15
+#define BENCH_PIPELINE_BLOCK    512
+
+/**
+ * @brief 黄金校验和（与BENCH_DATA_LEN和下列参数绑定，修改内核行为后须重新生成）
+ */
+static const uint32_t s_golden[BENCH_KERNEL_NUM] =
+{
+  0x5F8F3C7DU,  /* MAF */
+  0x09735F67U,  /* WMAF */
+  0xCA265DE9U,  /* Median */
+  0xF2D00D41U,  /* Hampel */
+  0xD090C62FU,  /* BiquadQ15 */
+  0x4586BD1EU,  /* BiquadQ31 */
+  0x813E00C2U,  /* CIC */
+  0x786DC45BU,  /* Kalman */
+  0xE52DC6DAU,  /* AlphaBeta */
+  0xFBF9D19FU,  /* Pipeline */
+};
+
+/* 默认流水线：与应用层一致 */
+static const Pipeline_StageDesc_t s_bench_pipeline[PIPELINE_MAX_STAGES] =
+{
+  {PIPE_STAGE_CIC,    {3, 64, 1}},
+  {PIPE_STAGE_MEDIAN, {5, 0, 0}},
+  {PIPE_STAGE_IIR,    {PIPE_IIR_LOWPASS | (1U << 8), 50, 71}},
+  {PIPE_STAGE_SCALE,  {0, 3300, 16}},
+  {PIPE_STAGE_STATS,  {0, 0, 0}},
+};
+
+/* 滤波器实例与窗口（静态分配，避免占用调用任务的栈） */
+static MAF_Handle_t s_maf;
+static WMAF_Handle_t s_wmaf;
+static Median_Handle_t s_median;
+static Hampel_Handle_t s_hampel;
+static BiquadQ15_Handle_t s_iir_q15;
+static BiquadQ31_Handle_t s_iir_q31;
+static CIC_Handle_t s_cic;
+static Kalman_Handle_t s_kalman;
+static AlphaBeta_Handle_t s_alpha_beta;
+static Pipeline_Handle_t s_pipeline;
+
+static uint16_t s_maf_buf[BENCH_MAF_WINDOW];
+static uint16_t s_wmaf_buf[BENCH_MAF_WINDOW];
+static uint16_t s_median_work[MEDIAN_WORK_LEN(BENCH_MEDIAN_WINDOW)];
+static uint16_t s_hampel_work[HAMPEL_WORK_LEN(BENCH_MEDIAN_WINDOW)];
+static int32_t s_pipeline_buf[2 * BENCH_PIPELINE_BLOCK];
+
+/* ==================== 工具函数 ==================== */
+
+void Bench_Generate(uint16_t *data, uint32_t len)
+{
+  uint32_t seed = 12345U;
+
+  if(data == NULL)
+  {
+    return;
+  }
+
+  for(uint32_t i = 0; i < len; i++)
+  {
+    int32_t phase = (int32_t)(i % 1000U);
+    int32_t tri = (phase < 500) ? (phase * 48 - 12000) : (12000 - (phase - 500) * 48);
+    int32_t x;
+
+    seed = seed * 1664525U + 1013904223U;
+    x = 32768 + tri + (int32_t)(seed >> 22) - 512;
+    if(i % 997U == 0U)
+    {
+      x += 20000;
+    }
+
+    data[i] = (x > 65535) ? 65535U : (x < 0) ? 0U : (uint16_t)x;
+  }
+}
+
+/**
+ * @brief   FNV-1a校验和，按小端累加value的低bytes个字节
+ */
+static uint32_t Bench_Hash(uint32_t hash, uint32_t value, uint8_t bytes)
+{
+  for(uint8_t i = 0; i < bytes; i++)
+  {
+    hash ^= (value >> (8U * i)) & 0xFFU;
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+static uint32_t Bench_HashU16(const uint16_t *data, uint32_t n)
+{
+  uint32_t hash = 2166136261U;
+
+  for(uint32_t i = 0; i < n; i++)
+  {
+    hash = Bench_Hash(hash, data[i], 2);
+  }
+
+  return hash;
+}
+
+static uint32_t Bench_HashS32(const int32_t *data, uint32_t n)
+{
+  uint32_t hash = 2166136261U;
+
+  for(uint32_t i = 0; i < n; i++)
+  {
+    hash = Bench_Hash(hash, (uint32_t)data[i], 4);
+  }
+
+  return hash;
+}
+
+/**
+ * @brief   4阶Butterworth低通（5 kHz），两节级联
+ */
+static void Bench_DesignIir(Biquad_Design_t design[2])
+{
+  Biquad_DesignLowPass(&design[0], BENCH_SAMPLE_RATE, 5000.0, 0.5412);
+  Biquad_DesignLowPass(&design[1], BENCH_SAMPLE_RATE, 5000.0, 1.3066);
+}
+
+/* ==================== 基准 ==================== */
+
+int Bench_RunData(const Bench_Buffer_t *buf, uint32_t len, Bench_CycleFn_t cycles,
+                  Bench_Result_t *results)
+{
+  const uint16_t *in;
+  uint16_t *out16;
+  int16_t *io16;
+  int32_t *in32;
+  int32_t *out32;
+  Biquad_Design_t design[2];
+  uint32_t start;
+  uint32_t n;
+
+  if(buf == NULL || buf->input == NULL || buf->work == NULL || cycles == NULL ||
+     results == NULL || len == 0)
+  {
+    return -1;
+  }
+
+  in = buf->input;
+  in32 = buf->work;
+  out32 = buf->work + len;
+  out16 = (uint16_t *)out32;
+  io16 = (int16_t *)out32;
+
+  for(uint32_t i = 0; i < len; i++)
+  {
+    in32[i] = (int32_t)in[i] - 32768;
+  }
+  Bench_DesignIir(design);
+
+  // MAF
+  if(MAF_Init(&s_maf, s_maf_buf, BENCH_MAF_WINDOW) != 0)
+  {
+    return -1;
+  }
+  start = cycles();
+  MAF_Process(&s_maf, in, out16, len);
+  results[0].cycles = cycles() - start;
+  results[0].name = "MAF";
+  results[0].samples = len;
+  results[0].checksum = Bench_HashU16(out16, len);
+
+  // WMAF
+  if(WMAF_Init(&s_wmaf, s_wmaf_buf, BENCH_MAF_WINDOW) != 0)
+  {
+    return -1;
+  }
+  start = cycles();
+  WMAF_Process(&s_wmaf, in, out16, len);
+  results[1].cycles = cycles() - start;
+  results[1].name = "WMAF";
+  results[1].samples = len;
+  results[1].checksum = Bench_HashU16(out16, len);
+
+  // 中值
+  Median_Init(&s_median, s_median_work, BENCH_MEDIAN_WINDOW);
+  start = cycles();
+  Median_Process(&s_median, in, out16, len);
+  results[2].cycles = cycles() - start;
+  results[2].name = "Median";
+  results[2].samples = len;
+  results[2].checksum = Bench_HashU16(out16, len);
+
+  // Hampel（k = 3.0）
+  Hampel_Init(&s_hampel, s_hampel_work, BENCH_MEDIAN_WINDOW, 768);
+  start = cycles();
+  Hampel_Process(&s_hampel, in, out16, len);
+  results[3].cycles = cycles() - start;
+  results[3].name = "Hampel";
+  results[3].samples = len;
+  results[3].checksum = Bench_HashU16(out16, len);
+
+  // Q15双二阶（DF1，原位处理）
+  for(uint32_t i = 0; i < len; i++)
+  {
+    io16[i] = (int16_t)in32[i];
+  }
+  BiquadQ15_Init(&s_iir_q15, BIQUAD_DF1, design, 2);
+  start = cycles();
+  BiquadQ15_Process(&s_iir_q15, io16, io16, len);
+  results[4].cycles = cycles() - start;
+  results[4].name = "BiquadQ15";
+  results[4].samples = len;
+  results[4].checksum = Bench_HashU16((const uint16_t *)io16, len);
+
+  // Q31双二阶（DF2T，输入左移8位）
+  for(uint32_t i = 0; i < len; i++)
+  {
+    out32[i] = in32[i] * 256;
+  }
+  BiquadQ31_Init(&s_iir_q31, BIQUAD_DF2T, design, 2);
+  start = cycles();
+  BiquadQ31_Process(&s_iir_q31, out32, out32, len);
+  results[5].cycles = cycles() - start;
+  results[5].name = "BiquadQ31";
+  results[5].samples = len;
+  results[5].checksum = Bench_HashS32(out32, len);
+
+  // CIC（3级，64倍抽取，带补偿）
+  CIC_Init(&s_cic, 3, 64, true);
+  start = cycles();
+  n = CIC_Process(&s_cic, in, len, out32);
+  results[6].cycles = cycles() - start;
+  results[6].name = "CIC";
+  results[6].samples = len;
+  results[6].checksum = Bench_HashS32(out32, n);
+
+  // 卡尔曼
+  Kalman_Init(&s_kalman, 64, 400U << 8);
+  start = cycles();
+  for(uint32_t i = 0; i < len; i++)
+  {
+    out32[i] = Kalman_Update(&s_kalman, in32[i]);
+  }
+  results[7].cycles = cycles() - start;
+  results[7].name = "Kalman";
+  results[7].samples = len;
+  results[7].checksum = Bench_HashS32(out32, len);
+
+  // alpha-beta
+  AlphaBeta_Init(&s_alpha_beta, 1, 25U << 8);
+  start = cycles();
+  for(uint32_t i = 0; i < len; i++)
+  {
+    out32[i] = AlphaBeta_Update(&s_alpha_beta, in32[i]);
+  }
+  results[8].cycles = cycles() - start;
+  results[8].name = "AlphaBeta";
+  results[8].samples = len;
+  results[8].checksum = Bench_HashS32(out32, len);
+
+  // 流水线（按块处理，校验和覆盖全部输出与统计结果）
+  {
+    Pipeline_Stats_t stats = {0};
+    uint32_t hash = 2166136261U;
+    uint32_t total = 0;
+
+    Pipeline_Init(&s_pipeline, s_pipeline_buf, BENCH_PIPELINE_BLOCK, BENCH_SAMPLE_RATE);
+    Pipeline_Configure(&s_pipeline, s_bench_pipeline, PIPELINE_MAX_STAGES);
+    for(uint32_t i = 0; i < len; i += BENCH_PIPELINE_BLOCK)
+    {
+      uint32_t block = (len - i < BENCH_PIPELINE_BLOCK) ? len - i : BENCH_PIPELINE_BLOCK;
+      const int32_t *out = NULL;
+
+      start = cycles();
+      n = Pipeline_Process(&s_pipeline, &in[i], block, &out);
+      total += cycles() - start;
+      for(uint32_t k = 0; k < n; k++)
+      {
+        hash = Bench_Hash(hash, (uint32_t)out[k], 4);
+      }
+    }
+    Pipeline_GetStats(&s_pipeline, &stats);
+    hash = Bench_Hash(hash, (uint32_t)stats.mean, 4);
+    hash = Bench_Hash(hash, (uint32_t)stats.std, 4);
+
+    results[9].cycles = total;
+    results[9].name = "Pipeline";
+    results[9].samples = len;
+    results[9].checksum = hash;
+  }
+
+  for(uint32_t i = 0; i < BENCH_KERNEL_NUM; i++)
+  {
+    results[i].golden = 0;
+    results[i].pass = true;
+  }
+
+  return 0;
+}
+
+int Bench_Run(const Bench_Buffer_t *buf, Bench_CycleFn_t cycles, Bench_Result_t *results)
+{
+  int failed = 0;
+
+  if(buf == NULL || buf->input == NULL)
+  {
+    return -1;
+  }
+
+  Bench_Generate(buf->input, BENCH_DATA_LEN);
+  if(Bench_RunData(buf, BENCH_DATA_LEN, cycles, results) != 0)
+  {
+    return -1;
+  }
+
+  for(uint32_t i = 0; i < BENCH_KERNEL_NUM; i++)
+  {
+    results[i].golden = s_golden[i];
+    results[i].pass = (results[i].checksum == s_golden[i]);
+    if(!results[i].pass)
+    {
+      failed++;
+    }
+  }
+
+  return failed;
+}
+
+float Bench_NsPerSample(const Bench_Result_t *result, uint32_t cpu_hz)
+{
+  if(result == NULL || result->samples == 0 || cpu_hz == 0)
+  {
+    return 0.0f;
+  }
+
+  return (float)result->cycles * 1.0e9f / (float)cpu_hz / (float)result->samples;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file    bench.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   滤波器性能基准与黄金校验
+ *
+ * @details 以固定种子生成BENCH_DATA_LEN点合成ADC数据（三角波 + 伪随机噪声 + 周期尖峰），
+ *          依次运行common/filter下的各个内核（含流水线统计级），记录周期数，
+ *          并将输出的FNV-1a校验和与预存的黄金值比对。
+ *          Bench_RunData()对调用者提供的任意长度数据（更长的合成数据或录制数据）
+ *          运行同一组内核，只测耗时与校验和，不比对黄金值。
+ *          周期计数函数由调用者提供：目标板使用DWT CYCCNT，主机可用clock_gettime换算，
+ *          因此同一份源码可在两端运行并比较结果。
+ *          仅依赖标准C库，无硬件依赖。
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 合成数据长度（样本数），黄金校验和基于该长度
+ */
+#define BENCH_DATA_LEN          4096
+
+/**
+ * @brief 基准内核数量
+ */
+#define BENCH_KERNEL_NUM        10
+
+/**
+ * @brief 周期计数函数（32位回绕，单个内核耗时须小于一个回绕周期）
+ */
+typedef uint32_t (*Bench_CycleFn_t)(void);
+
+/**
+ * @brief 基准缓冲区（由调用者分配，建议放在AXI SRAM）
+ */
+typedef struct
+{
+  uint16_t *input;                      /**< 输入，Bench_Run为BENCH_DATA_LEN个，Bench_RunData为len个 */
+  int32_t *work;                        /**< 工作区，输入样本数的2倍 */
+} Bench_Buffer_t;
+
+/**
+ * @brief 单个内核的测量结果
+ */
+typedef struct
+{
+  const char *name;                     /**< 内核名称 */
+  uint32_t samples;                     /**< 输入样本数 */
+  uint32_t cycles;                      /**< 总周期数 */
+  uint32_t checksum;                    /**< 输出校验和 */
+  uint32_t golden;                      /**< 黄金校验和 */
+  bool pass;                            /**< 校验是否通过 */
+} Bench_Result_t;
+
+/**
+ * @brief   生成合成ADC数据（三角波 + 伪随机噪声 + 周期尖峰，固定种子）
+ *
+ * @param[out]  data  输出
+ * @param[in]   len   样本数，前BENCH_DATA_LEN个即黄金校验所用数据
+ *
+ * @return  None
+ */
+void Bench_Generate(uint16_t *data, uint32_t len);
+
+/**
+ * @brief   对给定数据运行全部基准（不比对黄金值）
+ *
+ * @param[in]   buf       缓冲区，input已填入len个样本
+ * @param[in]   len       样本数
+ * @param[in]   cycles    周期计数函数
+ * @param[out]  results   结果数组，至少BENCH_KERNEL_NUM个，golden为0、pass为true
+ *
+ * @return  0成功，-1表示参数错误
+ */
+int Bench_RunData(const Bench_Buffer_t *buf, uint32_t len, Bench_CycleFn_t cycles,
+                  Bench_Result_t *results);
+
+/**
+ * @brief   运行全部基准（BENCH_DATA_LEN点合成数据，比对黄金值）
+ *
+ * @param[in]   buf       缓冲区
+ * @param[in]   cycles    周期计数函数
+ * @param[out]  results   结果数组，至少BENCH_KERNEL_NUM个
+ *
+ * @return  校验失败的内核数，-1表示参数错误
+ */
+int Bench_Run(const Bench_Buffer_t *buf, Bench_CycleFn_t cycles, Bench_Result_t *results);
+
+/**
+ * @brief   换算每样本耗时
+ *
+ * @param[in]   result  测量结果
+ * @param[in]   cpu_hz  周期计数频率(Hz)
+ *
+ * @return  每样本纳秒数
+ */
+float Bench_NsPerSample(const Bench_Result_t *result, uint32_t cpu_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_H */
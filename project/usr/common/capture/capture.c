@@ -0,0 +1,402 @@
+/**
+ * @file    capture.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   触发式波形捕获模块实现
+ *
+ * @details 每个槽位是一个(pre+post)块的环：
+ *          - 未触发时循环覆盖，始终保留最近的数据块作为预触发历史
+ *          - 触发块记为第1个触发后块，再写入post-1块后环中恰好是
+ *            pre块历史 + post块触发后数据，此时下一个写位置即最旧块
+ *          槽位状态转换各由唯一一方完成，无需关中断：
+ *          FREE→FILLING→READY由Capture_Feed（中断）完成，READY→FREE由任务完成。
+ *          记录信息在触发时写入，冻结时只修改状态。
+ *          记录与待生效触发条件不是volatile，发布方在置状态/标志前、读取方在确认
+ *          状态/标志后各加一道屏障，防止编译器将数据访问移过标志。
+ */
+
+#include "capture.h"
+#include <string.h>
+
+/**
+ * @brief 发布/读取屏障：ARM上为DMB（同时是编译器屏障），主机端只阻止编译器重排
+ */
+#if defined(__CC_ARM)
+#define CAPTURE_BARRIER()       __dmb(0xF)
+#elif defined(__arm__)
+#define CAPTURE_BARRIER()       __asm volatile("dmb" ::: "memory")
+#else
+#define CAPTURE_BARRIER()       __asm volatile("" ::: "memory")
+#endif
+
+/**
+ * @brief   拷贝数据块并检测触发
+ *
+ * @param[in]   trig  触发条件
+ * @param[in]   prev  上一个样本
+ * @param[in]   src   源数据块
+ * @param[out]  dst   目标存储
+ * @param[in]   len   样本数
+ *
+ * @return  首个触发样本的位置，未触发返回-1
+ */
+static int32_t Capture_Scan(const Capture_Trigger_t *trig, uint16_t prev,
+                            const uint16_t *src, uint16_t *dst, uint16_t len)
+{
+  const bool rising = (trig->edge != CAPTURE_EDGE_FALLING);
+  const bool falling = (trig->edge != CAPTURE_EDGE_RISING);
+  uint32_t i = 0;
+  int32_t hit = -1;
+
+  // 各触发方式独立循环，避免在逐样本循环中做分支选择
+  switch(trig->type)
+  {
+    case CAPTURE_TRIG_LEVEL:
+      for(; i < len; i++)
+      {
+        uint16_t x = src[i];
+        dst[i] = x;
+        if((rising && prev < trig->level && x >= trig->level) ||
+           (falling && prev > trig->level && x <= trig->level))
+        {
+          hit = (int32_t)i++;
+          break;
+        }
+        prev = x;
+      }
+      break;
+
+    case CAPTURE_TRIG_SLOPE:
+      for(; i < len; i++)
+      {
+        uint16_t x = src[i];
+        int32_t diff = (int32_t)x - (int32_t)prev;
+        dst[i] = x;
+        if((rising && diff >= (int32_t)trig->slope) ||
+           (falling && -diff >= (int32_t)trig->slope))
+        {
+          hit = (int32_t)i++;
+          break;
+        }
+        prev = x;
+      }
+      break;
+
+    case CAPTURE_TRIG_WINDOW:
+      for(; i < len; i++)
+      {
+        uint16_t x = src[i];
+        dst[i] = x;
+        if(x < trig->low || x > trig->high)
+        {
+          hit = (int32_t)i++;
+          break;
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  // 触发后（或无触发方式）剩余部分直接拷贝
+  if(i < len)
+  {
+    memcpy(&dst[i], &src[i], (len - i) * sizeof(uint16_t));
+  }
+
+  return hit;
+}
+
+/**
+ * @brief   为后续数据块分配一个空闲槽位
+ *
+ * @param[in,out] cap  捕获句柄
+ *
+ * @return  None
+ */
+static void Capture_NextSlot(Capture_Handle_t *cap)
+{
+  for(uint8_t i = 0; i < cap->config.slot_count; i++)
+  {
+    if(cap->state[i] == CAPTURE_SLOT_FREE)
+    {
+      cap->state[i] = CAPTURE_SLOT_FILLING;
+      cap->active_slot = i;
+      cap->write_block = 0;
+      cap->filled = 0;
+      cap->post_remaining = 0;
+      return;
+    }
+  }
+
+  cap->active_slot = cap->config.slot_count;
+}
+
+/**
+ * @brief   初始化捕获模块
+ */
+int Capture_Init(Capture_Handle_t *cap, const Capture_Config_t *config)
+{
+  if(cap == NULL || config == NULL || config->storage == NULL || config->block_len == 0 ||
+     config->post_blocks == 0 || config->slot_count == 0 ||
+     config->slot_count > CAPTURE_MAX_SLOTS)
+  {
+    return -1;
+  }
+
+  // 触发样本位置与文件视图的寄存器号均为16位，单个记录不能超过CAPTURE_MAX_RECORD_LEN
+  if((uint32_t)config->block_len * ((uint32_t)config->pre_blocks + config->post_blocks) >
+     CAPTURE_MAX_RECORD_LEN)
+  {
+    return -1;
+  }
+
+  memset(cap, 0, sizeof(Capture_Handle_t));
+  cap->config = *config;
+  cap->trigger.type = CAPTURE_TRIG_NONE;
+  Capture_NextSlot(cap);
+
+  return 0;
+}
+
+/**
+ * @brief   设置触发条件
+ */
+void Capture_SetTrigger(Capture_Handle_t *cap, const Capture_Trigger_t *trigger)
+{
+  if(cap == NULL || trigger == NULL)
+  {
+    return;
+  }
+
+  // 先写入待生效副本再置标志，由Capture_Feed在块边界应用
+  cap->pending_valid = false;
+  CAPTURE_BARRIER();
+  cap->pending = *trigger;
+  CAPTURE_BARRIER();
+  cap->pending_valid = true;
+}
+
+/**
+ * @brief   请求手动触发
+ */
+void Capture_Force(Capture_Handle_t *cap)
+{
+  if(cap == NULL)
+  {
+    return;
+  }
+
+  cap->force = true;
+}
+
+/**
+ * @brief   输入一块ADC数据
+ */
+bool Capture_Feed(Capture_Handle_t *cap, const uint16_t *samples)
+{
+  if(cap == NULL || samples == NULL)
+  {
+    return false;
+  }
+
+  const uint16_t len = cap->config.block_len;
+  const uint16_t slot_blocks = cap->config.pre_blocks + cap->config.post_blocks;
+  bool completed = false;
+
+  cap->block_seq++;
+
+  if(cap->pending_valid)
+  {
+    CAPTURE_BARRIER();
+    cap->trigger = cap->pending;
+    cap->pending_valid = false;
+  }
+
+  if(cap->active_slot >= cap->config.slot_count)
+  {
+    Capture_NextSlot(cap);
+    if(cap->active_slot >= cap->config.slot_count)
+    {
+      // 所有槽位都在等待读取，本块不保存
+      cap->missed++;
+      cap->last_sample = samples[len - 1];
+      cap->have_last = true;
+      return false;
+    }
+  }
+
+  const uint8_t slot = cap->active_slot;
+  uint16_t *dst = cap->config.storage +
+                  ((uint32_t)slot * slot_blocks + cap->write_block) * len;
+  bool armed = (cap->post_remaining == 0) && (cap->filled >= cap->config.pre_blocks);
+  int32_t hit = -1;
+
+  if(armed && cap->force)
+  {
+    memcpy(dst, samples, len * sizeof(uint16_t));
+    cap->force = false;
+    cap->trigger_type = CAPTURE_TRIG_NONE;
+    hit = 0;
+  }
+  else if(armed)
+  {
+    uint16_t prev = cap->have_last ? cap->last_sample : samples[0];
+    hit = Capture_Scan(&cap->trigger, prev, samples, dst, len);
+    cap->trigger_type = (uint8_t)cap->trigger.type;
+  }
+  else
+  {
+    memcpy(dst, samples, len * sizeof(uint16_t));
+  }
+
+  cap->last_sample = samples[len - 1];
+  cap->have_last = true;
+
+  if(hit >= 0)
+  {
+    // 触发块位于write_block，冻结时最旧块为其后第post块，触发块前恰有pre块
+    Capture_Record_t *rec = &cap->record[slot];
+
+    rec->sequence = ++cap->sequence;
+    rec->block_seq = cap->block_seq;
+    rec->trigger_index = (uint16_t)((uint32_t)cap->config.pre_blocks * len + (uint32_t)hit);
+    rec->first_block = (uint16_t)((cap->write_block + cap->config.post_blocks) % slot_blocks);
+    rec->block_count = slot_blocks;
+    rec->trigger_type = cap->trigger_type;
+    cap->post_remaining = cap->config.post_blocks;
+  }
+
+  cap->write_block = (uint16_t)((cap->write_block + 1) % slot_blocks);
+  if(cap->filled < cap->config.pre_blocks)
+  {
+    cap->filled++;
+  }
+
+  if(cap->post_remaining > 0 && --cap->post_remaining == 0)
+  {
+    // 样本与记录写完后再发布
+    CAPTURE_BARRIER();
+    cap->state[slot] = CAPTURE_SLOT_READY;
+    Capture_NextSlot(cap);
+    completed = true;
+  }
+
+  return completed;
+}
+
+/**
+ * @brief   获取槽位的捕获记录信息
+ */
+int Capture_GetRecord(const Capture_Handle_t *cap, uint8_t slot, Capture_Record_t *record)
+{
+  if(cap == NULL || record == NULL || slot >= cap->config.slot_count ||
+     cap->state[slot] != CAPTURE_SLOT_READY)
+  {
+    return -1;
+  }
+
+  CAPTURE_BARRIER();
+  *record = cap->record[slot];
+
+  return 0;
+}
+
+/**
+ * @brief   按时间顺序读取捕获样本
+ */
+int Capture_Read(const Capture_Handle_t *cap, uint8_t slot, uint32_t offset,
+                 uint16_t *dst, uint32_t count)
+{
+  if(cap == NULL || dst == NULL || slot >= cap->config.slot_count ||
+     cap->state[slot] != CAPTURE_SLOT_READY)
+  {
+    return -1;
+  }
+
+  CAPTURE_BARRIER();
+  const Capture_Record_t *rec = &cap->record[slot];
+  const uint32_t total = (uint32_t)rec->block_count * cap->config.block_len;
+  const uint16_t *base = cap->config.storage + (uint32_t)slot * total;
+
+  if(offset > total || count > total - offset)
+  {
+    return -1;
+  }
+
+  // 环形存储展开为时间顺序，最多分两段拷贝
+  uint32_t pos = ((uint32_t)rec->first_block * cap->config.block_len + offset) % total;
+  uint32_t first = total - pos;
+  if(first > count)
+  {
+    first = count;
+  }
+  memcpy(dst, &base[pos], first * sizeof(uint16_t));
+  memcpy(&dst[first], base, (count - first) * sizeof(uint16_t));
+
+  return 0;
+}
+
+/**
+ * @brief   释放槽位，使其重新参与采集
+ */
+int Capture_Release(Capture_Handle_t *cap, uint8_t slot)
+{
+  if(cap == NULL || slot >= cap->config.slot_count || cap->state[slot] != CAPTURE_SLOT_READY)
+  {
+    return -1;
+  }
+
+  // 读取完成后再交还中断
+  CAPTURE_BARRIER();
+  cap->state[slot] = CAPTURE_SLOT_FREE;
+
+  return 0;
+}
+
+/**
+ * @brief   以16位寄存器文件形式读取槽位（Modbus文件记录）
+ */
+int Capture_FileRead(const Capture_Handle_t *cap, uint8_t slot, uint16_t reg,
+                     uint16_t *regs, uint16_t count)
+{
+  uint16_t header[CAPTURE_FILE_HEADER_LEN] = {0};
+
+  if(cap == NULL || regs == NULL || slot >= cap->config.slot_count)
+  {
+    return -1;
+  }
+
+  uint8_t state = cap->state[slot];
+  header[0] = state;
+  if(state == CAPTURE_SLOT_READY)
+  {
+    CAPTURE_BARRIER();
+    const Capture_Record_t *rec = &cap->record[slot];
+    header[1] = (uint16_t)(rec->sequence >> 16);
+    header[2] = (uint16_t)rec->sequence;
+    header[3] = (uint16_t)(rec->block_seq >> 16);
+    header[4] = (uint16_t)rec->block_seq;
+    header[5] = rec->trigger_index;
+    header[6] = rec->block_count;
+    header[7] = cap->config.block_len;
+    header[8] = cap->config.pre_blocks;
+    header[9] = rec->trigger_type;
+  }
+
+  // 头部
+  while(count > 0 && reg < CAPTURE_FILE_HEADER_LEN)
+  {
+    *regs++ = header[reg++];
+    count--;
+  }
+
+  if(count == 0)
+  {
+    return 0;
+  }
+
+  // 样本数据
+  return Capture_Read(cap, slot, (uint32_t)reg - CAPTURE_FILE_HEADER_LEN, regs, count);
+}
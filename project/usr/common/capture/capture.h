@@ -0,0 +1,251 @@
+/**
+ * @file    capture.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   触发式波形捕获模块
+ *
+ * @details 在ADC数据块回调（中断上下文）中逐块拷贝样本并检测触发条件：
+ *          - 未触发时，当前槽位作为N块的预触发历史环
+ *          - 触发后继续写入M块，随后冻结该槽位并切换到下一个空闲槽位
+ *          - 采集不停止，冻结的槽位由任务读取并释放后重新参与循环
+ *          支持电平、斜率、窗口三种触发方式，样本存储由调用者提供（建议放在AXI SRAM）。
+ *          仅依赖标准C库，无硬件依赖。
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 最大捕获槽位数量
+ */
+#define CAPTURE_MAX_SLOTS       4
+
+/**
+ * @brief 文件视图中记录头占用的寄存器数量（见Capture_FileRead）
+ */
+#define CAPTURE_FILE_HEADER_LEN 16
+
+/**
+ * @brief 单个记录的最大样本数（block_len*(pre+post)），文件视图的寄存器号须能以16位表示
+ */
+#define CAPTURE_MAX_RECORD_LEN  (65535U - CAPTURE_FILE_HEADER_LEN)
+
+/**
+ * @brief 触发方式
+ */
+typedef enum
+{
+  CAPTURE_TRIG_NONE = 0,                /**< 不触发（仅Capture_Force手动触发） */
+  CAPTURE_TRIG_LEVEL,                   /**< 电平：越过level */
+  CAPTURE_TRIG_SLOPE,                   /**< 斜率：相邻样本差值达到slope */
+  CAPTURE_TRIG_WINDOW                   /**< 窗口：样本离开[low, high] */
+} Capture_TrigType_t;
+
+/**
+ * @brief 触发边沿（电平/斜率触发有效）
+ */
+typedef enum
+{
+  CAPTURE_EDGE_RISING = 0,              /**< 上升 */
+  CAPTURE_EDGE_FALLING,                 /**< 下降 */
+  CAPTURE_EDGE_BOTH                     /**< 双向 */
+} Capture_Edge_t;
+
+/**
+ * @brief 触发条件
+ */
+typedef struct
+{
+  Capture_TrigType_t type;              /**< 触发方式 */
+  Capture_Edge_t edge;                  /**< 触发边沿 */
+  uint16_t level;                       /**< 电平触发阈值（码值） */
+  uint16_t slope;                       /**< 斜率触发阈值（码值/样本） */
+  uint16_t low;                         /**< 窗口下限（码值） */
+  uint16_t high;                        /**< 窗口上限（码值） */
+} Capture_Trigger_t;
+
+/**
+ * @brief 捕获配置
+ */
+typedef struct
+{
+  uint16_t *storage;                    /**< 样本存储，slot_count*(pre+post)*block_len个样本 */
+  uint16_t block_len;                   /**< 每个数据块的样本数，block_len*(pre+post)<=CAPTURE_MAX_RECORD_LEN */
+  uint8_t pre_blocks;                   /**< 预触发块数N */
+  uint8_t post_blocks;                  /**< 触发后块数M（含触发块），>=1 */
+  uint8_t slot_count;                   /**< 槽位数量，<=CAPTURE_MAX_SLOTS */
+} Capture_Config_t;
+
+/**
+ * @brief 槽位状态
+ */
+typedef enum
+{
+  CAPTURE_SLOT_FREE = 0,                /**< 空闲 */
+  CAPTURE_SLOT_FILLING,                 /**< 正在采集（预触发环或触发后） */
+  CAPTURE_SLOT_READY                    /**< 已冻结，等待读取 */
+} Capture_SlotState_t;
+
+/**
+ * @brief 捕获记录信息（冻结时生成）
+ */
+typedef struct
+{
+  uint32_t sequence;                    /**< 捕获序号，从1开始 */
+  uint32_t block_seq;                   /**< 触发块的全局块序号 */
+  uint16_t trigger_index;               /**< 触发样本在记录中的位置（从最旧样本算起） */
+  uint16_t first_block;                 /**< 槽位内最旧块的位置 */
+  uint16_t block_count;                 /**< 记录块数（pre+post） */
+  uint8_t trigger_type;                 /**< 触发来源（Capture_TrigType_t，手动为NONE） */
+} Capture_Record_t;
+
+/**
+ * @brief 捕获句柄
+ */
+typedef struct
+{
+  Capture_Config_t config;              /**< 配置副本 */
+  Capture_Trigger_t trigger;            /**< 当前触发条件（中断中使用） */
+  Capture_Trigger_t pending;            /**< 待生效的触发条件 */
+  volatile bool pending_valid;          /**< 有待生效的触发条件 */
+  volatile bool force;                  /**< 手动触发请求 */
+  uint8_t active_slot;                  /**< 当前采集槽位，无空闲槽位时为slot_count */
+  uint16_t write_block;                 /**< 当前槽位的块写位置 */
+  uint16_t filled;                      /**< 当前槽位已写入块数（饱和于pre_blocks） */
+  uint16_t post_remaining;              /**< 触发后剩余块数，0表示未触发 */
+  uint8_t trigger_type;                 /**< 本次触发来源 */
+  uint16_t last_sample;                 /**< 上一块最后一个样本（跨块边沿检测） */
+  bool have_last;                       /**< last_sample有效 */
+  uint32_t block_seq;                   /**< 全局块计数 */
+  uint32_t sequence;                    /**< 已完成的捕获数 */
+  uint32_t missed;                      /**< 无空闲槽位时丢弃的块数 */
+  volatile uint8_t state[CAPTURE_MAX_SLOTS];        /**< 槽位状态 */
+  Capture_Record_t record[CAPTURE_MAX_SLOTS];       /**< 槽位记录信息 */
+} Capture_Handle_t;
+
+/**
+ * @brief   初始化捕获模块
+ *
+ * @param[out]  cap     捕获句柄
+ * @param[in]   config  配置参数
+ *
+ * @retval  0   成功
+ * @retval  -1  参数错误或单个记录超过CAPTURE_MAX_RECORD_LEN个样本
+ *
+ * @note    初始触发方式为CAPTURE_TRIG_NONE
+ */
+int Capture_Init(Capture_Handle_t *cap, const Capture_Config_t *config);
+
+/**
+ * @brief   设置触发条件
+ *
+ * @details 在任务中调用，新条件在下一个数据块开始时生效
+ *
+ * @param[in,out] cap      捕获句柄
+ * @param[in]     trigger  触发条件
+ *
+ * @return  None
+ */
+void Capture_SetTrigger(Capture_Handle_t *cap, const Capture_Trigger_t *trigger);
+
+/**
+ * @brief   请求手动触发
+ *
+ * @param[in,out] cap  捕获句柄
+ *
+ * @return  None
+ */
+void Capture_Force(Capture_Handle_t *cap);
+
+/**
+ * @brief   输入一块ADC数据
+ *
+ * @details 拷贝样本的同时检测触发，预触发历史未填满N块前不检测触发
+ *
+ * @param[in,out] cap      捕获句柄
+ * @param[in]     samples  数据块，长度必须为config.block_len
+ *
+ * @retval  true   本块完成了一次捕获（有槽位变为READY）
+ * @retval  false  无新捕获
+ *
+ * @note    可在中断中调用，须在DMA覆盖该半区之前完成
+ */
+bool Capture_Feed(Capture_Handle_t *cap, const uint16_t *samples);
+
+/**
+ * @brief   获取槽位的捕获记录信息
+ *
+ * @param[in]   cap     捕获句柄
+ * @param[in]   slot    槽位号
+ * @param[out]  record  记录信息输出
+ *
+ * @retval  0   成功
+ * @retval  -1  槽位无效或未就绪
+ */
+int Capture_GetRecord(const Capture_Handle_t *cap, uint8_t slot, Capture_Record_t *record);
+
+/**
+ * @brief   按时间顺序读取捕获样本
+ *
+ * @param[in]   cap     捕获句柄
+ * @param[in]   slot    槽位号
+ * @param[in]   offset  起始样本（0为最旧样本）
+ * @param[out]  dst     输出缓冲区
+ * @param[in]   count   样本数
+ *
+ * @retval  0   成功
+ * @retval  -1  槽位无效、未就绪或越界
+ */
+int Capture_Read(const Capture_Handle_t *cap, uint8_t slot, uint32_t offset,
+                 uint16_t *dst, uint32_t count);
+
+/**
+ * @brief   释放槽位，使其重新参与采集
+ *
+ * @param[in,out] cap   捕获句柄
+ * @param[in]     slot  槽位号
+ *
+ * @retval  0   成功
+ * @retval  -1  槽位无效或未就绪
+ */
+int Capture_Release(Capture_Handle_t *cap, uint8_t slot);
+
+/**
+ * @brief   以16位寄存器文件形式读取槽位（Modbus文件记录）
+ *
+ * @details 文件布局：
+ *          - 0     槽位状态（Capture_SlotState_t）
+ *          - 1-2   捕获序号（高字在前）
+ *          - 3-4   触发块全局序号（高字在前）
+ *          - 5     触发样本位置
+ *          - 6     记录块数
+ *          - 7     每块样本数
+ *          - 8     预触发块数
+ *          - 9     触发来源
+ *          - 10-15 保留
+ *          - 16起  样本数据（时间顺序）
+ *
+ * @param[in]   cap    捕获句柄
+ * @param[in]   slot   槽位号
+ * @param[in]   reg    起始寄存器
+ * @param[out]  regs   输出寄存器
+ * @param[in]   count  寄存器数量
+ *
+ * @retval  0   成功
+ * @retval  -1  槽位无效或越界（未就绪时仅头部可读）
+ */
+int Capture_FileRead(const Capture_Handle_t *cap, uint8_t slot, uint16_t reg,
+                     uint16_t *regs, uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAPTURE_H */
@@ -0,0 +1,91 @@
+/**
+ * @file    dmaalloc.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   DMA流分配算法实现
+ *
+ * @details 已占用的流与已处理的请求分别记录在位图中。自动分配的请求每轮选出
+ *          尚未处理且优先级最高的一个，请求数不超过流数，O(n²)足够。
+ */
+
+#include "dmaalloc.h"
+#include <stddef.h>
+
+/* 在允许的控制器中取编号最小的空闲流 */
+static int8_t DmaAlloc_FirstFree(uint32_t used, uint8_t controllers)
+{
+  for(uint32_t s = 0; s < DMAALLOC_STREAM_NUM; s++)
+  {
+    if((controllers & DMAALLOC_CTRL_OF(s)) != 0U && (used & (1UL << s)) == 0U)
+    {
+      return (int8_t)s;
+    }
+  }
+
+  return DMAALLOC_NONE;
+}
+
+int DmaAlloc_Assign(const DmaAlloc_Request_t *reqs, uint32_t count, int8_t *streams)
+{
+  uint32_t used = 0;
+  uint32_t done = 0;
+  int result = 0;
+
+  if(reqs == NULL || streams == NULL || count > DMAALLOC_STREAM_NUM)
+  {
+    return -1;
+  }
+
+  // 第一轮：固定流
+  for(uint32_t i = 0; i < count; i++)
+  {
+    int8_t s = reqs[i].stream;
+
+    streams[i] = DMAALLOC_NONE;
+    if(s == DMAALLOC_ANY)
+    {
+      continue;
+    }
+
+    done |= 1UL << i;
+    if(s < 0 || s >= (int8_t)DMAALLOC_STREAM_NUM ||
+       (reqs[i].controllers & DMAALLOC_CTRL_OF(s)) == 0U || (used & (1UL << s)) != 0U)
+    {
+      result = -1;
+      continue;
+    }
+
+    used |= 1UL << s;
+    streams[i] = s;
+  }
+
+  // 第二轮：自动分配，每次取未处理请求中优先级最高者
+  for(;;)
+  {
+    int32_t best = -1;
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+      if((done & (1UL << i)) == 0U && (best < 0 || reqs[i].priority > reqs[best].priority))
+      {
+        best = (int32_t)i;
+      }
+    }
+
+    if(best < 0)
+    {
+      break;
+    }
+
+    done |= 1UL << best;
+    streams[best] = DmaAlloc_FirstFree(used, reqs[best].controllers);
+    if(streams[best] == DMAALLOC_NONE)
+    {
+      result = -1;
+      continue;
+    }
+    used |= 1UL << streams[best];
+  }
+
+  return result;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file    dmaalloc.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   DMA流分配算法
+ *
+ * @details 按声明式请求表为各外设请求分配DMA1/DMA2/BDMA的流（通道），
+ *          只做编号分配，不访问硬件，可在主机上单独编译验证。
+ *          流按全局编号0-23排列：DMA1 Stream0-7、DMA2 Stream0-7、BDMA Channel0-7。
+ *
+ *          分配规则：
+ *          1. 指定了固定流的请求先分配，流已占用或不属于允许的控制器时失败
+ *          2. 其余请求按优先级从高到低（同优先级按表中顺序）依次取
+ *             允许控制器中编号最小的空闲流；同一控制器内流编号越小
+ *             仲裁优先级越高，高优先级请求因此得到靠前的流
+ *          3. 任一请求分配失败时返回-1，该请求结果为DMAALLOC_NONE，
+ *            其余请求照常分配，便于一次定位所有冲突
+ */
+
+#ifndef DMAALLOC_H
+#define DMAALLOC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DMAALLOC_CTRL_DMA1      (1U << 0)   /**< DMA1（DMAMUX1） */
+#define DMAALLOC_CTRL_DMA2      (1U << 1)   /**< DMA2（DMAMUX1） */
+#define DMAALLOC_CTRL_BDMA      (1U << 2)   /**< BDMA（DMAMUX2，仅D3外设与SRAM4） */
+
+#define DMAALLOC_CTRL_NUM       3           /**< 控制器数 */
+#define DMAALLOC_CTRL_STREAMS   8           /**< 每个控制器的流数 */
+#define DMAALLOC_STREAM_NUM     (DMAALLOC_CTRL_NUM * DMAALLOC_CTRL_STREAMS)
+
+#define DMAALLOC_ANY            (-1)        /**< 不指定流 */
+#define DMAALLOC_NONE           (-1)        /**< 未分配 */
+
+/**
+ * @brief 全局流编号所属控制器（DMAALLOC_CTRL_xxx）
+ */
+#define DMAALLOC_CTRL_OF(stream)    (1U << ((uint32_t)(stream) / DMAALLOC_CTRL_STREAMS))
+
+/**
+ * @brief 分配请求
+ */
+typedef struct
+{
+  uint8_t controllers;                  /**< 允许的控制器（DMAALLOC_CTRL_xxx组合） */
+  int8_t stream;                        /**< 固定全局流编号，DMAALLOC_ANY表示自动分配 */
+  uint8_t priority;                     /**< 优先级，数值大者先分配 */
+} DmaAlloc_Request_t;
+
+/**
+ * @brief   为请求表分配流
+ *
+ * @param[in]   reqs     请求表
+ * @param[in]   count    请求数
+ * @param[out]  streams  分配结果，每个请求一个全局流编号或DMAALLOC_NONE
+ *
+ * @return  0全部分配成功，-1参数错误或存在未分配的请求
+ */
+int DmaAlloc_Assign(const DmaAlloc_Request_t *reqs, uint32_t count, int8_t *streams);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DMAALLOC_H */
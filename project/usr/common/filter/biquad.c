@@ -0,0 +1,401 @@
+/**
+ * @file biquad.c
+ * @brief 定点双二阶(biquad) IIR级联滤波器实现
+ */
+
+#include "biquad.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#define BIQUAD_PI           3.14159265358979323846
+
+/* Q15使用Q14系数，Q31使用Q30系数，乘积右移量即系数小数位数 */
+#define BIQUAD_Q15_SHIFT    14
+#define BIQUAD_Q31_SHIFT    30
+
+/* 系数下标 */
+#define B0  0
+#define B1  1
+#define B2  2
+#define A1  3
+#define A2  4
+
+/* ==================== 系数设计 ==================== */
+
+/*
+ * RBJ Cookbook公共部分：w0 = 2*pi*fc/fs，alpha = sin(w0)/(2q)，
+ * 分母 a0 = 1 + alpha，a1 = -2cos(w0)，a2 = 1 - alpha，结果统一除以a0
+ */
+static int Biquad_Prepare(double fs, double fc, double q, double *cos_w0, double *alpha)
+{
+  if(fs <= 0.0 || fc <= 0.0 || fc >= fs / 2.0 || q <= 0.0)
+  {
+    return -1;
+  }
+
+  double w0 = 2.0 * BIQUAD_PI * fc / fs;
+  *cos_w0 = cos(w0);
+  *alpha = sin(w0) / (2.0 * q);
+
+  return 0;
+}
+
+static void Biquad_Normalize(Biquad_Design_t *design, double b0, double b1, double b2,
+                             double cos_w0, double alpha)
+{
+  double a0 = 1.0 + alpha;
+
+  design->b0 = b0 / a0;
+  design->b1 = b1 / a0;
+  design->b2 = b2 / a0;
+  design->a1 = -2.0 * cos_w0 / a0;
+  design->a2 = (1.0 - alpha) / a0;
+}
+
+int Biquad_DesignLowPass(Biquad_Design_t *design, double fs, double fc, double q)
+{
+  double c;
+  double alpha;
+
+  if(design == NULL || Biquad_Prepare(fs, fc, q, &c, &alpha) != 0)
+  {
+    return -1;
+  }
+
+  Biquad_Normalize(design, (1.0 - c) / 2.0, 1.0 - c, (1.0 - c) / 2.0, c, alpha);
+  return 0;
+}
+
+int Biquad_DesignHighPass(Biquad_Design_t *design, double fs, double fc, double q)
+{
+  double c;
+  double alpha;
+
+  if(design == NULL || Biquad_Prepare(fs, fc, q, &c, &alpha) != 0)
+  {
+    return -1;
+  }
+
+  Biquad_Normalize(design, (1.0 + c) / 2.0, -(1.0 + c), (1.0 + c) / 2.0, c, alpha);
+  return 0;
+}
+
+int Biquad_DesignNotch(Biquad_Design_t *design, double fs, double fc, double q)
+{
+  double c;
+  double alpha;
+
+  if(design == NULL || Biquad_Prepare(fs, fc, q, &c, &alpha) != 0)
+  {
+    return -1;
+  }
+
+  Biquad_Normalize(design, 1.0, -2.0 * c, 1.0, c, alpha);
+  return 0;
+}
+
+int Biquad_DesignBandPass(Biquad_Design_t *design, double fs, double fc, double q)
+{
+  double c;
+  double alpha;
+
+  if(design == NULL || Biquad_Prepare(fs, fc, q, &c, &alpha) != 0)
+  {
+    return -1;
+  }
+
+  Biquad_Normalize(design, alpha, 0.0, -alpha, c, alpha);
+  return 0;
+}
+
+/* ==================== 量化与饱和 ==================== */
+
+/* 浮点系数四舍五入量化到Q(shift)，超出[min, max]返回-1 */
+static int Biquad_Quantize(double value, int shift, int64_t min, int64_t max, int64_t *out)
+{
+  double scaled = value * (double)((int64_t)1 << shift);
+  int64_t q = (int64_t)((scaled >= 0.0) ? (scaled + 0.5) : (scaled - 0.5));
+
+  if(q < min || q > max)
+  {
+    return -1;
+  }
+
+  *out = q;
+  return 0;
+}
+
+static int Biquad_QuantizeStage(const Biquad_Design_t *design, int shift, int64_t min,
+                                int64_t max, int64_t coef[5])
+{
+  const double values[5] = {design->b0, design->b1, design->b2, design->a1, design->a2};
+
+  for(uint8_t i = 0; i < 5; i++)
+  {
+    if(Biquad_Quantize(values[i], shift, min, max, &coef[i]) != 0)
+    {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+static inline int16_t Biquad_Sat16(int64_t x)
+{
+  if(x > INT16_MAX)
+  {
+    return INT16_MAX;
+  }
+  if(x < INT16_MIN)
+  {
+    return INT16_MIN;
+  }
+  return (int16_t)x;
+}
+
+/* Q31数据饱和到±BIQUAD_Q31_DATA_MAX，限制反馈状态幅度，保证64位累加不溢出 */
+static inline int32_t Biquad_SatQ31(int64_t x)
+{
+  if(x > BIQUAD_Q31_DATA_MAX)
+  {
+    return BIQUAD_Q31_DATA_MAX;
+  }
+  if(x < -BIQUAD_Q31_DATA_MAX)
+  {
+    return -BIQUAD_Q31_DATA_MAX;
+  }
+  return (int32_t)x;
+}
+
+/* ==================== 单节运算 ==================== */
+
+/*
+ * DF1：acc = b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2，y = round(acc >> shift)
+ * DF2T：y = round((b0*x + s1) >> shift)
+ *       s1 = b1*x - a1*y + s2
+ *       s2 = b2*x - a2*y
+ * DF2T状态保持乘积的全部小数位，仅输出做一次舍入。
+ * Q31的x与y均不超过2^29：DF1累加|acc| < 5 * 2^60，DF2T状态|s1| < 2^61、|s2| < 2^60，
+ * 饱和时（如高Q谐振被满量程激励）也不会溢出int64_t。
+ */
+static inline int64_t BiquadQ15_DF1(const int16_t c[5], int64_t s[4], int64_t x)
+{
+  int64_t acc = c[B0] * x + c[B1] * s[0] + c[B2] * s[1] - c[A1] * s[2] - c[A2] * s[3];
+  int64_t y = Biquad_Sat16((acc + (1 << (BIQUAD_Q15_SHIFT - 1))) >> BIQUAD_Q15_SHIFT);
+
+  s[1] = s[0];
+  s[0] = x;
+  s[3] = s[2];
+  s[2] = y;
+  return y;
+}
+
+static inline int64_t BiquadQ15_DF2T(const int16_t c[5], int64_t s[4], int64_t x)
+{
+  int64_t acc = c[B0] * x + s[0];
+  int64_t y = Biquad_Sat16((acc + (1 << (BIQUAD_Q15_SHIFT - 1))) >> BIQUAD_Q15_SHIFT);
+
+  s[0] = c[B1] * x - c[A1] * y + s[1];
+  s[1] = c[B2] * x - c[A2] * y;
+  return y;
+}
+
+static inline int64_t BiquadQ31_DF1(const int32_t c[5], int64_t s[4], int64_t x)
+{
+  x = Biquad_SatQ31(x);
+  int64_t acc = c[B0] * x + c[B1] * s[0] + c[B2] * s[1] - c[A1] * s[2] - c[A2] * s[3];
+  int64_t y = Biquad_SatQ31((acc + (1 << (BIQUAD_Q31_SHIFT - 1))) >> BIQUAD_Q31_SHIFT);
+
+  s[1] = s[0];
+  s[0] = x;
+  s[3] = s[2];
+  s[2] = y;
+  return y;
+}
+
+static inline int64_t BiquadQ31_DF2T(const int32_t c[5], int64_t s[4], int64_t x)
+{
+  x = Biquad_SatQ31(x);
+  int64_t acc = c[B0] * x + s[0];
+  int64_t y = Biquad_SatQ31((acc + (1 << (BIQUAD_Q31_SHIFT - 1))) >> BIQUAD_Q31_SHIFT);
+
+  s[0] = c[B1] * x - c[A1] * y + s[1];
+  s[1] = c[B2] * x - c[A2] * y;
+  return y;
+}
+
+/* ==================== Q15 ==================== */
+
+int BiquadQ15_Init(BiquadQ15_Handle_t *filter, Biquad_Form_t form,
+                   const Biquad_Design_t *design, uint8_t stages)
+{
+  int64_t coef[5];
+
+  if(filter == NULL || design == NULL || stages == 0 || stages > BIQUAD_MAX_STAGES ||
+     (form != BIQUAD_DF1 && form != BIQUAD_DF2T))
+  {
+    return -1;
+  }
+
+  for(uint8_t i = 0; i < stages; i++)
+  {
+    if(Biquad_QuantizeStage(&design[i], BIQUAD_Q15_SHIFT, INT16_MIN, INT16_MAX, coef) != 0)
+    {
+      return -1;
+    }
+    for(uint8_t k = 0; k < 5; k++)
+    {
+      filter->coef[i][k] = (int16_t)coef[k];
+    }
+  }
+
+  filter->form = form;
+  filter->stages = stages;
+  BiquadQ15_Reset(filter);
+
+  return 0;
+}
+
+void BiquadQ15_Reset(BiquadQ15_Handle_t *filter)
+{
+  if(filter == NULL)
+  {
+    return;
+  }
+
+  memset(filter->state, 0, sizeof(filter->state));
+}
+
+int16_t BiquadQ15_Update(BiquadQ15_Handle_t *filter, int16_t new_data)
+{
+  int64_t x = new_data;
+
+  for(uint8_t i = 0; i < filter->stages; i++)
+  {
+    x = (filter->form == BIQUAD_DF1) ? BiquadQ15_DF1(filter->coef[i], filter->state[i], x)
+                                     : BiquadQ15_DF2T(filter->coef[i], filter->state[i], x);
+  }
+
+  return (int16_t)x;
+}
+
+/*
+ * 块处理：逐节处理整块数据，每节的系数与状态只加载一次，
+ * 中间结果写入out，下一节从out读取（支持in == out）。
+ */
+void BiquadQ15_Process(BiquadQ15_Handle_t *filter, const int16_t *in, int16_t *out, uint32_t n)
+{
+  const int16_t *src = in;
+
+  for(uint8_t i = 0; i < filter->stages; i++)
+  {
+    const int16_t *c = filter->coef[i];
+    int64_t s[4] = {filter->state[i][0], filter->state[i][1],
+                    filter->state[i][2], filter->state[i][3]};
+
+    if(filter->form == BIQUAD_DF1)
+    {
+      for(uint32_t k = 0; k < n; k++)
+      {
+        out[k] = (int16_t)BiquadQ15_DF1(c, s, src[k]);
+      }
+    }
+    else
+    {
+      for(uint32_t k = 0; k < n; k++)
+      {
+        out[k] = (int16_t)BiquadQ15_DF2T(c, s, src[k]);
+      }
+    }
+
+    memcpy(filter->state[i], s, sizeof(s));
+    src = out;
+  }
+}
+
+/* ==================== Q31 ==================== */
+
+int BiquadQ31_Init(BiquadQ31_Handle_t *filter, Biquad_Form_t form,
+                   const Biquad_Design_t *design, uint8_t stages)
+{
+  int64_t coef[5];
+
+  if(filter == NULL || design == NULL || stages == 0 || stages > BIQUAD_MAX_STAGES ||
+     (form != BIQUAD_DF1 && form != BIQUAD_DF2T))
+  {
+    return -1;
+  }
+
+  for(uint8_t i = 0; i < stages; i++)
+  {
+    if(Biquad_QuantizeStage(&design[i], BIQUAD_Q31_SHIFT, INT32_MIN, INT32_MAX, coef) != 0)
+    {
+      return -1;
+    }
+    for(uint8_t k = 0; k < 5; k++)
+    {
+      filter->coef[i][k] = (int32_t)coef[k];
+    }
+  }
+
+  filter->form = form;
+  filter->stages = stages;
+  BiquadQ31_Reset(filter);
+
+  return 0;
+}
+
+void BiquadQ31_Reset(BiquadQ31_Handle_t *filter)
+{
+  if(filter == NULL)
+  {
+    return;
+  }
+
+  memset(filter->state, 0, sizeof(filter->state));
+}
+
+int32_t BiquadQ31_Update(BiquadQ31_Handle_t *filter, int32_t new_data)
+{
+  int64_t x = new_data;
+
+  for(uint8_t i = 0; i < filter->stages; i++)
+  {
+    x = (filter->form == BIQUAD_DF1) ? BiquadQ31_DF1(filter->coef[i], filter->state[i], x)
+                                     : BiquadQ31_DF2T(filter->coef[i], filter->state[i], x);
+  }
+
+  return (int32_t)x;
+}
+
+void BiquadQ31_Process(BiquadQ31_Handle_t *filter, const int32_t *in, int32_t *out, uint32_t n)
+{
+  const int32_t *src = in;
+
+  for(uint8_t i = 0; i < filter->stages; i++)
+  {
+    const int32_t *c = filter->coef[i];
+    int64_t s[4] = {filter->state[i][0], filter->state[i][1],
+                    filter->state[i][2], filter->state[i][3]};
+
+    if(filter->form == BIQUAD_DF1)
+    {
+      for(uint32_t k = 0; k < n; k++)
+      {
+        out[k] = (int32_t)BiquadQ31_DF1(c, s, src[k]);
+      }
+    }
+    else
+    {
+      for(uint32_t k = 0; k < n; k++)
+      {
+        out[k] = (int32_t)BiquadQ31_DF2T(c, s, src[k]);
+      }
+    }
+
+    memcpy(filter->state[i], s, sizeof(s));
+    src = out;
+  }
+}
@@ -0,0 +1,191 @@
+/**
+ * @file biquad.h
+ * @brief 定点双二阶(biquad) IIR级联滤波器
+ * @note 仅依赖标准 C 库，无硬件依赖
+ * @note 系数设计使用双精度浮点（RBJ Audio EQ Cookbook），运行时为纯定点运算
+ *
+ * 每一节的差分方程（a0归一化为1）：
+ *   y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ *
+ * 定点格式：
+ * - Q15：数据int16_t，系数Q14（范围[-2, 2)），64位累加
+ * - Q31：数据int32_t，系数Q30（范围[-2, 2)），64位累加，
+ *        输入与各节输出（即反馈状态）饱和到±BIQUAD_Q31_DATA_MAX（2位余量），
+ *        5个乘积之和 < 5 * 2^31 * 2^29 < 2^63，任意系数与输入下累加不溢出
+ *
+ * 截止频率与采样率之比很小时（fc/fs < 0.01）极点靠近单位圆，
+ * Q15系数量化误差会明显改变频响，此时应使用Q31或先抽取降采样。
+ */
+
+#ifndef BIQUAD_H
+#define BIQUAD_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 最大级联节数（4节即8阶） */
+#define BIQUAD_MAX_STAGES   4
+
+/* Q31数据幅度上限（|x| <= 2^29 - 1） */
+#define BIQUAD_Q31_DATA_MAX ((int32_t)((1UL << 29) - 1U))
+
+/* 实现结构 */
+typedef enum
+{
+  BIQUAD_DF1 = 0,       /* 直接I型：状态为输入/输出历史，定点下无内部溢出 */
+  BIQUAD_DF2T           /* 转置直接II型：状态少，内部状态保持全精度 */
+} Biquad_Form_t;
+
+/* 浮点系数（设计结果，a0已归一化） */
+typedef struct
+{
+  double b0;
+  double b1;
+  double b2;
+  double a1;
+  double a2;
+} Biquad_Design_t;
+
+/* Q15级联滤波器 */
+typedef struct
+{
+  Biquad_Form_t form;
+  uint8_t stages;
+  int16_t coef[BIQUAD_MAX_STAGES][5];     /* b0 b1 b2 a1 a2，Q14 */
+  int64_t state[BIQUAD_MAX_STAGES][4];    /* DF1: x1 x2 y1 y2；DF2T: s1 s2 */
+} BiquadQ15_Handle_t;
+
+/* Q31级联滤波器 */
+typedef struct
+{
+  Biquad_Form_t form;
+  uint8_t stages;
+  int32_t coef[BIQUAD_MAX_STAGES][5];     /* b0 b1 b2 a1 a2，Q30 */
+  int64_t state[BIQUAD_MAX_STAGES][4];    /* DF1: x1 x2 y1 y2；DF2T: s1 s2 */
+} BiquadQ31_Handle_t;
+
+/* ==================== 系数设计 ==================== */
+
+/**
+ * @brief 设计二阶低通
+ * @param design 输出系数
+ * @param fs 采样率(Hz)
+ * @param fc 截止频率(Hz)，0 < fc < fs/2
+ * @param q 品质因数，0.7071为Butterworth
+ * @return 0成功，-1参数错误
+ * @note 4阶Butterworth可由q=0.5412与q=1.3066两节级联得到
+ */
+int Biquad_DesignLowPass(Biquad_Design_t *design, double fs, double fc, double q);
+
+/**
+ * @brief 设计二阶高通
+ * @param design 输出系数
+ * @param fs 采样率(Hz)
+ * @param fc 截止频率(Hz)，0 < fc < fs/2
+ * @param q 品质因数，0.7071为Butterworth
+ * @return 0成功，-1参数错误
+ */
+int Biquad_DesignHighPass(Biquad_Design_t *design, double fs, double fc, double q);
+
+/**
+ * @brief 设计陷波器
+ * @param design 输出系数
+ * @param fs 采样率(Hz)
+ * @param fc 陷波中心频率(Hz)，如50/60 Hz工频
+ * @param q 品质因数，越大陷波越窄（-3dB带宽 = fc/q）
+ * @return 0成功，-1参数错误
+ */
+int Biquad_DesignNotch(Biquad_Design_t *design, double fs, double fc, double q);
+
+/**
+ * @brief 设计带通（中心频率增益0 dB）
+ * @param design 输出系数
+ * @param fs 采样率(Hz)
+ * @param fc 中心频率(Hz)
+ * @param q 品质因数（-3dB带宽 = fc/q）
+ * @return 0成功，-1参数错误
+ */
+int Biquad_DesignBandPass(Biquad_Design_t *design, double fs, double fc, double q);
+
+/* ==================== Q15 ==================== */
+
+/**
+ * @brief 初始化Q15级联滤波器
+ * @param filter 滤波器句柄
+ * @param form 实现结构
+ * @param design 各节浮点系数，共stages个
+ * @param stages 级联节数（1-BIQUAD_MAX_STAGES）
+ * @return 0成功，-1参数错误或系数超出Q14范围
+ */
+int BiquadQ15_Init(BiquadQ15_Handle_t *filter, Biquad_Form_t form,
+                   const Biquad_Design_t *design, uint8_t stages);
+
+/**
+ * @brief 清零Q15滤波器状态
+ * @param filter 滤波器句柄
+ */
+void BiquadQ15_Reset(BiquadQ15_Handle_t *filter);
+
+/**
+ * @brief 更新Q15滤波器
+ * @param filter 滤波器句柄
+ * @param new_data 新数据
+ * @return 滤波后的值（饱和到int16_t）
+ */
+int16_t BiquadQ15_Update(BiquadQ15_Handle_t *filter, int16_t new_data);
+
+/**
+ * @brief 块处理Q15滤波器
+ * @param filter 滤波器句柄
+ * @param in 输入数据
+ * @param out 输出数据（可与in相同）
+ * @param n 样本数
+ * @note 结果与逐个调用BiquadQ15_Update完全一致
+ */
+void BiquadQ15_Process(BiquadQ15_Handle_t *filter, const int16_t *in, int16_t *out, uint32_t n);
+
+/* ==================== Q31 ==================== */
+
+/**
+ * @brief 初始化Q31级联滤波器
+ * @param filter 滤波器句柄
+ * @param form 实现结构
+ * @param design 各节浮点系数，共stages个
+ * @param stages 级联节数（1-BIQUAD_MAX_STAGES）
+ * @return 0成功，-1参数错误或系数超出Q30范围
+ */
+int BiquadQ31_Init(BiquadQ31_Handle_t *filter, Biquad_Form_t form,
+                   const Biquad_Design_t *design, uint8_t stages);
+
+/**
+ * @brief 清零Q31滤波器状态
+ * @param filter 滤波器句柄
+ */
+void BiquadQ31_Reset(BiquadQ31_Handle_t *filter);
+
+/**
+ * @brief 更新Q31滤波器
+ * @param filter 滤波器句柄
+ * @param new_data 新数据，超出±BIQUAD_Q31_DATA_MAX时先饱和
+ * @return 滤波后的值（饱和到±BIQUAD_Q31_DATA_MAX）
+ */
+int32_t BiquadQ31_Update(BiquadQ31_Handle_t *filter, int32_t new_data);
+
+/**
+ * @brief 块处理Q31滤波器
+ * @param filter 滤波器句柄
+ * @param in 输入数据
+ * @param out 输出数据（可与in相同）
+ * @param n 样本数
+ * @note 结果与逐个调用BiquadQ31_Update完全一致，输入输出范围同BiquadQ31_Update
+ */
+void BiquadQ31_Process(BiquadQ31_Handle_t *filter, const int32_t *in, int32_t *out, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BIQUAD_H */
@@ -0,0 +1,224 @@
+/**
+ * @file cic.c
+ * @brief CIC抽取滤波器与补偿FIR实现
+ */
+
+#include "cic.h"
+#include <stddef.h>
+#include <string.h>
+
+/* 补偿FIR系数的小数位数 */
+#define CIC_COMP_SHIFT  14
+
+int CIC_Init(CIC_Handle_t *filter, uint8_t order, uint16_t ratio, bool compensate)
+{
+  uint64_t gain = 1;
+  uint8_t bits = 0;
+
+  if(filter == NULL || order == 0 || order > CIC_MAX_ORDER || ratio < 2)
+  {
+    return -1;
+  }
+
+  // 位增长 = N*ceil(log2(R))，加上16位输入和8位小数后须在64位以内
+  while((1UL << bits) < ratio)
+  {
+    bits++;
+  }
+  if(16U + (uint32_t)order * bits + CIC_OUTPUT_FRAC_BITS > 63U)
+  {
+    return -1;
+  }
+
+  for(uint8_t i = 0; i < order; i++)
+  {
+    gain *= ratio;
+  }
+
+  filter->order = order;
+  filter->ratio = ratio;
+  filter->gain = gain;
+  filter->gain_shift = 0xFF;
+  if((gain & (gain - 1)) == 0)
+  {
+    filter->gain_shift = 0;
+    while(((uint64_t)1 << filter->gain_shift) < gain)
+    {
+      filter->gain_shift++;
+    }
+  }
+
+  // h = [-N/24, 1 + N/12, -N/24]，Q14
+  filter->compensate = compensate;
+  filter->comp_side = (int16_t)(-(((int32_t)order << CIC_COMP_SHIFT) + 12) / 24);
+  filter->comp_center = (int16_t)((1 << CIC_COMP_SHIFT) - 2 * filter->comp_side);
+
+  CIC_Reset(filter);
+
+  return 0;
+}
+
+void CIC_Reset(CIC_Handle_t *filter)
+{
+  if(filter == NULL)
+  {
+    return;
+  }
+
+  filter->phase = 0;
+  memset(filter->integ, 0, sizeof(filter->integ));
+  memset(filter->comb, 0, sizeof(filter->comb));
+  filter->comp_hist[0] = 0;
+  filter->comp_hist[1] = 0;
+}
+
+/* 梳状器 + 增益归一化 + 补偿FIR（输出速率） */
+static int32_t CIC_Output(CIC_Handle_t *filter)
+{
+  uint64_t y = filter->integ[filter->order - 1];
+  int32_t value;
+
+  for(uint8_t i = 0; i < filter->order; i++)
+  {
+    uint64_t x = y;
+    y = x - filter->comb[i];
+    filter->comb[i] = x;
+  }
+
+  // y / R^N，保留8位小数；y < 2^16 * R^N，先商后余避免溢出
+  if(filter->gain_shift != 0xFF)
+  {
+    if(filter->gain_shift >= CIC_OUTPUT_FRAC_BITS)
+    {
+      value = (int32_t)(y >> (filter->gain_shift - CIC_OUTPUT_FRAC_BITS));
+    }
+    else
+    {
+      value = (int32_t)(y << (CIC_OUTPUT_FRAC_BITS - filter->gain_shift));
+    }
+  }
+  else
+  {
+    uint64_t q = y / filter->gain;
+    uint64_t r = y % filter->gain;
+    value = (int32_t)((q << CIC_OUTPUT_FRAC_BITS) +
+                      ((r << CIC_OUTPUT_FRAC_BITS) / filter->gain));
+  }
+
+  if(filter->compensate)
+  {
+    int64_t acc = (int64_t)filter->comp_side * ((int64_t)value + filter->comp_hist[1]) +
+                  (int64_t)filter->comp_center * filter->comp_hist[0];
+    filter->comp_hist[1] = filter->comp_hist[0];
+    filter->comp_hist[0] = value;
+    value = (int32_t)((acc + (1 << (CIC_COMP_SHIFT - 1))) >> CIC_COMP_SHIFT);
+  }
+
+  return value;
+}
+
+bool CIC_Update(CIC_Handle_t *filter, uint16_t new_data, int32_t *out)
+{
+  uint64_t x = new_data;
+
+  for(uint8_t i = 0; i < filter->order; i++)
+  {
+    filter->integ[i] += x;
+    x = filter->integ[i];
+  }
+
+  if(++filter->phase < filter->ratio)
+  {
+    return false;
+  }
+
+  filter->phase = 0;
+  *out = CIC_Output(filter);
+  return true;
+}
+
+/*
+ * 块处理：积分器在输入速率运行，是主要开销。按级数展开为独立循环，
+ * 积分器状态保存在局部变量中，每个抽取周期只写回一次。
+ */
+uint32_t CIC_Process(CIC_Handle_t *filter, const uint16_t *in, uint32_t n, int32_t *out)
+{
+  uint32_t count = 0;
+  uint32_t i = 0;
+
+  while(i < n)
+  {
+    uint32_t run = filter->ratio - filter->phase;
+    if(run > n - i)
+    {
+      run = n - i;
+    }
+
+    uint64_t s0 = filter->integ[0];
+    uint64_t s1 = filter->integ[1];
+    uint64_t s2 = filter->integ[2];
+    uint64_t s3 = filter->integ[3];
+    uint64_t s4 = filter->integ[4];
+    const uint16_t *p = &in[i];
+
+    switch(filter->order)
+    {
+      case 1:
+        for(uint32_t k = 0; k < run; k++)
+        {
+          s0 += p[k];
+        }
+        break;
+      case 2:
+        for(uint32_t k = 0; k < run; k++)
+        {
+          s0 += p[k];
+          s1 += s0;
+        }
+        break;
+      case 3:
+        for(uint32_t k = 0; k < run; k++)
+        {
+          s0 += p[k];
+          s1 += s0;
+          s2 += s1;
+        }
+        break;
+      case 4:
+        for(uint32_t k = 0; k < run; k++)
+        {
+          s0 += p[k];
+          s1 += s0;
+          s2 += s1;
+          s3 += s2;
+        }
+        break;
+      default:
+        for(uint32_t k = 0; k < run; k++)
+        {
+          s0 += p[k];
+          s1 += s0;
+          s2 += s1;
+          s3 += s2;
+          s4 += s3;
+        }
+        break;
+    }
+
+    filter->integ[0] = s0;
+    filter->integ[1] = s1;
+    filter->integ[2] = s2;
+    filter->integ[3] = s3;
+    filter->integ[4] = s4;
+
+    i += run;
+    filter->phase += (uint16_t)run;
+    if(filter->phase >= filter->ratio)
+    {
+      filter->phase = 0;
+      out[count++] = CIC_Output(filter);
+    }
+  }
+
+  return count;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file cic.h
+ * @brief CIC抽取滤波器与补偿FIR
+ * @note 仅依赖标准 C 类型，无硬件依赖
+ *
+ * N级积分器(输入速率) → 抽取R → N级梳状器(输出速率，差分延迟1)，
+ * 直流增益R^N，输出归一化后保留CIC_OUTPUT_FRAC_BITS位小数（单位为LSB/2^8），
+ * 抽取带来的过采样增益转化为额外的有效分辨率。
+ *
+ * CIC通带呈sinc^N下垂，可选3抽头补偿FIR（输出速率，延迟1个输出样本）：
+ *   h = [-N/24, 1 + N/12, -N/24]
+ * 由sinc^N的二阶泰勒展开推得，直流增益为1，低频段下垂基本抵消。
+ */
+
+#ifndef CIC_H
+#define CIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 最大级数 */
+#define CIC_MAX_ORDER         5
+
+/* 输出保留的小数位数 */
+#define CIC_OUTPUT_FRAC_BITS  8
+
+typedef struct
+{
+  uint8_t order;                      /* 级数N */
+  uint16_t ratio;                     /* 抽取比R */
+  uint16_t phase;                     /* 当前抽取相位 */
+  uint8_t gain_shift;                 /* R^N为2的幂时的移位量，否则为0xFF */
+  uint64_t gain;                      /* 直流增益R^N */
+  uint64_t integ[CIC_MAX_ORDER];      /* 积分器（模2^64运算，溢出回绕不影响结果） */
+  uint64_t comb[CIC_MAX_ORDER];       /* 梳状器延迟单元 */
+  bool compensate;                    /* 是否启用补偿FIR */
+  int16_t comp_side;                  /* 补偿FIR两侧系数，Q14 */
+  int16_t comp_center;                /* 补偿FIR中心系数，Q14 */
+  int32_t comp_hist[2];               /* 补偿FIR历史输入 */
+} CIC_Handle_t;
+
+/**
+ * @brief 初始化CIC抽取器
+ * @param filter 滤波器句柄
+ * @param order 级数（1-CIC_MAX_ORDER）
+ * @param ratio 抽取比（>=2）
+ * @param compensate 是否启用补偿FIR
+ * @return 0成功，-1参数错误或位宽不足（16 + 8 + N*ceil(log2(R)) > 63）
+ */
+int CIC_Init(CIC_Handle_t *filter, uint8_t order, uint16_t ratio, bool compensate);
+
+/**
+ * @brief 清零CIC状态
+ * @param filter 滤波器句柄
+ */
+void CIC_Reset(CIC_Handle_t *filter);
+
+/**
+ * @brief 输入一个样本
+ * @param filter 滤波器句柄
+ * @param new_data 新数据（输入速率）
+ * @param out 输出值（LSB/2^CIC_OUTPUT_FRAC_BITS）
+ * @return true本次产生了输出，false未产生输出
+ */
+bool CIC_Update(CIC_Handle_t *filter, uint16_t new_data, int32_t *out);
+
+/**
+ * @brief 块处理CIC抽取器
+ * @param filter 滤波器句柄
+ * @param in 输入数据（输入速率）
+ * @param n 输入样本数
+ * @param out 输出数据，至少n/ratio+1个
+ * @return 输出样本数
+ * @note 结果与逐个调用CIC_Update完全一致
+ */
+uint32_t CIC_Process(CIC_Handle_t *filter, const uint16_t *in, uint32_t n, int32_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIC_H */
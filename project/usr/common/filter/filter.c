@@ -4,36 +4,189 @@
  */
 
 #include "filter.h"
+#include <stddef.h>
 
 /* ==================== 移动平均滤波 ==================== */
 
+int MAF_Init(MAF_Handle_t *filter, uint16_t *buffer, uint16_t size)
+{
+  if(filter == NULL || buffer == NULL || size == 0)
+  {
+    return -1;
+  }
+
+  for(uint16_t i = 0; i < size; i++)
+  {
+    buffer[i] = 0;
+  }
+
+  filter->buffer = buffer;
+  filter->size = size;
+  filter->index = 0;
+  filter->sum = 0;
+
+  return 0;
+}
+
 uint16_t MAF_Update(MAF_Handle_t *filter, uint16_t new_data)
 {
   filter->sum -= filter->buffer[filter->index];
   filter->buffer[filter->index] = new_data;
   filter->sum += new_data;
-  filter->index = (filter->index + 1) & MAF_WINDOW_MASK;
-  return (uint16_t)(filter->sum >> 4);
+  if(++filter->index >= filter->size)
+  {
+    filter->index = 0;
+  }
+  return (uint16_t)(filter->sum / filter->size);
+}
+
+/*
+ * 块处理：状态读入局部变量，循环按两个样本展开，结束时写回。
+ * 每次迭代先读出两个输入再写输出，因此允许in与out为同一缓冲区。
+ */
+void MAF_Process(MAF_Handle_t *filter, const uint16_t *in, uint16_t *out, uint32_t n)
+{
+  uint16_t *buffer = filter->buffer;
+  const uint32_t size = filter->size;
+  uint32_t index = filter->index;
+  uint32_t sum = filter->sum;
+  uint32_t i = 0;
+
+  for(; i + 1 < n; i += 2)
+  {
+    uint16_t x0 = in[i];
+    uint16_t x1 = in[i + 1];
+
+    sum = sum - buffer[index] + x0;
+    buffer[index] = x0;
+    if(++index >= size)
+    {
+      index = 0;
+    }
+    out[i] = (uint16_t)(sum / size);
+
+    sum = sum - buffer[index] + x1;
+    buffer[index] = x1;
+    if(++index >= size)
+    {
+      index = 0;
+    }
+    out[i + 1] = (uint16_t)(sum / size);
+  }
+
+  if(i < n)
+  {
+    uint16_t x0 = in[i];
+
+    sum = sum - buffer[index] + x0;
+    buffer[index] = x0;
+    if(++index >= size)
+    {
+      index = 0;
+    }
+    out[i] = (uint16_t)(sum / size);
+  }
+
+  filter->index = (uint16_t)index;
+  filter->sum = sum;
 }
 
 /* ==================== 滑动加权滤波 ==================== */
 
-/* 权重数组，线性递减 */
-static const uint8_t s_wmaf_weights[WMAF_WINDOW_SIZE] = {
-  16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
-};
+int WMAF_Init(WMAF_Handle_t *filter, uint16_t *buffer, uint16_t size)
+{
+  if(filter == NULL || buffer == NULL || size == 0 || size > WMAF_WINDOW_MAX)
+  {
+    return -1;
+  }
 
+  for(uint16_t i = 0; i < size; i++)
+  {
+    buffer[i] = 0;
+  }
+
+  filter->buffer = buffer;
+  filter->size = size;
+  filter->index = 0;
+  filter->sum = 0;
+  filter->weighted_sum = 0;
+  filter->weight_sum = (uint32_t)size * (size + 1) / 2;
+
+  return 0;
+}
+
+/*
+ * 权重线性递减（最新样本为N，最旧为1），递推关系：
+ *   W[n] = W[n-1] - S[n-1] + N * x[n]
+ *   S[n] = S[n-1] - x[n-N] + x[n]
+ * 其中S为窗口内样本的普通和。W[n-1] - S[n-1]使窗口内每个旧样本的权重减1，
+ * 最旧样本权重降为0即移出窗口，与逐项加权求和结果完全一致。
+ */
 uint16_t WMAF_Update(WMAF_Handle_t *filter, uint16_t new_data)
 {
+  uint16_t oldest = filter->buffer[filter->index];
+
+  filter->weighted_sum = filter->weighted_sum - filter->sum + (uint32_t)filter->size * new_data;
+  filter->sum = filter->sum - oldest + new_data;
+
   filter->buffer[filter->index] = new_data;
-  filter->index = (filter->index + 1) & WMAF_WINDOW_MASK;
+  if(++filter->index >= filter->size)
+  {
+    filter->index = 0;
+  }
 
-  filter->weighted_sum = 0;
-  for(uint8_t i = 0; i < WMAF_WINDOW_SIZE; i++)
+  return (uint16_t)(filter->weighted_sum / filter->weight_sum);
+}
+
+void WMAF_Process(WMAF_Handle_t *filter, const uint16_t *in, uint16_t *out, uint32_t n)
+{
+  uint16_t *buffer = filter->buffer;
+  const uint32_t size = filter->size;
+  const uint32_t weight_sum = filter->weight_sum;
+  uint32_t index = filter->index;
+  uint32_t sum = filter->sum;
+  uint32_t weighted_sum = filter->weighted_sum;
+  uint32_t i = 0;
+
+  for(; i + 1 < n; i += 2)
   {
-    int data_index = (filter->index - 1 - i + WMAF_WINDOW_SIZE) & WMAF_WINDOW_MASK;
-    filter->weighted_sum += filter->buffer[data_index] * s_wmaf_weights[i];
+    uint16_t x0 = in[i];
+    uint16_t x1 = in[i + 1];
+
+    weighted_sum = weighted_sum - sum + size * x0;
+    sum = sum - buffer[index] + x0;
+    buffer[index] = x0;
+    if(++index >= size)
+    {
+      index = 0;
+    }
+    out[i] = (uint16_t)(weighted_sum / weight_sum);
+
+    weighted_sum = weighted_sum - sum + size * x1;
+    sum = sum - buffer[index] + x1;
+    buffer[index] = x1;
+    if(++index >= size)
+    {
+      index = 0;
+    }
+    out[i + 1] = (uint16_t)(weighted_sum / weight_sum);
+  }
+
+  if(i < n)
+  {
+    uint16_t x0 = in[i];
+
+    weighted_sum = weighted_sum - sum + size * x0;
+    sum = sum - buffer[index] + x0;
+    buffer[index] = x0;
+    if(++index >= size)
+    {
+      index = 0;
+    }
+    out[i] = (uint16_t)(weighted_sum / weight_sum);
   }
 
-  return (uint16_t)(filter->weighted_sum / WMAF_WEIGHT_SUM);
+  filter->index = (uint16_t)index;
+  filter->sum = sum;
+  filter->weighted_sum = weighted_sum;
 }
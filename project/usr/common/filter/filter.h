@@ -2,6 +2,7 @@
  * @file filter.h
  * @brief 平台无关的滤波器模块
  * @note 仅依赖标准 C 类型，无硬件依赖
+ * @note 窗口缓冲区由调用者提供，每个实例可使用不同的窗口长度
  */
 
 #ifndef FILTER_H
@@ -15,16 +16,26 @@ extern "C" {
 
 /* ==================== 移动平均滤波 (Moving Average Filter, MAF) ==================== */
 
+/* 默认窗口长度，用于定义缓冲区 */
 #define MAF_WINDOW_SIZE   16
-#define MAF_WINDOW_MASK   (MAF_WINDOW_SIZE - 1)
 
 typedef struct
 {
-  uint16_t buffer[MAF_WINDOW_SIZE];
-  uint8_t index;
+  uint16_t *buffer;
+  uint16_t size;
+  uint16_t index;
   uint32_t sum;
 } MAF_Handle_t;
 
+/**
+ * @brief 初始化移动平均滤波器
+ * @param filter 滤波器句柄
+ * @param buffer 窗口缓冲区，长度为size，由调用者分配
+ * @param size 窗口长度（1-65535）
+ * @return 0成功，-1参数错误
+ */
+int MAF_Init(MAF_Handle_t *filter, uint16_t *buffer, uint16_t size);
+
 /**
  * @brief 更新移动平均滤波器
  * @param filter 滤波器句柄
@@ -33,27 +44,62 @@ typedef struct
  */
 uint16_t MAF_Update(MAF_Handle_t *filter, uint16_t new_data);
 
+/**
+ * @brief 块处理移动平均滤波器
+ * @param filter 滤波器句柄
+ * @param in 输入数据
+ * @param out 输出数据（可与in相同）
+ * @param n 样本数
+ * @note 结果与逐个调用MAF_Update完全一致
+ */
+void MAF_Process(MAF_Handle_t *filter, const uint16_t *in, uint16_t *out, uint32_t n);
+
 /* ==================== 滑动加权滤波 (Weighted Moving Average, WMA) ==================== */
 
+/* 默认窗口长度，用于定义缓冲区 */
 #define WMAF_WINDOW_SIZE  16
-#define WMAF_WINDOW_MASK  (WMAF_WINDOW_SIZE - 1)
-#define WMAF_WEIGHT_SUM   136
+
+/* 最大窗口长度：保证 65535 * N(N+1)/2 不溢出 uint32_t */
+#define WMAF_WINDOW_MAX   361
 
 typedef struct
 {
-  uint16_t buffer[WMAF_WINDOW_SIZE];
-  uint8_t index;
+  uint16_t *buffer;
+  uint16_t size;
+  uint16_t index;
+  uint32_t sum;
   uint32_t weighted_sum;
+  uint32_t weight_sum;
 } WMAF_Handle_t;
 
+/**
+ * @brief 初始化加权移动平均滤波器
+ * @param filter 滤波器句柄
+ * @param buffer 窗口缓冲区，长度为size，由调用者分配
+ * @param size 窗口长度（1-WMAF_WINDOW_MAX）
+ * @return 0成功，-1参数错误
+ */
+int WMAF_Init(WMAF_Handle_t *filter, uint16_t *buffer, uint16_t size);
+
 /**
  * @brief 更新加权移动平均滤波器
  * @param filter 滤波器句柄
  * @param new_data 新数据
  * @return 滤波后的值
+ * @note 最新样本权重为N，最旧样本权重为1，每样本O(1)更新
  */
 uint16_t WMAF_Update(WMAF_Handle_t *filter, uint16_t new_data);
 
+/**
+ * @brief 块处理加权移动平均滤波器
+ * @param filter 滤波器句柄
+ * @param in 输入数据
+ * @param out 输出数据（可与in相同）
+ * @param n 样本数
+ * @note 结果与逐个调用WMAF_Update完全一致
+ */
+void WMAF_Process(WMAF_Handle_t *filter, const uint16_t *in, uint16_t *out, uint32_t n);
+
 /* 兼容旧类型名 */
 typedef MAF_Handle_t MovingAverageFilter;
 typedef WMAF_Handle_t WeightedMovingAverageFilter;
@@ -0,0 +1,321 @@
+/**
+ * @file median.c
+ * @brief 滑动中值滤波与Hampel离群点剔除实现
+ */
+
+#include "median.h"
+#include <stddef.h>
+
+/* ==================== 双堆维护 ==================== */
+
+/*
+ * 堆布局（heap指针指向中值）：
+ *   heap[0]           中值
+ *   heap[1..min]      最小堆，heap[i]的子节点为heap[2i]、heap[2i+1]
+ *   heap[-1..-max]    最大堆，heap[i]的子节点为heap[2i]、heap[2i-1]
+ * 负数除以2向零取整，正好得到最大堆中的父节点。
+ */
+
+/* 堆位置i处的样本小于位置j处的样本 */
+static inline int Median_Less(const Median_Handle_t *f, int i, int j)
+{
+  return f->data[f->heap[i]] < f->data[f->heap[j]];
+}
+
+/* 交换堆位置i、j并更新位置索引 */
+static inline int Median_Exchange(Median_Handle_t *f, int i, int j)
+{
+  uint16_t t = f->heap[i];
+
+  f->heap[i] = f->heap[j];
+  f->heap[j] = t;
+  f->pos[f->heap[i]] = (int16_t)i;
+  f->pos[f->heap[j]] = (int16_t)j;
+  return 1;
+}
+
+/* 位置i处小于位置j处时交换，返回是否交换 */
+static inline int Median_CmpExch(Median_Handle_t *f, int i, int j)
+{
+  return Median_Less(f, i, j) && Median_Exchange(f, i, j);
+}
+
+/* 最小堆：自位置i下沉 */
+static void Median_MinSortDown(Median_Handle_t *f, int i)
+{
+  for(i *= 2; i <= f->min_count; i *= 2)
+  {
+    if(i < f->min_count && Median_Less(f, i + 1, i))
+    {
+      ++i;
+    }
+    if(!Median_CmpExch(f, i, i / 2))
+    {
+      break;
+    }
+  }
+}
+
+/* 最大堆：自位置i下沉 */
+static void Median_MaxSortDown(Median_Handle_t *f, int i)
+{
+  for(i *= 2; i >= -(int)f->max_count; i *= 2)
+  {
+    if(i > -(int)f->max_count && Median_Less(f, i, i - 1))
+    {
+      --i;
+    }
+    if(!Median_CmpExch(f, i / 2, i))
+    {
+      break;
+    }
+  }
+}
+
+/* 最小堆：自位置i上浮（可到达中值），返回是否到达中值 */
+static int Median_MinSortUp(Median_Handle_t *f, int i)
+{
+  while(i > 0 && Median_CmpExch(f, i, i / 2))
+  {
+    i /= 2;
+  }
+  return i == 0;
+}
+
+/* 最大堆：自位置i上浮（可到达中值），返回是否到达中值 */
+static int Median_MaxSortUp(Median_Handle_t *f, int i)
+{
+  while(i < 0 && Median_CmpExch(f, i / 2, i))
+  {
+    i /= 2;
+  }
+  return i == 0;
+}
+
+/* ==================== 滑动中值滤波 ==================== */
+
+int Median_Init(Median_Handle_t *filter, uint16_t *work, uint16_t size)
+{
+  if(filter == NULL || work == NULL || size == 0 || size > MEDIAN_WINDOW_MAX)
+  {
+    return -1;
+  }
+
+  filter->data = work;
+  filter->pos = (int16_t *)(work + size);
+  filter->heap = work + 2U * size + size / 2U;
+  filter->size = size;
+  filter->index = 0;
+  filter->min_count = 0;
+  filter->max_count = 0;
+
+  // 样本i的初始位置：0, 1, -1, 2, -2 ... 交替放入最小堆/最大堆两侧
+  for(int i = (int)size - 1; i >= 0; i--)
+  {
+    int p = ((i + 1) / 2) * ((i & 1) ? -1 : 1);
+    filter->data[i] = 0;
+    filter->pos[i] = (int16_t)p;
+    filter->heap[p] = (uint16_t)i;
+  }
+
+  return 0;
+}
+
+uint16_t Median_Update(Median_Handle_t *filter, uint16_t new_data)
+{
+  int p = filter->pos[filter->index];
+  uint16_t old = filter->data[filter->index];
+
+  filter->data[filter->index] = new_data;
+  if(++filter->index >= filter->size)
+  {
+    filter->index = 0;
+  }
+
+  if(p > 0)
+  {
+    // 新样本位于最小堆
+    if(filter->min_count < (filter->size - 1) / 2)
+    {
+      filter->min_count++;
+    }
+    else if(new_data > old)
+    {
+      Median_MinSortDown(filter, p);
+      return filter->data[filter->heap[0]];
+    }
+    if(Median_MinSortUp(filter, p) && Median_CmpExch(filter, 0, -1))
+    {
+      Median_MaxSortDown(filter, -1);
+    }
+  }
+  else if(p < 0)
+  {
+    // 新样本位于最大堆
+    if(filter->max_count < filter->size / 2)
+    {
+      filter->max_count++;
+    }
+    else if(new_data < old)
+    {
+      Median_MaxSortDown(filter, p);
+      return filter->data[filter->heap[0]];
+    }
+    if(Median_MaxSortUp(filter, p) && filter->min_count > 0 && Median_CmpExch(filter, 1, 0))
+    {
+      Median_MinSortDown(filter, 1);
+    }
+  }
+  else
+  {
+    // 新样本即中值
+    if(filter->max_count > 0 && Median_MaxSortUp(filter, -1))
+    {
+      Median_MaxSortDown(filter, -1);
+    }
+    if(filter->min_count > 0 && Median_MinSortUp(filter, 1))
+    {
+      Median_MinSortDown(filter, 1);
+    }
+  }
+
+  return filter->data[filter->heap[0]];
+}
+
+void Median_Process(Median_Handle_t *filter, const uint16_t *in, uint16_t *out, uint32_t n)
+{
+  for(uint32_t i = 0; i < n; i++)
+  {
+    out[i] = Median_Update(filter, in[i]);
+  }
+}
+
+/* ==================== Hampel离群点剔除 ==================== */
+
+/* 1.4826（正态分布下MAD到标准差的换算系数），Q8 */
+#define HAMPEL_MAD_SCALE_Q8   380U
+
+/* 快速选择：返回buf[0..n-1]中第k小的元素（会打乱buf） */
+static uint16_t Hampel_Select(uint16_t *buf, uint16_t n, uint16_t k)
+{
+  uint16_t lo = 0;
+  uint16_t hi = n - 1;
+
+  while(lo < hi)
+  {
+    uint16_t pivot = buf[(lo + hi) / 2];
+    uint16_t i = lo;
+    uint16_t j = hi;
+
+    while(i <= j)
+    {
+      while(buf[i] < pivot)
+      {
+        i++;
+      }
+      while(buf[j] > pivot)
+      {
+        j--;
+      }
+      if(i <= j)
+      {
+        uint16_t t = buf[i];
+        buf[i] = buf[j];
+        buf[j] = t;
+        i++;
+        if(j == 0)
+        {
+          break;
+        }
+        j--;
+      }
+    }
+
+    if(k <= j)
+    {
+      hi = j;
+    }
+    else if(k >= i)
+    {
+      lo = i;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  return buf[k];
+}
+
+int Hampel_Init(Hampel_Handle_t *filter, uint16_t *work, uint16_t size, uint16_t k_q8)
+{
+  if(filter == NULL || work == NULL || size < 3 || size > HAMPEL_WINDOW_MAX)
+  {
+    return -1;
+  }
+
+  if(Median_Init(&filter->median, work, size) != 0)
+  {
+    return -1;
+  }
+
+  filter->scratch = work + MEDIAN_WORK_LEN(size);
+  filter->k_q8 = k_q8;
+  filter->count = 0;
+  filter->replaced = 0;
+
+  return 0;
+}
+
+uint16_t Hampel_Update(Hampel_Handle_t *filter, uint16_t new_data)
+{
+  Median_Handle_t *m = &filter->median;
+  const uint16_t size = m->size;
+  uint16_t med = Median_Update(m, new_data);
+  uint16_t n = size;
+
+  // 预热：中值已按已有样本计算，MAD同样只统计已写入的data[0..n-1]，
+  // 否则未写入位置的初始0会把MAD放大到信号电平
+  if(filter->count < size)
+  {
+    n = ++filter->count;
+  }
+
+  // 插入后index指向最旧样本，中心样本在其后(N-1)/2处
+  uint16_t center_index = (uint16_t)((m->index + (size - 1) / 2) % size);
+  uint16_t center = m->data[center_index];
+
+  if(center_index >= n)
+  {
+    return center;
+  }
+
+  for(uint16_t i = 0; i < n; i++)
+  {
+    uint16_t x = m->data[i];
+    filter->scratch[i] = (x > med) ? (uint16_t)(x - med) : (uint16_t)(med - x);
+  }
+  uint16_t mad = Hampel_Select(filter->scratch, n, (uint16_t)((n - 1) / 2));
+
+  // |x - m| > k * 1.4826 * MAD，两边同乘2^16后用整数比较
+  uint32_t dev = (center > med) ? (uint32_t)(center - med) : (uint32_t)(med - center);
+  uint64_t lhs = (uint64_t)dev << 16;
+  uint64_t rhs = (uint64_t)filter->k_q8 * HAMPEL_MAD_SCALE_Q8 * mad;
+
+  if(lhs > rhs)
+  {
+    filter->replaced++;
+    return med;
+  }
+
+  return center;
+}
+
+void Hampel_Process(Hampel_Handle_t *filter, const uint16_t *in, uint16_t *out, uint32_t n)
+{
+  for(uint32_t i = 0; i < n; i++)
+  {
+    out[i] = Hampel_Update(filter, in[i]);
+  }
+}
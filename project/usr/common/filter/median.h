@@ -0,0 +1,118 @@
+/**
+ * @file median.h
+ * @brief 滑动中值滤波与Hampel离群点剔除
+ * @note 仅依赖标准 C 类型，无硬件依赖
+ * @note 工作缓冲区由调用者提供，内存占用固定
+ *
+ * 中值滤波采用双堆(mediator)结构：以中值为根，一侧为最大堆、一侧为最小堆，
+ * 每个样本记录其在堆中的位置，新样本直接替换最旧样本后上浮/下沉，
+ * 每样本更新为O(log N)。
+ *
+ * Hampel滤波以窗口中值m和中值绝对偏差MAD判断中心样本：
+ * |x - m| > k * 1.4826 * MAD 时输出m，否则输出原值，输出延迟(N-1)/2个样本。
+ */
+
+#ifndef MEDIAN_H
+#define MEDIAN_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== 滑动中值滤波 ==================== */
+
+/* 工作缓冲区长度（uint16_t个数）：样本、位置、堆各N个 */
+#define MEDIAN_WORK_LEN(n)    (3U * (n))
+
+/* 最大窗口长度（堆位置以int16_t存储） */
+#define MEDIAN_WINDOW_MAX     32767
+
+typedef struct
+{
+  uint16_t *data;       /* 样本环形队列 */
+  int16_t *pos;         /* 各样本在堆中的位置（相对中值） */
+  uint16_t *heap;       /* 指向堆存储的中值位置，负下标为最大堆，正下标为最小堆 */
+  uint16_t size;
+  uint16_t index;       /* 下一个写入（最旧样本）位置 */
+  uint16_t min_count;   /* 最小堆元素数 */
+  uint16_t max_count;   /* 最大堆元素数 */
+} Median_Handle_t;
+
+/**
+ * @brief 初始化中值滤波器
+ * @param filter 滤波器句柄
+ * @param work 工作缓冲区，长度MEDIAN_WORK_LEN(size)，由调用者分配
+ * @param size 窗口长度（1-MEDIAN_WINDOW_MAX），偶数时取上中值
+ * @return 0成功，-1参数错误
+ */
+int Median_Init(Median_Handle_t *filter, uint16_t *work, uint16_t size);
+
+/**
+ * @brief 更新中值滤波器
+ * @param filter 滤波器句柄
+ * @param new_data 新数据
+ * @return 窗口中值（窗口未填满时按已有样本计算）
+ */
+uint16_t Median_Update(Median_Handle_t *filter, uint16_t new_data);
+
+/**
+ * @brief 块处理中值滤波器
+ * @param filter 滤波器句柄
+ * @param in 输入数据
+ * @param out 输出数据（可与in相同）
+ * @param n 样本数
+ */
+void Median_Process(Median_Handle_t *filter, const uint16_t *in, uint16_t *out, uint32_t n);
+
+/* ==================== Hampel离群点剔除 ==================== */
+
+/* 最大窗口长度（MAD在O(N)临时缓冲区上计算） */
+#define HAMPEL_WINDOW_MAX     64
+
+/* 工作缓冲区长度（uint16_t个数）：中值滤波工作区 + MAD临时区 */
+#define HAMPEL_WORK_LEN(n)    (MEDIAN_WORK_LEN(n) + (n))
+
+typedef struct
+{
+  Median_Handle_t median;
+  uint16_t *scratch;    /* MAD计算临时区 */
+  uint16_t k_q8;        /* 门限系数k，Q8格式（3.0 = 768） */
+  uint16_t count;       /* 已写入的样本数，窗口填满后等于size */
+  uint32_t replaced;    /* 已剔除的样本数 */
+} Hampel_Handle_t;
+
+/**
+ * @brief 初始化Hampel滤波器
+ * @param filter 滤波器句柄
+ * @param work 工作缓冲区，长度HAMPEL_WORK_LEN(size)，由调用者分配
+ * @param size 窗口长度（3-HAMPEL_WINDOW_MAX，建议奇数）
+ * @param k_q8 门限系数k，Q8格式，常用3.0（768）
+ * @return 0成功，-1参数错误
+ */
+int Hampel_Init(Hampel_Handle_t *filter, uint16_t *work, uint16_t size, uint16_t k_q8);
+
+/**
+ * @brief 更新Hampel滤波器
+ * @param filter 滤波器句柄
+ * @param new_data 新数据
+ * @return 窗口中心样本，判为离群点时替换为窗口中值
+ * @note 窗口未填满时中值与MAD只统计已写入的样本，中心样本尚未写入时输出0
+ */
+uint16_t Hampel_Update(Hampel_Handle_t *filter, uint16_t new_data);
+
+/**
+ * @brief 块处理Hampel滤波器
+ * @param filter 滤波器句柄
+ * @param in 输入数据
+ * @param out 输出数据（可与in相同）
+ * @param n 样本数
+ */
+void Hampel_Process(Hampel_Handle_t *filter, const uint16_t *in, uint16_t *out, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEDIAN_H */
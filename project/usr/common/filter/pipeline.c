@@ -0,0 +1,398 @@
+/**
+ * @file pipeline.c
+ * @brief 描述符表驱动的滤波流水线实现
+ */
+
+#include "pipeline.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/* ==================== 级配置 ==================== */
+
+static int Pipeline_SetupIir(Pipeline_Stage_t *stage, float rate)
+{
+  Biquad_Design_t design[BIQUAD_MAX_STAGES];
+  uint8_t kind = (uint8_t)(stage->desc.param[0] & 0xFFU);
+  uint8_t sections = (uint8_t)(stage->desc.param[0] >> 8);
+  double fc = (double)stage->desc.param[1];
+  double q = (double)stage->desc.param[2] / 100.0;
+  int ret;
+
+  if(sections == 0)
+  {
+    sections = 1;
+  }
+  if(sections > BIQUAD_MAX_STAGES)
+  {
+    return -1;
+  }
+
+  switch(kind)
+  {
+    case PIPE_IIR_LOWPASS:
+      ret = Biquad_DesignLowPass(&design[0], rate, fc, q);
+      break;
+    case PIPE_IIR_HIGHPASS:
+      ret = Biquad_DesignHighPass(&design[0], rate, fc, q);
+      break;
+    case PIPE_IIR_NOTCH:
+      ret = Biquad_DesignNotch(&design[0], rate, fc, q);
+      break;
+    case PIPE_IIR_BANDPASS:
+      ret = Biquad_DesignBandPass(&design[0], rate, fc, q);
+      break;
+    default:
+      ret = -1;
+      break;
+  }
+  if(ret != 0)
+  {
+    return -1;
+  }
+
+  // 多节级联使用相同系数
+  for(uint8_t i = 1; i < sections; i++)
+  {
+    design[i] = design[0];
+  }
+
+  return BiquadQ31_Init(&stage->u.iir, BIQUAD_DF1, design, sections);
+}
+
+/*
+ * 按描述符初始化一级，rate/frac为本级输入的采样率与小数位数，
+ * 返回时更新为本级输出的采样率与小数位数
+ */
+static int Pipeline_SetupStage(Pipeline_Stage_t *stage, const Pipeline_StageDesc_t *desc,
+                               uint8_t index, float *rate, uint8_t *frac)
+{
+  const uint16_t *param = desc->param;
+
+  stage->desc = *desc;
+  stage->frac = *frac;
+
+  switch(desc->type)
+  {
+    case PIPE_STAGE_CIC:
+      // CIC直接读取uint16_t原始码值
+      if(index != 0 ||
+         CIC_Init(&stage->u.cic, (uint8_t)param[0], param[1], param[2] != 0) != 0)
+      {
+        return -1;
+      }
+      *rate /= (float)param[1];
+      *frac = CIC_OUTPUT_FRAC_BITS;
+      return 0;
+
+    case PIPE_STAGE_IIR:
+      return Pipeline_SetupIir(stage, *rate);
+
+    case PIPE_STAGE_MEDIAN:
+      if(param[0] == 0 || param[0] > PIPELINE_MEDIAN_MAX)
+      {
+        return -1;
+      }
+      return Median_Init(&stage->u.median, stage->work, param[0]);
+
+    case PIPE_STAGE_MAF:
+      if(param[0] == 0 || param[0] > PIPELINE_WORK_LEN)
+      {
+        return -1;
+      }
+      return MAF_Init(&stage->u.maf, stage->work, param[0]);
+
+    case PIPE_STAGE_WMAF:
+      if(param[0] == 0 || param[0] > PIPELINE_WORK_LEN)
+      {
+        return -1;
+      }
+      return WMAF_Init(&stage->u.wmaf, stage->work, param[0]);
+
+    case PIPE_STAGE_STATS:
+      memset(&stage->u.stats, 0, sizeof(stage->u.stats));
+      return 0;
+
+    case PIPE_STAGE_SCALE:
+      if(param[2] > 31U)
+      {
+        return -1;
+      }
+      *frac = 0;
+      return 0;
+
+    case PIPE_STAGE_TRACKER:
+      if(param[0] == 0)
+      {
+        Kalman_Init(&stage->u.kalman, param[1], (uint32_t)param[2] << 8);
+      }
+      else if(param[0] == 1)
+      {
+        AlphaBeta_Init(&stage->u.alpha_beta, param[1], (uint32_t)param[2] << 8);
+      }
+      else
+      {
+        return -1;
+      }
+      return 0;
+
+    default:
+      return -1;
+  }
+}
+
+int Pipeline_Init(Pipeline_Handle_t *pipe, int32_t *buf, uint32_t block_len, float sample_rate)
+{
+  if(pipe == NULL || buf == NULL || block_len == 0 || sample_rate <= 0.0f)
+  {
+    return -1;
+  }
+
+  pipe->count = 0;
+  pipe->buf[0] = buf;
+  pipe->buf[1] = buf + block_len;
+  pipe->block_len = block_len;
+  pipe->sample_rate = sample_rate;
+  pipe->out_rate = sample_rate;
+  pipe->out_frac = 0;
+  pipe->truncated = 0;
+
+  return 0;
+}
+
+int Pipeline_Configure(Pipeline_Handle_t *pipe, const Pipeline_StageDesc_t *desc, uint8_t count)
+{
+  Pipeline_Stage_t trial;
+  float rate;
+  uint8_t frac;
+  uint8_t n = 0;
+
+  if(pipe == NULL || (desc == NULL && count != 0) || count > PIPELINE_MAX_STAGES)
+  {
+    return -1;
+  }
+
+  while(n < count && desc[n].type != PIPE_STAGE_NONE)
+  {
+    n++;
+  }
+
+  // 先在临时对象上试配置全部级，任一级非法则保留原配置
+  rate = pipe->sample_rate;
+  frac = 0;
+  for(uint8_t i = 0; i < n; i++)
+  {
+    if(Pipeline_SetupStage(&trial, &desc[i], i, &rate, &frac) != 0)
+    {
+      return -1;
+    }
+  }
+
+  rate = pipe->sample_rate;
+  frac = 0;
+  for(uint8_t i = 0; i < n; i++)
+  {
+    (void)Pipeline_SetupStage(&pipe->stage[i], &desc[i], i, &rate, &frac);
+  }
+
+  pipe->count = n;
+  pipe->out_rate = rate;
+  pipe->out_frac = frac;
+
+  return 0;
+}
+
+/* ==================== 块处理 ==================== */
+
+/* 去掉小数位并饱和到uint16_t码值 */
+static inline uint16_t Pipeline_ToCode(int32_t x, uint8_t frac)
+{
+  x >>= frac;
+  if(x < 0)
+  {
+    return 0;
+  }
+  if(x > UINT16_MAX)
+  {
+    return UINT16_MAX;
+  }
+  return (uint16_t)x;
+}
+
+static void Pipeline_AccumulateStats(Pipeline_StatsAcc_t *acc, const int32_t *src, uint32_t n)
+{
+  for(uint32_t i = 0; i < n; i++)
+  {
+    int32_t x = src[i];
+
+    if(acc->count == 0 || x < acc->min)
+    {
+      acc->min = x;
+    }
+    if(acc->count == 0 || x > acc->max)
+    {
+      acc->max = x;
+    }
+    acc->sum += x;
+    acc->sum_sq += (double)x * (double)x;
+    acc->count++;
+  }
+}
+
+/* 执行一级：src → dst，返回输出样本数 */
+static uint32_t Pipeline_RunStage(Pipeline_Stage_t *stage, const int32_t *src, int32_t *dst,
+                                  uint32_t n)
+{
+  const uint8_t frac = stage->frac;
+
+  switch(stage->desc.type)
+  {
+    case PIPE_STAGE_IIR:
+      BiquadQ31_Process(&stage->u.iir, src, dst, n);
+      break;
+
+    case PIPE_STAGE_MEDIAN:
+      for(uint32_t i = 0; i < n; i++)
+      {
+        dst[i] = (int32_t)Median_Update(&stage->u.median, Pipeline_ToCode(src[i], frac)) << frac;
+      }
+      break;
+
+    case PIPE_STAGE_MAF:
+      for(uint32_t i = 0; i < n; i++)
+      {
+        dst[i] = (int32_t)MAF_Update(&stage->u.maf, Pipeline_ToCode(src[i], frac)) << frac;
+      }
+      break;
+
+    case PIPE_STAGE_WMAF:
+      for(uint32_t i = 0; i < n; i++)
+      {
+        dst[i] = (int32_t)WMAF_Update(&stage->u.wmaf, Pipeline_ToCode(src[i], frac)) << frac;
+      }
+      break;
+
+    case PIPE_STAGE_SCALE:
+    {
+      // y = (x - offset) * mul >> shift，offset以码值给出
+      const int64_t offset = (int64_t)stage->desc.param[0] << frac;
+      const int64_t mul = (int16_t)stage->desc.param[1];
+      const uint8_t shift = (uint8_t)(stage->desc.param[2] + frac);
+
+      for(uint32_t i = 0; i < n; i++)
+      {
+        dst[i] = (int32_t)(((src[i] - offset) * mul) >> shift);
+      }
+      break;
+    }
+
+    case PIPE_STAGE_TRACKER:
+      if(stage->desc.param[0] == 0)
+      {
+        for(uint32_t i = 0; i < n; i++)
+        {
+          dst[i] = Kalman_Update(&stage->u.kalman, src[i]);
+        }
+      }
+      else
+      {
+        for(uint32_t i = 0; i < n; i++)
+        {
+          dst[i] = AlphaBeta_Update(&stage->u.alpha_beta, src[i]);
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return n;
+}
+
+uint32_t Pipeline_Process(Pipeline_Handle_t *pipe, const uint16_t *in, uint32_t n,
+                          const int32_t **out)
+{
+  uint8_t cur = 0;
+  uint8_t first = 0;
+
+  // 乒乓缓冲区只能容纳block_len个样本，超出部分丢弃并计数
+  if(n > pipe->block_len)
+  {
+    pipe->truncated += n - pipe->block_len;
+    n = pipe->block_len;
+  }
+
+  // 第一级：CIC直接读取原始码值，否则扩展为int32_t
+  if(pipe->count > 0 && pipe->stage[0].desc.type == PIPE_STAGE_CIC)
+  {
+    n = CIC_Process(&pipe->stage[0].u.cic, in, n, pipe->buf[0]);
+    first = 1;
+  }
+  else
+  {
+    for(uint32_t i = 0; i < n; i++)
+    {
+      pipe->buf[0][i] = in[i];
+    }
+  }
+
+  for(uint8_t i = first; i < pipe->count && n > 0; i++)
+  {
+    Pipeline_Stage_t *stage = &pipe->stage[i];
+
+    if(stage->desc.type == PIPE_STAGE_STATS)
+    {
+      Pipeline_AccumulateStats(&stage->u.stats, pipe->buf[cur], n);
+      continue;
+    }
+
+    n = Pipeline_RunStage(stage, pipe->buf[cur], pipe->buf[cur ^ 1U], n);
+    cur ^= 1U;
+  }
+
+  if(out != NULL)
+  {
+    *out = pipe->buf[cur];
+  }
+
+  return n;
+}
+
+int Pipeline_GetStats(Pipeline_Handle_t *pipe, Pipeline_Stats_t *stats)
+{
+  if(pipe == NULL || stats == NULL)
+  {
+    return -1;
+  }
+
+  for(uint8_t i = 0; i < pipe->count; i++)
+  {
+    Pipeline_StatsAcc_t *acc = &pipe->stage[i].u.stats;
+    double mean;
+    double var;
+
+    if(pipe->stage[i].desc.type != PIPE_STAGE_STATS)
+    {
+      continue;
+    }
+    if(acc->count == 0)
+    {
+      return -1;
+    }
+
+    mean = (double)acc->sum / (double)acc->count;
+    var = acc->sum_sq / (double)acc->count - mean * mean;
+
+    stats->mean = (int32_t)lround(mean);
+    stats->min = acc->min;
+    stats->max = acc->max;
+    stats->std = (var > 0.0) ? (int32_t)lround(sqrt(var)) : 0;
+    stats->count = acc->count;
+
+    memset(acc, 0, sizeof(*acc));
+    return 0;
+  }
+
+  return -1;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file pipeline.h
+ * @brief 描述符表驱动的滤波流水线
+ * @note 仅依赖标准 C 类型与本目录下的滤波器，无硬件依赖
+ * @note 乒乓缓冲区由调用者提供，每个通道一个实例
+ *
+ * 流水线由若干级串联而成，每级由一个描述符（类型 + 3个参数）定义，
+ * 描述符均为uint16_t，可直接映射到Modbus保持寄存器，运行时重新配置。
+ *
+ * 数据以int32_t块在两个缓冲区之间交替传递（乒乓），级间不拷贝：
+ * 每级从当前缓冲区读、向另一缓冲区写，随后交换；统计级只读不写。
+ *
+ * 样本格式：原始ADC码值，CIC抽取后附带CIC_OUTPUT_FRAC_BITS位小数。
+ * 中值/MAF/WMAF级内部按整数码值（去掉小数位并饱和到uint16_t）运算，
+ * 单位换算级输出工程量整数，此后小数位清零。
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+#include "filter.h"
+#include "biquad.h"
+#include "median.h"
+#include "cic.h"
+#include "tracker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 最大级数 */
+#define PIPELINE_MAX_STAGES     5
+
+/* 每级工作缓冲区长度（uint16_t个数），限制MAF/WMAF/中值窗口 */
+#define PIPELINE_WORK_LEN       64
+
+/* 中值级最大窗口 */
+#define PIPELINE_MEDIAN_MAX     (PIPELINE_WORK_LEN / 3)
+
+/* 描述符参数个数 */
+#define PIPELINE_STAGE_PARAMS   3
+
+/* 级类型 */
+typedef enum
+{
+  PIPE_STAGE_NONE = 0,  /* 结束标记，其后各级忽略 */
+  PIPE_STAGE_CIC,       /* CIC抽取：级数、抽取比、补偿FIR(0/1)，只能作为第一级 */
+  PIPE_STAGE_IIR,       /* Q31双二阶：类型|(节数<<8)、fc(Hz)、Q*100 */
+  PIPE_STAGE_MEDIAN,    /* 滑动中值：窗口长度 */
+  PIPE_STAGE_MAF,       /* 移动平均：窗口长度 */
+  PIPE_STAGE_WMAF,      /* 加权移动平均：窗口长度 */
+  PIPE_STAGE_STATS,     /* 统计（直通）：无参数 */
+  PIPE_STAGE_SCALE,     /* 单位换算：偏移(码值)、乘数(int16)、右移位数 */
+  PIPE_STAGE_TRACKER,   /* 跟踪器：模型(0卡尔曼/1 alpha-beta)、Q(Q8)、R（仅Q/R比值有效） */
+  PIPE_STAGE_TYPE_NUM
+} Pipeline_StageType_t;
+
+/* IIR级类型（参数0低字节） */
+typedef enum
+{
+  PIPE_IIR_LOWPASS = 0,
+  PIPE_IIR_HIGHPASS,
+  PIPE_IIR_NOTCH,
+  PIPE_IIR_BANDPASS
+} Pipeline_IirType_t;
+
+/* 级描述符 */
+typedef struct
+{
+  uint16_t type;                          /* Pipeline_StageType_t */
+  uint16_t param[PIPELINE_STAGE_PARAMS];
+} Pipeline_StageDesc_t;
+
+/* 统计结果（流水线输出单位） */
+typedef struct
+{
+  int32_t mean;
+  int32_t min;
+  int32_t max;
+  int32_t std;          /* 标准差 */
+  uint32_t count;       /* 统计样本数 */
+} Pipeline_Stats_t;
+
+/* 统计级累加器 */
+typedef struct
+{
+  int64_t sum;
+  double sum_sq;
+  int32_t min;
+  int32_t max;
+  uint32_t count;
+} Pipeline_StatsAcc_t;
+
+typedef struct
+{
+  Pipeline_StageDesc_t desc;
+  uint8_t frac;                           /* 本级输入的小数位数 */
+  union
+  {
+    CIC_Handle_t cic;
+    BiquadQ31_Handle_t iir;
+    Median_Handle_t median;
+    MAF_Handle_t maf;
+    WMAF_Handle_t wmaf;
+    Pipeline_StatsAcc_t stats;
+    Kalman_Handle_t kalman;
+    AlphaBeta_Handle_t alpha_beta;
+  } u;
+  uint16_t work[PIPELINE_WORK_LEN];
+} Pipeline_Stage_t;
+
+typedef struct
+{
+  Pipeline_Stage_t stage[PIPELINE_MAX_STAGES];
+  uint8_t count;                          /* 有效级数 */
+  int32_t *buf[2];                        /* 乒乓缓冲区 */
+  uint32_t block_len;                     /* 单次处理的最大输入样本数 */
+  float sample_rate;                      /* 输入采样率(Hz) */
+  float out_rate;                         /* 输出采样率(Hz) */
+  uint8_t out_frac;                       /* 输出小数位数 */
+  uint32_t truncated;                     /* 超出block_len被丢弃的输入样本数 */
+} Pipeline_Handle_t;
+
+/**
+ * @brief 初始化流水线（空流水线，输出等于输入）
+ * @param pipe 流水线句柄
+ * @param buf 乒乓缓冲区，长度2*block_len，由调用者分配
+ * @param block_len 单次处理的最大输入样本数
+ * @param sample_rate 输入采样率(Hz)
+ * @return 0成功，-1参数错误
+ */
+int Pipeline_Init(Pipeline_Handle_t *pipe, int32_t *buf, uint32_t block_len, float sample_rate);
+
+/**
+ * @brief 按描述符表配置流水线，各级状态清零
+ * @param pipe 流水线句柄
+ * @param desc 描述符表，遇到PIPE_STAGE_NONE提前结束
+ * @param count 描述符个数（不超过PIPELINE_MAX_STAGES）
+ * @return 0成功，-1描述符非法（原配置保持不变）
+ */
+int Pipeline_Configure(Pipeline_Handle_t *pipe, const Pipeline_StageDesc_t *desc, uint8_t count);
+
+/**
+ * @brief 处理一块ADC数据
+ * @param pipe 流水线句柄
+ * @param in 输入数据（原始码值）
+ * @param n 样本数，超出block_len的部分丢弃并计入truncated
+ * @param out 输出指针，指向内部乒乓缓冲区，下次处理前有效
+ * @return 输出样本数（抽取后可能为0）
+ */
+uint32_t Pipeline_Process(Pipeline_Handle_t *pipe, const uint16_t *in, uint32_t n,
+                          const int32_t **out);
+
+/**
+ * @brief 读取第一个统计级的结果并清零累加器
+ * @param pipe 流水线句柄
+ * @param stats 统计结果
+ * @return 0成功，-1无统计级或无样本
+ */
+int Pipeline_GetStats(Pipeline_Handle_t *pipe, Pipeline_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PIPELINE_H */
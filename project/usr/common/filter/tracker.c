@@ -0,0 +1,136 @@
+/**
+ * @file tracker.c
+ * @brief 定点标量卡尔曼滤波与alpha-beta跟踪器实现
+ */
+
+#include "tracker.h"
+#include <math.h>
+#include <stddef.h>
+
+/* 状态小数位数与增益小数位数 */
+#define TRACKER_STATE_SHIFT   8
+#define TRACKER_GAIN_SHIFT    16
+#define TRACKER_GAIN_ONE      (1UL << TRACKER_GAIN_SHIFT)
+
+/* Q8状态四舍五入为整数 */
+static inline int32_t Tracker_Round(int64_t x)
+{
+  return (int32_t)((x + (1 << (TRACKER_STATE_SHIFT - 1))) >> TRACKER_STATE_SHIFT);
+}
+
+/* 增益(Q16)乘以Q8误差，四舍五入 */
+static inline int64_t Tracker_Scale(uint32_t gain, int64_t err)
+{
+  return ((int64_t)gain * err + (1 << (TRACKER_GAIN_SHIFT - 1))) >> TRACKER_GAIN_SHIFT;
+}
+
+/* ==================== 标量卡尔曼滤波 ==================== */
+
+void Kalman_Init(Kalman_Handle_t *filter, uint32_t q, uint32_t r)
+{
+  if(filter == NULL)
+  {
+    return;
+  }
+
+  filter->x = 0;
+  filter->p = r;
+  filter->q = q;
+  filter->r = r;
+  filter->ready = false;
+}
+
+void Kalman_SetNoise(Kalman_Handle_t *filter, uint32_t q, uint32_t r)
+{
+  if(filter == NULL)
+  {
+    return;
+  }
+
+  filter->q = q;
+  filter->r = r;
+}
+
+int32_t Kalman_Update(Kalman_Handle_t *filter, int32_t new_data)
+{
+  int64_t z = (int64_t)new_data << TRACKER_STATE_SHIFT;
+
+  if(!filter->ready)
+  {
+    filter->x = z;
+    filter->p = filter->r;
+    filter->ready = true;
+    return new_data;
+  }
+
+  // 预测：随机游走模型，估计值不变，方差增加Q
+  uint64_t p = filter->p + filter->q;
+  uint64_t den = p + filter->r;
+  uint32_t k = (den != 0) ? (uint32_t)((p << TRACKER_GAIN_SHIFT) / den) : TRACKER_GAIN_ONE;
+
+  // 校正
+  filter->x += Tracker_Scale(k, z - filter->x);
+  filter->p = (p * (TRACKER_GAIN_ONE - k)) >> TRACKER_GAIN_SHIFT;
+
+  return Tracker_Round(filter->x);
+}
+
+/* ==================== alpha-beta跟踪器 ==================== */
+
+void AlphaBeta_Init(AlphaBeta_Handle_t *filter, uint32_t q, uint32_t r)
+{
+  if(filter == NULL)
+  {
+    return;
+  }
+
+  filter->x = 0;
+  filter->v = 0;
+  filter->ready = false;
+  AlphaBeta_SetNoise(filter, q, r);
+}
+
+void AlphaBeta_SetNoise(AlphaBeta_Handle_t *filter, uint32_t q, uint32_t r)
+{
+  double alpha = 1.0;
+  double beta = 1.0;
+
+  if(filter == NULL)
+  {
+    return;
+  }
+
+  // Kalata：lambda = sigma_a * T^2 / sigma_v，T取1个样本
+  if(r != 0)
+  {
+    double lambda = sqrt((double)q / (double)r);
+    double s = (4.0 + lambda - sqrt(8.0 * lambda + lambda * lambda)) / 4.0;
+
+    alpha = 1.0 - s * s;
+    beta = 2.0 * (2.0 - alpha) - 4.0 * sqrt(1.0 - alpha);
+  }
+
+  filter->alpha = (uint32_t)(alpha * (double)TRACKER_GAIN_ONE + 0.5);
+  filter->beta = (uint32_t)(beta * (double)TRACKER_GAIN_ONE + 0.5);
+}
+
+int32_t AlphaBeta_Update(AlphaBeta_Handle_t *filter, int32_t new_data)
+{
+  int64_t z = (int64_t)new_data << TRACKER_STATE_SHIFT;
+
+  if(!filter->ready)
+  {
+    filter->x = z;
+    filter->v = 0;
+    filter->ready = true;
+    return new_data;
+  }
+
+  int64_t x = filter->x + filter->v;
+  int64_t residual = z - x;
+
+  filter->x = x + Tracker_Scale(filter->alpha, residual);
+  filter->v += Tracker_Scale(filter->beta, residual);
+
+  return Tracker_Round(filter->x);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file tracker.h
+ * @brief 定点标量卡尔曼滤波与alpha-beta跟踪器
+ * @note 仅依赖标准 C 库，无硬件依赖
+ * @note 每样本O(1)，噪声参数可在运行时修改
+ *
+ * 卡尔曼滤波（随机游走模型 x[k] = x[k-1] + w，z[k] = x[k] + v）：
+ *   P' = P + Q，K = P' / (P' + R)，x += K * (z - x)，P = (1 - K) * P'
+ * 适合缓变量，Q/R越小输出越平滑、跟随越慢。
+ *
+ * alpha-beta跟踪器（常速度模型）同时估计值与变化率，斜坡输入无稳态滞后：
+ *   x' = x + v，r = z - x'，x = x' + alpha*r，v += beta*r
+ * alpha/beta由跟踪指数 lambda = sqrt(Q/R) 按Kalata公式求得稳态最优值，
+ * 此时Q为每样本加速度方差。
+ *
+ * 定点格式：状态Q8（int64），增益Q16，Q、R为Q8格式的方差（单位^2 * 256），
+ * 只有Q/R的比值影响稳态增益。
+ */
+
+#ifndef TRACKER_H
+#define TRACKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== 标量卡尔曼滤波 ==================== */
+
+typedef struct
+{
+  int64_t x;            /* 估计值，Q8 */
+  uint64_t p;           /* 估计方差，Q8 */
+  uint32_t q;           /* 过程噪声方差，Q8 */
+  uint32_t r;           /* 测量噪声方差，Q8 */
+  bool ready;           /* 已用首个样本初始化 */
+} Kalman_Handle_t;
+
+/**
+ * @brief 初始化卡尔曼滤波器，首个样本直接作为初值
+ * @param filter 滤波器句柄
+ * @param q 过程噪声方差，Q8
+ * @param r 测量噪声方差，Q8
+ */
+void Kalman_Init(Kalman_Handle_t *filter, uint32_t q, uint32_t r);
+
+/**
+ * @brief 修改噪声参数，保留当前估计
+ * @param filter 滤波器句柄
+ * @param q 过程噪声方差，Q8
+ * @param r 测量噪声方差，Q8
+ */
+void Kalman_SetNoise(Kalman_Handle_t *filter, uint32_t q, uint32_t r);
+
+/**
+ * @brief 更新卡尔曼滤波器
+ * @param filter 滤波器句柄
+ * @param new_data 测量值
+ * @return 估计值（四舍五入）
+ */
+int32_t Kalman_Update(Kalman_Handle_t *filter, int32_t new_data);
+
+/* ==================== alpha-beta跟踪器 ==================== */
+
+typedef struct
+{
+  int64_t x;            /* 估计值，Q8 */
+  int64_t v;            /* 每样本变化率，Q8 */
+  uint32_t alpha;       /* Q16 */
+  uint32_t beta;        /* Q16 */
+  bool ready;           /* 已用首个样本初始化 */
+} AlphaBeta_Handle_t;
+
+/**
+ * @brief 初始化alpha-beta跟踪器，首个样本直接作为初值
+ * @param filter 跟踪器句柄
+ * @param q 每样本加速度方差，Q8
+ * @param r 测量噪声方差，Q8
+ */
+void AlphaBeta_Init(AlphaBeta_Handle_t *filter, uint32_t q, uint32_t r);
+
+/**
+ * @brief 修改噪声参数并重算alpha/beta，保留当前估计
+ * @param filter 跟踪器句柄
+ * @param q 每样本加速度方差，Q8
+ * @param r 测量噪声方差，Q8
+ */
+void AlphaBeta_SetNoise(AlphaBeta_Handle_t *filter, uint32_t q, uint32_t r);
+
+/**
+ * @brief 更新alpha-beta跟踪器
+ * @param filter 跟踪器句柄
+ * @param new_data 测量值
+ * @return 估计值（四舍五入）
+ */
+int32_t AlphaBeta_Update(AlphaBeta_Handle_t *filter, int32_t new_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACKER_H */
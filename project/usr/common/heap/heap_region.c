@@ -0,0 +1,461 @@
+/**
+ * @file    heap_region.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   分区域堆实现
+ *
+ * @details 块格式与heap_5相同：块头（下一空闲块、块大小）紧邻用户数据，
+ *          块大小最高位为已分配标志。每个区域一条按地址排序的空闲链表，
+ *          以NULL结尾；释放时与地址相邻的前后空闲块合并。
+ *          块头大小按区域对齐取整，DMA区域返回的指针与块大小均为32字节的整数倍。
+ */
+
+#include "heap_region.h"
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mem_region.h"
+
+/**
+ * @brief 块头
+ */
+typedef struct HeapRegion_Block
+{
+  struct HeapRegion_Block *next;        /**< 下一空闲块（地址递增） */
+  size_t size;                          /**< 块大小（含块头），最高位为已分配标志 */
+} HeapRegion_Block_t;
+
+/**
+ * @brief 区域描述与运行状态
+ */
+typedef struct
+{
+  const char *name;
+  uint8_t *base;                        /**< 堆存储 */
+  size_t size;                          /**< 堆存储字节数 */
+  uint32_t caps;                        /**< 区域属性 */
+  size_t align;                         /**< 块对齐（2的幂） */
+  HeapRegion_Block_t start;             /**< 空闲链表头（不属于堆存储） */
+  size_t total;
+  size_t free;
+  size_t min_free;
+  size_t allocs;
+  size_t frees;
+  size_t failures;
+} HeapRegion_Heap_t;
+
+#define HEAP_BLOCK_ALLOCATED    ((size_t)1 << (sizeof(size_t) * 8U - 1U))
+#define HEAP_DMA_ALIGN          32U
+
+/**
+ * @brief 各区域堆存储
+ */
+static uint8_t s_heap_dtcm[configTOTAL_HEAP_SIZE] MEM_DTCM;
+#if HEAP_REGION_AXI_SIZE > 0
+static uint8_t s_heap_axi[HEAP_REGION_AXI_SIZE] MEM_AXI;
+#define HEAP_AXI_BASE           s_heap_axi
+#else
+#define HEAP_AXI_BASE           NULL
+#endif
+#if HEAP_REGION_D2_SIZE > 0
+static uint8_t s_heap_d2[HEAP_REGION_D2_SIZE] MEM_D2;
+#define HEAP_D2_BASE            s_heap_d2
+#else
+#define HEAP_D2_BASE            NULL
+#endif
+#if HEAP_REGION_D3_SIZE > 0
+static uint8_t s_heap_d3[HEAP_REGION_D3_SIZE] MEM_D3;
+#define HEAP_D3_BASE            s_heap_d3
+#else
+#define HEAP_D3_BASE            NULL
+#endif
+
+static HeapRegion_Heap_t s_region[HEAP_REGION_NUM] =
+{
+  [HEAP_REGION_DTCM] = {.name = "DTCM", .base = s_heap_dtcm, .size = sizeof(s_heap_dtcm),
+                        .caps = REGION_FAST, .align = portBYTE_ALIGNMENT},
+  [HEAP_REGION_AXI]  = {.name = "AXI", .base = HEAP_AXI_BASE, .size = HEAP_REGION_AXI_SIZE,
+                        .caps = REGION_FAST | REGION_DMA, .align = HEAP_DMA_ALIGN},
+  [HEAP_REGION_D2]   = {.name = "D2", .base = HEAP_D2_BASE, .size = HEAP_REGION_D2_SIZE,
+                        .caps = REGION_DMA, .align = HEAP_DMA_ALIGN},
+  [HEAP_REGION_D3]   = {.name = "D3", .base = HEAP_D3_BASE, .size = HEAP_REGION_D3_SIZE,
+                        .caps = REGION_DMA | REGION_BDMA, .align = HEAP_DMA_ALIGN},
+};
+
+// 区域尝试顺序（按多余属性个数排序），首次分配时生成
+static uint8_t s_order[HEAP_REGION_NUM];
+static uint8_t s_initialised = 0;
+
+/* 块头大小：按区域对齐取整 */
+static size_t HeapRegion_HeaderSize(const HeapRegion_Heap_t *r)
+{
+  return (sizeof(HeapRegion_Block_t) + r->align - 1U) & ~(r->align - 1U);
+}
+
+static uint8_t HeapRegion_BitCount(uint32_t value)
+{
+  uint8_t n = 0;
+
+  for(; value != 0U; value &= value - 1U)
+  {
+    n++;
+  }
+
+  return n;
+}
+
+static void HeapRegion_Init(void)
+{
+  for(uint8_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    HeapRegion_Heap_t *r = &s_region[i];
+    uintptr_t first = ((uintptr_t)r->base + r->align - 1U) & ~(uintptr_t)(r->align - 1U);
+    uintptr_t last = ((uintptr_t)r->base + r->size) & ~(uintptr_t)(r->align - 1U);
+    HeapRegion_Block_t *blk = (HeapRegion_Block_t *)first;
+
+    r->start.next = NULL;
+    r->start.size = 0;
+    r->total = 0;
+    // 未启用的区域（base为NULL）不建立空闲块
+    if(r->base != NULL && last > first && last - first >= 2U * HeapRegion_HeaderSize(r))
+    {
+      blk->next = NULL;
+      blk->size = last - first;
+      r->start.next = blk;
+      r->total = blk->size;
+    }
+    r->free = r->total;
+    r->min_free = r->total;
+    s_order[i] = i;
+  }
+
+  // 插入排序：多余属性少的区域在前，相同时保持表中顺序
+  for(uint8_t i = 1; i < HEAP_REGION_NUM; i++)
+  {
+    uint8_t key = s_order[i];
+    uint8_t k = i;
+
+    while(k > 0 && HeapRegion_BitCount(s_region[s_order[k - 1]].caps) >
+                   HeapRegion_BitCount(s_region[key].caps))
+    {
+      s_order[k] = s_order[k - 1];
+      k--;
+    }
+    s_order[k] = key;
+  }
+
+  s_initialised = 1;
+}
+
+/* 按地址插入空闲链表，并与相邻空闲块合并 */
+static void HeapRegion_Insert(HeapRegion_Heap_t *r, HeapRegion_Block_t *blk)
+{
+  HeapRegion_Block_t *prev = &r->start;
+  HeapRegion_Block_t *next;
+
+  while(prev->next != NULL && prev->next < blk)
+  {
+    prev = prev->next;
+  }
+  next = prev->next;
+
+  if(next != NULL && (uint8_t *)blk + blk->size == (uint8_t *)next)
+  {
+    blk->size += next->size;
+    blk->next = next->next;
+  }
+  else
+  {
+    blk->next = next;
+  }
+
+  if(prev != &r->start && (uint8_t *)prev + prev->size == (uint8_t *)blk)
+  {
+    prev->size += blk->size;
+    prev->next = blk->next;
+  }
+  else
+  {
+    prev->next = blk;
+  }
+}
+
+/* 在单个区域中首次适配分配，调用方已挂起调度器 */
+static void *HeapRegion_Alloc(HeapRegion_Heap_t *r, size_t size)
+{
+  size_t header = HeapRegion_HeaderSize(r);
+  size_t want;
+  HeapRegion_Block_t *prev = &r->start;
+  HeapRegion_Block_t *blk;
+
+  if(size == 0 || size > r->free)
+  {
+    return NULL;
+  }
+
+  want = (size + header + r->align - 1U) & ~(r->align - 1U);
+  if(want < size || want > r->free)
+  {
+    return NULL;
+  }
+
+  for(blk = prev->next; blk != NULL && blk->size < want; blk = blk->next)
+  {
+    prev = blk;
+  }
+  if(blk == NULL)
+  {
+    return NULL;
+  }
+
+  prev->next = blk->next;
+
+  // 剩余部分足够容纳一个最小块时拆分
+  if(blk->size - want >= 2U * header)
+  {
+    HeapRegion_Block_t *rest = (HeapRegion_Block_t *)((uint8_t *)blk + want);
+
+    rest->size = blk->size - want;
+    blk->size = want;
+    HeapRegion_Insert(r, rest);
+  }
+
+  r->free -= blk->size;
+  if(r->free < r->min_free)
+  {
+    r->min_free = r->free;
+  }
+  r->allocs++;
+
+  blk->size |= HEAP_BLOCK_ALLOCATED;
+  blk->next = NULL;
+
+  return (uint8_t *)blk + header;
+}
+
+/* 按地址查找块所属区域 */
+static HeapRegion_Heap_t *HeapRegion_Find(const void *p)
+{
+  for(uint8_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    HeapRegion_Heap_t *r = &s_region[i];
+
+    if(r->base != NULL && (const uint8_t *)p >= r->base && (const uint8_t *)p < r->base + r->size)
+    {
+      return r;
+    }
+  }
+
+  return NULL;
+}
+
+void *pvPortMallocRegion(size_t size, uint32_t flags)
+{
+  void *p = NULL;
+
+  vTaskSuspendAll();
+  {
+    HeapRegion_Heap_t *failed = NULL;
+
+    if(s_initialised == 0)
+    {
+      HeapRegion_Init();
+    }
+
+    for(uint8_t i = 0; i < HEAP_REGION_NUM && p == NULL; i++)
+    {
+      HeapRegion_Heap_t *r = &s_region[s_order[i]];
+
+      if((r->caps & flags) != flags)
+      {
+        continue;
+      }
+      if(failed == NULL)
+      {
+        failed = r;
+      }
+      p = HeapRegion_Alloc(r, size);
+    }
+
+    // 失败计入首选区域
+    if(p == NULL && failed != NULL)
+    {
+      failed->failures++;
+    }
+
+    traceMALLOC(p, size);
+  }
+  (void)xTaskResumeAll();
+
+  return p;
+}
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+  void *p;
+
+  vTaskSuspendAll();
+  {
+    if(s_initialised == 0)
+    {
+      HeapRegion_Init();
+    }
+
+    p = HeapRegion_Alloc(&s_region[HEAP_REGION_DTCM], xWantedSize);
+    if(p == NULL)
+    {
+      s_region[HEAP_REGION_DTCM].failures++;
+    }
+
+    traceMALLOC(p, xWantedSize);
+  }
+  (void)xTaskResumeAll();
+
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+  if(p == NULL)
+  {
+    extern void vApplicationMallocFailedHook(void);
+    vApplicationMallocFailedHook();
+  }
+#endif
+
+  return p;
+}
+
+void vPortFree(void *pv)
+{
+  HeapRegion_Heap_t *r;
+  HeapRegion_Block_t *blk;
+
+  if(pv == NULL)
+  {
+    return;
+  }
+
+  r = HeapRegion_Find(pv);
+  configASSERT(r != NULL);
+  if(r == NULL)
+  {
+    return;
+  }
+
+  blk = (HeapRegion_Block_t *)((uint8_t *)pv - HeapRegion_HeaderSize(r));
+  configASSERT((blk->size & HEAP_BLOCK_ALLOCATED) != 0U);
+  configASSERT(blk->next == NULL);
+  if((blk->size & HEAP_BLOCK_ALLOCATED) == 0U || blk->next != NULL)
+  {
+    return;
+  }
+
+  blk->size &= ~HEAP_BLOCK_ALLOCATED;
+
+  vTaskSuspendAll();
+  {
+    r->free += blk->size;
+    r->frees++;
+    traceFREE(pv, blk->size);
+    HeapRegion_Insert(r, blk);
+  }
+  (void)xTaskResumeAll();
+}
+
+void *pvPortCalloc(size_t xNum, size_t xSize)
+{
+  void *p = NULL;
+
+  if(xSize == 0 || xNum <= SIZE_MAX / xSize)
+  {
+    p = pvPortMalloc(xNum * xSize);
+    if(p != NULL)
+    {
+      memset(p, 0, xNum * xSize);
+    }
+  }
+
+  return p;
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+  return (s_initialised != 0) ? s_region[HEAP_REGION_DTCM].free : configTOTAL_HEAP_SIZE;
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+  return (s_initialised != 0) ? s_region[HEAP_REGION_DTCM].min_free : configTOTAL_HEAP_SIZE;
+}
+
+void vPortInitialiseBlocks(void)
+{
+  // 首次分配时初始化，此处无需处理
+}
+
+void vPortGetRegionHeapStats(HeapRegion_Id_t region, HeapRegion_Stats_t *stats)
+{
+  const HeapRegion_Heap_t *r;
+
+  if(stats == NULL)
+  {
+    return;
+  }
+
+  memset(stats, 0, sizeof(*stats));
+  if((uint32_t)region >= HEAP_REGION_NUM)
+  {
+    return;
+  }
+
+  r = &s_region[region];
+
+  vTaskSuspendAll();
+  {
+    if(s_initialised == 0)
+    {
+      HeapRegion_Init();
+    }
+
+    for(const HeapRegion_Block_t *blk = r->start.next; blk != NULL; blk = blk->next)
+    {
+      if(blk->size > stats->largest)
+      {
+        stats->largest = blk->size;
+      }
+      if(stats->smallest == 0 || blk->size < stats->smallest)
+      {
+        stats->smallest = blk->size;
+      }
+      stats->free_blocks++;
+    }
+
+    stats->name = r->name;
+    stats->caps = r->caps;
+    stats->total = r->total;
+    stats->free = r->free;
+    stats->min_free = r->min_free;
+    stats->allocs = r->allocs;
+    stats->frees = r->frees;
+    stats->failures = r->failures;
+  }
+  (void)xTaskResumeAll();
+
+  if(stats->free != 0)
+  {
+    stats->fragmentation = (uint16_t)(1000U - (uint32_t)((uint64_t)stats->largest * 1000U / stats->free));
+  }
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats)
+{
+  HeapRegion_Stats_t stats;
+
+  vPortGetRegionHeapStats(HEAP_REGION_DTCM, &stats);
+
+  pxHeapStats->xAvailableHeapSpaceInBytes = stats.free;
+  pxHeapStats->xSizeOfLargestFreeBlockInBytes = stats.largest;
+  pxHeapStats->xSizeOfSmallestFreeBlockInBytes = stats.smallest;
+  pxHeapStats->xNumberOfFreeBlocks = stats.free_blocks;
+  pxHeapStats->xMinimumEverFreeBytesRemaining = stats.min_free;
+  pxHeapStats->xNumberOfSuccessfulAllocations = stats.allocs;
+  pxHeapStats->xNumberOfSuccessfulFrees = stats.frees;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file    heap_region.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   分区域堆（替代heap_4）
+ *
+ * @details 在heap_5的基础上按RAM区域拆分：DTCM、AXI SRAM、D2 SRAM1-3、D3 SRAM4
+ *          各有一块堆存储与独立的空闲链表（按地址排序、首次适配、释放时合并相邻块），
+ *          分配与统计互不干扰。
+ *
+ *          调用方用属性标志描述需求，分配器在满足全部标志的区域中
+ *          优先选择多余属性最少的区域，相同时按DTCM、AXI、D2、D3的顺序：
+ *
+ *          | 标志                      | 候选区域（按尝试顺序） |
+ *          |---------------------------|------------------------|
+ *          | REGION_ANY                | DTCM、D2、AXI、D3      |
+ *          | REGION_FAST               | DTCM、AXI              |
+ *          | REGION_DMA                | D2、AXI、D3            |
+ *          | REGION_DMA | REGION_FAST  | AXI                    |
+ *          | REGION_BDMA               | D3                     |
+ *
+ *          DMA区域的块按32字节（cache行）对齐并取整，维护cache时不会波及相邻块。
+ *          目标板MPU将D2/D3设为非cache，AXI为写回cache，
+ *          AXI区域的块用作DMA缓冲区时由调用方维护cache。
+ *          内核接口pvPortMalloc()/vPortGetHeapStats()只使用DTCM区域，
+ *          其大小即configTOTAL_HEAP_SIZE，行为与heap_4一致；vPortFree()可释放任意区域的块。
+ *          分配与释放在挂起调度器的情况下完成，不能在中断中调用。
+ */
+
+#ifndef HEAP_REGION_H
+#define HEAP_REGION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 各区域堆大小（字节），DTCM区域为configTOTAL_HEAP_SIZE
+ * @note  AXI/D2/D3默认为0（不启用），需要按区域分配的工程在编译选项中定义，
+ *        避免未使用时静态占用各区域RAM；为0的区域不参与分配，统计全部为0。
+ *        固件的取值在CMakeLists.txt与Keil工程的预定义宏中，两处须一致
+ */
+#ifndef HEAP_REGION_AXI_SIZE
+#define HEAP_REGION_AXI_SIZE    0
+#endif
+#ifndef HEAP_REGION_D2_SIZE
+#define HEAP_REGION_D2_SIZE     0
+#endif
+#ifndef HEAP_REGION_D3_SIZE
+#define HEAP_REGION_D3_SIZE     0
+#endif
+
+/**
+ * @brief 区域属性标志（pvPortMallocRegion的flags）
+ */
+#define REGION_ANY              0U
+#define REGION_FAST             (1U << 0)   /**< 零等待或高带宽：DTCM、AXI */
+#define REGION_DMA              (1U << 1)   /**< DMA1/DMA2/MDMA可访问：AXI、D2、D3 */
+#define REGION_BDMA             (1U << 2)   /**< BDMA可访问：D3 */
+
+/**
+ * @brief 堆区域编号
+ */
+typedef enum
+{
+  HEAP_REGION_DTCM = 0,
+  HEAP_REGION_AXI,
+  HEAP_REGION_D2,
+  HEAP_REGION_D3,
+  HEAP_REGION_NUM
+} HeapRegion_Id_t;
+
+/**
+ * @brief 区域统计（单位字节）
+ */
+typedef struct
+{
+  const char *name;                     /**< 区域名 */
+  uint32_t caps;                        /**< 区域属性（REGION_*） */
+  size_t total;                         /**< 可分配总量（扣除对齐） */
+  size_t free;                          /**< 当前剩余 */
+  size_t min_free;                      /**< 历史最小剩余 */
+  size_t largest;                       /**< 最大空闲块 */
+  size_t smallest;                      /**< 最小空闲块，无空闲块时为0 */
+  size_t free_blocks;                   /**< 空闲块数 */
+  size_t allocs;                        /**< 成功分配次数 */
+  size_t frees;                         /**< 成功释放次数 */
+  size_t failures;                      /**< 分配失败次数 */
+  uint16_t fragmentation;               /**< 碎片率（0.1%）：1 - 最大空闲块 / 剩余 */
+} HeapRegion_Stats_t;
+
+/**
+ * @brief   按区域属性分配
+ *
+ * @param[in]   size   字节数
+ * @param[in]   flags  区域属性（REGION_*组合）
+ *
+ * @return  内存指针，无满足条件的区域或空间不足时返回NULL
+ *
+ * @note    失败时不调用vApplicationMallocFailedHook，由调用方处理
+ */
+void *pvPortMallocRegion(size_t size, uint32_t flags);
+
+/**
+ * @brief   读取区域统计
+ *
+ * @param[in]   region  区域编号
+ * @param[out]  stats   区域统计
+ *
+ * @return  None
+ *
+ * @note    区域编号越界时统计全部清零
+ */
+void vPortGetRegionHeapStats(HeapRegion_Id_t region, HeapRegion_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAP_REGION_H */
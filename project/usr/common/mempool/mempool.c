@@ -0,0 +1,250 @@
+/**
+ * @file    mempool.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   固定块内存池实现
+ *
+ * @details 空闲块首字存放下一空闲块的序号+1。出栈时先读链表头再读其首字，
+ *          其间若块被其他上下文取走并重新放回，链表头的修改计数已变化，
+ *          比较交换失败后重试，不会取到过期的下一块。
+ *          占用位以比较交换原子地置位/清除，同一块被并发重复释放时只有一次成功。
+ */
+
+#include "mempool.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__arm__) || defined(__ARMCC_VERSION)
+#include "cmsis_compiler.h"
+
+/* 单核Cortex-M：异常进出会清除独占监视器，被打断时STREX失败 */
+static bool MemPool_Cas(volatile uint32_t *p, uint32_t expect, uint32_t desired)
+{
+  if(__LDREXW(p) != expect)
+  {
+    __CLREX();
+    return false;
+  }
+
+  return __STREXW(desired, p) == 0U;
+}
+#else
+static bool MemPool_Cas(volatile uint32_t *p, uint32_t expect, uint32_t desired)
+{
+  return __atomic_compare_exchange_n(p, &expect, desired, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+#define MEMPOOL_INDEX_MASK      0xFFFFU
+#define MEMPOOL_TAG_STEP        0x10000U
+
+static void MemPool_Add(volatile uint32_t *p, uint32_t delta)
+{
+  uint32_t old;
+
+  do
+  {
+    old = *p;
+  } while(!MemPool_Cas(p, old, old + delta));
+}
+
+static void MemPool_Sub(volatile uint32_t *p, uint32_t delta)
+{
+  uint32_t old;
+
+  do
+  {
+    old = *p;
+  } while(!MemPool_Cas(p, old, old - delta));
+}
+
+static void MemPool_Max(volatile uint32_t *p, uint32_t value)
+{
+  uint32_t old;
+
+  do
+  {
+    old = *p;
+    if(old >= value)
+    {
+      return;
+    }
+  } while(!MemPool_Cas(p, old, value));
+}
+
+static uint8_t *MemPool_Block(const MemPool_t *pool, uint32_t index)
+{
+  return &pool->storage[index * pool->block_size];
+}
+
+/* 原子地置位或清除块的占用位，返回修改前该位的值 */
+static bool MemPool_MarkUsed(MemPool_t *pool, uint32_t index, bool used)
+{
+  volatile uint32_t *word = &pool->used_map[index / 32U];
+  uint32_t bit = 1UL << (index % 32U);
+  uint32_t old;
+
+  do
+  {
+    old = *word;
+  } while(!MemPool_Cas(word, old, used ? (old | bit) : (old & ~bit)));
+
+  return (old & bit) != 0U;
+}
+
+#if MEMPOOL_POISON
+/* 块内除首字外是否全部为空闲填充值 */
+static bool MemPool_IsPoisoned(const MemPool_t *pool, const uint8_t *blk)
+{
+  for(uint32_t i = sizeof(uint32_t); i < pool->block_size; i++)
+  {
+    if(blk[i] != MEMPOOL_POISON_FREE)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+#endif
+
+/* 压入空闲链表 */
+static void MemPool_Push(MemPool_t *pool, uint32_t index)
+{
+  volatile uint32_t *link = (volatile uint32_t *)MemPool_Block(pool, index);
+  uint32_t old;
+  uint32_t new_head;
+
+  do
+  {
+    old = pool->head;
+    *link = old & MEMPOOL_INDEX_MASK;
+    new_head = ((old + MEMPOOL_TAG_STEP) & ~MEMPOOL_INDEX_MASK) | (index + 1U);
+  } while(!MemPool_Cas(&pool->head, old, new_head));
+}
+
+int MemPool_Init(MemPool_t *pool, const char *name, void *storage, uint32_t size, uint32_t count)
+{
+  if(pool == NULL || storage == NULL || size == 0 || count == 0 || count > MEMPOOL_MAX_BLOCKS ||
+     ((uintptr_t)storage & 7U) != 0U)
+  {
+    return -1;
+  }
+
+  pool->name = name;
+  pool->storage = (uint8_t *)storage;
+  pool->used_map = (volatile uint32_t *)&pool->storage[MEMPOOL_BLOCK_SIZE(size) * count];
+  pool->block_size = MEMPOOL_BLOCK_SIZE(size);
+  pool->block_count = (uint16_t)count;
+  pool->head = 0;
+  pool->in_use = 0;
+  pool->peak = 0;
+  pool->failures = 0;
+  pool->errors = 0;
+
+  memset((void *)pool->used_map, 0, MEMPOOL_MAP_SIZE(count));
+#if MEMPOOL_POISON
+  memset(storage, MEMPOOL_POISON_FREE, MEMPOOL_BLOCK_SIZE(size) * count);
+#endif
+
+  // 逆序压入，首次分配从第0块开始
+  for(uint32_t i = count; i > 0; i--)
+  {
+    MemPool_Push(pool, i - 1U);
+  }
+
+  return 0;
+}
+
+void *MemPool_Alloc(MemPool_t *pool)
+{
+  uint32_t old;
+  uint32_t index;
+  uint32_t next;
+  uint8_t *blk;
+
+  if(pool == NULL)
+  {
+    return NULL;
+  }
+
+  do
+  {
+    old = pool->head;
+    index = old & MEMPOOL_INDEX_MASK;
+    if(index == 0)
+    {
+      MemPool_Add(&pool->failures, 1U);
+      return NULL;
+    }
+    blk = MemPool_Block(pool, index - 1U);
+    next = *(volatile uint32_t *)blk & MEMPOOL_INDEX_MASK;
+  } while(!MemPool_Cas(&pool->head, old, ((old + MEMPOOL_TAG_STEP) & ~MEMPOOL_INDEX_MASK) | next));
+
+  MemPool_MarkUsed(pool, index - 1U, true);
+  MemPool_Add(&pool->in_use, 1U);
+  MemPool_Max(&pool->peak, pool->in_use);
+
+#if MEMPOOL_POISON
+  if(!MemPool_IsPoisoned(pool, blk))
+  {
+    MemPool_Add(&pool->errors, 1U);
+  }
+  memset(blk, MEMPOOL_POISON_ALLOC, pool->block_size);
+#endif
+
+  return blk;
+}
+
+int MemPool_Free(MemPool_t *pool, void *block)
+{
+  uintptr_t offset;
+  uint8_t *blk = (uint8_t *)block;
+
+  if(pool == NULL)
+  {
+    return -1;
+  }
+
+  offset = (uintptr_t)blk - (uintptr_t)pool->storage;
+  if(blk < pool->storage || offset >= (uintptr_t)pool->block_size * pool->block_count ||
+     offset % pool->block_size != 0U)
+  {
+    MemPool_Add(&pool->errors, 1U);
+    return -1;
+  }
+
+  // 占用位已为0：重复释放
+  if(!MemPool_MarkUsed(pool, (uint32_t)(offset / pool->block_size), false))
+  {
+    MemPool_Add(&pool->errors, 1U);
+    return -1;
+  }
+
+#if MEMPOOL_POISON
+  memset(blk, MEMPOOL_POISON_FREE, pool->block_size);
+#endif
+
+  MemPool_Sub(&pool->in_use, 1U);
+  MemPool_Push(pool, (uint32_t)(offset / pool->block_size));
+
+  return 0;
+}
+
+void MemPool_GetStats(const MemPool_t *pool, MemPool_Stats_t *stats)
+{
+  if(pool == NULL || stats == NULL)
+  {
+    return;
+  }
+
+  stats->name = pool->name;
+  stats->block_size = pool->block_size;
+  stats->block_count = pool->block_count;
+  stats->in_use = pool->in_use;
+  stats->peak = pool->peak;
+  stats->failures = pool->failures;
+  stats->errors = pool->errors;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file    mempool.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   固定块内存池
+ *
+ * @details 用于Modbus帧、日志记录、ADC样本块等定长对象，分配与释放均为O(1)。
+ *          空闲块以块序号串成LIFO链表，链表头为32位字：高16位为修改计数，
+ *          低16位为块序号+1（0表示空），以单次比较交换更新，
+ *          修改计数防止ABA，任务与中断均可调用且不关中断。
+ *          目标板使用LDREX/STREX，其他平台使用GCC原子内建函数。
+ *
+ *          存储区末尾附带占用位图（每块1位），分配时置位、释放时原子清除，
+ *          清除前已为0即为重复释放，返回-1并计入错误，所有构建均有效。
+ *
+ *          MEMPOOL_POISON为1时（Debug构建默认开启）：
+ *          - 释放时用MEMPOOL_POISON_FREE填充块（首字存链表指针除外）
+ *          - 分配时检查填充值，被改写说明释放后仍有写入，计入错误；
+ *            随后用MEMPOOL_POISON_ALLOC填充整块，便于发现未初始化使用
+ */
+
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MEMPOOL_POISON
+#define MEMPOOL_POISON          0
+#endif
+
+#define MEMPOOL_POISON_FREE     0xDDU       /**< 空闲块填充值 */
+#define MEMPOOL_POISON_ALLOC    0xCDU       /**< 新分配块填充值 */
+
+/**
+ * @brief 最多块数（块序号占链表头低16位）
+ */
+#define MEMPOOL_MAX_BLOCKS      65535U
+
+/**
+ * @brief 块大小按8字节取整（容纳链表指针并满足double/uint64_t对齐）
+ */
+#define MEMPOOL_BLOCK_SIZE(size)            (((uint32_t)(size) + 7U) & ~7U)
+
+/**
+ * @brief 占用位图字节数（按8字节取整）
+ */
+#define MEMPOOL_MAP_SIZE(count)             ((((uint32_t)(count) + 63U) / 64U) * 8U)
+
+/**
+ * @brief 存储区字节数（块 + 占用位图），存储区须8字节对齐（可声明为uint64_t数组）
+ */
+#define MEMPOOL_STORAGE_SIZE(size, count)   (MEMPOOL_BLOCK_SIZE(size) * (uint32_t)(count) + \
+                                             MEMPOOL_MAP_SIZE(count))
+
+/**
+ * @brief 内存池
+ */
+typedef struct
+{
+  const char *name;                     /**< 池名 */
+  uint8_t *storage;                     /**< 存储区 */
+  volatile uint32_t *used_map;          /**< 占用位图（位于存储区末尾） */
+  uint32_t block_size;                  /**< 块大小（取整后） */
+  uint16_t block_count;                 /**< 块数 */
+  volatile uint32_t head;               /**< 空闲链表头：[31:16]修改计数 [15:0]块序号+1 */
+  volatile uint32_t in_use;             /**< 已分配块数 */
+  volatile uint32_t peak;               /**< 已分配块数峰值 */
+  volatile uint32_t failures;           /**< 池空导致的分配失败次数 */
+  volatile uint32_t errors;             /**< 非法释放、重复释放与填充值被改写次数 */
+} MemPool_t;
+
+/**
+ * @brief 内存池统计
+ */
+typedef struct
+{
+  const char *name;                     /**< 池名 */
+  uint32_t block_size;                  /**< 块大小 */
+  uint32_t block_count;                 /**< 块数 */
+  uint32_t in_use;                      /**< 已分配块数 */
+  uint32_t peak;                        /**< 已分配块数峰值 */
+  uint32_t failures;                    /**< 分配失败次数 */
+  uint32_t errors;                      /**< 错误次数 */
+} MemPool_Stats_t;
+
+/**
+ * @brief   初始化内存池
+ *
+ * @param[out]  pool        内存池
+ * @param[in]   name        池名（须为静态字符串）
+ * @param[in]   storage     存储区（8字节对齐，至少MEMPOOL_STORAGE_SIZE(size, count)字节）
+ * @param[in]   size        对象大小（字节）
+ * @param[in]   count       块数（1 ~ MEMPOOL_MAX_BLOCKS）
+ *
+ * @return  0成功，-1参数错误
+ *
+ * @note    须在使用前调用，不可与分配/释放并发
+ */
+int MemPool_Init(MemPool_t *pool, const char *name, void *storage, uint32_t size, uint32_t count);
+
+/**
+ * @brief   分配一块
+ *
+ * @param[in,out]   pool  内存池
+ *
+ * @return  块指针，池空或pool为NULL时返回NULL
+ *
+ * @note    任务与中断上下文均可调用
+ */
+void *MemPool_Alloc(MemPool_t *pool);
+
+/**
+ * @brief   释放一块
+ *
+ * @param[in,out]   pool   内存池
+ * @param[in]       block  MemPool_Alloc()返回的块指针
+ *
+ * @return  0成功，-1块不属于该池或重复释放
+ *
+ * @note    任务与中断上下文均可调用
+ */
+int MemPool_Free(MemPool_t *pool, void *block);
+
+/**
+ * @brief   读取统计
+ *
+ * @param[in]   pool   内存池
+ * @param[out]  stats  统计
+ *
+ * @return  None
+ */
+void MemPool_GetStats(const MemPool_t *pool, MemPool_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMPOOL_H */
@@ -0,0 +1,568 @@
+/**
+ * @file    runstats.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   任务/中断运行时统计实现
+ *
+ * @details 64位扩展：记录上一次读到的32位值，新值小于旧值即回绕一次，高32位加1。
+ *          读取在后端临界区内完成，任务与中断可同时调用。
+ *          中断按窗口累计周期数与次数，RunStats_Sample()在临界区内取走并清零；
+ *          任务负载由后端任务快照中累计运行时间的差值计算。
+ *          RTOS与硬件相关部分见runstats_port.h。
+ */
+
+#include "runstats.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "runstats_port.h"
+#include "printf.h"
+
+/**
+ * @brief 滑动窗口历史
+ */
+typedef struct
+{
+  uint16_t win[RUNSTATS_HISTORY];       /**< 各窗口负载，环形存放 */
+  uint8_t head;                         /**< 下一个写入位置 */
+  uint8_t filled;                       /**< 有效窗口数 */
+  RunStats_Load_t load;                 /**< 由历史计算出的负载 */
+} RunStats_History_t;
+
+/**
+ * @brief 任务槽位
+ */
+typedef struct
+{
+  char name[RUNSTATS_NAME_LEN];         /**< 任务名副本（任务删除后TCB会被释放） */
+  uint32_t id;                          /**< 任务编号，0表示空闲槽位 */
+  uint32_t priority;                    /**< 当前优先级 */
+  uint64_t last_run;                    /**< 上一窗口结束时的累计运行时间 */
+  RunStats_History_t history;
+} RunStats_TaskSlot_t;
+
+/**
+ * @brief 中断槽位
+ */
+typedef struct
+{
+  const char *name;                     /**< 中断名，NULL表示未注册 */
+  volatile uint32_t win_cycles;         /**< 本窗口累计周期数（中断写） */
+  volatile uint32_t win_count;          /**< 本窗口次数（中断写） */
+  volatile uint32_t max_cycles;         /**< 单次最长周期数（中断写） */
+  uint32_t count;                       /**< 累计次数 */
+  uint32_t rate;                        /**< 最近一个窗口内次数 */
+  RunStats_History_t history;
+} RunStats_IrqSlot_t;
+
+static RunStats_CycleFn_t s_cycles = NULL;
+static uint32_t s_cpu_hz = 0;
+
+// 64位扩展状态
+static uint32_t s_cycles_last = 0;
+static uint32_t s_cycles_high = 0;
+
+// 窗口状态
+static uint64_t s_window_start = 0;
+static uint32_t s_window_cycles = 0;
+static uint32_t s_windows = 0;
+static RunStats_History_t s_cpu;
+static RunStats_History_t s_irq_total;
+
+static RunStats_TaskSlot_t s_task[RUNSTATS_MAX_TASKS];
+static RunStats_IrqSlot_t s_irq[RUNSTATS_MAX_IRQS];
+static uint8_t s_task_count = 0;
+
+// 任务快照（静态分配，避免占用采样任务的栈）
+static RunStats_PortTask_t s_snapshot[RUNSTATS_MAX_TASKS];
+
+/* ==================== 时基 ==================== */
+
+void RunStats_Init(RunStats_CycleFn_t cycles, uint32_t cpu_hz)
+{
+  s_cycles = cycles;
+  s_cpu_hz = cpu_hz;
+  s_cycles_last = 0;
+  s_cycles_high = 0;
+  s_windows = 0;
+  s_window_cycles = 0;
+  s_task_count = 0;
+  memset(&s_cpu, 0, sizeof(s_cpu));
+  memset(&s_irq_total, 0, sizeof(s_irq_total));
+  memset(s_task, 0, sizeof(s_task));
+  memset(s_irq, 0, sizeof(s_irq));
+}
+
+int RunStats_SetIrqName(uint8_t id, const char *name)
+{
+  if(id >= RUNSTATS_MAX_IRQS)
+  {
+    return -1;
+  }
+
+  s_irq[id].name = name;
+  return 0;
+}
+
+void RunStats_Start(void)
+{
+  s_window_start = RunStats_GetCycles64();
+}
+
+uint64_t RunStats_GetCycles64(void)
+{
+  uint32_t state;
+  uint32_t now;
+  uint64_t result;
+
+  if(s_cycles == NULL)
+  {
+    return 0;
+  }
+
+  state = RunStats_PortEnterCritical();
+  now = s_cycles();
+  if(now < s_cycles_last)
+  {
+    s_cycles_high++;
+  }
+  s_cycles_last = now;
+  result = ((uint64_t)s_cycles_high << 32) | now;
+  RunStats_PortExitCritical(state);
+
+  return result;
+}
+
+/* ==================== 中断计时 ==================== */
+
+uint32_t RunStats_IrqEnter(void)
+{
+  return (s_cycles != NULL) ? s_cycles() : 0;
+}
+
+void RunStats_IrqExit(uint8_t id, uint32_t start)
+{
+  RunStats_IrqSlot_t *slot;
+  uint32_t cycles;
+
+  if(s_cycles == NULL || id >= RUNSTATS_MAX_IRQS)
+  {
+    return;
+  }
+
+  // 同一中断不会自身嵌套，槽位只被一个中断写入
+  cycles = s_cycles() - start;
+  slot = &s_irq[id];
+  slot->win_cycles += cycles;
+  slot->win_count++;
+  if(cycles > slot->max_cycles)
+  {
+    slot->max_cycles = cycles;
+  }
+}
+
+/* ==================== 窗口计算 ==================== */
+
+/* 周期数换算为0.1%负载 */
+static uint16_t RunStats_Permille(uint64_t part, uint64_t window)
+{
+  uint64_t permille;
+
+  if(window == 0)
+  {
+    return 0;
+  }
+
+  permille = (part * 1000U + window / 2U) / window;
+  return (permille > 1000U) ? 1000U : (uint16_t)permille;
+}
+
+/* 追加一个窗口并更新平均值与峰值 */
+static void RunStats_Push(RunStats_History_t *history, uint16_t load)
+{
+  uint32_t sum = 0;
+  uint16_t peak = 0;
+
+  history->win[history->head] = load;
+  history->head = (uint8_t)((history->head + 1U) % RUNSTATS_HISTORY);
+  if(history->filled < RUNSTATS_HISTORY)
+  {
+    history->filled++;
+  }
+
+  for(uint8_t i = 0; i < history->filled; i++)
+  {
+    sum += history->win[i];
+    if(history->win[i] > peak)
+    {
+      peak = history->win[i];
+    }
+  }
+
+  history->load.now = load;
+  history->load.avg = (uint16_t)((sum + history->filled / 2U) / history->filled);
+  history->load.peak = peak;
+}
+
+/* 按任务编号查找槽位，不存在时分配空闲槽位 */
+static RunStats_TaskSlot_t *RunStats_FindTask(const RunStats_PortTask_t *task)
+{
+  RunStats_TaskSlot_t *free_slot = NULL;
+
+  for(uint8_t i = 0; i < RUNSTATS_MAX_TASKS; i++)
+  {
+    if(s_task[i].id == task->id)
+    {
+      return &s_task[i];
+    }
+    if(s_task[i].id == 0 && free_slot == NULL)
+    {
+      free_slot = &s_task[i];
+    }
+  }
+
+  if(free_slot != NULL)
+  {
+    // 新任务的累计运行时间从0开始，首个窗口即为完整差值
+    memset(free_slot, 0, sizeof(*free_slot));
+    free_slot->id = task->id;
+    strncpy(free_slot->name, task->name, sizeof(free_slot->name) - 1U);
+  }
+
+  return free_slot;
+}
+
+static void RunStats_SampleTasks(uint64_t window)
+{
+  bool seen[RUNSTATS_MAX_TASKS] = {false};
+  uint32_t n;
+
+  n = RunStats_PortGetTasks(s_snapshot, RUNSTATS_MAX_TASKS);
+
+  for(uint32_t i = 0; i < n; i++)
+  {
+    RunStats_TaskSlot_t *slot = RunStats_FindTask(&s_snapshot[i]);
+    uint64_t run = s_snapshot[i].run_time;
+    uint16_t load;
+
+    if(slot == NULL)
+    {
+      continue;
+    }
+
+    load = RunStats_Permille(run - slot->last_run, window);
+    slot->last_run = run;
+    slot->priority = s_snapshot[i].priority;
+    RunStats_Push(&slot->history, load);
+    seen[slot - s_task] = true;
+
+    if(s_snapshot[i].idle)
+    {
+      RunStats_Push(&s_cpu, (uint16_t)(1000U - load));
+    }
+  }
+
+  // 已删除的任务释放槽位；任务数超过RUNSTATS_MAX_TASKS时n为0，保留上一次结果
+  if(n > 0)
+  {
+    s_task_count = 0;
+    for(uint8_t i = 0; i < RUNSTATS_MAX_TASKS; i++)
+    {
+      if(!seen[i])
+      {
+        s_task[i].id = 0;
+      }
+      else
+      {
+        s_task_count++;
+      }
+    }
+  }
+}
+
+static void RunStats_SampleIrqs(uint64_t window)
+{
+  uint64_t total = 0;
+
+  for(uint8_t i = 0; i < RUNSTATS_MAX_IRQS; i++)
+  {
+    RunStats_IrqSlot_t *slot = &s_irq[i];
+    uint32_t cycles;
+    uint32_t count;
+    uint32_t state;
+
+    if(slot->name == NULL)
+    {
+      continue;
+    }
+
+    state = RunStats_PortEnterCritical();
+    cycles = slot->win_cycles;
+    count = slot->win_count;
+    slot->win_cycles = 0;
+    slot->win_count = 0;
+    RunStats_PortExitCritical(state);
+
+    slot->count += count;
+    slot->rate = count;
+    total += cycles;
+    RunStats_Push(&slot->history, RunStats_Permille(cycles, window));
+  }
+
+  RunStats_Push(&s_irq_total, RunStats_Permille(total, window));
+}
+
+void RunStats_Sample(void)
+{
+  uint64_t now = RunStats_GetCycles64();
+  uint64_t window = now - s_window_start;
+
+  if(s_cycles == NULL || window == 0)
+  {
+    return;
+  }
+
+  s_window_start = now;
+  s_window_cycles = (window > UINT32_MAX) ? UINT32_MAX : (uint32_t)window;
+  s_windows++;
+
+  RunStats_SampleTasks(window);
+  RunStats_SampleIrqs(window);
+}
+
+void RunStats_Reset(void)
+{
+  memset(&s_cpu, 0, sizeof(s_cpu));
+  memset(&s_irq_total, 0, sizeof(s_irq_total));
+
+  for(uint8_t i = 0; i < RUNSTATS_MAX_TASKS; i++)
+  {
+    memset(&s_task[i].history, 0, sizeof(s_task[i].history));
+  }
+  for(uint8_t i = 0; i < RUNSTATS_MAX_IRQS; i++)
+  {
+    memset(&s_irq[i].history, 0, sizeof(s_irq[i].history));
+    s_irq[i].max_cycles = 0;
+  }
+}
+
+/* ==================== 查询与导出 ==================== */
+
+int RunStats_GetSummary(RunStats_Summary_t *summary)
+{
+  if(summary == NULL)
+  {
+    return -1;
+  }
+
+  summary->windows = s_windows;
+  summary->window_cycles = s_window_cycles;
+  summary->cpu_hz = s_cpu_hz;
+  summary->cpu = s_cpu.load;
+  summary->irq = s_irq_total.load;
+  summary->task_count = s_task_count;
+  summary->irq_count = 0;
+  for(uint8_t i = 0; i < RUNSTATS_MAX_IRQS; i++)
+  {
+    if(s_irq[i].name != NULL)
+    {
+      summary->irq_count++;
+    }
+  }
+
+  return 0;
+}
+
+int RunStats_GetTask(uint8_t index, RunStats_TaskInfo_t *info)
+{
+  if(info == NULL)
+  {
+    return -1;
+  }
+
+  // 按槽位顺序跳过空闲槽位
+  for(uint8_t i = 0; i < RUNSTATS_MAX_TASKS; i++)
+  {
+    if(s_task[i].id == 0)
+    {
+      continue;
+    }
+    if(index-- == 0)
+    {
+      info->name = s_task[i].name;
+      info->id = s_task[i].id;
+      info->priority = s_task[i].priority;
+      info->run_cycles = s_task[i].last_run;
+      info->load = s_task[i].history.load;
+      return 0;
+    }
+  }
+
+  return -1;
+}
+
+int RunStats_GetIrq(uint8_t id, RunStats_IrqInfo_t *info)
+{
+  if(info == NULL || id >= RUNSTATS_MAX_IRQS || s_irq[id].name == NULL)
+  {
+    return -1;
+  }
+
+  info->name = s_irq[id].name;
+  info->count = s_irq[id].count;
+  info->rate = s_irq[id].rate;
+  info->max_cycles = s_irq[id].max_cycles;
+  info->load = s_irq[id].history.load;
+
+  return 0;
+}
+
+/* 32位值按高/低寄存器存放 */
+static void RunStats_Put32(uint16_t *regs, uint32_t value)
+{
+  regs[0] = (uint16_t)(value >> 16);
+  regs[1] = (uint16_t)(value & 0xFFFFU);
+}
+
+static void RunStats_PutLoad(uint16_t *regs, const RunStats_Load_t *load)
+{
+  regs[0] = load->now;
+  regs[1] = load->avg;
+  regs[2] = load->peak;
+}
+
+void RunStats_Export(uint16_t *regs, uint16_t count)
+{
+  static uint16_t image[RUNSTATS_REG_COUNT];
+  RunStats_Summary_t summary;
+  RunStats_TaskInfo_t task;
+  RunStats_IrqInfo_t irq;
+  uint16_t *r;
+
+  if(regs == NULL)
+  {
+    return;
+  }
+
+  memset(image, 0, sizeof(image));
+  RunStats_GetSummary(&summary);
+
+  image[0] = (uint16_t)summary.windows;
+  image[1] = (uint16_t)((s_cpu_hz != 0) ? (uint64_t)summary.window_cycles * 1000U / s_cpu_hz : 0);
+  RunStats_PutLoad(&image[2], &summary.cpu);
+  image[5] = summary.irq.now;
+  image[6] = summary.task_count;
+  image[7] = summary.irq_count;
+
+  r = &image[RUNSTATS_REG_HEADER_LEN];
+  for(uint8_t i = 0; RunStats_GetTask(i, &task) == 0; i++)
+  {
+    uint64_t run_ms = (s_cpu_hz != 0) ? task.run_cycles / (s_cpu_hz / 1000U) : 0;
+
+    r[0] = (uint16_t)task.id;
+    RunStats_PutLoad(&r[1], &task.load);
+    RunStats_Put32(&r[4], (run_ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)run_ms);
+    // 任务名按Modbus字符串习惯高字节在前
+    for(uint8_t k = 0; k < 4 && task.name[k] != '\0'; k++)
+    {
+      r[6 + k / 2] |= (uint16_t)((uint8_t)task.name[k] << ((k % 2U) ? 0 : 8));
+    }
+    r += RUNSTATS_REG_TASK_LEN;
+  }
+
+  r = &image[RUNSTATS_REG_HEADER_LEN + RUNSTATS_MAX_TASKS * RUNSTATS_REG_TASK_LEN];
+  for(uint8_t i = 0; i < RUNSTATS_MAX_IRQS; i++)
+  {
+    if(RunStats_GetIrq(i, &irq) == 0)
+    {
+      RunStats_PutLoad(&r[0], &irq.load);
+      r[3] = (irq.rate > UINT16_MAX) ? UINT16_MAX : (uint16_t)irq.rate;
+      RunStats_Put32(&r[4], irq.max_cycles);
+      RunStats_Put32(&r[6], irq.count);
+    }
+    r += RUNSTATS_REG_IRQ_LEN;
+  }
+
+  // 整块复制，缩短主机读到半新半旧数据的时间窗
+  if(count > RUNSTATS_REG_COUNT)
+  {
+    memset(&regs[RUNSTATS_REG_COUNT], 0, (count - RUNSTATS_REG_COUNT) * sizeof(uint16_t));
+    count = RUNSTATS_REG_COUNT;
+  }
+  memcpy(regs, image, count * sizeof(uint16_t));
+}
+
+/* 追加格式化文本，返回新的写入位置（截断时停在缓冲区末尾） */
+static uint32_t RunStats_Append(uint32_t size, uint32_t pos, int len)
+{
+  if(len < 0)
+  {
+    return pos;
+  }
+  pos += (uint32_t)len;
+  return (pos >= size) ? size - 1U : pos;
+}
+
+uint32_t RunStats_Format(char *buf, uint32_t size)
+{
+  RunStats_Summary_t summary;
+  RunStats_TaskInfo_t task;
+  RunStats_IrqInfo_t irq;
+  uint32_t pos = 0;
+  uint32_t us_div;
+
+  if(buf == NULL || size == 0)
+  {
+    return 0;
+  }
+  buf[0] = '\0';
+
+  RunStats_GetSummary(&summary);
+  us_div = (summary.cpu_hz >= 1000000U) ? summary.cpu_hz / 1000000U : 1U;
+
+  pos = RunStats_Append(size, pos, snprintf(&buf[pos], size - pos,
+        "window %lu cyc, cpu %u.%u%% avg %u.%u%% peak %u.%u%%, irq %u.%u%%\n",
+        (unsigned long)summary.window_cycles,
+        summary.cpu.now / 10U, summary.cpu.now % 10U,
+        summary.cpu.avg / 10U, summary.cpu.avg % 10U,
+        summary.cpu.peak / 10U, summary.cpu.peak % 10U,
+        summary.irq.now / 10U, summary.irq.now % 10U));
+
+  pos = RunStats_Append(size, pos, snprintf(&buf[pos], size - pos,
+        "%-16s %3s %3s %6s %6s %6s %10s\n",
+        "task", "id", "pri", "now%", "avg%", "peak%", "run(ms)"));
+  for(uint8_t i = 0; RunStats_GetTask(i, &task) == 0; i++)
+  {
+    uint32_t run_ms = (uint32_t)(task.run_cycles / (us_div * 1000U));
+
+    pos = RunStats_Append(size, pos, snprintf(&buf[pos], size - pos,
+          "%-16s %3lu %3lu %4u.%u %4u.%u %4u.%u %10lu\n",
+          task.name, (unsigned long)task.id, (unsigned long)task.priority,
+          task.load.now / 10U, task.load.now % 10U,
+          task.load.avg / 10U, task.load.avg % 10U,
+          task.load.peak / 10U, task.load.peak % 10U,
+          (unsigned long)run_ms));
+  }
+
+  pos = RunStats_Append(size, pos, snprintf(&buf[pos], size - pos,
+        "%-16s %10s %6s %6s %6s %6s %8s\n",
+        "irq", "count", "rate", "now%", "avg%", "peak%", "max(us)"));
+  for(uint8_t i = 0; i < RUNSTATS_MAX_IRQS; i++)
+  {
+    if(RunStats_GetIrq(i, &irq) != 0)
+    {
+      continue;
+    }
+
+    pos = RunStats_Append(size, pos, snprintf(&buf[pos], size - pos,
+          "%-16s %10lu %6lu %4u.%u %4u.%u %4u.%u %8lu\n",
+          irq.name, (unsigned long)irq.count, (unsigned long)irq.rate,
+          irq.load.now / 10U, irq.load.now % 10U,
+          irq.load.avg / 10U, irq.load.avg % 10U,
+          irq.load.peak / 10U, irq.load.peak % 10U,
+          (unsigned long)(irq.max_cycles / us_div)));
+  }
+
+  return pos;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file    runstats.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   任务/中断运行时统计
+ *
+ * @details 以32位周期计数器（目标板为DWT CYCCNT）为时基，软件扩展为64位后
+ *          作为FreeRTOS运行时统计计数器（portGET_RUN_TIME_COUNTER_VALUE）。
+ *          周期性调用RunStats_Sample()，按窗口计算各任务与各中断的负载，
+ *          并保留最近RUNSTATS_HISTORY个窗口用于滑动平均与峰值。
+ *          结果可导出为寄存器镜像（Modbus输入寄存器）或文本。
+ *          周期计数源、临界区与任务快照由后端提供（runstats_port.h），
+ *          本模块不依赖RTOS头文件，可在主机上配合POSIX后端测试。
+ *
+ *          使用约束：
+ *          - 32位计数器须在回绕前至少读取一次（480MHz约8.9秒），
+ *            任务切换与RunStats_Sample()均会读取，采样周期不得超过该值
+ *          - 中断时间包含被更高优先级中断嵌套的时间，且同时计入被打断的任务
+ *          - 查询与导出函数须与RunStats_Sample()在同一任务中调用
+ */
+
+#ifndef RUNSTATS_H
+#define RUNSTATS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 最多统计的任务数（含IDLE与定时器任务）
+ */
+#define RUNSTATS_MAX_TASKS      16
+
+/**
+ * @brief 最多统计的中断数
+ */
+#define RUNSTATS_MAX_IRQS       8
+
+/**
+ * @brief 滑动窗口个数（平均值与峰值基于最近RUNSTATS_HISTORY个窗口）
+ */
+#define RUNSTATS_HISTORY        10
+
+/**
+ * @brief 寄存器镜像布局（RunStats_Export）
+ * @note  头部：[0]已完成窗口数 [1]窗口长度ms [2-4]CPU负载当前/平均/峰值
+ *              [5]中断合计负载 [6]任务数 [7]中断数
+ *        每任务：[0]任务编号 [1-3]负载当前/平均/峰值 [4-5]累计运行ms(高/低)
+ *              [6-7]任务名前4个ASCII字符
+ *        每中断：[0-2]负载当前/平均/峰值 [3]最近窗口次数 [4-5]单次最长周期数(高/低)
+ *              [6-7]累计次数(高/低)
+ *        负载单位均为0.1%
+ */
+#define RUNSTATS_REG_HEADER_LEN 8
+#define RUNSTATS_REG_TASK_LEN   8
+#define RUNSTATS_REG_IRQ_LEN    8
+#define RUNSTATS_REG_COUNT      (RUNSTATS_REG_HEADER_LEN + \
+                                 RUNSTATS_MAX_TASKS * RUNSTATS_REG_TASK_LEN + \
+                                 RUNSTATS_MAX_IRQS * RUNSTATS_REG_IRQ_LEN)
+
+/**
+ * @brief 周期计数函数（32位回绕）
+ */
+typedef uint32_t (*RunStats_CycleFn_t)(void);
+
+/**
+ * @brief 负载（单位0.1%）
+ */
+typedef struct
+{
+  uint16_t now;                         /**< 最近一个窗口 */
+  uint16_t avg;                         /**< 最近RUNSTATS_HISTORY个窗口平均 */
+  uint16_t peak;                        /**< 最近RUNSTATS_HISTORY个窗口峰值 */
+} RunStats_Load_t;
+
+/**
+ * @brief 任务统计
+ */
+typedef struct
+{
+  const char *name;                     /**< 任务名 */
+  uint32_t id;                          /**< 任务编号 */
+  uint32_t priority;                    /**< 当前优先级 */
+  uint64_t run_cycles;                  /**< 累计运行周期数 */
+  RunStats_Load_t load;                 /**< 负载 */
+} RunStats_TaskInfo_t;
+
+/**
+ * @brief 中断统计
+ */
+typedef struct
+{
+  const char *name;                     /**< 中断名，未注册为NULL */
+  uint32_t count;                       /**< 累计次数 */
+  uint32_t rate;                        /**< 最近一个窗口内次数 */
+  uint32_t max_cycles;                  /**< 单次最长周期数 */
+  RunStats_Load_t load;                 /**< 负载 */
+} RunStats_IrqInfo_t;
+
+/**
+ * @brief 总体统计
+ */
+typedef struct
+{
+  uint32_t windows;                     /**< 已完成窗口数 */
+  uint32_t window_cycles;               /**< 最近一个窗口长度（周期数） */
+  uint32_t cpu_hz;                      /**< 周期计数频率(Hz) */
+  RunStats_Load_t cpu;                  /**< CPU负载（1 - IDLE） */
+  RunStats_Load_t irq;                  /**< 全部中断合计负载 */
+  uint8_t task_count;                   /**< 当前任务数 */
+  uint8_t irq_count;                    /**< 已注册中断数 */
+} RunStats_Summary_t;
+
+/**
+ * @brief   初始化运行时统计
+ *
+ * @param[in]   cycles  周期计数函数（通常为RunStats_PortCycles）
+ * @param[in]   cpu_hz  周期计数频率(Hz)
+ *
+ * @return  None
+ *
+ * @note    须在启动调度器之前调用
+ */
+void RunStats_Init(RunStats_CycleFn_t cycles, uint32_t cpu_hz);
+
+/**
+ * @brief   注册中断名
+ *
+ * @param[in]   id    中断编号（0 ~ RUNSTATS_MAX_IRQS-1）
+ * @param[in]   name  中断名（须为静态字符串）
+ *
+ * @return  0成功，-1编号越界
+ */
+int RunStats_SetIrqName(uint8_t id, const char *name);
+
+/**
+ * @brief   开始计时（portCONFIGURE_TIMER_FOR_RUN_TIME_STATS）
+ *
+ * @details 以当前时刻作为第一个窗口的起点
+ *
+ * @return  None
+ */
+void RunStats_Start(void);
+
+/**
+ * @brief   读取64位周期计数（portGET_RUN_TIME_COUNTER_VALUE）
+ *
+ * @return  扩展后的周期数，未初始化时返回0
+ *
+ * @note    任务与中断上下文均可调用
+ */
+uint64_t RunStats_GetCycles64(void);
+
+/**
+ * @brief   中断入口计时
+ *
+ * @return  入口时刻，传给RunStats_IrqExit()
+ */
+uint32_t RunStats_IrqEnter(void);
+
+/**
+ * @brief   中断出口计时
+ *
+ * @param[in]   id     中断编号
+ * @param[in]   start  RunStats_IrqEnter()的返回值
+ *
+ * @return  None
+ */
+void RunStats_IrqExit(uint8_t id, uint32_t start);
+
+/**
+ * @brief   结束当前窗口并计算负载
+ *
+ * @details 窗口长度取两次调用间的实际周期数，调用周期抖动不影响结果
+ *
+ * @return  None
+ */
+void RunStats_Sample(void);
+
+/**
+ * @brief   清除历史窗口与中断最长时间
+ *
+ * @return  None
+ */
+void RunStats_Reset(void);
+
+/**
+ * @brief   读取总体统计
+ *
+ * @param[out]  summary  总体统计
+ *
+ * @return  0成功，-1参数错误
+ */
+int RunStats_GetSummary(RunStats_Summary_t *summary);
+
+/**
+ * @brief   读取任务统计
+ *
+ * @param[in]   index  任务序号（0 ~ task_count-1）
+ * @param[out]  info   任务统计
+ *
+ * @return  0成功，-1序号越界
+ */
+int RunStats_GetTask(uint8_t index, RunStats_TaskInfo_t *info);
+
+/**
+ * @brief   读取中断统计
+ *
+ * @param[in]   id    中断编号
+ * @param[out]  info  中断统计
+ *
+ * @return  0成功，-1编号越界或未注册
+ */
+int RunStats_GetIrq(uint8_t id, RunStats_IrqInfo_t *info);
+
+/**
+ * @brief   导出寄存器镜像（二进制转储）
+ *
+ * @param[out]  regs   输出寄存器
+ * @param[in]   count  寄存器数量，超出RUNSTATS_REG_COUNT部分填0
+ *
+ * @return  None
+ */
+void RunStats_Export(uint16_t *regs, uint16_t count);
+
+/**
+ * @brief   生成文本报告（文本转储）
+ *
+ * @param[out]  buf   输出缓冲区
+ * @param[in]   size  缓冲区大小
+ *
+ * @return  写入的字符数（不含结束符），缓冲区不足时截断
+ */
+uint32_t RunStats_Format(char *buf, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RUNSTATS_H */
@@ -0,0 +1,88 @@
+/**
+ * @file    runstats_port.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   运行时统计后端接口
+ *
+ * @details runstats.c只依赖本接口，不直接包含RTOS或硬件头文件。后端提供：
+ *          - 周期计数源（32位回绕）及其频率
+ *          - 任务与中断上下文均可调用的临界区
+ *          - 任务运行时间快照
+ *          目标板后端为drivers/<PLATFORM>/drv_runstats.c（DWT CYCCNT + BASEPRI + FreeRTOS），
+ *          主机后端为drivers/posix/drv_runstats.c（clock_gettime + pthread互斥锁 + 模拟任务表）。
+ */
+
+#ifndef RUNSTATS_PORT_H
+#define RUNSTATS_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 任务名最大长度（含结束符），与configMAX_TASK_NAME_LEN一致
+ */
+#define RUNSTATS_NAME_LEN       16
+
+/**
+ * @brief 任务快照
+ */
+typedef struct
+{
+  const char *name;                     /**< 任务名（仅在快照有效期内可用） */
+  uint32_t id;                          /**< 任务编号，非0且在任务生命周期内唯一 */
+  uint32_t priority;                    /**< 当前优先级 */
+  uint64_t run_time;                    /**< 累计运行周期数 */
+  bool idle;                            /**< 是否为空闲任务 */
+} RunStats_PortTask_t;
+
+/**
+ * @brief   读取32位周期计数
+ *
+ * @return  当前周期数，回绕计数
+ */
+uint32_t RunStats_PortCycles(void);
+
+/**
+ * @brief   周期计数频率
+ *
+ * @return  频率(Hz)
+ */
+uint32_t RunStats_PortCycleHz(void);
+
+/**
+ * @brief   进入临界区
+ *
+ * @return  退出时恢复的状态
+ *
+ * @note    任务与中断上下文均可调用
+ */
+uint32_t RunStats_PortEnterCritical(void);
+
+/**
+ * @brief   退出临界区
+ *
+ * @param[in]   state  RunStats_PortEnterCritical()的返回值
+ *
+ * @return  None
+ */
+void RunStats_PortExitCritical(uint32_t state);
+
+/**
+ * @brief   读取任务快照
+ *
+ * @param[out]  tasks  快照数组
+ * @param[in]   max    数组长度
+ *
+ * @return  任务数，任务数超过max时返回0
+ */
+uint32_t RunStats_PortGetTasks(RunStats_PortTask_t *tasks, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RUNSTATS_PORT_H */
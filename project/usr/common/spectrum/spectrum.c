@@ -0,0 +1,303 @@
+/**
+ * @file    spectrum.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   振动频谱分析模块实现
+ *
+ * @details 处理流程：
+ *          ADC块 → 块平均抽取 → 滑动窗口(N点) → 去直流 → Hann窗
+ *                → N/2点复数FFT + 实数拆分 → 功率谱 → 频带RMS/峰值
+ *
+ *          实数FFT采用"N点实序列当作N/2点复序列"的标准做法：
+ *          z[k] = x[2k] + j*x[2k+1]，做N/2点复数FFT后按
+ *          X[k] = Fe[k] + W^k * Fo[k] 拆分出实数序列的频谱，
+ *          运算量约为同点数复数FFT的一半。
+ *
+ *          幅值换算（Parseval）：
+ *          - 频带均方值 = 2 * sum(|X[k]|^2) / (N^2 * Wp)，Wp为窗函数均方值
+ *          - 正弦幅度   = 2 * |X[k]| / (N * CG)，CG为窗函数相干增益
+ */
+
+#include "spectrum.h"
+#include <math.h>
+#include <string.h>
+
+#define SPECTRUM_PI           3.14159265358979f
+#define SPECTRUM_HALF_SIZE    (SPECTRUM_FFT_SIZE / 2)
+
+/* Hann窗与旋转因子表，所有实例共享，首次初始化时计算 */
+static float s_window[SPECTRUM_FFT_SIZE];
+static float s_cos[SPECTRUM_HALF_SIZE];
+static float s_sin[SPECTRUM_HALF_SIZE];
+static float s_window_power = 0.0f;   /**< 窗函数均方值 Wp */
+static float s_window_gain = 0.0f;    /**< 窗函数相干增益 CG */
+static bool s_tables_ready = false;
+
+/**
+ * @brief   生成窗函数与旋转因子表
+ *
+ * @param   None
+ * @return  None
+ */
+static void Spectrum_InitTables(void)
+{
+  float sum = 0.0f;
+  float sum_sq = 0.0f;
+
+  // 周期Hann窗，50%重叠时各帧权重之和恒定
+  for(uint32_t n = 0; n < SPECTRUM_FFT_SIZE; n++)
+  {
+    float w = 0.5f - 0.5f * cosf(2.0f * SPECTRUM_PI * (float)n / (float)SPECTRUM_FFT_SIZE);
+    s_window[n] = w;
+    sum += w;
+    sum_sq += w * w;
+  }
+  s_window_gain = sum / (float)SPECTRUM_FFT_SIZE;
+  s_window_power = sum_sq / (float)SPECTRUM_FFT_SIZE;
+
+  // W^k = cos(2*pi*k/N) - j*sin(2*pi*k/N)
+  for(uint32_t k = 0; k < SPECTRUM_HALF_SIZE; k++)
+  {
+    float angle = 2.0f * SPECTRUM_PI * (float)k / (float)SPECTRUM_FFT_SIZE;
+    s_cos[k] = cosf(angle);
+    s_sin[k] = sinf(angle);
+  }
+
+  s_tables_ready = true;
+}
+
+/**
+ * @brief   N/2点原地复数FFT（基2，时间抽取）
+ *
+ * @param[in,out] z  复数数组，实部虚部交错存放，长度为SPECTRUM_FFT_SIZE
+ *
+ * @return  None
+ */
+static void Spectrum_ComplexFFT(float *z)
+{
+  const uint32_t m = SPECTRUM_HALF_SIZE;
+
+  // 位反转重排
+  for(uint32_t i = 1, j = 0; i < m; i++)
+  {
+    uint32_t bit = m >> 1;
+    while(j & bit)
+    {
+      j ^= bit;
+      bit >>= 1;
+    }
+    j |= bit;
+
+    if(i < j)
+    {
+      float tr = z[2 * i];
+      float ti = z[2 * i + 1];
+      z[2 * i] = z[2 * j];
+      z[2 * i + 1] = z[2 * j + 1];
+      z[2 * j] = tr;
+      z[2 * j + 1] = ti;
+    }
+  }
+
+  // 蝶形运算：len级的旋转因子 exp(-j*2*pi*k/len) 对应表索引 k*(N/len)
+  for(uint32_t len = 2; len <= m; len <<= 1)
+  {
+    uint32_t half = len >> 1;
+    uint32_t step = SPECTRUM_FFT_SIZE / len;
+
+    for(uint32_t i = 0; i < m; i += len)
+    {
+      for(uint32_t k = 0; k < half; k++)
+      {
+        float wr = s_cos[k * step];
+        float wi = -s_sin[k * step];
+        float *a = &z[2 * (i + k)];
+        float *b = &z[2 * (i + k + half)];
+        float br = b[0] * wr - b[1] * wi;
+        float bi = b[0] * wi + b[1] * wr;
+
+        b[0] = a[0] - br;
+        b[1] = a[1] - bi;
+        a[0] += br;
+        a[1] += bi;
+      }
+    }
+  }
+}
+
+/**
+ * @brief   对当前窗口执行一次频谱分析并更新结果
+ *
+ * @param[in,out] spec  频谱分析句柄
+ *
+ * @return  None
+ */
+static void Spectrum_ProcessFrame(Spectrum_Handle_t *spec)
+{
+  float *z = spec->work;
+  float mean = 0.0f;
+  float band_ms[SPECTRUM_MAX_BANDS] = {0.0f};
+  float total_ms = 0.0f;
+  float peak_power = 0.0f;
+  uint32_t peak_bin = 0;
+
+  // 按时间顺序展开环形窗口，write_index处为最旧样本
+  for(uint32_t n = 0; n < SPECTRUM_FFT_SIZE; n++)
+  {
+    uint32_t idx = (spec->write_index + n) & (SPECTRUM_FFT_SIZE - 1);
+    z[n] = spec->history[idx];
+    mean += z[n];
+  }
+  mean /= (float)SPECTRUM_FFT_SIZE;
+
+  // 去直流后加窗，避免直流分量经窗函数泄漏到低频频带
+  for(uint32_t n = 0; n < SPECTRUM_FFT_SIZE; n++)
+  {
+    z[n] = (z[n] - mean) * s_window[n];
+  }
+
+  Spectrum_ComplexFFT(z);
+
+  const float norm = 1.0f / ((float)SPECTRUM_FFT_SIZE * (float)SPECTRUM_FFT_SIZE * s_window_power);
+  const float bin_hz = spec->fs / (float)SPECTRUM_FFT_SIZE;
+
+  // 实数拆分，逐bin累计功率（k=0为直流，已去除，跳过）
+  for(uint32_t k = 1; k <= SPECTRUM_HALF_SIZE; k++)
+  {
+    float xr;
+    float xi;
+
+    if(k == SPECTRUM_HALF_SIZE)
+    {
+      // 奈奎斯特频点：X[N/2] = Re(Z0) - Im(Z0)
+      xr = z[0] - z[1];
+      xi = 0.0f;
+    }
+    else
+    {
+      float ar = z[2 * k];
+      float ai = z[2 * k + 1];
+      float br = z[2 * (SPECTRUM_HALF_SIZE - k)];
+      float bi = z[2 * (SPECTRUM_HALF_SIZE - k) + 1];
+      float fer = 0.5f * (ar + br);
+      float fei = 0.5f * (ai - bi);
+      float for_ = 0.5f * (ai + bi);
+      float foi = -0.5f * (ar - br);
+      float c = s_cos[k];
+      float s = s_sin[k];
+
+      xr = fer + c * for_ + s * foi;
+      xi = fei + c * foi - s * for_;
+    }
+
+    float power = xr * xr + xi * xi;
+    float ms = ((k == SPECTRUM_HALF_SIZE) ? 1.0f : 2.0f) * power * norm;
+    float freq = (float)k * bin_hz;
+
+    total_ms += ms;
+    for(uint32_t b = 0; b < spec->config.band_count; b++)
+    {
+      if(freq >= spec->config.bands[b].f_low && freq < spec->config.bands[b].f_high)
+      {
+        band_ms[b] += ms;
+      }
+    }
+
+    if(power > peak_power)
+    {
+      peak_power = power;
+      peak_bin = k;
+    }
+  }
+
+  const float scale = spec->config.scale;
+  for(uint32_t b = 0; b < SPECTRUM_MAX_BANDS; b++)
+  {
+    spec->result.band_rms[b] = sqrtf(band_ms[b]) * scale;
+  }
+  spec->result.total_rms = sqrtf(total_ms) * scale;
+  spec->result.peak_freq = (float)peak_bin * bin_hz;
+  spec->result.peak_amp = 2.0f * sqrtf(peak_power) /
+                          ((float)SPECTRUM_FFT_SIZE * s_window_gain) * scale;
+  spec->result.frame_count++;
+}
+
+/**
+ * @brief   初始化频谱分析器
+ */
+int Spectrum_Init(Spectrum_Handle_t *spec, const Spectrum_Config_t *config)
+{
+  if(spec == NULL || config == NULL || config->decimation == 0 ||
+     config->sample_rate <= 0.0f || config->band_count > SPECTRUM_MAX_BANDS)
+  {
+    return -1;
+  }
+
+  if(!s_tables_ready)
+  {
+    Spectrum_InitTables();
+  }
+
+  memset(spec, 0, sizeof(Spectrum_Handle_t));
+  spec->config = *config;
+  spec->fs = config->sample_rate / (float)config->decimation;
+
+  return 0;
+}
+
+/**
+ * @brief   输入一块原始ADC数据
+ */
+bool Spectrum_Feed(Spectrum_Handle_t *spec, const uint16_t *samples, uint32_t len)
+{
+  bool updated = false;
+
+  if(spec == NULL || samples == NULL)
+  {
+    return false;
+  }
+
+  for(uint32_t i = 0; i < len; i++)
+  {
+    spec->decim_sum += samples[i];
+    if(++spec->decim_count < spec->config.decimation)
+    {
+      continue;
+    }
+
+    // 块平均抽取：兼作简单抗混叠低通
+    spec->history[spec->write_index] = (float)spec->decim_sum / (float)spec->config.decimation;
+    spec->write_index = (spec->write_index + 1) & (SPECTRUM_FFT_SIZE - 1);
+    spec->decim_sum = 0;
+    spec->decim_count = 0;
+
+    if(spec->fill < SPECTRUM_FFT_SIZE)
+    {
+      spec->fill++;
+    }
+    spec->hop_count++;
+
+    // 窗口填满后每前进半帧计算一次（50%重叠）
+    if(spec->fill == SPECTRUM_FFT_SIZE && spec->hop_count >= SPECTRUM_HOP_SIZE)
+    {
+      spec->hop_count = 0;
+      Spectrum_ProcessFrame(spec);
+      updated = true;
+    }
+  }
+
+  return updated;
+}
+
+/**
+ * @brief   获取最近一帧的分析结果
+ */
+void Spectrum_GetResult(const Spectrum_Handle_t *spec, Spectrum_Result_t *result)
+{
+  if(spec == NULL || result == NULL)
+  {
+    return;
+  }
+
+  *result = spec->result;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file    spectrum.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   振动频谱分析模块
+ *
+ * @details 对ADC数据块进行抽取、加窗（Hann）、50%重叠的实数FFT，
+ *          输出可配置频带的RMS值、总RMS以及峰值频率/幅度。
+ *          仅依赖标准C库与单精度浮点（Cortex-M7 FPU），无硬件依赖。
+ */
+
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief FFT点数（实数点数，必须为2的幂）
+ */
+#define SPECTRUM_FFT_SIZE     512
+
+/**
+ * @brief 帧移（50%重叠）
+ */
+#define SPECTRUM_HOP_SIZE     (SPECTRUM_FFT_SIZE / 2)
+
+/**
+ * @brief 最大频带数量
+ */
+#define SPECTRUM_MAX_BANDS    4
+
+/**
+ * @brief 频带定义
+ */
+typedef struct
+{
+  float f_low;                          /**< 频带下限(Hz)，包含 */
+  float f_high;                         /**< 频带上限(Hz)，不包含 */
+} Spectrum_Band_t;
+
+/**
+ * @brief 频谱分析配置
+ */
+typedef struct
+{
+  float sample_rate;                    /**< 输入采样率(Hz)，抽取前 */
+  uint16_t decimation;                  /**< 抽取因子（块平均），>=1 */
+  float scale;                          /**< 码值到物理量的换算系数 */
+  uint8_t band_count;                   /**< 有效频带数量 */
+  Spectrum_Band_t bands[SPECTRUM_MAX_BANDS]; /**< 频带表 */
+} Spectrum_Config_t;
+
+/**
+ * @brief 频谱分析结果（物理量单位，已乘scale）
+ */
+typedef struct
+{
+  float band_rms[SPECTRUM_MAX_BANDS];   /**< 各频带RMS */
+  float total_rms;                      /**< 全频带RMS（不含直流） */
+  float peak_freq;                      /**< 峰值频率(Hz) */
+  float peak_amp;                       /**< 峰值正弦幅度 */
+  uint32_t frame_count;                 /**< 已完成的FFT帧数 */
+} Spectrum_Result_t;
+
+/**
+ * @brief 频谱分析句柄
+ */
+typedef struct
+{
+  Spectrum_Config_t config;             /**< 配置副本 */
+  float fs;                             /**< 抽取后的采样率(Hz) */
+  float history[SPECTRUM_FFT_SIZE];     /**< 抽取后样本的滑动窗口 */
+  float work[SPECTRUM_FFT_SIZE];        /**< FFT工作区（N/2个复数交错存放） */
+  uint16_t write_index;                 /**< history写位置 */
+  uint16_t fill;                        /**< history已填充的样本数 */
+  uint16_t hop_count;                   /**< 距上一帧的新样本数 */
+  uint16_t decim_count;                 /**< 当前抽取累加计数 */
+  uint32_t decim_sum;                   /**< 当前抽取累加值 */
+  Spectrum_Result_t result;             /**< 最近一帧的结果 */
+} Spectrum_Handle_t;
+
+/**
+ * @brief   初始化频谱分析器
+ *
+ * @param[out]  spec    频谱分析句柄
+ * @param[in]   config  配置参数
+ *
+ * @retval  0   成功
+ * @retval  -1  参数错误
+ */
+int Spectrum_Init(Spectrum_Handle_t *spec, const Spectrum_Config_t *config);
+
+/**
+ * @brief   输入一块原始ADC数据
+ *
+ * @details 数据先按decimation做块平均抽取，每累计SPECTRUM_HOP_SIZE个
+ *          抽取后样本即对最近SPECTRUM_FFT_SIZE个样本执行一次FFT。
+ *
+ * @param[in,out] spec     频谱分析句柄
+ * @param[in]     samples  ADC样本
+ * @param[in]     len      样本数
+ *
+ * @retval  true   本次调用产生了新的结果
+ * @retval  false  结果未更新
+ *
+ * @note    FFT在调用者上下文中执行，应在任务中调用，不要在中断中调用
+ */
+bool Spectrum_Feed(Spectrum_Handle_t *spec, const uint16_t *samples, uint32_t len);
+
+/**
+ * @brief   获取最近一帧的分析结果
+ *
+ * @param[in]   spec    频谱分析句柄
+ * @param[out]  result  结果输出
+ *
+ * @return  None
+ */
+void Spectrum_GetResult(const Spectrum_Handle_t *spec, Spectrum_Result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPECTRUM_H */
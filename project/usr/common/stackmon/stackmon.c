@@ -0,0 +1,450 @@
+/**
+ * @file    stackmon.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   任务栈水位与堆使用监视实现
+ *
+ * @details 栈大小登记表按FreeRTOS任务编号匹配：任务编号单调递增且不复用，
+ *          任务删除后TCB地址可能被新任务复用，按句柄匹配会张冠李戴。
+ *          采样时未出现且编号小于本次最大编号的登记项即属于已删除任务，予以清除；
+ *          编号更大的登记项可能是采样之后才创建的任务，保留到下一次。
+ */
+
+#include "stackmon.h"
+#include <stddef.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "printf.h"
+
+/**
+ * @brief 栈大小登记项
+ */
+typedef struct
+{
+  uint32_t id;                          /**< 任务编号，0表示空闲 */
+  uint32_t size;                        /**< 栈大小（字节） */
+} StackMon_Size_t;
+
+/**
+ * @brief 任务采样结果
+ */
+typedef struct
+{
+  char name[configMAX_TASK_NAME_LEN];   /**< 任务名副本 */
+  StackMon_TaskInfo_t info;
+} StackMon_Task_t;
+
+static StackMon_Size_t s_size[STACKMON_MAX_TASKS];
+static StackMon_Task_t s_task[STACKMON_MAX_TASKS];
+static uint8_t s_task_count = 0;
+static StackMon_HeapInfo_t s_heap;
+static HeapRegion_Stats_t s_region[HEAP_REGION_NUM];
+static char s_overflow[configMAX_TASK_NAME_LEN];
+
+// uxTaskGetSystemState()输出（静态分配，避免占用采样任务的栈）
+static TaskStatus_t s_status[STACKMON_MAX_TASKS];
+
+void StackMon_Init(void)
+{
+  memset(s_size, 0, sizeof(s_size));
+  memset(s_task, 0, sizeof(s_task));
+  memset(&s_heap, 0, sizeof(s_heap));
+  memset(s_region, 0, sizeof(s_region));
+  memset(s_overflow, 0, sizeof(s_overflow));
+  s_task_count = 0;
+}
+
+/* 按任务编号登记，已登记则更新 */
+static int StackMon_SetSizeById(uint32_t id, uint32_t size)
+{
+  StackMon_Size_t *free_slot = NULL;
+
+  for(uint8_t i = 0; i < STACKMON_MAX_TASKS; i++)
+  {
+    if(s_size[i].id == id)
+    {
+      s_size[i].size = size;
+      return 0;
+    }
+    if(s_size[i].id == 0 && free_slot == NULL)
+    {
+      free_slot = &s_size[i];
+    }
+  }
+
+  if(free_slot == NULL)
+  {
+    return -1;
+  }
+
+  free_slot->size = size;
+  free_slot->id = id;
+  return 0;
+}
+
+int StackMon_SetSize(void *task, uint32_t size)
+{
+  TaskStatus_t status;
+
+  if(task == NULL || size == 0)
+  {
+    return -1;
+  }
+
+  vTaskGetInfo((TaskHandle_t)task, &status, pdFALSE, eInvalid);
+  return StackMon_SetSizeById(status.xTaskNumber, size);
+}
+
+void StackMon_SetOverflow(const char *name)
+{
+  memset(s_overflow, 0, sizeof(s_overflow));
+  if(name != NULL)
+  {
+    strncpy(s_overflow, name, sizeof(s_overflow) - 1U);
+  }
+}
+
+static uint32_t StackMon_GetSizeById(uint32_t id)
+{
+  for(uint8_t i = 0; i < STACKMON_MAX_TASKS; i++)
+  {
+    if(s_size[i].id == id)
+    {
+      return s_size[i].size;
+    }
+  }
+
+  return 0;
+}
+
+/* 建议栈大小：峰值用量加余量后按STACKMON_ALIGN取整 */
+static uint32_t StackMon_Suggest(uint32_t used)
+{
+  uint32_t margin = used * STACKMON_MARGIN_PERCENT / 100U;
+
+  if(margin < STACKMON_MARGIN_MIN)
+  {
+    margin = STACKMON_MARGIN_MIN;
+  }
+
+  return (used + margin + STACKMON_ALIGN - 1U) / STACKMON_ALIGN * STACKMON_ALIGN;
+}
+
+/* IDLE与定时器任务的栈由内核按配置创建，首次采样时自动登记 */
+static void StackMon_RegisterKernelTasks(void)
+{
+  TaskHandle_t idle = xTaskGetIdleTaskHandle();
+  TaskHandle_t timer = xTimerGetTimerDaemonTaskHandle();
+
+  if(idle != NULL)
+  {
+    (void)StackMon_SetSize(idle, configMINIMAL_STACK_SIZE * sizeof(StackType_t));
+  }
+  if(timer != NULL)
+  {
+    (void)StackMon_SetSize(timer, configTIMER_TASK_STACK_DEPTH * sizeof(StackType_t));
+  }
+}
+
+static void StackMon_SampleTasks(void)
+{
+  uint32_t max_id = 0;
+  UBaseType_t n;
+
+  n = uxTaskGetSystemState(s_status, STACKMON_MAX_TASKS, NULL);
+  if(n == 0)
+  {
+    return;
+  }
+
+  // 按任务编号排序，导出的寄存器顺序保持稳定
+  for(UBaseType_t i = 1; i < n; i++)
+  {
+    TaskStatus_t key = s_status[i];
+    UBaseType_t k = i;
+
+    while(k > 0 && s_status[k - 1].xTaskNumber > key.xTaskNumber)
+    {
+      s_status[k] = s_status[k - 1];
+      k--;
+    }
+    s_status[k] = key;
+  }
+
+  for(UBaseType_t i = 0; i < n; i++)
+  {
+    StackMon_Task_t *task = &s_task[i];
+    StackMon_TaskInfo_t *info = &task->info;
+
+    strncpy(task->name, s_status[i].pcTaskName, sizeof(task->name) - 1U);
+    task->name[sizeof(task->name) - 1U] = '\0';
+    info->name = task->name;
+    info->id = s_status[i].xTaskNumber;
+    info->size = StackMon_GetSizeById(info->id);
+    info->min_free = (uint32_t)s_status[i].usStackHighWaterMark * sizeof(StackType_t);
+    info->used = (info->size > info->min_free) ? info->size - info->min_free : 0;
+    info->suggested = (info->size != 0) ? StackMon_Suggest(info->used) : 0;
+    info->low = (info->min_free < STACKMON_LOW_FREE);
+
+    if(info->id > max_id)
+    {
+      max_id = info->id;
+    }
+  }
+  s_task_count = (uint8_t)n;
+
+  // 清除已删除任务的登记项
+  for(uint8_t i = 0; i < STACKMON_MAX_TASKS; i++)
+  {
+    bool seen = false;
+
+    if(s_size[i].id == 0 || s_size[i].id > max_id)
+    {
+      continue;
+    }
+    for(UBaseType_t k = 0; k < n && !seen; k++)
+    {
+      seen = (s_status[k].xTaskNumber == s_size[i].id);
+    }
+    if(!seen)
+    {
+      s_size[i].id = 0;
+    }
+  }
+}
+
+static void StackMon_SampleHeap(void)
+{
+  HeapStats_t stats;
+  uint32_t saving = 0;
+  uint32_t need;
+  uint32_t margin;
+
+  vPortGetHeapStats(&stats);
+
+  s_heap.total = configTOTAL_HEAP_SIZE;
+  s_heap.free = stats.xAvailableHeapSpaceInBytes;
+  s_heap.min_free = stats.xMinimumEverFreeBytesRemaining;
+  s_heap.largest = stats.xSizeOfLargestFreeBlockInBytes;
+  s_heap.allocs = stats.xNumberOfSuccessfulAllocations;
+  s_heap.frees = stats.xNumberOfSuccessfulFrees;
+
+  // 按建议值裁剪栈可节省的字节数；动态创建的任务栈在堆中，堆峰值相应减少
+  for(uint8_t i = 0; i < s_task_count; i++)
+  {
+    const StackMon_TaskInfo_t *info = &s_task[i].info;
+
+    if(info->suggested != 0 && info->suggested < info->size)
+    {
+      saving += info->size - info->suggested;
+    }
+  }
+
+  need = s_heap.total - s_heap.min_free;
+#if (configSUPPORT_STATIC_ALLOCATION == 0)
+  need = (need > saving) ? need - saving : 0;
+#endif
+  margin = need / 8U;
+  if(margin < 1024U)
+  {
+    margin = 1024U;
+  }
+
+  s_heap.stack_saving = saving;
+  s_heap.suggested = (need + margin + 1023U) / 1024U * 1024U;
+
+  for(uint8_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    vPortGetRegionHeapStats((HeapRegion_Id_t)i, &s_region[i]);
+  }
+}
+
+void StackMon_Sample(void)
+{
+  StackMon_RegisterKernelTasks();
+  StackMon_SampleTasks();
+  StackMon_SampleHeap();
+}
+
+int StackMon_GetTask(uint8_t index, StackMon_TaskInfo_t *info)
+{
+  if(info == NULL || index >= s_task_count)
+  {
+    return -1;
+  }
+
+  *info = s_task[index].info;
+  return 0;
+}
+
+void StackMon_GetHeap(StackMon_HeapInfo_t *info)
+{
+  if(info != NULL)
+  {
+    *info = s_heap;
+  }
+}
+
+int StackMon_GetRegion(HeapRegion_Id_t region, HeapRegion_Stats_t *stats)
+{
+  if(stats == NULL || (uint32_t)region >= HEAP_REGION_NUM)
+  {
+    return -1;
+  }
+
+  *stats = s_region[region];
+  return 0;
+}
+
+/* 32位值按高/低寄存器存放 */
+static void StackMon_Put32(uint16_t *regs, uint32_t value)
+{
+  regs[0] = (uint16_t)(value >> 16);
+  regs[1] = (uint16_t)(value & 0xFFFFU);
+}
+
+static uint16_t StackMon_Sat16(uint32_t value)
+{
+  return (value > UINT16_MAX) ? UINT16_MAX : (uint16_t)value;
+}
+
+void StackMon_Export(uint16_t *regs, uint16_t count)
+{
+  static uint16_t image[STACKMON_REG_COUNT];
+  uint16_t *r = &image[STACKMON_REG_HEADER_LEN];
+
+  if(regs == NULL)
+  {
+    return;
+  }
+
+  memset(image, 0, sizeof(image));
+  StackMon_Put32(&image[0], s_heap.total);
+  StackMon_Put32(&image[2], s_heap.free);
+  StackMon_Put32(&image[4], s_heap.min_free);
+  StackMon_Put32(&image[6], s_heap.suggested);
+
+  for(uint8_t i = 0; i < s_task_count; i++)
+  {
+    const StackMon_TaskInfo_t *info = &s_task[i].info;
+
+    r[0] = (uint16_t)info->id;
+    r[1] = StackMon_Sat16(info->size);
+    r[2] = StackMon_Sat16(info->used);
+    r[3] = StackMon_Sat16(info->min_free);
+    r[4] = StackMon_Sat16(info->suggested);
+    r[5] = info->low ? 1U : 0U;
+    // 任务名按Modbus字符串习惯高字节在前
+    for(uint8_t k = 0; k < 4 && info->name[k] != '\0'; k++)
+    {
+      r[6 + k / 2] |= (uint16_t)((uint8_t)info->name[k] << ((k % 2U) ? 0 : 8));
+    }
+    r += STACKMON_REG_TASK_LEN;
+  }
+
+  if(count > STACKMON_REG_COUNT)
+  {
+    memset(&regs[STACKMON_REG_COUNT], 0, (count - STACKMON_REG_COUNT) * sizeof(uint16_t));
+    count = STACKMON_REG_COUNT;
+  }
+  memcpy(regs, image, count * sizeof(uint16_t));
+}
+
+void StackMon_ExportRegions(uint16_t *regs, uint16_t count)
+{
+  static uint16_t image[STACKMON_REG_REGION_COUNT];
+
+  if(regs == NULL)
+  {
+    return;
+  }
+
+  for(uint8_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    const HeapRegion_Stats_t *st = &s_region[i];
+    uint16_t *r = &image[i * STACKMON_REG_REGION_LEN];
+
+    StackMon_Put32(&r[0], (uint32_t)st->total);
+    StackMon_Put32(&r[2], (uint32_t)st->free);
+    StackMon_Put32(&r[4], (uint32_t)st->min_free);
+    r[6] = StackMon_Sat16((uint32_t)st->failures);
+    r[7] = st->fragmentation;
+  }
+
+  if(count > STACKMON_REG_REGION_COUNT)
+  {
+    memset(&regs[STACKMON_REG_REGION_COUNT], 0,
+           (count - STACKMON_REG_REGION_COUNT) * sizeof(uint16_t));
+    count = STACKMON_REG_REGION_COUNT;
+  }
+  memcpy(regs, image, count * sizeof(uint16_t));
+}
+
+/* 追加格式化文本，返回新的写入位置（截断时停在缓冲区末尾） */
+static uint32_t StackMon_Append(uint32_t size, uint32_t pos, int len)
+{
+  if(len < 0)
+  {
+    return pos;
+  }
+  pos += (uint32_t)len;
+  return (pos >= size) ? size - 1U : pos;
+}
+
+uint32_t StackMon_Format(char *buf, uint32_t size)
+{
+  uint32_t pos = 0;
+
+  if(buf == NULL || size == 0)
+  {
+    return 0;
+  }
+  buf[0] = '\0';
+
+  if(s_overflow[0] != '\0')
+  {
+    pos = StackMon_Append(size, pos, snprintf(&buf[pos], size - pos,
+          "last reset: stack overflow in %s\n", s_overflow));
+  }
+  pos = StackMon_Append(size, pos, snprintf(&buf[pos], size - pos,
+        "%-16s %3s %6s %6s %6s %8s\n", "task", "id", "size", "used", "free", "suggest"));
+  for(uint8_t i = 0; i < s_task_count; i++)
+  {
+    const StackMon_TaskInfo_t *info = &s_task[i].info;
+
+    pos = StackMon_Append(size, pos, snprintf(&buf[pos], size - pos,
+          "%-16s %3lu %6lu %6lu %6lu %8lu%s\n",
+          info->name, (unsigned long)info->id, (unsigned long)info->size,
+          (unsigned long)info->used, (unsigned long)info->min_free,
+          (unsigned long)info->suggested, info->low ? " LOW" : ""));
+  }
+
+  pos = StackMon_Append(size, pos, snprintf(&buf[pos], size - pos,
+        "heap total %lu free %lu min %lu largest %lu alloc %lu free %lu\n",
+        (unsigned long)s_heap.total, (unsigned long)s_heap.free,
+        (unsigned long)s_heap.min_free, (unsigned long)s_heap.largest,
+        (unsigned long)s_heap.allocs, (unsigned long)s_heap.frees));
+  pos = StackMon_Append(size, pos, snprintf(&buf[pos], size - pos,
+        "suggest configTOTAL_HEAP_SIZE %lu (stack saving %lu)\n",
+        (unsigned long)s_heap.suggested, (unsigned long)s_heap.stack_saving));
+
+  pos = StackMon_Append(size, pos, snprintf(&buf[pos], size - pos,
+        "%-6s %8s %8s %8s %8s %6s %6s %6s\n",
+        "region", "total", "free", "min", "largest", "alloc", "fail", "frag%"));
+  for(uint8_t i = 0; i < HEAP_REGION_NUM; i++)
+  {
+    const HeapRegion_Stats_t *st = &s_region[i];
+
+    pos = StackMon_Append(size, pos, snprintf(&buf[pos], size - pos,
+          "%-6s %8lu %8lu %8lu %8lu %6lu %6lu %4u.%u\n",
+          (st->name != NULL) ? st->name : "-", (unsigned long)st->total,
+          (unsigned long)st->free, (unsigned long)st->min_free, (unsigned long)st->largest,
+          (unsigned long)st->allocs, (unsigned long)st->failures,
+          st->fragmentation / 10U, st->fragmentation % 10U));
+  }
+
+  return pos;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file    stackmon.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   任务栈水位与堆使用监视
+ *
+ * @details 周期性读取全部任务的栈高水位（uxTaskGetSystemState，与
+ *          uxTaskGetStackHighWaterMark相同），给出每个任务的最小剩余字节数
+ *          与建议栈大小；同时读取堆统计（heap_region的DTCM区域），
+ *          给出configTOTAL_HEAP_SIZE的建议值（仅动态分配时扣除裁剪任务栈节省的部分），
+ *          以及全部堆区域（DTCM/AXI/D2/D3）的使用与碎片统计。
+ *
+ *          FreeRTOS不提供查询任务栈大小的接口，应用任务创建后须调用
+ *          StackMon_SetSize()登记；IDLE与定时器任务按配置自动登记。
+ *          高水位只反映已执行过的代码路径，建议值须在覆盖全部工况
+ *          （通信、告警、命令等）运行一段时间后再采纳。
+ */
+
+#ifndef STACKMON_H
+#define STACKMON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "heap_region.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 最多监视的任务数
+ */
+#define STACKMON_MAX_TASKS      16
+
+/**
+ * @brief 建议栈大小 = 峰值用量 + max(峰值用量 * STACKMON_MARGIN_PERCENT%, STACKMON_MARGIN_MIN)，
+ *        按STACKMON_ALIGN字节向上取整
+ */
+#define STACKMON_MARGIN_PERCENT 25
+#define STACKMON_MARGIN_MIN     128
+#define STACKMON_ALIGN          64
+
+/**
+ * @brief 剩余栈低于该字节数时置低水位标志
+ */
+#define STACKMON_LOW_FREE       128
+
+/**
+ * @brief 寄存器镜像布局（StackMon_Export）
+ * @note  头部：[0-1]堆总字节数 [2-3]当前剩余 [4-5]历史最小剩余 [6-7]建议堆大小（高/低）
+ *        每任务：[0]任务编号 [1]栈大小(字节，0未登记) [2]峰值用量 [3]最小剩余
+ *              [4]建议栈大小 [5]标志(bit0低水位) [6-7]任务名前4个ASCII字符
+ */
+#define STACKMON_REG_HEADER_LEN 8
+#define STACKMON_REG_TASK_LEN   8
+#define STACKMON_REG_COUNT      (STACKMON_REG_HEADER_LEN + STACKMON_MAX_TASKS * STACKMON_REG_TASK_LEN)
+
+/**
+ * @brief 堆区域寄存器镜像布局（StackMon_ExportRegions），按DTCM、AXI、D2、D3顺序
+ * @note  每区域：[0-1]可分配总量 [2-3]当前剩余 [4-5]历史最小剩余（高/低）
+ *              [6]分配失败次数 [7]碎片率(0.1%)；未启用的区域全部为0
+ */
+#define STACKMON_REG_REGION_LEN   8
+#define STACKMON_REG_REGION_COUNT (HEAP_REGION_NUM * STACKMON_REG_REGION_LEN)
+
+/**
+ * @brief 任务栈信息（单位字节）
+ */
+typedef struct
+{
+  const char *name;                     /**< 任务名 */
+  uint32_t id;                          /**< FreeRTOS任务编号 */
+  uint32_t size;                        /**< 栈大小，0表示未登记 */
+  uint32_t used;                        /**< 峰值用量，未登记时为0 */
+  uint32_t min_free;                    /**< 最小剩余（高水位） */
+  uint32_t suggested;                   /**< 建议栈大小，未登记时为0 */
+  bool low;                             /**< 最小剩余低于STACKMON_LOW_FREE */
+} StackMon_TaskInfo_t;
+
+/**
+ * @brief 堆信息（单位字节）
+ */
+typedef struct
+{
+  uint32_t total;                       /**< configTOTAL_HEAP_SIZE */
+  uint32_t free;                        /**< 当前剩余 */
+  uint32_t min_free;                    /**< 历史最小剩余 */
+  uint32_t largest;                     /**< 最大空闲块 */
+  uint32_t allocs;                      /**< 成功分配次数 */
+  uint32_t frees;                       /**< 成功释放次数 */
+  uint32_t stack_saving;                /**< 按建议值裁剪已登记任务栈可节省的字节数 */
+  uint32_t suggested;                   /**< 建议堆大小（峰值 + 余量，按1KB取整） */
+} StackMon_HeapInfo_t;
+
+/**
+ * @brief   初始化
+ *
+ * @return  None
+ */
+void StackMon_Init(void);
+
+/**
+ * @brief   登记任务栈大小
+ *
+ * @param[in]   task  任务句柄（osThreadId_t / TaskHandle_t）
+ * @param[in]   size  栈大小（字节，即osThreadAttr_t.stack_size）
+ *
+ * @return  0成功，-1参数错误或登记表已满
+ */
+int StackMon_SetSize(void *task, uint32_t size);
+
+/**
+ * @brief   登记上次复位前栈溢出的任务名（文本报告中输出）
+ *
+ * @param[in]   name  任务名，NULL清除
+ *
+ * @return  None
+ *
+ * @note    须在StackMon_Init()之后调用
+ */
+void StackMon_SetOverflow(const char *name);
+
+/**
+ * @brief   采样全部任务的栈高水位与堆统计
+ *
+ * @return  None
+ */
+void StackMon_Sample(void);
+
+/**
+ * @brief   读取任务栈信息
+ *
+ * @param[in]   index  任务序号（0 ~ 任务数-1）
+ * @param[out]  info   任务栈信息
+ *
+ * @return  0成功，-1序号越界
+ */
+int StackMon_GetTask(uint8_t index, StackMon_TaskInfo_t *info);
+
+/**
+ * @brief   读取堆信息
+ *
+ * @param[out]  info  堆信息
+ *
+ * @return  None
+ */
+void StackMon_GetHeap(StackMon_HeapInfo_t *info);
+
+/**
+ * @brief   读取堆区域统计（最近一次采样）
+ *
+ * @param[in]   region  区域编号
+ * @param[out]  stats   区域统计
+ *
+ * @return  0成功，-1参数错误
+ */
+int StackMon_GetRegion(HeapRegion_Id_t region, HeapRegion_Stats_t *stats);
+
+/**
+ * @brief   导出寄存器镜像
+ *
+ * @param[out]  regs   输出寄存器
+ * @param[in]   count  寄存器数量，超出STACKMON_REG_COUNT部分填0
+ *
+ * @return  None
+ */
+void StackMon_Export(uint16_t *regs, uint16_t count);
+
+/**
+ * @brief   导出堆区域寄存器镜像
+ *
+ * @param[out]  regs   输出寄存器
+ * @param[in]   count  寄存器数量，超出STACKMON_REG_REGION_COUNT部分填0
+ *
+ * @return  None
+ */
+void StackMon_ExportRegions(uint16_t *regs, uint16_t count);
+
+/**
+ * @brief   生成文本报告（含建议栈大小与建议堆大小）
+ *
+ * @param[out]  buf   输出缓冲区
+ * @param[in]   size  缓冲区大小
+ *
+ * @return  写入的字符数（不含结束符），缓冲区不足时截断
+ */
+uint32_t StackMon_Format(char *buf, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACKMON_H */
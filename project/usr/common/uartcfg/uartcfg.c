@@ -0,0 +1,65 @@
+/**
+ * @file    uartcfg.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   串口描述符校验与编号映射实现
+ */
+
+#include "uartcfg.h"
+#include <stddef.h>
+
+int32_t UartCfg_PortIndex(uintptr_t instance, const uintptr_t *instances, uint32_t count)
+{
+  if(instances == NULL)
+  {
+    return -1;
+  }
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+    if(instances[i] == instance)
+    {
+      return (int32_t)i;
+    }
+  }
+
+  return -1;
+}
+
+int32_t UartCfg_GpioIndex(uintptr_t port, uintptr_t first, uintptr_t stride)
+{
+  uintptr_t offset = port - first;
+
+  if(stride == 0U || port < first || offset % stride != 0U || offset / stride >= UARTCFG_GPIO_PORTS)
+  {
+    return -1;
+  }
+
+  return (int32_t)(offset / stride);
+}
+
+int UartCfg_Validate(const UartCfg_t *cfg)
+{
+  if(cfg == NULL || cfg->port < 0 || cfg->tx_gpio < 0 || cfg->rx_gpio < 0)
+  {
+    return -1;
+  }
+
+  if(cfg->dma_rx && (cfg->dma_rx_buf == NULL || cfg->dma_rx_len == 0U))
+  {
+    return -1;
+  }
+
+  if(cfg->rs485 && cfg->de_gpio < 0)
+  {
+    return -1;
+  }
+
+  // 不使用硬件DE时该值不写入寄存器，仍按同一范围检查，避免描述符中残留无效配置
+  if(cfg->de_assert > UARTCFG_DE_TIME_MAX || cfg->de_deassert > UARTCFG_DE_TIME_MAX)
+  {
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file    uartcfg.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   串口描述符校验与编号映射
+ *
+ * @details 从drv_uart.c中分离出与硬件无关的部分，只处理地址与数值，
+ *          不包含HAL头文件，可在主机上单独编译验证：
+ *          - 串口实例地址 → 中断分发编号
+ *          - GPIO端口地址 → 端口编号（GPIOA-GPIOK在RCC->AHB4ENR中按此编号排列）
+ *          - 描述符参数校验（实例、引脚端口、接收DMA缓冲区、RS485 DE配置）
+ */
+
+#ifndef UARTCFG_H
+#define UARTCFG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UARTCFG_GPIO_PORTS      11U     /**< GPIO端口数（GPIOA-GPIOK） */
+#define UARTCFG_DE_TIME_MAX     31U     /**< 硬件DE提前/保持时间上限（采样时钟数） */
+
+/**
+ * @brief 待校验的描述符参数（由驱动从串口描述符换算得到）
+ */
+typedef struct
+{
+  int32_t port;                         /**< 分发编号（UartCfg_PortIndex()结果） */
+  int32_t tx_gpio;                      /**< TX端口编号（UartCfg_GpioIndex()结果） */
+  int32_t rx_gpio;                      /**< RX端口编号 */
+  bool dma_rx;                          /**< 使用接收DMA */
+  const void *dma_rx_buf;               /**< DMA接收缓冲区 */
+  uint32_t dma_rx_len;                  /**< DMA接收缓冲区长度 */
+  bool rs485;                           /**< 使用RS485方向控制（硬件DE或GPIO） */
+  int32_t de_gpio;                      /**< DE端口编号 */
+  uint32_t de_assert;                   /**< 硬件DE提前置位时间 */
+  uint32_t de_deassert;                 /**< 硬件DE保持时间 */
+} UartCfg_t;
+
+/**
+ * @brief   查找串口实例对应的分发编号
+ *
+ * @param[in]   instance   串口实例地址
+ * @param[in]   instances  支持的实例地址表（下标即分发编号）
+ * @param[in]   count      表项数
+ *
+ * @return  分发编号，不支持的实例返回-1
+ */
+int32_t UartCfg_PortIndex(uintptr_t instance, const uintptr_t *instances, uint32_t count);
+
+/**
+ * @brief   计算GPIO端口编号
+ *
+ * @param[in]   port    端口地址
+ * @param[in]   first   GPIOA地址
+ * @param[in]   stride  相邻端口地址间隔
+ *
+ * @return  端口编号0-10（GPIOA-GPIOK），地址不在端口范围内或未对齐返回-1
+ */
+int32_t UartCfg_GpioIndex(uintptr_t port, uintptr_t first, uintptr_t stride);
+
+/**
+ * @brief   校验描述符参数
+ *
+ * @param[in]   cfg  参数
+ *
+ * @retval  0   有效
+ * @retval  -1  实例不支持、引脚端口无效、接收DMA缓冲区为空或RS485 DE配置无效
+ */
+int UartCfg_Validate(const UartCfg_t *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UARTCFG_H */
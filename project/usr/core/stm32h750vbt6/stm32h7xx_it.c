@@ -26,6 +26,7 @@
 #include "board.h"
 #include "stm32h7xx_hal_tim.h"
 #include "task.h"
+#include "runstats.h"
 
 
 /* Private includes ----------------------------------------------------------*/
@@ -196,6 +197,8 @@ extern void xPortSysTickHandler(void);
  *  这种设计使得代码可以在裸机模式下运行而不会崩溃。
  */
 void SysTick_Handler(void) {
+  uint32_t stamp = RunStats_IrqEnter();
+
   /* 
    * 检查FreeRTOS调度器是否已启动。
    * 如果调度器未启动，则跳过调用FreeRTOS的SysTick处理函数。
@@ -205,6 +208,7 @@ void SysTick_Handler(void) {
     xPortSysTickHandler();
   }
 
+  RunStats_IrqExit(BOARD_IRQ_SYSTICK, stamp);
 }
 
 /**
@@ -213,11 +217,12 @@ void SysTick_Handler(void) {
 void TIM4_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM4_IRQn 0 */
+  uint32_t stamp = RunStats_IrqEnter();
 
   /* USER CODE END TIM4_IRQn 0 */
   HAL_TIM_IRQHandler(&htim4);
   /* USER CODE BEGIN TIM4_IRQn 1 */
-
+  RunStats_IrqExit(BOARD_IRQ_TIM4, stamp);
   /* USER CODE END TIM4_IRQn 1 */
 }
 
@@ -5,7 +5,8 @@
  * @brief   Modbus从机设备层实现
  *
  * @details 实现nanoMODBUS平台适配接口，对接DMA+IDLE+环形缓冲区串口驱动，
- *          当前仅实现功能码0x03（读保持寄存器）
+ *          实现功能码0x03（读保持寄存器）、0x04（读输入寄存器）、
+ *          0x06/0x10（写保持寄存器）、0x14/0x15（读/写文件记录）
  */
 
 #include "modbus.h"
@@ -154,6 +155,177 @@ static nmbs_error modbus_read_holding_regs_callback(uint16_t address, uint16_t q
   return NMBS_ERROR_NONE;
 }
 
+/**
+ * @brief   读输入寄存器回调函数（功能码0x04）
+ *
+ * @param[in]   address      起始地址
+ * @param[in]   quantity     寄存器数量
+ * @param[out]  registers_out 输出寄存器数组
+ * @param[in]   unit_id      单元ID（RTU地址）
+ * @param[in]   arg          用户参数（modbus_dev_t指针）
+ *
+ * @return  NMBS_ERROR_NONE 成功，其他值为Modbus异常码
+ */
+static nmbs_error modbus_read_input_regs_callback(uint16_t address, uint16_t quantity,
+                                                  uint16_t *registers_out,
+                                                  uint8_t unit_id, void *arg)
+{
+  (void) unit_id;
+  modbus_dev_t *dev = (modbus_dev_t *)arg;
+
+  if(dev->input_regs == NULL)
+  {
+    return NMBS_EXCEPTION_ILLEGAL_FUNCTION;
+  }
+
+  // 检查地址范围：必须在 [input_base, input_base + input_count) 内
+  if(address < dev->input_base ||
+     (uint32_t)address + quantity > (uint32_t)dev->input_base + dev->input_count)
+  {
+    return NMBS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+  }
+
+  uint16_t index = address - dev->input_base;
+  memcpy(registers_out, &dev->input_regs[index], quantity * sizeof(uint16_t));
+
+  return NMBS_ERROR_NONE;
+}
+
+/**
+ * @brief   写保持寄存器公共处理
+ *
+ * @param[in]   dev       Modbus设备描述符指针
+ * @param[in]   address   起始地址
+ * @param[in]   quantity  寄存器数量
+ * @param[in]   values    写入值
+ *
+ * @return  NMBS_ERROR_NONE 成功，其他值为Modbus异常码
+ */
+static nmbs_error modbus_write_regs(modbus_dev_t *dev, uint16_t address, uint16_t quantity,
+                                   const uint16_t *values)
+{
+  // 检查地址范围：必须在可写窗口 [base_addr + write_first, +write_count) 内
+  uint32_t first = (uint32_t)dev->base_addr + dev->write_first;
+
+  if(dev->write_count == 0 || address < first ||
+     (uint32_t)address + quantity > first + dev->write_count)
+  {
+    return NMBS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+  }
+
+  uint16_t index = address - dev->base_addr;
+  memcpy(&dev->regs[index], values, quantity * sizeof(uint16_t));
+
+  if(dev->write_notify != NULL)
+  {
+    dev->write_notify(index, quantity, dev->write_arg);
+  }
+
+  return NMBS_ERROR_NONE;
+}
+
+/**
+ * @brief   写单个保持寄存器回调函数（功能码0x06）
+ *
+ * @param[in]   address  寄存器地址
+ * @param[in]   value    写入值
+ * @param[in]   unit_id  单元ID（RTU地址）
+ * @param[in]   arg      用户参数（modbus_dev_t指针）
+ *
+ * @return  NMBS_ERROR_NONE 成功，其他值为Modbus异常码
+ */
+static nmbs_error modbus_write_single_reg_callback(uint16_t address, uint16_t value,
+                                                   uint8_t unit_id, void *arg)
+{
+  (void) unit_id;
+
+  return modbus_write_regs((modbus_dev_t *)arg, address, 1, &value);
+}
+
+/**
+ * @brief   写多个保持寄存器回调函数（功能码0x10）
+ *
+ * @param[in]   address    起始地址
+ * @param[in]   quantity   寄存器数量
+ * @param[in]   registers  写入值
+ * @param[in]   unit_id    单元ID（RTU地址）
+ * @param[in]   arg        用户参数（modbus_dev_t指针）
+ *
+ * @return  NMBS_ERROR_NONE 成功，其他值为Modbus异常码
+ */
+static nmbs_error modbus_write_multiple_regs_callback(uint16_t address, uint16_t quantity,
+                                                      const uint16_t *registers,
+                                                      uint8_t unit_id, void *arg)
+{
+  (void) unit_id;
+
+  return modbus_write_regs((modbus_dev_t *)arg, address, quantity, registers);
+}
+
+/**
+ * @brief   读文件记录回调函数（功能码0x14）
+ *
+ * @param[in]   file_number    文件号
+ * @param[in]   record_number  起始记录号
+ * @param[out]  registers      输出寄存器数组
+ * @param[in]   count          寄存器数量
+ * @param[in]   unit_id        单元ID（RTU地址）
+ * @param[in]   arg            用户参数（modbus_dev_t指针）
+ *
+ * @return  NMBS_ERROR_NONE 成功，其他值为Modbus异常码
+ */
+static nmbs_error modbus_read_file_record_callback(uint16_t file_number, uint16_t record_number,
+                                                   uint16_t *registers, uint16_t count,
+                                                   uint8_t unit_id, void *arg)
+{
+  (void) unit_id;
+  modbus_dev_t *dev = (modbus_dev_t *)arg;
+
+  if(dev->file_read == NULL)
+  {
+    return NMBS_EXCEPTION_ILLEGAL_FUNCTION;
+  }
+
+  if(dev->file_read(file_number, record_number, registers, count, dev->file_arg) != 0)
+  {
+    return NMBS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+  }
+
+  return NMBS_ERROR_NONE;
+}
+
+/**
+ * @brief   写文件记录回调函数（功能码0x15）
+ *
+ * @param[in]   file_number    文件号
+ * @param[in]   record_number  起始记录号
+ * @param[in]   registers      写入的寄存器数组
+ * @param[in]   count          寄存器数量
+ * @param[in]   unit_id        单元ID（RTU地址）
+ * @param[in]   arg            用户参数（modbus_dev_t指针）
+ *
+ * @return  NMBS_ERROR_NONE 成功，其他值为Modbus异常码
+ */
+static nmbs_error modbus_write_file_record_callback(uint16_t file_number, uint16_t record_number,
+                                                    const uint16_t *registers, uint16_t count,
+                                                    uint8_t unit_id, void *arg)
+{
+  (void) unit_id;
+  modbus_dev_t *dev = (modbus_dev_t *)arg;
+
+  if(dev->file_write == NULL)
+  {
+    return NMBS_EXCEPTION_ILLEGAL_FUNCTION;
+  }
+
+  if(dev->file_write(file_number, record_number, registers, count, dev->file_arg) != 0)
+  {
+    return NMBS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+  }
+
+  return NMBS_ERROR_NONE;
+}
+
 /**
  * @brief   初始化Modbus从机
  *
@@ -193,6 +365,11 @@ void modbus_init(modbus_dev_t *dev, uart_desc_t uart, uint8_t slave_addr,
   nmbs_callbacks callbacks;
   nmbs_callbacks_create(&callbacks);
   callbacks.read_holding_registers = modbus_read_holding_regs_callback;     //注册保持寄存器回调函数
+  callbacks.read_input_registers = modbus_read_input_regs_callback;         //注册输入寄存器回调函数
+  callbacks.write_single_register = modbus_write_single_reg_callback;       //注册写单个寄存器回调函数
+  callbacks.write_multiple_registers = modbus_write_multiple_regs_callback; //注册写多个寄存器回调函数
+  callbacks.read_file_record = modbus_read_file_record_callback;            //注册读文件记录回调函数
+  callbacks.write_file_record = modbus_write_file_record_callback;          //注册写文件记录回调函数
   callbacks.arg = dev;
 
   // 创建Modbus从机
@@ -210,6 +387,79 @@ void modbus_init(modbus_dev_t *dev, uart_desc_t uart, uint8_t slave_addr,
   nmbs_set_byte_timeout(&dev->nmbs, 10);     // 10ms字节间超时
 }
 
+/**
+ * @brief   注册文件记录回调
+ *
+ * @param[in]   dev    Modbus设备描述符指针
+ * @param[in]   read   读取回调，NULL表示不支持
+ * @param[in]   write  写入回调，NULL表示不支持
+ * @param[in]   arg    回调用户参数
+ *
+ * @return  None
+ */
+void modbus_set_file_handler(modbus_dev_t *dev, modbus_file_read_t read,
+                             modbus_file_write_t write, void *arg)
+{
+  if(dev == NULL)
+  {
+    return;
+  }
+
+  dev->file_arg = arg;
+  dev->file_read = read;
+  dev->file_write = write;
+}
+
+/**
+ * @brief   设置可写保持寄存器范围
+ *
+ * @details 范围外的写请求返回非法数据地址异常
+ *
+ * @param[in]   dev     Modbus设备描述符指针
+ * @param[in]   first   可写寄存器起始索引（相对于起始地址）
+ * @param[in]   count   可写寄存器数量，0表示全部只读
+ * @param[in]   notify  写入通知回调，可为NULL
+ * @param[in]   arg     回调用户参数
+ *
+ * @return  None
+ */
+void modbus_set_write_handler(modbus_dev_t *dev, uint16_t first, uint16_t count,
+                              modbus_write_notify_t notify, void *arg)
+{
+  if(dev == NULL || (uint32_t)first + count > dev->regs_count)
+  {
+    return;
+  }
+
+  dev->write_arg = arg;
+  dev->write_notify = notify;
+  dev->write_first = first;
+  dev->write_count = count;
+}
+
+/**
+ * @brief   设置输入寄存器（功能码0x04）
+ *
+ * @param[in]   dev        Modbus设备描述符指针
+ * @param[in]   regs       输入寄存器数组指针，NULL表示不支持
+ * @param[in]   count      输入寄存器数量
+ * @param[in]   base_addr  输入寄存器起始地址
+ *
+ * @return  None
+ */
+void modbus_set_input_regs(modbus_dev_t *dev, const uint16_t *regs, uint16_t count,
+                           uint16_t base_addr)
+{
+  if(dev == NULL)
+  {
+    return;
+  }
+
+  dev->input_regs = regs;
+  dev->input_count = count;
+  dev->input_base = base_addr;
+}
+
 /**
  * @brief   Modbus从机轮询处理函数
  *
@@ -265,6 +515,28 @@ void modbus_set_byte_timeout(modbus_dev_t *dev, int32_t timeout_ms)
   nmbs_set_byte_timeout(&dev->nmbs, timeout_ms);
 }
 
+/**
+ * @brief   读取过程量原始测量值
+ *
+ * @param[out]  raw  112-115对应的原始值，共MODBUS_REG_PROCESS_LEN个
+ *
+ * @return  None
+ *
+ * @note    由应用层跟踪滤波后写入112-115，modbus_update_regs()不再覆盖
+ */
+void modbus_get_process_raw(uint16_t *raw)
+{
+  if(raw == NULL)
+  {
+    return;
+  }
+
+  raw[0] = 65000;  // 112: Intake Pressure (进气压力 Psi*10)
+  raw[1] = 135;    // 113: Discharge Pressure (排气压力 Psi*10)
+  raw[2] = 800;    // 114: Intake Temperature (进气温度 ℃*10)
+  raw[3] = 800;    // 115: Motor Temperature (电机温度 ℃*10)
+}
+
 /**
  * @brief   更新Modbus寄存器数据
  *
@@ -300,17 +572,13 @@ void modbus_update_regs(uint16_t *regs)
   // 地址110-119: 数字板
   regs[10] = 10000+cnt;  // 110: CL Value (mA*1000)
   regs[11] = 20000;  // 111: CH Value (mA*1000)
-  regs[12] = 65000;  // 112: Intake Pressure (进气压力 Psi*10)
-  regs[13] = 135;  // 113: Discharge Pressure (排气压力 Psi*10)
-  regs[14] = 800;  // 114: Intake Temperature (进气温度 ℃*10)
-  regs[15] = 800;  // 115: Motor Temperature (电机温度 ℃*10)
-  regs[16] = 200;  // 116: X-Vibration (X振动 g*1000)
-  regs[17] = 200;  // 117: Y-Vibration (Y振动 g*1000)
+  // 112-115: 压力/温度，由过程量跟踪任务滤波后更新，原始值见modbus_get_process_raw()
+  // 116-117: X/Y-Vibration (X/Y振动 g*1000)，由振动频谱任务实时更新
   regs[18] = 1;  // 118: Current Leakage (电流泄漏 mA*1000)
   regs[19] = 1000;  // 119: Y Point Voltage (Y点电压 V*10)
 
   // 地址130-139: 扩展数据
-  // regs[20] = 0;  // 120: FW flag (错误状态标志)
+  // 120: FW flag (错误状态标志)，由告警任务锁存
   // regs[30] = 0;  // 130: Discharge Temperature (排气温度 ℃*10)
   // regs[31] = 0;  // 131: X-Vibration (X振动 g*10)
   // regs[32] = 0;  // 132: Z-Vibration (Z振动 g*10)
@@ -6,7 +6,8 @@
  *
  * @details 基于nanoMODBUS库实现的Modbus RTU从机，
  *          适配DMA+IDLE+环形缓冲区的串口驱动，
- *          当前仅实现功能码0x03（读保持寄存器）
+ *          实现功能码0x03（读保持寄存器）、0x04（读输入寄存器）、
+ *          0x06/0x10（写保持寄存器）、0x14/0x15（读/写文件记录）
  */
 
 #ifndef MODBUS_H
@@ -20,6 +21,84 @@
 extern "C" {
 #endif
 
+/**
+ * @brief 保持寄存器索引（相对于起始地址100）
+ * @note  以下寄存器由应用任务实时维护，modbus_update_regs()不再覆盖
+ */
+#define MODBUS_REG_PROCESS        12  /**< 112-115: 进/排气压力(Psi*10)、进气/电机温度(℃*10)，跟踪滤波后 */
+#define MODBUS_REG_PROCESS_LEN    4   /**< 过程量寄存器数量 */
+#define MODBUS_REG_VIB_X          16  /**< 116: X振动 (g*1000，全频带RMS) */
+#define MODBUS_REG_VIB_Y          17  /**< 117: Y振动 (g*1000，全频带RMS) */
+#define MODBUS_REG_ALARM          20  /**< 120: FW flag 告警锁存状态位图 */
+#define MODBUS_REG_SPECTRUM_X     50  /**< 150-155: X轴频谱（4个频带RMS、峰值频率Hz、峰值幅度） */
+#define MODBUS_REG_SPECTRUM_Y     56  /**< 156-161: Y轴频谱，格式同X轴 */
+#define MODBUS_REG_SPECTRUM_LEN   6   /**< 单轴频谱寄存器数量 */
+#define MODBUS_REG_PIPELINE_1     100 /**< 200-227: ADC1滤波流水线（控制、状态、输出、统计、级描述，可写） */
+#define MODBUS_REG_PIPELINE_2     128 /**< 228-255: ADC2滤波流水线，格式同ADC1 */
+#define MODBUS_REG_PIPELINE_LEN   28  /**< 单通道流水线寄存器数量 */
+#define MODBUS_REG_TRACKER        156 /**< 256-267: 112-115跟踪器参数，每个3个（模型、Q、R），可写 */
+#define MODBUS_REG_TRACKER_LEN    12  /**< 跟踪器参数寄存器数量 */
+#define MODBUS_REG_RUNSTATS_CMD   168 /**< 268: 统计命令（1运行时统计文本转储，2清除历史与串口统计，3栈/堆报告），执行后清零，可写 */
+#define MODBUS_REG_COUNT          169 /**< 保持寄存器总数（地址100-268） */
+
+/**
+ * @brief 输入寄存器索引（功能码0x04，相对于起始地址100）
+ */
+#define MODBUS_INPUT_REG_RUNSTATS 0   /**< 100-299: 任务/中断运行时统计镜像（布局见runstats.h） */
+#define MODBUS_INPUT_REG_STACK    200 /**< 300-435: 任务栈高水位与堆使用镜像（布局见stackmon.h） */
+#define MODBUS_INPUT_REG_BOOT     336 /**< 436-445: 启动阶段完成时刻(us，高/低16位)：入口、时钟、内存清零、驱动、调度器 */
+#define MODBUS_INPUT_REG_BOOT_LEN 10  /**< 启动时间戳寄存器数量 */
+#define MODBUS_INPUT_REG_UART     346 /**< 446-481: 串口链路统计，RS232、RS485各18个（布局见drv_uart.h uart_stats_t，高/低16位） */
+#define MODBUS_INPUT_REG_UART_LEN 36  /**< 串口统计寄存器数量 */
+#define MODBUS_INPUT_REG_HEAP     382 /**< 482-513: 堆区域统计，DTCM、AXI、D2、D3各8个（布局见stackmon.h） */
+#define MODBUS_INPUT_REG_HEAP_LEN 32  /**< 堆区域统计寄存器数量 */
+#define MODBUS_INPUT_REG_FAULT    414 /**< 514-518: 上次复位前的栈溢出记录（[0]为1表示有记录，[1-4]任务名前8个ASCII字符） */
+#define MODBUS_INPUT_REG_FAULT_LEN 5  /**< 栈溢出记录寄存器数量 */
+#define MODBUS_INPUT_REG_COUNT    419 /**< 输入寄存器总数（地址100-518） */
+
+/**
+ * @brief   文件记录读取回调（功能码0x14）
+ *
+ * @param[in]   file    文件号
+ * @param[in]   record  起始记录号（文件内寄存器偏移）
+ * @param[out]  regs    输出寄存器
+ * @param[in]   count   寄存器数量
+ * @param[in]   arg     用户参数
+ *
+ * @retval  0   成功
+ * @retval  -1  文件或记录不存在
+ */
+typedef int (*modbus_file_read_t)(uint16_t file, uint16_t record, uint16_t *regs,
+                                  uint16_t count, void *arg);
+
+/**
+ * @brief   文件记录写入回调（功能码0x15）
+ *
+ * @param[in]   file    文件号
+ * @param[in]   record  起始记录号（文件内寄存器偏移）
+ * @param[in]   regs    写入的寄存器
+ * @param[in]   count   寄存器数量
+ * @param[in]   arg     用户参数
+ *
+ * @retval  0   成功
+ * @retval  -1  文件或记录不存在、不可写
+ */
+typedef int (*modbus_file_write_t)(uint16_t file, uint16_t record, const uint16_t *regs,
+                                   uint16_t count, void *arg);
+
+/**
+ * @brief   保持寄存器写入通知回调（功能码0x06/0x10）
+ *
+ * @param[in]   index  起始寄存器索引（相对于起始地址）
+ * @param[in]   count  寄存器数量
+ * @param[in]   arg    用户参数
+ *
+ * @return  None
+ *
+ * @note    在Modbus任务上下文中调用，调用时新值已写入寄存器数组
+ */
+typedef void (*modbus_write_notify_t)(uint16_t index, uint16_t count, void *arg);
+
 /**
  * @brief Modbus从机设备描述符
  */
@@ -31,6 +110,16 @@ typedef struct
   uint16_t *regs;        /**< 保持寄存器数组指针 */
   uint16_t regs_count;   /**< 保持寄存器数量 */
   uint16_t base_addr;    /**< 寄存器起始地址 */
+  modbus_file_read_t file_read;   /**< 文件记录读取回调，NULL表示不支持 */
+  modbus_file_write_t file_write; /**< 文件记录写入回调，NULL表示不支持 */
+  void *file_arg;                 /**< 文件记录回调用户参数 */
+  uint16_t write_first;           /**< 可写寄存器起始索引 */
+  uint16_t write_count;           /**< 可写寄存器数量，0表示全部只读 */
+  modbus_write_notify_t write_notify; /**< 写入通知回调，可为NULL */
+  void *write_arg;                /**< 写入通知回调用户参数 */
+  const uint16_t *input_regs;     /**< 输入寄存器数组指针，NULL表示不支持 */
+  uint16_t input_count;           /**< 输入寄存器数量 */
+  uint16_t input_base;            /**< 输入寄存器起始地址 */
 } modbus_dev_t;
 
 /**
@@ -48,6 +137,50 @@ typedef struct
 void modbus_init(modbus_dev_t *dev, uart_desc_t uart, uint8_t slave_addr,
                  uint16_t *regs, uint16_t regs_count, uint16_t base_addr);
 
+/**
+ * @brief   注册文件记录回调
+ *
+ * @param[in]   dev    Modbus设备描述符指针
+ * @param[in]   read   读取回调，NULL表示不支持
+ * @param[in]   write  写入回调，NULL表示不支持
+ * @param[in]   arg    回调用户参数
+ *
+ * @return  None
+ */
+void modbus_set_file_handler(modbus_dev_t *dev, modbus_file_read_t read,
+                             modbus_file_write_t write, void *arg);
+
+/**
+ * @brief   设置可写保持寄存器范围
+ *
+ * @details 范围外的写请求返回非法数据地址异常
+ *
+ * @param[in]   dev     Modbus设备描述符指针
+ * @param[in]   first   可写寄存器起始索引（相对于起始地址）
+ * @param[in]   count   可写寄存器数量，0表示全部只读
+ * @param[in]   notify  写入通知回调，可为NULL
+ * @param[in]   arg     回调用户参数
+ *
+ * @return  None
+ */
+void modbus_set_write_handler(modbus_dev_t *dev, uint16_t first, uint16_t count,
+                              modbus_write_notify_t notify, void *arg);
+
+/**
+ * @brief   设置输入寄存器（功能码0x04）
+ *
+ * @param[in]   dev        Modbus设备描述符指针
+ * @param[in]   regs       输入寄存器数组指针，NULL表示不支持
+ * @param[in]   count      输入寄存器数量
+ * @param[in]   base_addr  输入寄存器起始地址
+ *
+ * @return  None
+ *
+ * @note    数组由应用层维护，读请求直接返回当前内容
+ */
+void modbus_set_input_regs(modbus_dev_t *dev, const uint16_t *regs, uint16_t count,
+                           uint16_t base_addr);
+
 /**
  * @brief   Modbus从机轮询处理函数
  *
@@ -79,6 +212,17 @@ void modbus_set_read_timeout(modbus_dev_t *dev, int32_t timeout_ms);
  */
 void modbus_set_byte_timeout(modbus_dev_t *dev, int32_t timeout_ms);
 
+/**
+ * @brief   读取过程量原始测量值
+ *
+ * @param[out]  raw  112-115对应的原始值，共MODBUS_REG_PROCESS_LEN个
+ *
+ * @return  None
+ *
+ * @note    由应用层跟踪滤波后写入112-115，modbus_update_regs()不再覆盖
+ */
+void modbus_get_process_raw(uint16_t *raw);
+
 /**
  * @brief   更新Modbus寄存器数据
  *
@@ -11,6 +11,7 @@
 #include "drv_gpio.h"
 #include "drv_uart.h"
 #include "drv_adc.h"
+#include "drv_dma.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,16 +37,6 @@ extern uart_desc_t uart2_rs485;
  */
 extern uart_desc_t uart1_rs232;
 
-/**
- * @brief UART1 DMA接收缓冲区（硬件DMA使用）
- */
-extern uint8_t Uart1_dma_rx_buf[256];
-
-/**
- * @brief UART2 DMA接收缓冲区（硬件DMA使用）
- */
-extern uint8_t Uart2_dma_rx_buf[256];
-
 /**
  * @brief UART1 环形缓冲区存储空间
  */
@@ -62,6 +53,50 @@ extern uint8_t Uart2_ringbuf_storage[512];
 extern adc_desc_t adc1;
 extern adc_desc_t adc2;
 
+/**
+ * @brief ADC数据块样本数（DMA缓冲区的一半，半传输/传输完成各交付一块）
+ * @note  126 kSPS下每4ms交付一块
+ */
+#define BOARD_ADC_BLOCK_LEN     512
+
+/**
+ * @brief 运行时统计中断编号（RunStats_IrqEnter/RunStats_IrqExit）
+ */
+typedef enum
+{
+  BOARD_IRQ_SYSTICK = 0,    /**< SysTick（RTOS节拍） */
+  BOARD_IRQ_TIM4,           /**< TIM4（HAL时基） */
+  BOARD_IRQ_USART1,         /**< USART1（RS232） */
+  BOARD_IRQ_USART2,         /**< USART2（RS485） */
+  BOARD_IRQ_ADC1_DMA,       /**< ADC1的DMA流 */
+  BOARD_IRQ_ADC2_DMA,       /**< ADC2的DMA流 */
+  BOARD_IRQ_ADC,            /**< ADC1/ADC2全局中断（模拟看门狗） */
+  BOARD_IRQ_MDMA,           /**< MDMA（异步内存复制） */
+  BOARD_IRQ_NUM
+} board_irq_t;
+
+/**
+ * @brief 运行时统计中断名，按board_irq_t编号
+ */
+extern const char *const board_irq_names[BOARD_IRQ_NUM];
+
+/**
+ * @brief DMA请求编号（board_dma_requests下标，dma_attach使用）
+ */
+typedef enum
+{
+  BOARD_DMA_USART2_RX = 0,  /**< USART2接收（循环） */
+  BOARD_DMA_USART2_TX,      /**< USART2发送 */
+  BOARD_DMA_ADC1,           /**< ADC1采样（循环） */
+  BOARD_DMA_ADC2,           /**< ADC2采样（循环） */
+  BOARD_DMA_NUM
+} board_dma_t;
+
+/**
+ * @brief DMA请求表，按board_dma_t编号，dma_init()据此分配流
+ */
+extern const dma_request_t board_dma_requests[BOARD_DMA_NUM];
+
 
 #ifdef __cplusplus
 }
@@ -18,6 +18,43 @@ extern "C" {
 struct adc_desc;
 typedef struct adc_desc *adc_desc_t;
 
+/**
+ * @brief   ADC数据块回调函数类型
+ *
+ * @details DMA半传输/传输完成时在中断上下文中调用，block指向DMA缓冲区中
+ *          刚刚写满、且在下一个半周期内不会被覆盖的一半。
+ *
+ * @param[in]   adc    ADC描述符
+ * @param[in]   block  数据块指针
+ * @param[in]   len    数据块样本数（DMA缓冲区长度的一半）
+ * @param[in]   arg    用户参数
+ */
+typedef void (*adc_block_cb_t)(adc_desc_t adc, const uint16_t *block, uint16_t len, void *arg);
+
+/**
+ * @brief 模拟看门狗编号
+ */
+typedef enum
+{
+  ADC_AWD_1 = 0,
+  ADC_AWD_2,
+  ADC_AWD_3,
+  ADC_AWD_NUM
+} adc_awd_t;
+
+/**
+ * @brief   模拟看门狗告警回调函数类型
+ *
+ * @details 采样值离开[low, high]窗口时在ADC中断上下文中调用，
+ *          调用后该看门狗中断自动关闭，需由任务调用adc_awd_arm()重新使能。
+ *          中断优先级为configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY，可调用RTOS的中断API。
+ *
+ * @param[in]   adc  ADC描述符
+ * @param[in]   awd  触发的看门狗编号
+ * @param[in]   arg  用户参数
+ */
+typedef void (*adc_awd_cb_t)(adc_desc_t adc, adc_awd_t awd, void *arg);
+
 void adc_init(adc_desc_t adc);
 uint16_t adc_read(adc_desc_t adc);
 void adc_start_dma(adc_desc_t adc);
@@ -25,6 +62,13 @@ void adc_stop_dma(adc_desc_t adc);
 uint16_t adc_get_average(adc_desc_t adc);
 uint16_t *adc_get_dma_buffer(adc_desc_t adc);
 uint16_t adc_get_dma_length(adc_desc_t adc);
+void adc_set_block_callback(adc_desc_t adc, adc_block_cb_t cb, void *arg);
+int adc_awd_config(adc_desc_t adc, adc_awd_t awd, uint16_t low, uint16_t high,
+                   adc_awd_cb_t cb, void *arg);
+void adc_awd_arm(adc_desc_t adc, adc_awd_t awd);
+void adc_awd_disarm(adc_desc_t adc, adc_awd_t awd);
+uint8_t adc_awd_get_status(adc_desc_t adc);
+void adc_awd_clear_status(adc_desc_t adc, uint8_t mask);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,84 @@
+/**
+ * @file    drv_dma.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   DMA流资源管理
+ *
+ * @details 统一管理DMA1/DMA2的16个流与BDMA的8个通道。板级以请求表
+ *          （board_dma_requests）声明各外设的DMAMUX请求、允许的控制器、
+ *          优先级与中断优先级，dma_init()一次分配全部流，冲突在启动时报错，
+ *          不再需要人工核对各驱动中写死的流号。
+ *
+ *          外设驱动在MSP初始化中调用dma_attach()（drv_dma_desc.h）取得流并
+ *          初始化HAL句柄；流中断由本驱动统一定义，按分配表分发到HAL句柄，
+ *          并计入请求表指定的运行时统计中断编号。
+ */
+
+#ifndef DRV_DMA_H
+#define DRV_DMA_H
+
+#include <stdint.h>
+#include "dmaalloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DMA仲裁优先级（同时决定自动分配顺序）
+ */
+#define DMA_PRIO_LOW            0U
+#define DMA_PRIO_MEDIUM         1U
+#define DMA_PRIO_HIGH           2U
+#define DMA_PRIO_VERY_HIGH      3U
+
+/**
+ * @brief DMA请求描述
+ */
+typedef struct
+{
+  const char *name;                     /**< 请求名（诊断输出） */
+  uint32_t request;                     /**< DMAMUX请求编号（DMA_REQUEST_xxx/BDMA_REQUEST_xxx） */
+  uint8_t controllers;                  /**< 允许的控制器（DMAALLOC_CTRL_xxx组合） */
+  int8_t stream;                        /**< 固定全局流编号，DMAALLOC_ANY表示自动分配 */
+  uint8_t priority;                     /**< 仲裁优先级（DMA_PRIO_xxx） */
+  uint8_t irq_priority;                 /**< 流中断抢占优先级 */
+  int8_t stat;                          /**< 运行时统计中断编号（board_irq_t），-1不统计 */
+} dma_request_t;
+
+/**
+ * @brief   按请求表分配DMA流
+ *
+ * @param[in]   reqs   请求表（须为静态存储，请求编号即表中下标）
+ * @param[in]   count  请求数
+ *
+ * @retval  0   成功
+ * @retval  -1  参数错误或存在无法分配的请求
+ *
+ * @note    须在各外设初始化（HAL_xxx_MspInit）之前调用
+ */
+int dma_init(const dma_request_t *reqs, uint32_t count);
+
+/**
+ * @brief   获取请求分配到的全局流编号
+ *
+ * @param[in]   id  请求编号
+ *
+ * @return  全局流编号（0-23），未分配返回-1
+ */
+int dma_get_stream(uint32_t id);
+
+/**
+ * @brief   获取全局流名称
+ *
+ * @param[in]   stream  全局流编号
+ *
+ * @return  名称（如"DMA1_S3"、"BDMA_C0"），编号无效返回"-"
+ */
+const char *dma_stream_name(int stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV_DMA_H */
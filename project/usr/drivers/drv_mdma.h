@@ -0,0 +1,144 @@
+/**
+ * @file    drv_mdma.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   MDMA异步内存复制/填充服务
+ *
+ * @details 将大块memcpy/memset交给MDMA在后台完成，CPU继续运行。
+ *          作业描述由调用者分配（首次使用前清零，完成前不得释放），按提交顺序排队执行，
+ *          完成后置状态并调用回调（中断上下文）；也可用mdma_job_done()轮询
+ *          或mdma_wait()等待，作为future使用。
+ *
+ *          - 长度小于MDMA_CPU_THRESHOLD时由CPU立即完成，回调在提交者上下文中调用
+ *          - 目标首尾不满32字节cache行的部分由CPU处理，MDMA只写整行，
+ *            完成后失效目标cache时不会丢弃相邻变量的修改
+ *          - 启动前清理源与目标的D-Cache，完成后失效目标的D-Cache，
+ *            CPU在完成前不得读写目标区域
+ *          - 源、目标可位于DTCM/AXI/D2/D3（MDMA经AHBS访问TCM），不能位于ITCM代码区
+ *
+ *          任务与中断均可提交作业。
+ */
+
+#ifndef DRV_MDMA_H
+#define DRV_MDMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 低于该字节数由CPU直接完成（MDMA启动与cache维护的开销大于收益）
+ */
+#ifndef MDMA_CPU_THRESHOLD
+#define MDMA_CPU_THRESHOLD      256U
+#endif
+
+/**
+ * @brief 作业状态
+ */
+typedef enum
+{
+  MDMA_JOB_IDLE = 0,                    /**< 未提交或已取走结果 */
+  MDMA_JOB_PENDING,                     /**< 排队或传输中 */
+  MDMA_JOB_DONE,                        /**< 完成 */
+  MDMA_JOB_ERROR                        /**< MDMA传输错误 */
+} mdma_job_state_t;
+
+struct mdma_job;
+
+/**
+ * @brief   作业完成回调
+ *
+ * @param[in]   job  完成的作业（state为MDMA_JOB_DONE或MDMA_JOB_ERROR）
+ * @param[in]   arg  用户参数
+ *
+ * @note    MDMA完成时在中断上下文中调用，CPU完成时在提交者上下文中调用
+ */
+typedef void (*mdma_callback_t)(struct mdma_job *job, void *arg);
+
+/**
+ * @brief 作业描述（由调用者分配，成员由驱动维护）
+ */
+typedef struct mdma_job
+{
+  struct mdma_job *next;                /**< 队列链接 */
+  uint8_t *dst;                         /**< 目标地址 */
+  const uint8_t *src;                   /**< 源地址，NULL表示填充 */
+  uint32_t len;                         /**< 字节数 */
+  uint32_t offset;                      /**< 已启动的字节数（超过64KB时分段传输） */
+  uint32_t pattern;                     /**< 填充值（4字节重复） */
+  mdma_callback_t callback;             /**< 完成回调，可为NULL */
+  void *arg;                            /**< 回调参数 */
+  volatile mdma_job_state_t state;      /**< 状态 */
+} mdma_job_t;
+
+/**
+ * @brief   初始化MDMA服务
+ *
+ * @retval  0   成功
+ * @retval  -1  失败
+ */
+int mdma_init(void);
+
+/**
+ * @brief   提交复制作业（等价于memcpy，区域不能重叠）
+ *
+ * @param[out]  job       作业描述
+ * @param[out]  dst       目标地址
+ * @param[in]   src       源地址
+ * @param[in]   len       字节数
+ * @param[in]   callback  完成回调，可为NULL
+ * @param[in]   arg       回调参数
+ *
+ * @retval  0   已提交（或已由CPU完成）
+ * @retval  -1  参数错误或作业仍在进行中
+ */
+int mdma_memcpy(mdma_job_t *job, void *dst, const void *src, uint32_t len,
+                mdma_callback_t callback, void *arg);
+
+/**
+ * @brief   提交填充作业（等价于memset）
+ *
+ * @param[out]  job       作业描述
+ * @param[out]  dst       目标地址
+ * @param[in]   value     填充字节
+ * @param[in]   len       字节数
+ * @param[in]   callback  完成回调，可为NULL
+ * @param[in]   arg       回调参数
+ *
+ * @retval  0   已提交（或已由CPU完成）
+ * @retval  -1  参数错误或作业仍在进行中
+ */
+int mdma_memset(mdma_job_t *job, void *dst, uint8_t value, uint32_t len,
+                mdma_callback_t callback, void *arg);
+
+/**
+ * @brief   查询作业是否结束
+ *
+ * @param[in]   job  作业描述
+ *
+ * @return  true已完成或出错，false仍在进行
+ */
+bool mdma_job_done(const mdma_job_t *job);
+
+/**
+ * @brief   等待作业结束
+ *
+ * @param[in]   job      作业描述
+ * @param[in]   timeout  超时（ms，HAL时基）
+ *
+ * @retval  0   完成
+ * @retval  -1  传输错误或超时
+ *
+ * @note    忙等，RTOS任务中较长的作业宜在回调中发送线程标志后阻塞等待
+ */
+int mdma_wait(const mdma_job_t *job, uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV_MDMA_H */
@@ -1,12 +1,38 @@
 #ifndef DRV_SYSTEM_H
 #define DRV_SYSTEM_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define DRV_CACHE_LINE          32U     /**< Cortex-M7 D-Cache行字节数 */
+
+/**
+ * @brief 启动阶段（DRV_System_BootMark打点）
+ */
+typedef enum
+{
+  DRV_BOOT_RESET = 0,                   /**< DRV_System_Init入口（计时起点） */
+  DRV_BOOT_CLOCKS,                      /**< PLL锁定、系统时钟切换完成 */
+  DRV_BOOT_MEMORY,                      /**< AXI/D2/D3区域变量清零完成 */
+  DRV_BOOT_DRIVERS,                     /**< 外设、Modbus与ADC初始化完成 */
+  DRV_BOOT_SCHEDULER,                   /**< 任务创建完成，即将启动调度器 */
+  DRV_BOOT_PHASE_NUM
+} DRV_BootPhase_t;
+
 int DRV_System_Init(void);
 void DRV_System_ErrorHandler(void);
+uint32_t DRV_System_GetCycles(void);
+uint32_t DRV_System_GetCoreClock(void);
+void DRV_System_SetCache(bool enable);
+bool DRV_System_CacheEnabled(void);
+void DRV_System_CacheClean(const void *addr, uint32_t len);
+void DRV_System_CacheInvalidate(void *addr, uint32_t len);
+void DRV_System_BootMark(DRV_BootPhase_t phase);
+uint32_t DRV_System_GetBootTime(DRV_BootPhase_t phase);
 
 #ifdef __cplusplus
 }
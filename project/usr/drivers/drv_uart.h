@@ -22,6 +22,27 @@ struct uart_desc;
 // app和设备层只包含 drv_uart.h，通过 uart_desc_t 不透明指针操作串口！
 typedef struct uart_desc *uart_desc_t;
 
+/**
+ * @brief 串口链路统计（自uart_init或uart_clear_stats起累计）
+ */
+typedef struct
+{
+  uint32_t rx_bytes;                  /**< 接收字节数 */
+  uint32_t tx_bytes;                  /**< 已启动发送的字节数 */
+  uint32_t rx_frames;                 /**< 接收帧数（总线空闲分帧） */
+  uint32_t ore;                       /**< 溢出错误（ORE）次数 */
+  uint32_t fe;                        /**< 帧错误（FE）次数 */
+  uint32_t ne;                        /**< 噪声错误（NE）次数 */
+  uint32_t pe;                        /**< 校验错误（PE）次数 */
+  uint32_t rx_dropped;                /**< 环形缓冲区满时被覆盖丢弃的字节数 */
+  uint32_t rx_peak;                   /**< 环形缓冲区占用峰值（字节） */
+} uart_stats_t;
+
+/**
+ * @brief 统计寄存器镜像长度（uart_stats_t各成员依次按高/低16位展开）
+ */
+#define UART_STATS_REG_LEN  (2U * (sizeof(uart_stats_t) / sizeof(uint32_t)))
+
 /**
  * @brief   初始化UART
  *
@@ -134,6 +155,26 @@ uint32_t uart_get_available(uart_desc_t uart);
  */
 void uart_flush_rx(uart_desc_t uart);
 
+/**
+ * @brief   读取链路统计
+ *
+ * @param[in]   uart   UART描述符
+ * @param[out]  stats  统计快照
+ *
+ * @retval  0   成功
+ * @retval  -1  参数错误
+ */
+int uart_get_stats(uart_desc_t uart, uart_stats_t *stats);
+
+/**
+ * @brief   清除链路统计
+ *
+ * @param[in]   uart  UART描述符
+ *
+ * @return  None
+ */
+void uart_clear_stats(uart_desc_t uart);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,236 @@
+/**
+ * @file    drv_adc.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   ADC驱动主机端模型
+ *
+ * @details 实现drv_adc.h的全部接口，用于在主机上测试告警与数据块处理逻辑：
+ *          - 模拟看门狗比较器：每个样本与[low, high]比较，离开窗口时置位硬件标志；
+ *            中断使能时与目标板相同地关闭该看门狗中断、锁存状态并调用回调（单次触发）
+ *          - adc_awd_arm()清除硬件标志后重新使能中断，标志置位期间不会重复进入中断
+ *          - 攒满半个缓冲区调用数据块回调，交付的数据块位于模拟DMA缓冲区中
+ *
+ *          与目标板一致，adc_awd_config()须在adc_start_dma()之前调用。
+ */
+
+#include "drv_adc.h"
+#include "drv_adc_desc.h"
+#include <stddef.h>
+
+void adc_init(adc_desc_t adc)
+{
+  if(adc == NULL)
+  {
+    return;
+  }
+
+  adc->write_index = 0;
+  adc->running = false;
+  adc->awd_status = 0;
+  adc->awd_irq_count = 0;
+  for(uint32_t i = 0; i < ADC_AWD_NUM; i++)
+  {
+    adc->awd_configured[i] = false;
+    adc->awd_it[i] = false;
+    adc->awd_flag[i] = false;
+  }
+}
+
+uint16_t adc_read(adc_desc_t adc)
+{
+  if(adc == NULL || adc->dma_buffer == NULL || adc->buffer_len == 0)
+  {
+    return 0;
+  }
+
+  return adc->dma_buffer[(adc->write_index + adc->buffer_len - 1U) % adc->buffer_len];
+}
+
+void adc_start_dma(adc_desc_t adc)
+{
+  if(adc == NULL)
+  {
+    return;
+  }
+
+  adc->write_index = 0;
+  adc->running = true;
+}
+
+void adc_stop_dma(adc_desc_t adc)
+{
+  if(adc == NULL)
+  {
+    return;
+  }
+
+  adc->running = false;
+}
+
+uint16_t adc_get_average(adc_desc_t adc)
+{
+  uint32_t sum = 0;
+
+  if(adc == NULL || adc->dma_buffer == NULL || adc->buffer_len == 0)
+  {
+    return 0;
+  }
+
+  for(uint32_t i = 0; i < adc->buffer_len; i++)
+  {
+    sum += adc->dma_buffer[i];
+  }
+
+  return (uint16_t)(sum / adc->buffer_len);
+}
+
+uint16_t *adc_get_dma_buffer(adc_desc_t adc)
+{
+  return (adc == NULL) ? NULL : adc->dma_buffer;
+}
+
+uint16_t adc_get_dma_length(adc_desc_t adc)
+{
+  return (adc == NULL) ? 0 : adc->buffer_len;
+}
+
+void adc_set_block_callback(adc_desc_t adc, adc_block_cb_t cb, void *arg)
+{
+  if(adc == NULL)
+  {
+    return;
+  }
+
+  adc->block_arg = arg;
+  adc->block_cb = cb;
+}
+
+int adc_awd_config(adc_desc_t adc, adc_awd_t awd, uint16_t low, uint16_t high,
+                   adc_awd_cb_t cb, void *arg)
+{
+  // 与HAL_ADC_AnalogWDGConfig相同：转换进行中不能修改
+  if(adc == NULL || awd >= ADC_AWD_NUM || low > high || adc->running)
+  {
+    return -1;
+  }
+
+  adc->awd_cb[awd] = cb;
+  adc->awd_arg[awd] = arg;
+  adc->awd_status &= (uint8_t)~(1U << awd);
+  adc->awd_low[awd] = low;
+  adc->awd_high[awd] = high;
+  adc->awd_configured[awd] = true;
+  adc->awd_flag[awd] = false;
+  adc->awd_it[awd] = true;
+
+  return 0;
+}
+
+void adc_awd_arm(adc_desc_t adc, adc_awd_t awd)
+{
+  if(adc == NULL || awd >= ADC_AWD_NUM)
+  {
+    return;
+  }
+
+  adc->awd_flag[awd] = false;
+  adc->awd_it[awd] = true;
+}
+
+void adc_awd_disarm(adc_desc_t adc, adc_awd_t awd)
+{
+  if(adc == NULL || awd >= ADC_AWD_NUM)
+  {
+    return;
+  }
+
+  adc->awd_it[awd] = false;
+}
+
+uint8_t adc_awd_get_status(adc_desc_t adc)
+{
+  return (adc == NULL) ? 0 : adc->awd_status;
+}
+
+void adc_awd_clear_status(adc_desc_t adc, uint8_t mask)
+{
+  if(adc == NULL)
+  {
+    return;
+  }
+
+  adc->awd_status &= (uint8_t)~mask;
+}
+
+/**
+ * @brief   一次转换结果经过模拟看门狗比较器
+ *
+ * @param[in,out]   adc     ADC描述符
+ * @param[in]       sample  转换结果
+ *
+ * @return  None
+ */
+static void adc_host_compare(adc_desc_t adc, uint16_t sample)
+{
+  for(uint32_t i = 0; i < ADC_AWD_NUM; i++)
+  {
+    if(!adc->awd_configured[i] || (sample >= adc->awd_low[i] && sample <= adc->awd_high[i]))
+    {
+      continue;
+    }
+
+    // 标志已置位时不会再次产生中断（与硬件相同，需软件清除）
+    if(adc->awd_flag[i])
+    {
+      continue;
+    }
+    adc->awd_flag[i] = true;
+
+    if(adc->awd_it[i])
+    {
+      adc->awd_irq_count++;
+      adc->awd_it[i] = false;
+      adc->awd_status |= (uint8_t)(1U << i);
+      if(adc->awd_cb[i] != NULL)
+      {
+        adc->awd_cb[i](adc, (adc_awd_t)i, adc->awd_arg[i]);
+      }
+    }
+  }
+}
+
+void adc_host_feed(adc_desc_t adc, const uint16_t *samples, uint32_t len)
+{
+  if(adc == NULL || samples == NULL || !adc->running)
+  {
+    return;
+  }
+
+  for(uint32_t i = 0; i < len; i++)
+  {
+    adc_host_compare(adc, samples[i]);
+
+    if(adc->dma_buffer == NULL || adc->buffer_len < 2)
+    {
+      continue;
+    }
+
+    adc->dma_buffer[adc->write_index++] = samples[i];
+
+    // 半传输/传输完成
+    if(adc->write_index == adc->buffer_len / 2 || adc->write_index == adc->buffer_len)
+    {
+      uint16_t half = adc->buffer_len / 2;
+      const uint16_t *block = adc->dma_buffer + (adc->write_index - half);
+
+      if(adc->write_index == adc->buffer_len)
+      {
+        adc->write_index = 0;
+      }
+      if(adc->block_cb != NULL)
+      {
+        adc->block_cb(adc, block, half, adc->block_arg);
+      }
+    }
+  }
+}
@@ -0,0 +1,51 @@
+/**
+ * @file    drv_adc_desc.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   ADC描述符定义（主机端模型）
+ *
+ * @details 主机端没有ADC，adc_host_feed()按转换顺序输入样本：每个样本先经模拟看门狗
+ *          比较器（与H7 AWD相同：样本 < LTR 或 > HTR 置位标志，中断使能时进入回调），
+ *          攒满半个缓冲区后调用数据块回调，与目标板的中断时序一致。
+ */
+
+#ifndef DRV_ADC_DESC_H
+#define DRV_ADC_DESC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "drv_adc.h"
+
+struct adc_desc
+{
+  uint16_t *dma_buffer;               // 模拟DMA缓冲区
+  uint16_t buffer_len;                // 缓冲区长度
+  uint16_t write_index;               // 模拟DMA写位置
+  bool running;                       // 已启动连续转换
+  adc_block_cb_t block_cb;            // 数据块回调
+  void *block_arg;                    // 数据块回调用户参数
+  bool awd_configured[ADC_AWD_NUM];   // 看门狗已配置
+  bool awd_it[ADC_AWD_NUM];           // 看门狗中断使能（AWDxIE）
+  bool awd_flag[ADC_AWD_NUM];         // 看门狗硬件标志（AWDx）
+  uint16_t awd_low[ADC_AWD_NUM];      // 下限（LTR）
+  uint16_t awd_high[ADC_AWD_NUM];     // 上限（HTR）
+  adc_awd_cb_t awd_cb[ADC_AWD_NUM];   // 告警回调
+  void *awd_arg[ADC_AWD_NUM];         // 告警回调用户参数
+  volatile uint8_t awd_status;        // 锁存状态，bit n对应AWD(n+1)
+  uint32_t awd_irq_count;             // 进入看门狗中断的次数
+};
+
+/**
+ * @brief   按转换顺序输入样本（主机端模型）
+ *
+ * @param[in]   adc      ADC描述符
+ * @param[in]   samples  样本
+ * @param[in]   len      样本数
+ *
+ * @return  None
+ *
+ * @note    未调用adc_start_dma()时忽略
+ */
+void adc_host_feed(adc_desc_t adc, const uint16_t *samples, uint32_t len);
+
+#endif /* DRV_ADC_DESC_H */
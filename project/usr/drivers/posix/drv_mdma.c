@@ -0,0 +1,297 @@
+/**
+ * @file    drv_mdma.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   MDMA异步内存复制/填充服务（POSIX主机端）
+ *
+ * @details 以一个工作线程模拟MDMA通道：作业按提交顺序排队，每次执行不超过64KB的一段，
+ *          整个作业结束后置状态并在工作线程中调用回调（对应目标板的MDMA中断上下文）。
+ *          长度阈值与首尾不满cache行部分由CPU完成的规则与目标板一致，
+ *          主机端没有cache，只是保持调用方看到的行为相同。目标板上等待的任务在完成中断
+ *          返回后才恢复运行，主机端mdma_wait()同样等到回调返回。测试控制见drv_mdma_host.h。
+ */
+
+#include "drv_mdma.h"
+#include "drv_mdma_host.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#define MDMA_HOST_LINE          32U
+#define MDMA_HOST_BLOCK_MAX     65536U
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_kick = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t s_done = PTHREAD_COND_INITIALIZER;
+static pthread_t s_worker;
+static bool s_started = false;
+static bool s_hold = false;
+static bool s_fail_next = false;
+static mdma_job_t *s_queue_head = NULL;
+static mdma_job_t *s_queue_tail = NULL;
+static mdma_job_t *s_finishing = NULL;
+
+/**
+ * @brief   结束作业：置状态、唤醒等待者并调用回调
+ *
+ * @param[in]   job    作业
+ * @param[in]   state  结束状态
+ *
+ * @return  None
+ */
+static void mdma_finish(mdma_job_t *job, mdma_job_state_t state)
+{
+  pthread_mutex_lock(&s_lock);
+  job->state = state;
+  s_finishing = job;
+  pthread_mutex_unlock(&s_lock);
+
+  // 回调中可以提交新作业，不能持锁调用
+  if(job->callback != NULL)
+  {
+    job->callback(job, job->arg);
+  }
+
+  pthread_mutex_lock(&s_lock);
+  s_finishing = NULL;
+  pthread_cond_broadcast(&s_done);
+  pthread_mutex_unlock(&s_lock);
+}
+
+/**
+ * @brief   模拟通道：取队首作业逐段执行
+ *
+ * @param[in]   arg  未使用
+ *
+ * @return  NULL
+ */
+static void *mdma_worker(void *arg)
+{
+  (void)arg;
+
+  for(;;)
+  {
+    mdma_job_t *job;
+    bool fail;
+
+    pthread_mutex_lock(&s_lock);
+    while(s_queue_head == NULL || s_hold)
+    {
+      pthread_cond_wait(&s_kick, &s_lock);
+    }
+    job = s_queue_head;
+    fail = s_fail_next;
+    s_fail_next = false;
+    pthread_mutex_unlock(&s_lock);
+
+    while(!fail && job->offset < job->len)
+    {
+      uint32_t block = job->len - job->offset;
+
+      if(block > MDMA_HOST_BLOCK_MAX)
+      {
+        block = MDMA_HOST_BLOCK_MAX;
+      }
+      if(job->src != NULL)
+      {
+        memcpy(job->dst + job->offset, job->src + job->offset, block);
+      }
+      else
+      {
+        memset(job->dst + job->offset, (uint8_t)job->pattern, block);
+      }
+      job->offset += block;
+    }
+
+    // 先出队再完成，回调中可以提交新作业
+    pthread_mutex_lock(&s_lock);
+    s_queue_head = job->next;
+    if(s_queue_head == NULL)
+    {
+      s_queue_tail = NULL;
+    }
+    pthread_mutex_unlock(&s_lock);
+
+    mdma_finish(job, fail ? MDMA_JOB_ERROR : MDMA_JOB_DONE);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   提交作业
+ *
+ * @details 短作业由CPU完成；否则目标首尾不满cache行的部分由CPU完成，其余整行部分入队
+ *
+ * @param[in,out]   job  已填写dst/src/len/pattern/callback/arg的作业
+ *
+ * @return  0
+ */
+static int mdma_submit(mdma_job_t *job)
+{
+  uint32_t head = (uint32_t)(-(uintptr_t)job->dst) & (MDMA_HOST_LINE - 1U);
+  uint32_t tail;
+
+  if(job->len < MDMA_CPU_THRESHOLD)
+  {
+    head = job->len;
+  }
+  tail = (job->len - head) & (MDMA_HOST_LINE - 1U);
+
+  if(job->src != NULL)
+  {
+    memcpy(job->dst, job->src, head);
+    memcpy(job->dst + job->len - tail, job->src + job->len - tail, tail);
+    job->src += head;
+  }
+  else
+  {
+    memset(job->dst, (uint8_t)job->pattern, head);
+    memset(job->dst + job->len - tail, (uint8_t)job->pattern, tail);
+  }
+  job->dst += head;
+  job->len -= head + tail;
+  job->offset = 0;
+  job->next = NULL;
+
+  if(job->len == 0)
+  {
+    job->state = MDMA_JOB_DONE;
+    if(job->callback != NULL)
+    {
+      job->callback(job, job->arg);
+    }
+    return 0;
+  }
+
+  pthread_mutex_lock(&s_lock);
+  job->state = MDMA_JOB_PENDING;
+  if(s_queue_tail != NULL)
+  {
+    s_queue_tail->next = job;
+  }
+  else
+  {
+    s_queue_head = job;
+  }
+  s_queue_tail = job;
+  pthread_cond_signal(&s_kick);
+  pthread_mutex_unlock(&s_lock);
+
+  return 0;
+}
+
+/**
+ * @brief   初始化MDMA服务（启动模拟通道线程，重复调用无副作用）
+ *
+ * @retval  0   成功
+ * @retval  -1  线程创建失败
+ */
+int mdma_init(void)
+{
+  int ret = 0;
+
+  pthread_mutex_lock(&s_lock);
+  if(!s_started)
+  {
+    if(pthread_create(&s_worker, NULL, mdma_worker, NULL) == 0)
+    {
+      pthread_detach(s_worker);
+      s_started = true;
+    }
+    else
+    {
+      ret = -1;
+    }
+  }
+  pthread_mutex_unlock(&s_lock);
+
+  return ret;
+}
+
+int mdma_memcpy(mdma_job_t *job, void *dst, const void *src, uint32_t len,
+                mdma_callback_t callback, void *arg)
+{
+  if(job == NULL || dst == NULL || src == NULL || job->state == MDMA_JOB_PENDING)
+  {
+    return -1;
+  }
+
+  job->dst = (uint8_t *)dst;
+  job->src = (const uint8_t *)src;
+  job->len = len;
+  job->pattern = 0;
+  job->callback = callback;
+  job->arg = arg;
+
+  return mdma_submit(job);
+}
+
+int mdma_memset(mdma_job_t *job, void *dst, uint8_t value, uint32_t len,
+                mdma_callback_t callback, void *arg)
+{
+  if(job == NULL || dst == NULL || job->state == MDMA_JOB_PENDING)
+  {
+    return -1;
+  }
+
+  job->dst = (uint8_t *)dst;
+  job->src = NULL;
+  job->len = len;
+  job->pattern = value * 0x01010101U;
+  job->callback = callback;
+  job->arg = arg;
+
+  return mdma_submit(job);
+}
+
+bool mdma_job_done(const mdma_job_t *job)
+{
+  return job != NULL && job->state != MDMA_JOB_PENDING;
+}
+
+int mdma_wait(const mdma_job_t *job, uint32_t timeout)
+{
+  struct timespec deadline;
+  int ret = 0;
+
+  if(job == NULL)
+  {
+    return -1;
+  }
+
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += timeout / 1000U;
+  deadline.tv_nsec += (long)(timeout % 1000U) * 1000000L;
+  if(deadline.tv_nsec >= 1000000000L)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  pthread_mutex_lock(&s_lock);
+  while((job->state == MDMA_JOB_PENDING || s_finishing == job) && ret == 0)
+  {
+    ret = pthread_cond_timedwait(&s_done, &s_lock, &deadline);
+  }
+  ret = (job->state == MDMA_JOB_DONE) ? 0 : -1;
+  pthread_mutex_unlock(&s_lock);
+
+  return ret;
+}
+
+void mdma_host_hold(bool hold)
+{
+  pthread_mutex_lock(&s_lock);
+  s_hold = hold;
+  pthread_cond_signal(&s_kick);
+  pthread_mutex_unlock(&s_lock);
+}
+
+void mdma_host_fail_next(void)
+{
+  pthread_mutex_lock(&s_lock);
+  s_fail_next = true;
+  pthread_mutex_unlock(&s_lock);
+}
@@ -0,0 +1,32 @@
+/**
+ * @file    drv_mdma_host.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   MDMA服务主机端实现的测试控制接口
+ *
+ * @details 主机端以工作线程模拟MDMA通道。测试可暂停通道使作业停留在队列中，
+ *          以检查排队顺序与等待超时；也可令下一个作业以传输错误结束。
+ */
+
+#ifndef DRV_MDMA_HOST_H
+#define DRV_MDMA_HOST_H
+
+#include <stdbool.h>
+
+/**
+ * @brief   暂停或恢复模拟通道
+ *
+ * @param[in]   hold  true暂停（已开始的分段仍会完成），false恢复
+ *
+ * @return  None
+ */
+void mdma_host_hold(bool hold);
+
+/**
+ * @brief   令下一个由通道执行的作业以MDMA_JOB_ERROR结束
+ *
+ * @return  None
+ */
+void mdma_host_fail_next(void);
+
+#endif /* DRV_MDMA_HOST_H */
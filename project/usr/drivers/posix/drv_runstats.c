@@ -0,0 +1,84 @@
+/**
+ * @file    drv_runstats.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   运行时统计后端（POSIX主机端）
+ *
+ * @details 周期计数取CLOCK_MONOTONIC纳秒数（频率1 GHz），32位约4.29秒回绕一次，
+ *          与目标板同样须在回绕前采样；临界区为进程内递归互斥锁，
+ *          多个线程同时调用RunStats_GetCycles64()时与目标板屏蔽中断等效。
+ *          主机线程无法像中断那样被屏蔽，模拟中断的RunStats_IrqExit()须与
+ *          RunStats_Sample()在同一线程调用。任务快照见drv_runstats_host.h。
+ */
+
+#include "runstats_port.h"
+#include "drv_runstats_host.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
+
+#define HOST_CYCLE_HZ           1000000000UL
+
+static pthread_mutex_t s_lock;
+static pthread_once_t s_lock_once = PTHREAD_ONCE_INIT;
+static const RunStats_PortTask_t *s_tasks = NULL;
+static uint32_t s_task_count = 0;
+
+static void runstats_host_lock_init(void)
+{
+  pthread_mutexattr_t attr;
+
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&s_lock, &attr);
+  pthread_mutexattr_destroy(&attr);
+}
+
+uint32_t RunStats_PortCycles(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint32_t)((uint64_t)ts.tv_sec * HOST_CYCLE_HZ + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t RunStats_PortCycleHz(void)
+{
+  return HOST_CYCLE_HZ;
+}
+
+uint32_t RunStats_PortEnterCritical(void)
+{
+  pthread_once(&s_lock_once, runstats_host_lock_init);
+  pthread_mutex_lock(&s_lock);
+
+  return 0;
+}
+
+void RunStats_PortExitCritical(uint32_t state)
+{
+  (void)state;
+  pthread_mutex_unlock(&s_lock);
+}
+
+uint32_t RunStats_PortGetTasks(RunStats_PortTask_t *tasks, uint32_t max)
+{
+  if(tasks == NULL || s_task_count > max)
+  {
+    return 0;
+  }
+
+  for(uint32_t i = 0; i < s_task_count; i++)
+  {
+    tasks[i] = s_tasks[i];
+  }
+
+  return s_task_count;
+}
+
+void runstats_host_set_tasks(const RunStats_PortTask_t *tasks, uint32_t count)
+{
+  s_tasks = tasks;
+  s_task_count = (tasks != NULL) ? count : 0;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file    drv_runstats_host.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   运行时统计主机端后端的模拟任务表
+ *
+ * @details 主机端没有RTOS，RunStats_PortGetTasks()返回由测试设置的任务表。
+ *          表由调用者持有，测试直接修改其中的run_time模拟任务运行，
+ *          下一次RunStats_Sample()即读到新值。
+ */
+
+#ifndef DRV_RUNSTATS_HOST_H
+#define DRV_RUNSTATS_HOST_H
+
+#include <stdint.h>
+#include "runstats_port.h"
+
+/**
+ * @brief   设置模拟任务表
+ *
+ * @param[in]   tasks  任务表（须在使用期间保持有效），NULL表示无任务
+ * @param[in]   count  任务数
+ *
+ * @return  None
+ */
+void runstats_host_set_tasks(const RunStats_PortTask_t *tasks, uint32_t count);
+
+#endif /* DRV_RUNSTATS_HOST_H */
@@ -12,6 +12,7 @@
 #include "drv_uart_desc.h"
 #include "drv_adc_desc.h"
 #include "stm32h7xx_hal_adc.h"
+#include "mem_region.h"
 
 /**
  * @brief LED1 GPIO描述符。
@@ -41,55 +42,61 @@ static struct gpio_desc s_relay1 = {
 gpio_desc_t relay1 = &s_relay1;
 
 /**
- * @brief UART1 DMA接收缓冲区（硬件DMA使用）
- * @note  32字节对齐确保cache一致性
- * @note  GCC使用section属性，Keil AC5使用__at关键字指定地址
+ * @brief UART2 DMA接收缓冲区（硬件DMA使用）
+ * @note  放入D2 SRAM（MPU非cache区域），DMA写入后CPU直接读取
  */
-#if defined(__GNUC__)
-__attribute__((aligned(32))) __attribute__((section(".ram_d1"))) uint8_t Uart1_dma_rx_buf[256] = {0};
-#elif defined(__CC_ARM)
-__align(32) uint8_t Uart1_dma_rx_buf[256] __attribute__((at(0x24000200)));
-#endif
+static uint8_t s_uart2_dma_rx_buf[256] MEM_D2;
 
 /**
- * @brief UART2 DMA接收缓冲区（硬件DMA使用）
- * @note  32字节对齐确保cache一致性
- * @note  GCC使用section属性，Keil AC5使用__at关键字指定地址
+ * @brief UART1 环形缓冲区存储空间（只有CPU访问，放入DTCM）
  */
-#if defined(__GNUC__)
-__attribute__((aligned(32))) __attribute__((section(".ram_d1"))) uint8_t Uart2_dma_rx_buf[256] = {0};
-#elif defined(__CC_ARM)
-__align(32) uint8_t Uart2_dma_rx_buf[256] __attribute__((at(0x24000100)));
-#endif
+uint8_t Uart1_ringbuf_storage[512] MEM_DTCM;
 
 /**
- * @brief UART1 环形缓冲区存储空间
+ * @brief UART2 环形缓冲区存储空间（只有CPU访问，放入DTCM）
  */
-uint8_t Uart1_ringbuf_storage[512] = {0};
+uint8_t Uart2_ringbuf_storage[512] MEM_DTCM;
 
 /**
- * @brief UART2 环形缓冲区存储空间
+ * @brief ADC DMA缓冲区长度（采样点数）
+ * @note  半传输/传输完成各交付一半（BOARD_ADC_BLOCK_LEN点）
  */
-uint8_t Uart2_ringbuf_storage[512] = {0};
+#define ADC_DMA_BUFFER_LEN  (2 * BOARD_ADC_BLOCK_LEN)
 
 /**
  * @brief ADC1 DMA缓冲区
- * @note  32字节对齐确保cache一致性
+ * @note  放入D2 SRAM（MPU非cache区域），块回调中无需失效cache
  */
-__attribute__((aligned(32))) __attribute__((section(".ram_d1"))) uint16_t s_adc1_buffer[64] = {0};
+uint16_t s_adc1_buffer[ADC_DMA_BUFFER_LEN] MEM_D2;
 
 /**
  * @brief ADC2 DMA缓冲区
- * @note  32字节对齐确保cache一致性
+ * @note  放入D2 SRAM（MPU非cache区域），块回调中无需失效cache
  */
-__attribute__((aligned(32))) __attribute__((section(".ram_d1"))) uint16_t s_adc2_buffer[64] = {0};
+uint16_t s_adc2_buffer[ADC_DMA_BUFFER_LEN] MEM_D2;
 
 /**
- * @brief 调试串口描述符。串口2-RS485
+ * @brief 调试串口描述符。串口2-RS485，PA2(TX) PA3(RX)
+ * @note  收发器方向由外部自动换向电路控制。PA1（USART2_DE，AF7）接DE的硬件上可设
+ *        .rs485 = UART_RS485_HW、.de_port = GPIOA、.de_pin = GPIO_PIN_1、
+ *        .de_assert = .de_deassert = 16（各1位时间，115200下约8.7us）
  */
 static struct uart_desc s_uart2_rs485 = {
   .instance = USART2,
-  .baudrate = 115200
+  .baudrate = 115200,
+  .tx_port = GPIOA,
+  .tx_pin = GPIO_PIN_2,
+  .rx_port = GPIOA,
+  .rx_pin = GPIO_PIN_3,
+  .af = GPIO_AF7_USART2,
+  .irqn = USART2_IRQn,
+  .irq_priority = 5,
+  .stat = BOARD_IRQ_USART2,
+  .dma_rx = BOARD_DMA_USART2_RX,
+  .dma_tx = BOARD_DMA_USART2_TX,
+  .dma_rx_buf = s_uart2_dma_rx_buf,
+  .dma_rx_len = sizeof(s_uart2_dma_rx_buf),
+  .rs485 = UART_RS485_NONE
 };
 
 // 调试串口句柄。
@@ -97,11 +104,28 @@ uart_desc_t uart2_rs485 = &s_uart2_rs485;
 
 
 /**
- * @brief 通信串口描述符。串口1-RS232
+ * @brief 通信串口描述符。串口1-RS232，PA9(TX) PA10(RX)
+ * @note  9600波特率短报文，不占DMA流：接收FIFO满12字节或总线空闲时成批读取，
+ *        中断发送每次填满16字节FIFO。主机端模型test_uart_irq：8字节Modbus请求帧
+ *        每KB接收中断逐字节1152次、FIFO 128次、DMA 128次，FIFO与DMA相同；
+ *        中断响应容限由1个字符（约1ms）放宽到5个字符
  */
 static struct uart_desc s_uart1_rs232 = {
   .instance = USART1,
-  .baudrate = 9600
+  .baudrate = 9600,
+  .tx_port = GPIOA,
+  .tx_pin = GPIO_PIN_9,
+  .rx_port = GPIOA,
+  .rx_pin = GPIO_PIN_10,
+  .af = GPIO_AF7_USART1,
+  .irqn = USART1_IRQn,
+  .irq_priority = 5,
+  .stat = BOARD_IRQ_USART1,
+  .dma_rx = UART_DESC_NONE,
+  .dma_tx = UART_DESC_NONE,
+  .fifo = true,
+  .rx_fifo_threshold = UART_RXFIFO_THRESHOLD_3_4,
+  .tx_fifo_threshold = UART_TXFIFO_THRESHOLD_8_8
 };
 
 // 调试串口句柄。
@@ -110,13 +134,13 @@ uart_desc_t uart1_rs232 = &s_uart1_rs232;
 
 
 /**
- * @brief ADC1描述符,ADC1 - PB1 ADC_CHANNEL_5 - DMA1_Stream2 - 采集下板数据
+ * @brief ADC1描述符,ADC1 - PB1 ADC_CHANNEL_5 - BOARD_DMA_ADC1 - 采集下板数据
  */
 static struct adc_desc s_adc1 = {
   .instance = ADC1,
   .channel = ADC_CHANNEL_5,
   .dma_buffer = s_adc1_buffer,
-  .buffer_len = 64
+  .buffer_len = ADC_DMA_BUFFER_LEN
   // hal_handle 和 dma_handle 没写 → 自动初始化为0
 };
 // ADC描述符句柄。
@@ -125,15 +149,45 @@ adc_desc_t adc1 = &s_adc1;
 
 
 /**
- * @brief ADC2描述符。ADC2 - PA6 ADC_CHANNEL_3 - DMA1_Stream1 - 采集星电电压
+ * @brief ADC2描述符。ADC2 - PA6 ADC_CHANNEL_3 - BOARD_DMA_ADC2 - 采集星电电压
  */
  static struct adc_desc s_adc2 = {
   .instance = ADC2,
   .channel = ADC_CHANNEL_3,
   .dma_buffer = s_adc2_buffer,
-  .buffer_len = 64
+  .buffer_len = ADC_DMA_BUFFER_LEN
   // hal_handle 和 dma_handle 没写 → 自动初始化为0
 };
 // ADC描述符句柄。
 adc_desc_t adc2 = &s_adc2;
 
+
+/**
+ * @brief 运行时统计中断名。
+ */
+const char *const board_irq_names[BOARD_IRQ_NUM] = {
+  [BOARD_IRQ_SYSTICK] = "SysTick",
+  [BOARD_IRQ_TIM4] = "TIM4",
+  [BOARD_IRQ_USART1] = "USART1",
+  [BOARD_IRQ_USART2] = "USART2",
+  [BOARD_IRQ_ADC1_DMA] = "DMA(ADC1)",
+  [BOARD_IRQ_ADC2_DMA] = "DMA(ADC2)",
+  [BOARD_IRQ_ADC] = "ADC",
+  [BOARD_IRQ_MDMA] = "MDMA",
+};
+
+/**
+ * @brief DMA请求表。
+ * @note  ADC为高优先级，先分配到编号小的流；UART的DMA中断计入对应串口的统计。
+ *        所有请求均可使用DMA1/DMA2，BDMA只服务D3外设。
+ */
+const dma_request_t board_dma_requests[BOARD_DMA_NUM] = {
+  [BOARD_DMA_USART2_RX] = {"USART2_RX", DMA_REQUEST_USART2_RX, DMAALLOC_CTRL_DMA1 | DMAALLOC_CTRL_DMA2,
+                           DMAALLOC_ANY, DMA_PRIO_LOW, 5, BOARD_IRQ_USART2},
+  [BOARD_DMA_USART2_TX] = {"USART2_TX", DMA_REQUEST_USART2_TX, DMAALLOC_CTRL_DMA1 | DMAALLOC_CTRL_DMA2,
+                           DMAALLOC_ANY, DMA_PRIO_LOW, 5, BOARD_IRQ_USART2},
+  [BOARD_DMA_ADC1] = {"ADC1", DMA_REQUEST_ADC1, DMAALLOC_CTRL_DMA1 | DMAALLOC_CTRL_DMA2,
+                      DMAALLOC_ANY, DMA_PRIO_HIGH, 5, BOARD_IRQ_ADC1_DMA},
+  [BOARD_DMA_ADC2] = {"ADC2", DMA_REQUEST_ADC2, DMAALLOC_CTRL_DMA1 | DMAALLOC_CTRL_DMA2,
+                      DMAALLOC_ANY, DMA_PRIO_HIGH, 5, BOARD_IRQ_ADC2_DMA},
+};
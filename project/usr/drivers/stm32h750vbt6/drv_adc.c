@@ -13,17 +13,28 @@
  *          - 采样时间：387.5个时钟周期
  *          - 采样率：约126 kSPS
  *          - DMA模式：循环模式
+ *          - 数据块：DMA半传输/传输完成中断回调，每次交付缓冲区的一半
+ *          - 模拟看门狗：AWD1-3硬件窗口比较，越限时中断回调，无需逐点软件判断
  *          
  *          硬件配置：
- *          - ADC1: PB1 → ADC_CHANNEL_5 → DMA1_Stream2
- *          - ADC2: PA6 → ADC_CHANNEL_3 → DMA1_Stream1
+ *          - ADC1: PB1 → ADC_CHANNEL_5 → BOARD_DMA_ADC1
+ *          - ADC2: PA6 → ADC_CHANNEL_3 → BOARD_DMA_ADC2
+ *          - DMA流由drv_dma分配，流中断由drv_dma分发到dma_handle
  *          
- * @note    DMA缓冲区必须位于AXI SRAM (0x2400_0000 - 0x24FF_FFFF)
+ * @note    DMA缓冲区须位于DMA1/DMA2可访问的AXI/D2 SRAM（DTCM不可访问），
+ *          位于AXI（写回cache）时CPU读取前须调用DRV_System_CacheInvalidate()
+ * @note    ADC_IRQn只服务模拟看门狗，优先级5（可调用RTOS中断API）；
+ *          DMA模式下的溢出中断被关闭，溢出按覆盖模式处理，不进入HAL_ADC_ErrorCallback
  * @warning 修改采样时间会影响采样率和信号稳定性
  */
 
 #include "drv_adc.h"
 #include "drv_adc_desc.h"
+#include "drv_dma_desc.h"
+#include "board.h"
+#include "mem_region.h"
+#include "runstats.h"
+#include <stddef.h>
 
 
 /**
@@ -99,9 +110,9 @@ void adc_init(adc_desc_t adc)
  * @details 配置ADC的GPIO、时钟和DMA资源。此函数由HAL库自动调用。
  *          
  *          配置内容：
- *          - 使能ADC12、GPIO和DMA1时钟
+ *          - 使能ADC12和GPIO时钟
  *          - 配置GPIO为模拟输入模式
- *          - 配置DMA为循环模式，高优先级
+ *          - 配置DMA为循环模式，流与优先级由请求表分配
  *          - 数据对齐方式：半字(16位)
  *
  * @param[in]   hadc  ADC句柄指针
@@ -120,9 +131,8 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc)
     return;
   }
 
-  // 使能ADC12时钟和DMA1时钟
+  // 使能ADC12时钟（DMA时钟由dma_attach使能）
   __HAL_RCC_ADC12_CLK_ENABLE();
-  __HAL_RCC_DMA1_CLK_ENABLE();
 
   // 根据ADC实例配置对应的GPIO和DMA
   if(hadc->Instance == ADC1)
@@ -136,19 +146,17 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc)
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
-    // 配置ADC1 DMA参数 (DMA1_Stream2)
-    hadc->DMA_Handle->Instance = DMA1_Stream2;
-    hadc->DMA_Handle->Init.Request = DMA_REQUEST_ADC1;
+    // 配置ADC1 DMA参数，流由请求表分配
     hadc->DMA_Handle->Init.Direction = DMA_PERIPH_TO_MEMORY;
     hadc->DMA_Handle->Init.PeriphInc = DMA_PINC_DISABLE;
     hadc->DMA_Handle->Init.MemInc = DMA_MINC_ENABLE;
     hadc->DMA_Handle->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
     hadc->DMA_Handle->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
     hadc->DMA_Handle->Init.Mode = DMA_CIRCULAR;
-    hadc->DMA_Handle->Init.Priority = DMA_PRIORITY_HIGH;
     hadc->DMA_Handle->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
 
-    if(HAL_DMA_Init(hadc->DMA_Handle) == HAL_OK)
+    // 初始化并使能流中断（半传输/传输完成用于数据块回调）
+    if(dma_attach(BOARD_DMA_ADC1, hadc->DMA_Handle) == 0)
     {
       __HAL_LINKDMA(hadc, DMA_Handle, *hadc->DMA_Handle);
     }
@@ -164,19 +172,17 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc)
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
-    // 配置ADC2 DMA参数 (DMA1_Stream1)
-    hadc->DMA_Handle->Instance = DMA1_Stream1;
-    hadc->DMA_Handle->Init.Request = DMA_REQUEST_ADC2;
+    // 配置ADC2 DMA参数，流由请求表分配
     hadc->DMA_Handle->Init.Direction = DMA_PERIPH_TO_MEMORY;
     hadc->DMA_Handle->Init.PeriphInc = DMA_PINC_DISABLE;
     hadc->DMA_Handle->Init.MemInc = DMA_MINC_ENABLE;
     hadc->DMA_Handle->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
     hadc->DMA_Handle->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
     hadc->DMA_Handle->Init.Mode = DMA_CIRCULAR;
-    hadc->DMA_Handle->Init.Priority = DMA_PRIORITY_HIGH;
     hadc->DMA_Handle->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
 
-    if(HAL_DMA_Init(hadc->DMA_Handle) == HAL_OK)
+    // 初始化并使能流中断（半传输/传输完成用于数据块回调）
+    if(dma_attach(BOARD_DMA_ADC2, hadc->DMA_Handle) == 0)
     {
       __HAL_LINKDMA(hadc, DMA_Handle, *hadc->DMA_Handle);
     }
@@ -234,6 +240,11 @@ void adc_start_dma(adc_desc_t adc)
   }
 
   HAL_ADC_Start_DMA(&adc->hal_handle, (uint32_t *)adc->dma_buffer, adc->buffer_len);
+
+  // HAL在DMA模式下同时打开溢出中断。溢出模式为覆盖（OVRMOD=1），溢出只丢失被覆盖的
+  // 样本，转换与DMA请求继续；ADC_IRQn只为模拟看门狗使能，关闭溢出中断，
+  // 避免DMA受阻时每次转换（126 kHz）都进入HAL_ADC_IRQHandler → HAL_ADC_ErrorCallback
+  __HAL_ADC_DISABLE_IT(&adc->hal_handle, ADC_IT_OVR);
 }
 
 /**
@@ -334,3 +345,297 @@ uint16_t adc_get_dma_length(adc_desc_t adc)
   return adc->buffer_len;
 }
 
+/**
+ * @brief   设置数据块回调
+ *
+ * @details 回调在DMA半传输/传输完成中断中被调用，依次交付DMA缓冲区的
+ *          前半部分和后半部分。回调必须快速返回，重计算应转交任务处理。
+ *
+ * @param[in]   adc  ADC描述符指针
+ * @param[in]   cb   回调函数，NULL表示取消
+ * @param[in]   arg  回调用户参数
+ *
+ * @return  None
+ *
+ * @note    数据块在下一个半周期（buffer_len/2个采样时间）内有效
+ */
+void adc_set_block_callback(adc_desc_t adc, adc_block_cb_t cb, void *arg)
+{
+  if(adc == NULL)
+  {
+    return;
+  }
+
+  // 先清回调再写参数，避免中断中看到新旧混合的组合
+  adc->block_cb = NULL;
+  adc->block_arg = arg;
+  adc->block_cb = cb;
+}
+
+/**
+ * @brief   由HAL句柄反查ADC描述符
+ *
+ * @param[in]   hadc  ADC句柄指针（描述符内嵌成员）
+ *
+ * @return  ADC描述符指针
+ */
+static adc_desc_t adc_from_handle(ADC_HandleTypeDef *hadc)
+{
+  return (adc_desc_t)((uint8_t *)hadc - offsetof(struct adc_desc, hal_handle));
+}
+
+/**
+ * @brief   DMA半传输完成回调（前半缓冲区可用）
+ *
+ * @param[in]   hadc  ADC句柄指针
+ *
+ * @return  None
+ */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  adc_desc_t adc = adc_from_handle(hadc);
+
+  if(adc->block_cb != NULL)
+  {
+    adc->block_cb(adc, adc->dma_buffer, adc->buffer_len / 2, adc->block_arg);
+  }
+}
+
+/**
+ * @brief   DMA传输完成回调（后半缓冲区可用）
+ *
+ * @param[in]   hadc  ADC句柄指针
+ *
+ * @return  None
+ */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  adc_desc_t adc = adc_from_handle(hadc);
+  uint16_t half = adc->buffer_len / 2;
+
+  if(adc->block_cb != NULL)
+  {
+    adc->block_cb(adc, adc->dma_buffer + half, half, adc->block_arg);
+  }
+}
+
+/**
+ * @brief 看门狗编号到HAL编号/中断/标志的映射
+ */
+static const uint32_t s_awd_number[ADC_AWD_NUM] =
+{
+  ADC_ANALOGWATCHDOG_1, ADC_ANALOGWATCHDOG_2, ADC_ANALOGWATCHDOG_3
+};
+static const uint32_t s_awd_it[ADC_AWD_NUM] = {ADC_IT_AWD1, ADC_IT_AWD2, ADC_IT_AWD3};
+static const uint32_t s_awd_flag[ADC_AWD_NUM] = {ADC_FLAG_AWD1, ADC_FLAG_AWD2, ADC_FLAG_AWD3};
+
+/**
+ * @brief   配置模拟看门狗
+ *
+ * @details 监视该ADC的规则通道，采样值 < low 或 > high 时触发中断并调用cb。
+ *          中断为单次触发：回调后自动关闭，避免越限期间每个采样都进中断
+ *          （126 kSPS），处理完成后由任务调用adc_awd_arm()重新使能。
+ *
+ * @param[in]   adc   ADC描述符指针
+ * @param[in]   awd   看门狗编号
+ * @param[in]   low   下限（码值）
+ * @param[in]   high  上限（码值）
+ * @param[in]   cb    告警回调，可为NULL（仅锁存状态）
+ * @param[in]   arg   回调用户参数
+ *
+ * @retval  0   成功
+ * @retval  -1  参数错误或ADC正在转换
+ *
+ * @note    必须在adc_init()之后、adc_start_dma()之前调用（HAL要求转换停止时配置）
+ */
+int adc_awd_config(adc_desc_t adc, adc_awd_t awd, uint16_t low, uint16_t high,
+                   adc_awd_cb_t cb, void *arg)
+{
+  ADC_AnalogWDGConfTypeDef awd_config = {0};
+
+  if(adc == NULL || awd >= ADC_AWD_NUM || low > high)
+  {
+    return -1;
+  }
+
+  adc->awd_cb[awd] = cb;
+  adc->awd_arg[awd] = arg;
+  adc->awd_status &= (uint8_t)~(1U << awd);
+
+  awd_config.WatchdogNumber = s_awd_number[awd];
+  awd_config.WatchdogMode = ADC_ANALOGWATCHDOG_SINGLE_REG;           // 监视单个规则通道
+  awd_config.Channel = adc->channel;
+  awd_config.ITMode = ENABLE;
+  awd_config.HighThreshold = high;
+  awd_config.LowThreshold = low;
+  if(HAL_ADC_AnalogWDGConfig(&adc->hal_handle, &awd_config) != HAL_OK)
+  {
+    return -1;
+  }
+
+  // ADC1/ADC2共用ADC_IRQn。告警回调经osThreadFlagsSet通知任务，RunStats_IrqExit与
+  // RunStats_Sample的BASEPRI临界区互斥，优先级不能高于configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY（5）；
+  // 与DMA数据块中断同级，告警延迟不超过一次块回调的执行时间（微秒级）
+  HAL_NVIC_SetPriority(ADC_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(ADC_IRQn);
+
+  return 0;
+}
+
+/**
+ * @brief   重新使能模拟看门狗中断
+ *
+ * @details 清除硬件标志后打开中断，可在转换进行中调用
+ *
+ * @param[in]   adc  ADC描述符指针
+ * @param[in]   awd  看门狗编号
+ *
+ * @return  None
+ */
+void adc_awd_arm(adc_desc_t adc, adc_awd_t awd)
+{
+  if(adc == NULL || awd >= ADC_AWD_NUM)
+  {
+    return;
+  }
+
+  __HAL_ADC_CLEAR_FLAG(&adc->hal_handle, s_awd_flag[awd]);
+  __HAL_ADC_ENABLE_IT(&adc->hal_handle, s_awd_it[awd]);
+}
+
+/**
+ * @brief   关闭模拟看门狗中断
+ *
+ * @param[in]   adc  ADC描述符指针
+ * @param[in]   awd  看门狗编号
+ *
+ * @return  None
+ */
+void adc_awd_disarm(adc_desc_t adc, adc_awd_t awd)
+{
+  if(adc == NULL || awd >= ADC_AWD_NUM)
+  {
+    return;
+  }
+
+  __HAL_ADC_DISABLE_IT(&adc->hal_handle, s_awd_it[awd]);
+}
+
+/**
+ * @brief   获取模拟看门狗锁存状态
+ *
+ * @param[in]   adc  ADC描述符指针
+ *
+ * @return  uint8_t 状态位图，bit n为1表示AWD(n+1)曾触发
+ * @retval  0  adc参数为NULL或无告警
+ */
+uint8_t adc_awd_get_status(adc_desc_t adc)
+{
+  if(adc == NULL)
+  {
+    return 0;
+  }
+
+  return adc->awd_status;
+}
+
+/**
+ * @brief   清除模拟看门狗锁存状态
+ *
+ * @param[in]   adc   ADC描述符指针
+ * @param[in]   mask  待清除的状态位
+ *
+ * @return  None
+ */
+void adc_awd_clear_status(adc_desc_t adc, uint8_t mask)
+{
+  if(adc == NULL)
+  {
+    return;
+  }
+
+  __disable_irq();
+  adc->awd_status &= (uint8_t)~mask;
+  __enable_irq();
+}
+
+/**
+ * @brief   模拟看门狗事件处理（中断上下文）
+ *
+ * @param[in]   hadc  ADC句柄指针
+ * @param[in]   awd   看门狗编号
+ *
+ * @return  None
+ */
+static void adc_awd_event(ADC_HandleTypeDef *hadc, adc_awd_t awd)
+{
+  adc_desc_t adc = adc_from_handle(hadc);
+
+  // 单次触发：关闭中断，由任务重新使能
+  __HAL_ADC_DISABLE_IT(hadc, s_awd_it[awd]);
+  adc->awd_status |= (uint8_t)(1U << awd);
+
+  if(adc->awd_cb[awd] != NULL)
+  {
+    adc->awd_cb[awd](adc, awd, adc->awd_arg[awd]);
+  }
+}
+
+/**
+ * @brief   模拟看门狗1越限回调
+ *
+ * @param[in]   hadc  ADC句柄指针
+ *
+ * @return  None
+ */
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef *hadc)
+{
+  adc_awd_event(hadc, ADC_AWD_1);
+}
+
+/**
+ * @brief   模拟看门狗2越限回调
+ *
+ * @param[in]   hadc  ADC句柄指针
+ *
+ * @return  None
+ */
+void HAL_ADCEx_LevelOutOfWindow2Callback(ADC_HandleTypeDef *hadc)
+{
+  adc_awd_event(hadc, ADC_AWD_2);
+}
+
+/**
+ * @brief   模拟看门狗3越限回调
+ *
+ * @param[in]   hadc  ADC句柄指针
+ *
+ * @return  None
+ */
+void HAL_ADCEx_LevelOutOfWindow3Callback(ADC_HandleTypeDef *hadc)
+{
+  adc_awd_event(hadc, ADC_AWD_3);
+}
+
+/**
+ * @brief   ADC1/ADC2全局中断服务函数
+ *
+ * @param   None
+ * @return  None
+ */
+MEM_ITCM_CODE void ADC_IRQHandler(void)
+{
+  uint32_t stamp = RunStats_IrqEnter();
+
+  // 未初始化的ADC句柄Instance为NULL，跳过
+  if(adc1->hal_handle.Instance != NULL)
+  {
+    HAL_ADC_IRQHandler(&adc1->hal_handle);
+  }
+  if(adc2->hal_handle.Instance != NULL)
+  {
+    HAL_ADC_IRQHandler(&adc2->hal_handle);
+  }
+
+  RunStats_IrqExit(BOARD_IRQ_ADC, stamp);
+}
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "stm32h7xx_hal.h"
+#include "drv_adc.h"
 
 struct adc_desc
 {
@@ -12,8 +13,11 @@ struct adc_desc
   uint16_t buffer_len;
   ADC_HandleTypeDef hal_handle;
   DMA_HandleTypeDef dma_handle;
+  adc_block_cb_t block_cb;     // 数据块回调（中断上下文）
+  void *block_arg;             // 数据块回调用户参数
+  adc_awd_cb_t awd_cb[ADC_AWD_NUM];   // 模拟看门狗告警回调（中断上下文）
+  void *awd_arg[ADC_AWD_NUM];         // 模拟看门狗回调用户参数
+  volatile uint8_t awd_status;        // 模拟看门狗锁存状态，bit n对应AWD(n+1)
 };
 
-typedef struct adc_desc *adc_desc_t;
-
 #endif /* DRV_ADC_DESC_H */
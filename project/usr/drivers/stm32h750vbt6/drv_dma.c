@@ -0,0 +1,252 @@
+/**
+ * @file    drv_dma.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   DMA流资源管理实现
+ *
+ * @details dma_init()调用DmaAlloc_Assign()得到各请求的全局流编号；
+ *          dma_attach()把流实例与DMAMUX请求写入HAL句柄并初始化
+ *          （HAL_DMA_Init同时配置DMAMUX1/DMAMUX2通道），登记句柄后使能流中断。
+ *
+ *          24个流中断入口统一定义于此，经dma_dispatch()查表调用
+ *          HAL_DMA_IRQHandler()，外设驱动不再各自定义DMA中断函数。
+ *
+ * @note    BDMA只能访问SRAM4（D3）且只服务D3外设，请求表中BDMA请求须使用
+ *          BDMA_REQUEST_xxx编号，缓冲区放在MEM_D3
+ */
+
+#include "drv_dma.h"
+#include "drv_dma_desc.h"
+#include "runstats.h"
+#include "mem_region.h"
+#include <stddef.h>
+
+/**
+ * @brief 全局流编号到实例、中断号与名称的映射
+ */
+static const struct
+{
+  void *instance;
+  IRQn_Type irqn;
+  const char *name;
+} s_streams[DMAALLOC_STREAM_NUM] =
+{
+  {DMA1_Stream0, DMA1_Stream0_IRQn, "DMA1_S0"},
+  {DMA1_Stream1, DMA1_Stream1_IRQn, "DMA1_S1"},
+  {DMA1_Stream2, DMA1_Stream2_IRQn, "DMA1_S2"},
+  {DMA1_Stream3, DMA1_Stream3_IRQn, "DMA1_S3"},
+  {DMA1_Stream4, DMA1_Stream4_IRQn, "DMA1_S4"},
+  {DMA1_Stream5, DMA1_Stream5_IRQn, "DMA1_S5"},
+  {DMA1_Stream6, DMA1_Stream6_IRQn, "DMA1_S6"},
+  {DMA1_Stream7, DMA1_Stream7_IRQn, "DMA1_S7"},
+  {DMA2_Stream0, DMA2_Stream0_IRQn, "DMA2_S0"},
+  {DMA2_Stream1, DMA2_Stream1_IRQn, "DMA2_S1"},
+  {DMA2_Stream2, DMA2_Stream2_IRQn, "DMA2_S2"},
+  {DMA2_Stream3, DMA2_Stream3_IRQn, "DMA2_S3"},
+  {DMA2_Stream4, DMA2_Stream4_IRQn, "DMA2_S4"},
+  {DMA2_Stream5, DMA2_Stream5_IRQn, "DMA2_S5"},
+  {DMA2_Stream6, DMA2_Stream6_IRQn, "DMA2_S6"},
+  {DMA2_Stream7, DMA2_Stream7_IRQn, "DMA2_S7"},
+  {BDMA_Channel0, BDMA_Channel0_IRQn, "BDMA_C0"},
+  {BDMA_Channel1, BDMA_Channel1_IRQn, "BDMA_C1"},
+  {BDMA_Channel2, BDMA_Channel2_IRQn, "BDMA_C2"},
+  {BDMA_Channel3, BDMA_Channel3_IRQn, "BDMA_C3"},
+  {BDMA_Channel4, BDMA_Channel4_IRQn, "BDMA_C4"},
+  {BDMA_Channel5, BDMA_Channel5_IRQn, "BDMA_C5"},
+  {BDMA_Channel6, BDMA_Channel6_IRQn, "BDMA_C6"},
+  {BDMA_Channel7, BDMA_Channel7_IRQn, "BDMA_C7"},
+};
+
+/**
+ * @brief DMA_PRIO_xxx到HAL优先级的映射
+ */
+static const uint32_t s_priority[] =
+{
+  DMA_PRIORITY_LOW, DMA_PRIORITY_MEDIUM, DMA_PRIORITY_HIGH, DMA_PRIORITY_VERY_HIGH
+};
+
+static const dma_request_t *s_requests;             /**< 请求表 */
+static uint32_t s_request_count;                    /**< 请求数 */
+static int8_t s_assign[DMAALLOC_STREAM_NUM];        /**< 请求编号→全局流编号 */
+static DMA_HandleTypeDef *s_handles[DMAALLOC_STREAM_NUM];   /**< 全局流编号→HAL句柄 */
+static int8_t s_stat[DMAALLOC_STREAM_NUM];          /**< 全局流编号→运行时统计编号 */
+
+/**
+ * @brief   按请求表分配DMA流
+ *
+ * @param[in]   reqs   请求表
+ * @param[in]   count  请求数
+ *
+ * @retval  0   成功
+ * @retval  -1  参数错误或存在无法分配的请求
+ */
+int dma_init(const dma_request_t *reqs, uint32_t count)
+{
+  DmaAlloc_Request_t alloc[DMAALLOC_STREAM_NUM];
+
+  if(reqs == NULL || count > DMAALLOC_STREAM_NUM)
+  {
+    return -1;
+  }
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+    alloc[i].controllers = reqs[i].controllers;
+    alloc[i].stream = reqs[i].stream;
+    alloc[i].priority = reqs[i].priority;
+  }
+
+  for(uint32_t s = 0; s < DMAALLOC_STREAM_NUM; s++)
+  {
+    s_handles[s] = NULL;
+    s_stat[s] = -1;
+  }
+
+  s_requests = reqs;
+  s_request_count = count;
+
+  return DmaAlloc_Assign(alloc, count, s_assign);
+}
+
+/**
+ * @brief   获取请求分配到的全局流编号
+ *
+ * @param[in]   id  请求编号
+ *
+ * @return  全局流编号，未分配返回-1
+ */
+int dma_get_stream(uint32_t id)
+{
+  if(id >= s_request_count)
+  {
+    return -1;
+  }
+
+  return s_assign[id];
+}
+
+/**
+ * @brief   获取全局流名称
+ *
+ * @param[in]   stream  全局流编号
+ *
+ * @return  名称，编号无效返回"-"
+ */
+const char *dma_stream_name(int stream)
+{
+  if(stream < 0 || stream >= (int)DMAALLOC_STREAM_NUM)
+  {
+    return "-";
+  }
+
+  return s_streams[stream].name;
+}
+
+/**
+ * @brief   将请求分配到的流绑定到HAL句柄并初始化
+ *
+ * @param[in]       id    请求编号
+ * @param[in,out]   hdma  DMA句柄
+ *
+ * @retval  0   成功
+ * @retval  -1  请求未分配、流已绑定其他句柄或HAL初始化失败
+ */
+int dma_attach(uint32_t id, DMA_HandleTypeDef *hdma)
+{
+  const dma_request_t *req;
+  int stream = dma_get_stream(id);
+
+  if(hdma == NULL || stream < 0 || (s_handles[stream] != NULL && s_handles[stream] != hdma))
+  {
+    return -1;
+  }
+
+  req = &s_requests[id];
+
+  switch(DMAALLOC_CTRL_OF(stream))
+  {
+    case DMAALLOC_CTRL_DMA1:
+      __HAL_RCC_DMA1_CLK_ENABLE();
+      break;
+    case DMAALLOC_CTRL_DMA2:
+      __HAL_RCC_DMA2_CLK_ENABLE();
+      break;
+    default:
+      __HAL_RCC_BDMA_CLK_ENABLE();
+      break;
+  }
+
+  hdma->Instance = s_streams[stream].instance;
+  hdma->Init.Request = req->request;
+  hdma->Init.Priority = s_priority[req->priority & 3U];
+
+  if(HAL_DMA_Init(hdma) != HAL_OK)
+  {
+    return -1;
+  }
+
+  s_stat[stream] = req->stat;
+  s_handles[stream] = hdma;
+
+  HAL_NVIC_SetPriority(s_streams[stream].irqn, req->irq_priority, 0);
+  HAL_NVIC_EnableIRQ(s_streams[stream].irqn);
+
+  return 0;
+}
+
+/**
+ * @brief   流中断分发
+ *
+ * @param[in]   stream  全局流编号
+ *
+ * @return  None
+ */
+static MEM_ITCM_CODE void dma_dispatch(uint32_t stream)
+{
+  DMA_HandleTypeDef *hdma = s_handles[stream];
+  uint32_t stamp = RunStats_IrqEnter();
+
+  if(hdma != NULL)
+  {
+    HAL_DMA_IRQHandler(hdma);
+  }
+
+  if(s_stat[stream] >= 0)
+  {
+    RunStats_IrqExit((uint8_t)s_stat[stream], stamp);
+  }
+}
+
+/**
+ * @brief 定义流中断服务函数，按全局流编号分发
+ */
+#define DMA_STREAM_IRQ_HANDLER(handler, stream) \
+  MEM_ITCM_CODE void handler(void)              \
+  {                                             \
+    dma_dispatch(stream);                       \
+  }
+
+DMA_STREAM_IRQ_HANDLER(DMA1_Stream0_IRQHandler, 0)
+DMA_STREAM_IRQ_HANDLER(DMA1_Stream1_IRQHandler, 1)
+DMA_STREAM_IRQ_HANDLER(DMA1_Stream2_IRQHandler, 2)
+DMA_STREAM_IRQ_HANDLER(DMA1_Stream3_IRQHandler, 3)
+DMA_STREAM_IRQ_HANDLER(DMA1_Stream4_IRQHandler, 4)
+DMA_STREAM_IRQ_HANDLER(DMA1_Stream5_IRQHandler, 5)
+DMA_STREAM_IRQ_HANDLER(DMA1_Stream6_IRQHandler, 6)
+DMA_STREAM_IRQ_HANDLER(DMA1_Stream7_IRQHandler, 7)
+DMA_STREAM_IRQ_HANDLER(DMA2_Stream0_IRQHandler, 8)
+DMA_STREAM_IRQ_HANDLER(DMA2_Stream1_IRQHandler, 9)
+DMA_STREAM_IRQ_HANDLER(DMA2_Stream2_IRQHandler, 10)
+DMA_STREAM_IRQ_HANDLER(DMA2_Stream3_IRQHandler, 11)
+DMA_STREAM_IRQ_HANDLER(DMA2_Stream4_IRQHandler, 12)
+DMA_STREAM_IRQ_HANDLER(DMA2_Stream5_IRQHandler, 13)
+DMA_STREAM_IRQ_HANDLER(DMA2_Stream6_IRQHandler, 14)
+DMA_STREAM_IRQ_HANDLER(DMA2_Stream7_IRQHandler, 15)
+DMA_STREAM_IRQ_HANDLER(BDMA_Channel0_IRQHandler, 16)
+DMA_STREAM_IRQ_HANDLER(BDMA_Channel1_IRQHandler, 17)
+DMA_STREAM_IRQ_HANDLER(BDMA_Channel2_IRQHandler, 18)
+DMA_STREAM_IRQ_HANDLER(BDMA_Channel3_IRQHandler, 19)
+DMA_STREAM_IRQ_HANDLER(BDMA_Channel4_IRQHandler, 20)
+DMA_STREAM_IRQ_HANDLER(BDMA_Channel5_IRQHandler, 21)
+DMA_STREAM_IRQ_HANDLER(BDMA_Channel6_IRQHandler, 22)
+DMA_STREAM_IRQ_HANDLER(BDMA_Channel7_IRQHandler, 23)
@@ -0,0 +1,30 @@
+/**
+ * @file    drv_dma_desc.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   DMA流资源管理平台接口（外设驱动使用）
+ */
+
+#ifndef DRV_DMA_DESC_H
+#define DRV_DMA_DESC_H
+
+#include <stdint.h>
+#include "stm32h7xx_hal.h"
+#include "drv_dma.h"
+
+/**
+ * @brief   将请求分配到的流绑定到HAL句柄并初始化
+ *
+ * @details 填写Instance、Init.Request与Init.Priority后调用HAL_DMA_Init()，
+ *          登记句柄用于中断分发，按请求表设置并使能流中断。
+ *          调用前由外设驱动填写方向、增量、数据宽度与模式等其余Init成员。
+ *
+ * @param[in]       id    请求编号
+ * @param[in,out]   hdma  DMA句柄（须为静态存储）
+ *
+ * @retval  0   成功
+ * @retval  -1  请求未分配、流已绑定其他句柄或HAL初始化失败
+ */
+int dma_attach(uint32_t id, DMA_HandleTypeDef *hdma);
+
+#endif /* DRV_DMA_DESC_H */
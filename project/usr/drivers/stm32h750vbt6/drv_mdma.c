@@ -0,0 +1,410 @@
+/**
+ * @file    drv_mdma.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   MDMA异步内存复制/填充服务实现
+ *
+ * @details 使用MDMA通道0，软件请求、块传输模式。作业以单向链表排队，
+ *          s_active为正在传输的作业；完成中断中取下一个作业启动。
+ *          任务与中断均可提交，通道是否空闲的判断与取出作业置为s_active在同一临界区内完成，
+ *          只有取到作业的一方启动通道。
+ *          单块最长64KB，更长的作业在完成中断中分段续传。
+ *
+ *          源、目标与长度均为4字节对齐时按字传输，否则按字节传输；
+ *          填充以作业中的4字节图案为源、源地址不递增。
+ */
+
+#include "drv_mdma.h"
+#include "drv_system.h"
+#include "board.h"
+#include "runstats.h"
+#include "stm32h7xx_hal.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 单块最大字节数（MDMA BNDT上限）
+ */
+#define MDMA_BLOCK_MAX          65536U
+
+static MDMA_HandleTypeDef s_mdma;
+static mdma_job_t *s_active;            /**< 正在传输的作业 */
+static mdma_job_t *s_queue_head;        /**< 等待队列头 */
+static mdma_job_t *s_queue_tail;        /**< 等待队列尾 */
+
+static void mdma_next(void);
+
+/**
+ * @brief   结束作业：失效目标cache、置状态、启动下一作业后调用回调
+ *
+ * @param[in]   job    作业
+ * @param[in]   state  结束状态
+ *
+ * @return  None
+ */
+static void mdma_finish(mdma_job_t *job, mdma_job_state_t state)
+{
+  // 传输期间推测读取可能把旧数据装入cache，完成后再失效一次
+  DRV_System_CacheInvalidate(job->dst, job->len);
+
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  s_active = NULL;
+  job->state = state;
+  __set_PRIMASK(primask);
+
+  mdma_next();
+
+  if(job->callback != NULL)
+  {
+    job->callback(job, job->arg);
+  }
+}
+
+/**
+ * @brief   启动作业的下一分段
+ *
+ * @param[in]   job  作业（s_active）
+ *
+ * @retval  0   已启动
+ * @retval  -1  HAL启动失败
+ */
+static int mdma_start(mdma_job_t *job)
+{
+  bool fill = (job->src == NULL);
+  uint8_t *dst = job->dst + job->offset;
+  const void *src = fill ? (const void *)&job->pattern : (const void *)(job->src + job->offset);
+  uint32_t chunk = job->len - job->offset;
+  bool word;
+
+  if(chunk > MDMA_BLOCK_MAX)
+  {
+    chunk = MDMA_BLOCK_MAX;
+  }
+  word = ((((uintptr_t)src | (uintptr_t)dst | chunk) & 3U) == 0U);
+
+  // 源写回内存；目标为整cache行，先失效，防止传输期间脏行被逐出覆盖新数据
+  DRV_System_CacheClean(src, fill ? sizeof(job->pattern) : chunk);
+  DRV_System_CacheInvalidate(dst, chunk);
+
+  s_mdma.Init.SourceInc = fill ? MDMA_SRC_INC_DISABLE : (word ? MDMA_SRC_INC_WORD : MDMA_SRC_INC_BYTE);
+  s_mdma.Init.DestinationInc = word ? MDMA_DEST_INC_WORD : MDMA_DEST_INC_BYTE;
+  s_mdma.Init.SourceDataSize = word ? MDMA_SRC_DATASIZE_WORD : MDMA_SRC_DATASIZE_BYTE;
+  s_mdma.Init.DestDataSize = word ? MDMA_DEST_DATASIZE_WORD : MDMA_DEST_DATASIZE_BYTE;
+  s_mdma.Init.SourceBurst = fill ? MDMA_SOURCE_BURST_SINGLE : MDMA_SOURCE_BURST_16BEATS;
+
+  if(HAL_MDMA_Init(&s_mdma) != HAL_OK)
+  {
+    return -1;
+  }
+
+  job->offset += chunk;
+
+  return HAL_MDMA_Start_IT(&s_mdma, (uint32_t)src, (uint32_t)dst, chunk, 1) == HAL_OK ? 0 : -1;
+}
+
+/**
+ * @brief   通道空闲时从队列取下一作业启动
+ *
+ * @details 通道正在传输（s_active非空）时直接返回，由其完成中断接续
+ *
+ * @return  None
+ */
+static void mdma_next(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  mdma_job_t *job;
+
+  __disable_irq();
+  job = (s_active == NULL) ? s_queue_head : NULL;
+  if(job != NULL)
+  {
+    s_queue_head = job->next;
+    if(s_queue_head == NULL)
+    {
+      s_queue_tail = NULL;
+    }
+    s_active = job;
+  }
+  __set_PRIMASK(primask);
+
+  if(job != NULL && mdma_start(job) != 0)
+  {
+    mdma_finish(job, MDMA_JOB_ERROR);
+  }
+}
+
+/**
+ * @brief   MDMA传输完成回调：续传下一分段或结束作业
+ *
+ * @param[in]   hmdma  MDMA句柄
+ *
+ * @return  None
+ */
+static void mdma_xfer_cplt(MDMA_HandleTypeDef *hmdma)
+{
+  mdma_job_t *job = s_active;
+
+  (void)hmdma;
+
+  if(job == NULL)
+  {
+    return;
+  }
+
+  if(job->offset < job->len)
+  {
+    if(mdma_start(job) != 0)
+    {
+      mdma_finish(job, MDMA_JOB_ERROR);
+    }
+    return;
+  }
+
+  mdma_finish(job, MDMA_JOB_DONE);
+}
+
+/**
+ * @brief   MDMA传输错误回调
+ *
+ * @param[in]   hmdma  MDMA句柄
+ *
+ * @return  None
+ */
+static void mdma_xfer_error(MDMA_HandleTypeDef *hmdma)
+{
+  (void)hmdma;
+
+  if(s_active != NULL)
+  {
+    mdma_finish(s_active, MDMA_JOB_ERROR);
+  }
+}
+
+/**
+ * @brief   提交作业
+ *
+ * @details 不足MDMA_CPU_THRESHOLD的作业由CPU完成；否则目标首尾不满cache行的
+ *          部分由CPU完成，其余整行部分入队
+ *
+ * @param[in,out]   job  已填写dst/src/len/pattern/callback/arg的作业
+ *
+ * @return  0
+ */
+static int mdma_submit(mdma_job_t *job)
+{
+  uint32_t head = (uint32_t)(-(uintptr_t)job->dst) & (DRV_CACHE_LINE - 1U);
+  uint32_t tail;
+  uint32_t primask;
+
+  if(job->len < MDMA_CPU_THRESHOLD)
+  {
+    head = job->len;
+  }
+  tail = (job->len - head) & (DRV_CACHE_LINE - 1U);
+
+  if(job->src != NULL)
+  {
+    memcpy(job->dst, job->src, head);
+    memcpy(job->dst + job->len - tail, job->src + job->len - tail, tail);
+    job->src += head;
+  }
+  else
+  {
+    memset(job->dst, (uint8_t)job->pattern, head);
+    memset(job->dst + job->len - tail, (uint8_t)job->pattern, tail);
+  }
+  job->dst += head;
+  job->len -= head + tail;
+  job->offset = 0;
+  job->next = NULL;
+
+  if(job->len == 0)
+  {
+    job->state = MDMA_JOB_DONE;
+    if(job->callback != NULL)
+    {
+      job->callback(job, job->arg);
+    }
+    return 0;
+  }
+
+  job->state = MDMA_JOB_PENDING;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if(s_queue_tail != NULL)
+  {
+    s_queue_tail->next = job;
+  }
+  else
+  {
+    s_queue_head = job;
+  }
+  s_queue_tail = job;
+  __set_PRIMASK(primask);
+
+  // 通道忙时mdma_next()直接返回，作业由当前传输的完成中断接续
+  mdma_next();
+
+  return 0;
+}
+
+/**
+ * @brief   初始化MDMA服务
+ *
+ * @retval  0   成功
+ * @retval  -1  失败
+ */
+int mdma_init(void)
+{
+  __HAL_RCC_MDMA_CLK_ENABLE();
+
+  s_mdma.Instance = MDMA_Channel0;
+  s_mdma.Init.Request = MDMA_REQUEST_SW;
+  s_mdma.Init.TransferTriggerMode = MDMA_BLOCK_TRANSFER;
+  s_mdma.Init.Priority = MDMA_PRIORITY_LOW;
+  s_mdma.Init.Endianness = MDMA_LITTLE_ENDIANNESS_PRESERVE;
+  s_mdma.Init.SourceInc = MDMA_SRC_INC_WORD;
+  s_mdma.Init.DestinationInc = MDMA_DEST_INC_WORD;
+  s_mdma.Init.SourceDataSize = MDMA_SRC_DATASIZE_WORD;
+  s_mdma.Init.DestDataSize = MDMA_DEST_DATASIZE_WORD;
+  s_mdma.Init.DataAlignment = MDMA_DATAALIGN_PACKENABLE;
+  s_mdma.Init.BufferTransferLength = 128;
+  s_mdma.Init.SourceBurst = MDMA_SOURCE_BURST_16BEATS;
+  s_mdma.Init.DestBurst = MDMA_DEST_BURST_16BEATS;
+  s_mdma.Init.SourceBlockAddressOffset = 0;
+  s_mdma.Init.DestBlockAddressOffset = 0;
+
+  if(HAL_MDMA_Init(&s_mdma) != HAL_OK)
+  {
+    return -1;
+  }
+
+  s_mdma.XferCpltCallback = mdma_xfer_cplt;
+  s_mdma.XferErrorCallback = mdma_xfer_error;
+
+  HAL_NVIC_SetPriority(MDMA_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(MDMA_IRQn);
+
+  return 0;
+}
+
+/**
+ * @brief   提交复制作业
+ *
+ * @param[out]  job       作业描述
+ * @param[out]  dst       目标地址
+ * @param[in]   src       源地址
+ * @param[in]   len       字节数
+ * @param[in]   callback  完成回调，可为NULL
+ * @param[in]   arg       回调参数
+ *
+ * @retval  0   已提交（或已由CPU完成）
+ * @retval  -1  参数错误或作业仍在进行中
+ */
+int mdma_memcpy(mdma_job_t *job, void *dst, const void *src, uint32_t len,
+                mdma_callback_t callback, void *arg)
+{
+  if(job == NULL || dst == NULL || src == NULL || job->state == MDMA_JOB_PENDING)
+  {
+    return -1;
+  }
+
+  job->dst = (uint8_t *)dst;
+  job->src = (const uint8_t *)src;
+  job->len = len;
+  job->pattern = 0;
+  job->callback = callback;
+  job->arg = arg;
+
+  return mdma_submit(job);
+}
+
+/**
+ * @brief   提交填充作业
+ *
+ * @param[out]  job       作业描述
+ * @param[out]  dst       目标地址
+ * @param[in]   value     填充字节
+ * @param[in]   len       字节数
+ * @param[in]   callback  完成回调，可为NULL
+ * @param[in]   arg       回调参数
+ *
+ * @retval  0   已提交（或已由CPU完成）
+ * @retval  -1  参数错误或作业仍在进行中
+ */
+int mdma_memset(mdma_job_t *job, void *dst, uint8_t value, uint32_t len,
+                mdma_callback_t callback, void *arg)
+{
+  if(job == NULL || dst == NULL || job->state == MDMA_JOB_PENDING)
+  {
+    return -1;
+  }
+
+  job->dst = (uint8_t *)dst;
+  job->src = NULL;
+  job->len = len;
+  job->pattern = value * 0x01010101U;
+  job->callback = callback;
+  job->arg = arg;
+
+  return mdma_submit(job);
+}
+
+/**
+ * @brief   查询作业是否结束
+ *
+ * @param[in]   job  作业描述
+ *
+ * @return  true已完成或出错，false仍在进行
+ */
+bool mdma_job_done(const mdma_job_t *job)
+{
+  return job != NULL && job->state != MDMA_JOB_PENDING;
+}
+
+/**
+ * @brief   等待作业结束
+ *
+ * @param[in]   job      作业描述
+ * @param[in]   timeout  超时（ms）
+ *
+ * @retval  0   完成
+ * @retval  -1  传输错误或超时
+ */
+int mdma_wait(const mdma_job_t *job, uint32_t timeout)
+{
+  uint32_t start = HAL_GetTick();
+
+  if(job == NULL)
+  {
+    return -1;
+  }
+
+  while(job->state == MDMA_JOB_PENDING)
+  {
+    if(HAL_GetTick() - start >= timeout)
+    {
+      return -1;
+    }
+  }
+
+  return job->state == MDMA_JOB_DONE ? 0 : -1;
+}
+
+/**
+ * @brief   MDMA中断服务函数
+ *
+ * @param   None
+ * @return  None
+ */
+void MDMA_IRQHandler(void)
+{
+  uint32_t stamp = RunStats_IrqEnter();
+
+  HAL_MDMA_IRQHandler(&s_mdma);
+
+  RunStats_IrqExit(BOARD_IRQ_MDMA, stamp);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file    drv_runstats.c
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   运行时统计后端（DWT CYCCNT + FreeRTOS）
+ *
+ * @details 周期计数取DWT CYCCNT，频率为内核时钟；临界区用BASEPRI屏蔽
+ *          configMAX_SYSCALL_INTERRUPT_PRIORITY及以下优先级的中断，任务与中断均可调用；
+ *          任务快照取自uxTaskGetSystemState()。
+ */
+
+#include "runstats_port.h"
+#include "runstats.h"
+#include "drv_system.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+
+#if configMAX_TASK_NAME_LEN > RUNSTATS_NAME_LEN
+#error "configMAX_TASK_NAME_LEN exceeds RUNSTATS_NAME_LEN"
+#endif
+
+// uxTaskGetSystemState()输出（静态分配，避免占用采样任务的栈）
+static TaskStatus_t s_status[RUNSTATS_MAX_TASKS];
+
+uint32_t RunStats_PortCycles(void)
+{
+  return DRV_System_GetCycles();
+}
+
+uint32_t RunStats_PortCycleHz(void)
+{
+  return DRV_System_GetCoreClock();
+}
+
+uint32_t RunStats_PortEnterCritical(void)
+{
+  return (uint32_t)portSET_INTERRUPT_MASK_FROM_ISR();
+}
+
+void RunStats_PortExitCritical(uint32_t state)
+{
+  portCLEAR_INTERRUPT_MASK_FROM_ISR((UBaseType_t)state);
+}
+
+uint32_t RunStats_PortGetTasks(RunStats_PortTask_t *tasks, uint32_t max)
+{
+  TaskHandle_t idle = xTaskGetIdleTaskHandle();
+  UBaseType_t n;
+
+  if(tasks == NULL)
+  {
+    return 0;
+  }
+  if(max > RUNSTATS_MAX_TASKS)
+  {
+    max = RUNSTATS_MAX_TASKS;
+  }
+
+  n = uxTaskGetSystemState(s_status, (UBaseType_t)max, NULL);
+  for(UBaseType_t i = 0; i < n; i++)
+  {
+    tasks[i].name = s_status[i].pcTaskName;
+    tasks[i].id = (uint32_t)s_status[i].xTaskNumber;
+    tasks[i].priority = (uint32_t)s_status[i].uxCurrentPriority;
+    tasks[i].run_time = (uint64_t)s_status[i].ulRunTimeCounter;
+    tasks[i].idle = (s_status[i].xHandle == idle);
+  }
+
+  return (uint32_t)n;
+}
@@ -4,63 +4,105 @@
  * @date    2026-01-15
  * @brief   系统初始化与时钟配置。
  *
- * @details 提供系统时钟与HAL基础初始化流程。
+ * @details 提供系统时钟与HAL基础初始化流程、cache维护与启动阶段计时。
  */
 
 #include "drv_system.h"
 #include "stm32h7xx_hal.h"
 
 /**
- * @brief   配置MPU（防止推测性访问）
- *
- * @details Cortex-M7推测性访问保护配置：
- *          - 配置整个4GB地址空间，通过SubRegionDisable选择性保护
- *          - SubRegionDisable = 0x87 (二进制: 10000111)
- *            * 4GB分为8个子区域，每个512MB
- *            * 位为1表示禁用该子区域的保护规则
- *          
- *          子区域划分：
- *          - 子区域0 (0x00000000-0x1FFFFFFF): 禁用保护，Flash/ITCM/DTCM区域
- *          - 子区域1 (0x20000000-0x3FFFFFFF): 禁用保护，SRAM/AHB SRAM区域
- *          - 子区域2 (0x40000000-0x5FFFFFFF): 禁用保护，外设区域
- *          - 子区域3 (0x60000000-0x7FFFFFFF): 启用保护，未使用区域
- *          - 子区域4 (0x80000000-0x9FFFFFFF): 启用保护，未使用区域
- *          - 子区域5 (0xA0000000-0xBFFFFFFF): 启用保护，未使用区域
- *          - 子区域6 (0xC0000000-0xDFFFFFFF): 启用保护，外部存储器区域（未使用）
- *          - 子区域7 (0xE0000000-0xFFFFFFFF): 禁用保护，系统区域
- *          
- *          保护策略：
- *          - 未使用的区域设为NO_ACCESS，防止推测性访问导致硬件错误
- *          - 已使用的区域禁用MPU保护，使用默认内存映射
+ * @brief   MPU区域策略表
+ *
+ * @details 编号大的区域优先级高，覆盖编号小的区域：
+ *
+ *          | 编号 | 地址范围                | 属性                 | 用途                         |
+ *          |------|-------------------------|----------------------|------------------------------|
+ *          | 0    | 4GB（子区域3-6）        | NO_ACCESS            | 未使用区域，防止推测性访问   |
+ *          | 1    | 0x24000000 AXI 512KB    | Normal WBWA          | 大块数据、AXI堆（DMA需维护） |
+ *          | 2    | 0x30000000 D2 512KB     | Normal 非cache, XN   | UART/ADC DMA缓冲区、D2堆     |
+ *          | 3    | 0x38000000 D3 64KB      | Normal 非cache, XN   | BDMA缓冲区、D3堆             |
+ *
+ *          区域0的子区域0/1/2/7禁用，Flash（WT）、TCM、外设与系统区使用默认内存映射。
+ *          D2/D3只放DMA缓冲区与冷数据，设为非cache后DMA收发无需维护cache；
+ *          AXI保留写回cache供CPU使用，其中的DMA缓冲区须调用
+ *          DRV_System_CacheClean()/DRV_System_CacheInvalidate()。
+ *          D2区域按512KB覆盖288KB SRAM，超出部分为保留地址，访问本就触发总线错误。
+ */
+static const MPU_Region_InitTypeDef s_mpu_regions[] =
+{
+  {
+    .Enable = MPU_REGION_ENABLE,
+    .Number = MPU_REGION_NUMBER0,
+    .BaseAddress = 0x00000000,
+    .Size = MPU_REGION_SIZE_4GB,
+    .SubRegionDisable = 0x87,
+    .TypeExtField = MPU_TEX_LEVEL0,
+    .AccessPermission = MPU_REGION_NO_ACCESS,
+    .DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE,
+    .IsShareable = MPU_ACCESS_SHAREABLE,
+    .IsCacheable = MPU_ACCESS_NOT_CACHEABLE,
+    .IsBufferable = MPU_ACCESS_NOT_BUFFERABLE,
+  },
+  {
+    .Enable = MPU_REGION_ENABLE,
+    .Number = MPU_REGION_NUMBER1,
+    .BaseAddress = 0x24000000,
+    .Size = MPU_REGION_SIZE_512KB,
+    .SubRegionDisable = 0x00,
+    .TypeExtField = MPU_TEX_LEVEL1,
+    .AccessPermission = MPU_REGION_FULL_ACCESS,
+    .DisableExec = MPU_INSTRUCTION_ACCESS_ENABLE,
+    .IsShareable = MPU_ACCESS_NOT_SHAREABLE,
+    .IsCacheable = MPU_ACCESS_CACHEABLE,
+    .IsBufferable = MPU_ACCESS_BUFFERABLE,
+  },
+  {
+    .Enable = MPU_REGION_ENABLE,
+    .Number = MPU_REGION_NUMBER2,
+    .BaseAddress = 0x30000000,
+    .Size = MPU_REGION_SIZE_512KB,
+    .SubRegionDisable = 0x00,
+    .TypeExtField = MPU_TEX_LEVEL1,
+    .AccessPermission = MPU_REGION_FULL_ACCESS,
+    .DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE,
+    .IsShareable = MPU_ACCESS_NOT_SHAREABLE,
+    .IsCacheable = MPU_ACCESS_NOT_CACHEABLE,
+    .IsBufferable = MPU_ACCESS_NOT_BUFFERABLE,
+  },
+  {
+    .Enable = MPU_REGION_ENABLE,
+    .Number = MPU_REGION_NUMBER3,
+    .BaseAddress = 0x38000000,
+    .Size = MPU_REGION_SIZE_64KB,
+    .SubRegionDisable = 0x00,
+    .TypeExtField = MPU_TEX_LEVEL1,
+    .AccessPermission = MPU_REGION_FULL_ACCESS,
+    .DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE,
+    .IsShareable = MPU_ACCESS_NOT_SHAREABLE,
+    .IsCacheable = MPU_ACCESS_NOT_CACHEABLE,
+    .IsBufferable = MPU_ACCESS_NOT_BUFFERABLE,
+  },
+};
+
+/**
+ * @brief   配置MPU
+ *
+ * @details 按s_mpu_regions配置各区域，未覆盖的地址使用默认内存映射作为背景区域
  *
  * @param   None
  * @return  None
  *
- * @note    参考: STM32CubeMX生成的默认MPU配置
+ * @note    须在使能D-Cache之前调用，否则DMA区域可能残留cache行
  */
 static void MPU_Config(void)
 {
-  MPU_Region_InitTypeDef MPU_InitStruct = {0};
-
-  // 禁用MPU
   HAL_MPU_Disable();
 
-  // 配置整个4GB地址空间，通过SubRegionDisable选择性保护未使用区域
-  MPU_InitStruct.Enable = MPU_REGION_ENABLE;
-  MPU_InitStruct.Number = MPU_REGION_NUMBER0;
-  MPU_InitStruct.BaseAddress = 0x0;
-  MPU_InitStruct.Size = MPU_REGION_SIZE_4GB;
-  MPU_InitStruct.SubRegionDisable = 0x87;  // 禁用子区域0,1,2,7的保护
-  MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL0;
-  MPU_InitStruct.AccessPermission = MPU_REGION_NO_ACCESS;  // 未禁用的子区域禁止访问
-  MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
-  MPU_InitStruct.IsShareable = MPU_ACCESS_SHAREABLE;
-  MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
-  MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
-
-  HAL_MPU_ConfigRegion(&MPU_InitStruct);
-
-  // 使能MPU，使用默认内存映射作为背景区域
+  for(uint32_t i = 0; i < sizeof(s_mpu_regions) / sizeof(s_mpu_regions[0]); i++)
+  {
+    HAL_MPU_ConfigRegion(&s_mpu_regions[i]);
+  }
+
   HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
 }
 
@@ -137,17 +179,186 @@ static int DRV_SystemClock_Config(void)
   return 0;
 }
 
+/**
+ * @brief   使能DWT周期计数器
+ *
+ * @details CYCCNT以内核时钟计数，480MHz下约8.9秒回绕一次，
+ *          用于性能测量与运行时统计
+ *
+ * @return  None
+ */
+static void DRV_CycleCounter_Init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = 0xC5ACCE55;  // Cortex-M7须先解锁DWT寄存器
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief   装载ITCM代码
+ *
+ * @details GCC启动文件只装载.data，.itcm_text（MEM_ITCM_CODE函数及链接脚本
+ *          收集的热点函数）由此从FLASH复制到ITCM；Keil由分散加载完成，无需处理
+ *
+ * @return  None
+ */
+static void DRV_Itcm_Load(void)
+{
+#if defined(__GNUC__) && !defined(__CC_ARM)
+  extern uint32_t _sitcm;
+  extern uint32_t _eitcm;
+  extern uint32_t _siitcm;
+
+  const uint32_t *src = &_siitcm;
+
+  for(uint32_t *dst = &_sitcm; dst < &_eitcm; dst++)
+  {
+    *dst = *src++;
+  }
+
+  __DSB();
+  __ISB();
+#endif
+}
+
+/**
+ * @brief   清零一段内存
+ *
+ * @details 每次循环写4个64位字（一个cache行），尾部不足32字节时逐字节清零。
+ *          使用volatile指针，防止编译器将循环替换为按字节实现的库函数memset
+ *
+ * @param[in]   start  起始地址（8字节对齐）
+ * @param[in]   end    结束地址（不含）
+ *
+ * @return  None
+ */
+static void DRV_Memory_Zero(uintptr_t start, uintptr_t end)
+{
+  volatile uint64_t *p = (volatile uint64_t *)start;
+
+  while((uintptr_t)(p + 4) <= end)
+  {
+    p[0] = 0;
+    p[1] = 0;
+    p[2] = 0;
+    p[3] = 0;
+    p += 4;
+  }
+
+  for(volatile uint8_t *b = (volatile uint8_t *)p; (uintptr_t)b < end; b++)
+  {
+    *b = 0;
+  }
+}
+
+/**
+ * @brief   清零AXI/D2/D3区域的变量
+ *
+ * @details 这些区域为NOLOAD(UNINIT)段，启动文件不处理；此处只清零链接器
+ *          实际分配的范围（各区域起止符号），未使用的SRAM保持原样。
+ *          Keil取执行区的Base/Limit：这些执行区只含本区域的变量，
+ *          mem_region.h中的zero_init使其归入ZI，整段清零即可。
+ *          须在PLL锁定与D2 SRAM时钟使能之后调用，DTCM的.bss仍由启动文件清零，
+ *          .noinit不在清零范围内
+ *
+ * @return  None
+ */
+static void DRV_Memory_ZeroRegions(void)
+{
+#if defined(__CC_ARM)
+  extern uint32_t Image$$RW_IRAM2$$Base[];
+  extern uint32_t Image$$RW_IRAM2$$Limit[];
+  extern uint32_t Image$$RW_RAM_D2$$Base[];
+  extern uint32_t Image$$RW_RAM_D2$$Limit[];
+  extern uint32_t Image$$RW_RAM_D3$$Base[];
+  extern uint32_t Image$$RW_RAM_D3$$Limit[];
+
+  DRV_Memory_Zero((uintptr_t)Image$$RW_IRAM2$$Base, (uintptr_t)Image$$RW_IRAM2$$Limit);
+  DRV_Memory_Zero((uintptr_t)Image$$RW_RAM_D2$$Base, (uintptr_t)Image$$RW_RAM_D2$$Limit);
+  DRV_Memory_Zero((uintptr_t)Image$$RW_RAM_D3$$Base, (uintptr_t)Image$$RW_RAM_D3$$Limit);
+#else
+  extern uint32_t _sram_d1[];
+  extern uint32_t _eram_d1[];
+  extern uint32_t _sram_d2[];
+  extern uint32_t _eram_d2[];
+  extern uint32_t _sram_d3[];
+  extern uint32_t _eram_d3[];
+
+  DRV_Memory_Zero((uintptr_t)_sram_d1, (uintptr_t)_eram_d1);
+  DRV_Memory_Zero((uintptr_t)_sram_d2, (uintptr_t)_eram_d2);
+  DRV_Memory_Zero((uintptr_t)_sram_d3, (uintptr_t)_eram_d3);
+#endif
+}
+
+/**
+ * @brief 启动阶段时间戳
+ */
+static uint32_t s_boot_us[DRV_BOOT_PHASE_NUM];  /**< 各阶段完成时刻(us，相对DRV_System_Init入口) */
+static uint32_t s_boot_cycles;                  /**< 上次打点的CYCCNT */
+static uint32_t s_boot_hz;                      /**< 上次打点时的内核时钟 */
+static uint32_t s_boot_elapsed;                 /**< 累计微秒数 */
+
+/**
+ * @brief   记录启动阶段完成时刻
+ *
+ * @details 内核时钟在启动过程中由HSI 64MHz切换到PLL 480MHz，CYCCNT不能直接换算，
+ *          因此按两次打点之间的周期数与前一次打点时的时钟频率分段累加。
+ *          时钟切换所在的阶段按HSI频率计算（该阶段主要耗时在等待PLL锁定）
+ *
+ * @param[in]   phase  阶段
+ *
+ * @return  None
+ */
+void DRV_System_BootMark(DRV_BootPhase_t phase)
+{
+  uint32_t now = DWT->CYCCNT;
+
+  if(phase >= DRV_BOOT_PHASE_NUM)
+  {
+    return;
+  }
+
+  if(phase != DRV_BOOT_RESET)
+  {
+    s_boot_elapsed += (now - s_boot_cycles) / (s_boot_hz / 1000000U);
+  }
+
+  s_boot_us[phase] = s_boot_elapsed;
+  s_boot_cycles = now;
+  s_boot_hz = SystemCoreClock;
+}
+
+/**
+ * @brief   读取启动阶段完成时刻
+ *
+ * @param[in]   phase  阶段
+ *
+ * @return  uint32_t 相对DRV_System_Init入口的微秒数，阶段未到达或越界时为0
+ */
+uint32_t DRV_System_GetBootTime(DRV_BootPhase_t phase)
+{
+  return phase < DRV_BOOT_PHASE_NUM ? s_boot_us[phase] : 0;
+}
+
 /**
  * @brief   系统初始化
  *
- * @return  int 初始化结果，0表示成功，-1表示失败
+ * @details 须为main()的第一步，启动计时以其入口为起点（启动文件装载.data、
+ *          清零DTCM .bss与SystemInit的耗时不计入）
  *
- * @note    不使用Cache时，MPU配置可选
+ * @return  int 初始化结果，0表示成功，-1表示失败
  */
 int DRV_System_Init(void)
 {
-  // Step 1: 配置MPU（不使用Cache时可选）
+  // Step 0: 使能周期计数器并记录启动起点，装载ITCM代码（须先于任何ITCM函数与中断）
+  DRV_CycleCounter_Init();
+  DRV_System_BootMark(DRV_BOOT_RESET);
+  DRV_Itcm_Load();
+
+  // Step 1: 配置MPU区域策略，随后使能I-Cache/D-Cache
   MPU_Config();
+  DRV_System_SetCache(true);
 
   // Step 2: HAL初始化
   if(HAL_Init() != HAL_OK)
@@ -155,8 +366,23 @@ int DRV_System_Init(void)
     return -1;
   }
 
-  // Step 3: 配置系统时钟
-  return DRV_SystemClock_Config();
+  // Step 3: 使能D2 SRAM1-3时钟（复位后关闭，D2区域变量与堆访问前必须使能）
+  __HAL_RCC_D2SRAM1_CLK_ENABLE();
+  __HAL_RCC_D2SRAM2_CLK_ENABLE();
+  __HAL_RCC_D2SRAM3_CLK_ENABLE();
+
+  // Step 4: 配置系统时钟
+  if(DRV_SystemClock_Config() != 0)
+  {
+    return -1;
+  }
+  DRV_System_BootMark(DRV_BOOT_CLOCKS);
+
+  // Step 5: 以480MHz清零AXI/D2/D3区域的变量
+  DRV_Memory_ZeroRegions();
+  DRV_System_BootMark(DRV_BOOT_MEMORY);
+
+  return 0;
 }
 
 /**
@@ -171,3 +397,114 @@ void DRV_System_ErrorHandler(void)
   {
   }
 }
+
+/**
+ * @brief   读取DWT周期计数
+ *
+ * @return  uint32_t 当前CYCCNT值（内核时钟周期，32位回绕）
+ */
+uint32_t DRV_System_GetCycles(void)
+{
+  return DWT->CYCCNT;
+}
+
+/**
+ * @brief   读取内核时钟频率
+ *
+ * @return  uint32_t 内核时钟频率(Hz)
+ */
+uint32_t DRV_System_GetCoreClock(void)
+{
+  return SystemCoreClock;
+}
+
+/**
+ * @brief   使能或关闭I-Cache与D-Cache
+ *
+ * @details 关闭D-Cache时先清理并失效全部cache行，脏数据写回内存后再关闭；
+ *          使能时先失效全部cache行。可在运行中切换（如基准测试对比），
+ *          切换期间其他任务照常运行，只是访问变慢
+ *
+ * @param[in]   enable  true使能，false关闭
+ *
+ * @return  None
+ */
+void DRV_System_SetCache(bool enable)
+{
+  if(enable)
+  {
+    if((SCB->CCR & SCB_CCR_IC_Msk) == 0U)
+    {
+      SCB_EnableICache();
+    }
+    if((SCB->CCR & SCB_CCR_DC_Msk) == 0U)
+    {
+      SCB_EnableDCache();
+    }
+  }
+  else
+  {
+    SCB_DisableDCache();
+    SCB_DisableICache();
+  }
+}
+
+/**
+ * @brief   读取D-Cache是否使能
+ *
+ * @return  bool true已使能
+ */
+bool DRV_System_CacheEnabled(void)
+{
+  return (SCB->CCR & SCB_CCR_DC_Msk) != 0U;
+}
+
+/**
+ * @brief   清理D-Cache（写回）
+ *
+ * @details DMA从内存读取（如发送）前调用，将CPU写入的脏数据写回内存。
+ *          地址向下、末端向上按32字节cache行取整，D-Cache未使能时直接返回；
+ *          非cache区域（DTCM、D2、D3）调用无副作用
+ *
+ * @param[in]   addr  起始地址
+ * @param[in]   len   字节数
+ *
+ * @return  None
+ */
+void DRV_System_CacheClean(const void *addr, uint32_t len)
+{
+  if(addr == NULL || len == 0 || !DRV_System_CacheEnabled())
+  {
+    return;
+  }
+
+  uint32_t start = (uint32_t)addr & ~(DRV_CACHE_LINE - 1U);
+  uint32_t end = ((uint32_t)addr + len + DRV_CACHE_LINE - 1U) & ~(DRV_CACHE_LINE - 1U);
+
+  SCB_CleanDCache_by_Addr((uint32_t *)start, (int32_t)(end - start));
+}
+
+/**
+ * @brief   失效D-Cache（丢弃）
+ *
+ * @details DMA向内存写入（如接收）后、CPU读取前调用，丢弃cache中的旧数据。
+ *          地址按32字节cache行取整，缓冲区首尾不满一行时会一并丢弃相邻变量
+ *          未写回的修改，因此缓冲区须按cache行对齐并取整（MEM_REGION已保证对齐）
+ *
+ * @param[in]   addr  起始地址
+ * @param[in]   len   字节数
+ *
+ * @return  None
+ */
+void DRV_System_CacheInvalidate(void *addr, uint32_t len)
+{
+  if(addr == NULL || len == 0 || !DRV_System_CacheEnabled())
+  {
+    return;
+  }
+
+  uint32_t start = (uint32_t)addr & ~(DRV_CACHE_LINE - 1U);
+  uint32_t end = ((uint32_t)addr + len + DRV_CACHE_LINE - 1U) & ~(DRV_CACHE_LINE - 1U);
+
+  SCB_InvalidateDCache_by_Addr((uint32_t *)start, (int32_t)(end - start));
+}
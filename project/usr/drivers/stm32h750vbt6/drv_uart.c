@@ -16,8 +16,12 @@
  *          - 过采样：16倍
  *          
  *          硬件配置：
- *          - UART1 (RS232): PA9(TX), PA10(RX) → DMA1_Stream3 (接收)
- *          - UART2 (RS485): PA2(TX), PA3(RX)  → DMA1_Stream4 (接收)
+ *          - 引脚、复用功能、中断、DMA请求与接收缓冲区由board.c中的描述符给出，
+ *            MspInit与中断处理对所有串口共用，新增串口只需增加描述符
+ *          - 支持USART1/2/3/6、UART4/5/7/8、LPUART1，中断入口按实例分发到共用处理
+ *          - DMA流由drv_dma按board_dma_requests分配，流中断由drv_dma分发
+ *          - 未配置接收DMA的串口以FIFO阈值+IDLE中断成批接收，或RXNE中断逐字节接收
+ *          - RS485方向控制：硬件DE（DEM）或GPIO（发送前置位、TC中断中复位）
  *          
  *          DMA+IDLE+环形缓冲区接收机制：
  *          - DMA工作在循环模式，持续接收数据到临时缓冲区
@@ -25,21 +29,158 @@
  *          - 应用层通过uart_read_ringbuf从环形缓冲区读取数据
  *          - 环形缓冲区避免数据丢失，支持连续高速接收
  *          
- * @note    UART DMA缓冲区需确保32字节对齐
+ * @note    链路统计（收发字节、帧、线路错误、覆盖丢弃、缓冲区峰值）在中断中累计，
+ *          uart_get_stats()读取
+ * @note    UART DMA接收缓冲区位于D2 SRAM（非cache），DMA发送前清理D-Cache
  * @note    printf输出通过UART2实现，需实现_putchar函数
- * @warning 不同UART必须使用不同的DMA Stream，避免冲突
  */
 
 #include "drv_uart.h"
+#include "drv_system.h"
 #include "drv_uart_desc.h"
+#include "drv_dma_desc.h"
 #include "board.h"
 #include "ringbuffer.h"
+#include "runstats.h"
+#include "mem_region.h"
+#include "uartcfg.h"
+#include <stddef.h>
 #include <string.h>
 #include <stdbool.h>
 
+/**
+ * @brief 支持的串口实例，下标即中断分发编号
+ */
+static const uintptr_t s_uart_instances[] =
+{
+  USART1_BASE, USART2_BASE, USART3_BASE, UART4_BASE, UART5_BASE,
+  USART6_BASE, UART7_BASE, UART8_BASE, LPUART1_BASE
+};
+
+#define UART_PORT_NUM   (sizeof(s_uart_instances) / sizeof(s_uart_instances[0]))
+
+/**
+ * @brief 已初始化的串口描述符，按s_uart_instances下标
+ */
+static uart_desc_t s_uart_ports[UART_PORT_NUM];
+
+/**
+ * @brief   查找串口实例对应的分发编号
+ *
+ * @param[in]   instance  串口实例
+ *
+ * @return  分发编号，不支持的实例返回-1
+ */
+static int uart_port_index(const USART_TypeDef *instance)
+{
+  return (int)UartCfg_PortIndex((uintptr_t)instance, s_uart_instances, UART_PORT_NUM);
+}
+
+/**
+ * @brief   计算GPIO端口编号
+ *
+ * @param[in]   port  GPIO端口
+ *
+ * @return  端口编号（GPIOA为0），无效端口返回-1
+ */
+static int32_t uart_gpio_index(const GPIO_TypeDef *port)
+{
+  return UartCfg_GpioIndex((uintptr_t)port, GPIOA_BASE, GPIOB_BASE - GPIOA_BASE);
+}
+
+/**
+ * @brief   使能串口时钟
+ *
+ * @param[in]   index  分发编号
+ *
+ * @return  None
+ */
+static void uart_clk_enable(int index)
+{
+  switch(index)
+  {
+    case 0: __HAL_RCC_USART1_CLK_ENABLE(); break;
+    case 1: __HAL_RCC_USART2_CLK_ENABLE(); break;
+    case 2: __HAL_RCC_USART3_CLK_ENABLE(); break;
+    case 3: __HAL_RCC_UART4_CLK_ENABLE(); break;
+    case 4: __HAL_RCC_UART5_CLK_ENABLE(); break;
+    case 5: __HAL_RCC_USART6_CLK_ENABLE(); break;
+    case 6: __HAL_RCC_UART7_CLK_ENABLE(); break;
+    case 7: __HAL_RCC_UART8_CLK_ENABLE(); break;
+    default: __HAL_RCC_LPUART1_CLK_ENABLE(); break;
+  }
+}
+
+/**
+ * @brief   使能GPIO端口时钟（GPIOA-GPIOK在AHB4ENR中按端口顺序排列）
+ *
+ * @param[in]   port  GPIO端口
+ *
+ * @return  None
+ */
+static void uart_gpio_clk_enable(const GPIO_TypeDef *port)
+{
+  int32_t index = uart_gpio_index(port);
+  uint32_t bit;
+
+  if(index < 0)
+  {
+    return;
+  }
+
+  bit = 1UL << index;
+  SET_BIT(RCC->AHB4ENR, bit);
+  (void)READ_BIT(RCC->AHB4ENR, bit);
+}
+
+/**
+ * @brief   由HAL句柄反查串口描述符
+ *
+ * @param[in]   huart  UART句柄指针（描述符内嵌成员）
+ *
+ * @return  串口描述符
+ */
+static uart_desc_t uart_from_handle(UART_HandleTypeDef *huart)
+{
+  return (uart_desc_t)((uint8_t *)huart - offsetof(struct uart_desc, hal_handle));
+}
+
+/**
+ * @brief   GPIO方式置位DE（切换到发送）
+ *
+ * @param[in]   uart  UART描述符
+ *
+ * @return  None
+ */
+static inline void uart_de_assert(uart_desc_t uart)
+{
+  if(uart->rs485 == UART_RS485_GPIO)
+  {
+    uart->de_port->BSRR = uart->de_pin;
+  }
+}
+
+/**
+ * @brief   GPIO方式复位DE（切换到接收）
+ *
+ * @param[in]   uart  UART描述符
+ *
+ * @return  None
+ */
+static inline void uart_de_deassert(uart_desc_t uart)
+{
+  if(uart->rs485 == UART_RS485_GPIO)
+  {
+    uart->de_port->BSRR = (uint32_t)uart->de_pin << 16;
+  }
+}
+
 /**
  * @brief   初始化UART
  *
+ * @details 按描述符配置串口：有接收DMA时以DMA循环接收+IDLE中断交付整帧，
+ *          否则以RXNE中断逐字节写入环形缓冲区
+ *
  * @param[in]   uart            UART描述符
  * @param[in]   ringbuf_storage 环形缓冲区存储空间指针
  * @param[in]   ringbuf_size    环形缓冲区大小
@@ -48,13 +189,33 @@
  */
 void uart_init(uart_desc_t uart, uint8_t *ringbuf_storage, uint32_t ringbuf_size)
 {
+  UartCfg_t cfg;
+  int index;
+
   if(uart == NULL || ringbuf_storage == NULL || ringbuf_size == 0)
   {
     return;
   }
 
-  // 初始化环形缓冲区
+  index = uart_port_index(uart->instance);
+  cfg.port = index;
+  cfg.tx_gpio = uart_gpio_index(uart->tx_port);
+  cfg.rx_gpio = uart_gpio_index(uart->rx_port);
+  cfg.dma_rx = (uart->dma_rx != UART_DESC_NONE);
+  cfg.dma_rx_buf = uart->dma_rx_buf;
+  cfg.dma_rx_len = uart->dma_rx_len;
+  cfg.rs485 = (uart->rs485 != UART_RS485_NONE);
+  cfg.de_gpio = uart_gpio_index(uart->de_port);
+  cfg.de_assert = uart->de_assert;
+  cfg.de_deassert = uart->de_deassert;
+  if(UartCfg_Validate(&cfg) != 0)
+  {
+    return;
+  }
+
+  // 初始化环形缓冲区与链路统计
   RingBuffer_Init(&uart->rx_ringbuf, ringbuf_storage, ringbuf_size);
+  memset(&uart->stats, 0, sizeof(uart->stats));
 
   uart->hal_handle.Instance = uart->instance;
   uart->hal_handle.Init.BaudRate = uart->baudrate;
@@ -65,40 +226,63 @@ void uart_init(uart_desc_t uart, uint8_t *ringbuf_storage, uint32_t ringbuf_size
   uart->hal_handle.Init.HwFlowCtl = UART_HWCONTROL_NONE;
   uart->hal_handle.Init.OverSampling = UART_OVERSAMPLING_16;
 
-  // HAL_UART_Init会调用HAL_UART_MspInit初始化DMA
-  if(HAL_UART_Init(&uart->hal_handle) != HAL_OK)
+  // 先登记再初始化，MspInit使能中断后即可分发
+  s_uart_ports[index] = uart;
+
+  // HAL_UART_Init/HAL_RS485Ex_Init会调用HAL_UART_MspInit初始化引脚、DMA与中断
+  if(uart->rs485 == UART_RS485_HW)
+  {
+    // 硬件DE：外设在起始位前de_assert、停止位后de_deassert个采样时钟翻转DE
+    if(HAL_RS485Ex_Init(&uart->hal_handle, UART_DE_POLARITY_HIGH,
+                        uart->de_assert, uart->de_deassert) != HAL_OK)
+    {
+      return;
+    }
+  }
+  else if(HAL_UART_Init(&uart->hal_handle) != HAL_OK)
   {
     return;
   }
 
-  // DMA初始化完成后，再启动接收和使能IDLE中断
-  if(uart->instance == USART1)
+  // FIFO阈值须在使能FIFO前设置，HAL据此计算中断发送每次填充的字节数
+  if(uart->fifo)
   {
-    // 清除可能存在的IDLE标志
-    __HAL_UART_CLEAR_IDLEFLAG(&uart->hal_handle);
-    
-    // 使能空闲中断
-    __HAL_UART_ENABLE_IT(&uart->hal_handle, UART_IT_IDLE);
+    if(HAL_UARTEx_SetTxFifoThreshold(&uart->hal_handle, uart->tx_fifo_threshold) != HAL_OK ||
+       HAL_UARTEx_SetRxFifoThreshold(&uart->hal_handle, uart->rx_fifo_threshold) != HAL_OK ||
+       HAL_UARTEx_EnableFifoMode(&uart->hal_handle) != HAL_OK)
+    {
+      return;
+    }
+  }
 
-    // 启动DMA循环接收
-    HAL_UART_Receive_DMA(&uart->hal_handle, Uart1_dma_rx_buf, sizeof(Uart1_dma_rx_buf));
+  // 清除可能存在的IDLE标志
+  __HAL_UART_CLEAR_IDLEFLAG(&uart->hal_handle);
+
+  if(uart->dma_rx != UART_DESC_NONE)
+  {
+    // 使能空闲中断，启动DMA循环接收
+    __HAL_UART_ENABLE_IT(&uart->hal_handle, UART_IT_IDLE);
+    HAL_UART_Receive_DMA(&uart->hal_handle, uart->dma_rx_buf, uart->dma_rx_len);
   }
-  else if(uart->instance == USART2)
+  else if(uart->fifo)
   {
-    // 清除可能存在的IDLE标志
-    __HAL_UART_CLEAR_IDLEFLAG(&uart->hal_handle);
-    
-    // 使能空闲中断
+    // 接收FIFO达到阈值时成批读取，帧尾不足阈值的部分由空闲中断读取
+    __HAL_UART_ENABLE_IT(&uart->hal_handle, UART_IT_RXFT);
+    __HAL_UART_ENABLE_IT(&uart->hal_handle, UART_IT_IDLE);
+  }
+  else
+  {
+    // 无接收DMA：逐字节中断接收，空闲中断用于帧计数
+    __HAL_UART_ENABLE_IT(&uart->hal_handle, UART_IT_RXNE);
     __HAL_UART_ENABLE_IT(&uart->hal_handle, UART_IT_IDLE);
-
-    // 启动DMA循环接收
-    HAL_UART_Receive_DMA(&uart->hal_handle, Uart2_dma_rx_buf, sizeof(Uart2_dma_rx_buf));
   }
 }
 
 /**
  * @brief   UART底层初始化
  *
+ * @details 按描述符使能时钟、配置TX/RX与DE引脚，绑定收发DMA并使能串口中断
+ *
  * @param[in]   huart  UART句柄
  *
  * @return  None
@@ -106,113 +290,84 @@ void uart_init(uart_desc_t uart, uint8_t *ringbuf_storage, uint32_t ringbuf_size
 void HAL_UART_MspInit(UART_HandleTypeDef *huart)
 {
   GPIO_InitTypeDef GPIO_InitStruct = {0};
+  uart_desc_t uart;
+  int index;
 
   if(huart == NULL)
   {
     return;
   }
 
-  if(huart->Instance == USART1)
-  {
-    static DMA_HandleTypeDef hdma_usart1_rx;
-    static DMA_HandleTypeDef hdma_usart1_tx;
-
-    __HAL_RCC_USART1_CLK_ENABLE();
-    __HAL_RCC_GPIOA_CLK_ENABLE();
-    __HAL_RCC_DMA1_CLK_ENABLE();
-
-
-    GPIO_InitStruct.Pin = GPIO_PIN_9 | GPIO_PIN_10;
-    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
-    GPIO_InitStruct.Pull = GPIO_PULLUP;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
-    GPIO_InitStruct.Alternate = GPIO_AF7_USART1;
-    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
-
-    // 配置DMA接收,Uart1 - DMA1 Stream3
-    hdma_usart1_rx.Instance = DMA1_Stream3;
-    hdma_usart1_rx.Init.Request = DMA_REQUEST_USART1_RX;
-    hdma_usart1_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
-    hdma_usart1_rx.Init.PeriphInc = DMA_PINC_DISABLE;
-    hdma_usart1_rx.Init.MemInc = DMA_MINC_ENABLE;
-    hdma_usart1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
-    hdma_usart1_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
-    hdma_usart1_rx.Init.Mode = DMA_CIRCULAR;
-    hdma_usart1_rx.Init.Priority = DMA_PRIORITY_LOW;
-    hdma_usart1_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
-    HAL_DMA_Init(&hdma_usart1_rx);
-
-    __HAL_LINKDMA(huart, hdmarx, hdma_usart1_rx);
-
-    // 配置DMA发送,Uart1 - DMA1 Stream5
-    hdma_usart1_tx.Instance = DMA1_Stream5;
-    hdma_usart1_tx.Init.Request = DMA_REQUEST_USART1_TX;
-    hdma_usart1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
-    hdma_usart1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
-    hdma_usart1_tx.Init.MemInc = DMA_MINC_ENABLE;
-    hdma_usart1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
-    hdma_usart1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
-    hdma_usart1_tx.Init.Mode = DMA_NORMAL;
-    hdma_usart1_tx.Init.Priority = DMA_PRIORITY_LOW;
-    hdma_usart1_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
-    HAL_DMA_Init(&hdma_usart1_tx);
-
-    __HAL_LINKDMA(huart, hdmatx, hdma_usart1_tx);
-
-    // 使能UART中断（用于IDLE中断接收）
-    HAL_NVIC_SetPriority(USART1_IRQn, 5, 0);
-    HAL_NVIC_EnableIRQ(USART1_IRQn);
-  }
-  else if(huart->Instance == USART2)
-  {
-    static DMA_HandleTypeDef hdma_usart2_rx;
-    static DMA_HandleTypeDef hdma_usart2_tx;
-
-    __HAL_RCC_USART2_CLK_ENABLE();
-    __HAL_RCC_GPIOA_CLK_ENABLE();
-    __HAL_RCC_DMA1_CLK_ENABLE();
-
-    GPIO_InitStruct.Pin = GPIO_PIN_2 | GPIO_PIN_3;
-    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
-    GPIO_InitStruct.Pull = GPIO_PULLUP;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
-    GPIO_InitStruct.Alternate = GPIO_AF7_USART2;
-    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
-
-    // 配置DMA接收,Uart2 - DMA1 Stream4
-    hdma_usart2_rx.Instance = DMA1_Stream4;
-    hdma_usart2_rx.Init.Request = DMA_REQUEST_USART2_RX;
-    hdma_usart2_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
-    hdma_usart2_rx.Init.PeriphInc = DMA_PINC_DISABLE;
-    hdma_usart2_rx.Init.MemInc = DMA_MINC_ENABLE;
-    hdma_usart2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
-    hdma_usart2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
-    hdma_usart2_rx.Init.Mode = DMA_CIRCULAR;
-    hdma_usart2_rx.Init.Priority = DMA_PRIORITY_LOW;
-    hdma_usart2_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
-    HAL_DMA_Init(&hdma_usart2_rx);
-
-    __HAL_LINKDMA(huart, hdmarx, hdma_usart2_rx);
-
-    // 配置DMA发送,Uart2 - DMA1 Stream6
-    hdma_usart2_tx.Instance = DMA1_Stream6;
-    hdma_usart2_tx.Init.Request = DMA_REQUEST_USART2_TX;
-    hdma_usart2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
-    hdma_usart2_tx.Init.PeriphInc = DMA_PINC_DISABLE;
-    hdma_usart2_tx.Init.MemInc = DMA_MINC_ENABLE;
-    hdma_usart2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
-    hdma_usart2_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
-    hdma_usart2_tx.Init.Mode = DMA_NORMAL;
-    hdma_usart2_tx.Init.Priority = DMA_PRIORITY_LOW;
-    hdma_usart2_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
-    HAL_DMA_Init(&hdma_usart2_tx);
-
-    __HAL_LINKDMA(huart, hdmatx, hdma_usart2_tx);
-
-    // 使能UART中断（用于IDLE中断接收）
-    HAL_NVIC_SetPriority(USART2_IRQn, 5, 0);
-    HAL_NVIC_EnableIRQ(USART2_IRQn);
+  uart = uart_from_handle(huart);
+  index = uart_port_index(uart->instance);
+  if(index < 0)
+  {
+    return;
+  }
+
+  uart_clk_enable(index);
+  uart_gpio_clk_enable(uart->tx_port);
+  uart_gpio_clk_enable(uart->rx_port);
+
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  GPIO_InitStruct.Alternate = uart->af;
+  GPIO_InitStruct.Pin = uart->tx_pin;
+  HAL_GPIO_Init(uart->tx_port, &GPIO_InitStruct);
+  GPIO_InitStruct.Pin = uart->rx_pin;
+  HAL_GPIO_Init(uart->rx_port, &GPIO_InitStruct);
+
+  // DE引脚：硬件DE为串口复用功能，GPIO方式为推挽输出、默认接收
+  if(uart->rs485 != UART_RS485_NONE)
+  {
+    uart_gpio_clk_enable(uart->de_port);
+    GPIO_InitStruct.Pin = uart->de_pin;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    if(uart->rs485 == UART_RS485_GPIO)
+    {
+      uart_de_deassert(uart);
+      GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+      GPIO_InitStruct.Alternate = 0;
+    }
+    HAL_GPIO_Init(uart->de_port, &GPIO_InitStruct);
   }
+
+  // 配置DMA接收（循环），流由请求表分配
+  if(uart->dma_rx != UART_DESC_NONE)
+  {
+    uart->hdma_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    uart->hdma_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    uart->hdma_rx.Init.MemInc = DMA_MINC_ENABLE;
+    uart->hdma_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    uart->hdma_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    uart->hdma_rx.Init.Mode = DMA_CIRCULAR;
+    uart->hdma_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if(dma_attach((uint32_t)uart->dma_rx, &uart->hdma_rx) == 0)
+    {
+      __HAL_LINKDMA(huart, hdmarx, uart->hdma_rx);
+    }
+  }
+
+  // 配置DMA发送，流由请求表分配
+  if(uart->dma_tx != UART_DESC_NONE)
+  {
+    uart->hdma_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    uart->hdma_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    uart->hdma_tx.Init.MemInc = DMA_MINC_ENABLE;
+    uart->hdma_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    uart->hdma_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    uart->hdma_tx.Init.Mode = DMA_NORMAL;
+    uart->hdma_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if(dma_attach((uint32_t)uart->dma_tx, &uart->hdma_tx) == 0)
+    {
+      __HAL_LINKDMA(huart, hdmatx, uart->hdma_tx);
+    }
+  }
+
+  // 使能UART中断（IDLE/RXNE接收与HAL收发完成处理）
+  HAL_NVIC_SetPriority(uart->irqn, uart->irq_priority, 0);
+  HAL_NVIC_EnableIRQ(uart->irqn);
 }
 
 
@@ -230,12 +385,26 @@ void HAL_UART_MspInit(UART_HandleTypeDef *huart)
  */
 int uart_transmit(uart_desc_t uart, uint8_t *data, uint16_t len, uint32_t timeout)
 {
+  HAL_StatusTypeDef status;
+
   if(uart == NULL)
   {
     return -1;
   }
 
-  return HAL_UART_Transmit(&uart->hal_handle, data, len, timeout) == HAL_OK ? 0 : -1;
+  // HAL_UART_Transmit返回前已等待TC，最后一位移出后立即切回接收
+  uart_de_assert(uart);
+  status = HAL_UART_Transmit(&uart->hal_handle, data, len, timeout);
+  uart_de_deassert(uart);
+
+  if(status != HAL_OK)
+  {
+    return -1;
+  }
+
+  uart->stats.tx_bytes += len;
+
+  return 0;
 }
 
 /**
@@ -276,7 +445,17 @@ int uart_transmit_it(uart_desc_t uart, uint8_t *data, uint16_t len)
     return -1;
   }
 
-  return HAL_UART_Transmit_IT(&uart->hal_handle, data, len) == HAL_OK ? 0 : -1;
+  // DE在发送完成回调（TC中断）中复位
+  uart_de_assert(uart);
+  if(HAL_UART_Transmit_IT(&uart->hal_handle, data, len) != HAL_OK)
+  {
+    uart_de_deassert(uart);
+    return -1;
+  }
+
+  uart->stats.tx_bytes += len;
+
+  return 0;
 }
 
 /**
@@ -307,16 +486,29 @@ int uart_receive_it(uart_desc_t uart, uint8_t *data, uint16_t len)
  * @param[in]   len   发送长度
  *
  * @retval  0   成功
- * @retval  -1  失败（DMA忙或参数错误）
+ * @retval  -1  失败（DMA忙、参数错误或未配置发送DMA）
  */
 int uart_transmit_dma(uart_desc_t uart, uint8_t *data, uint16_t len)
 {
-  if(uart == NULL || data == NULL || len == 0)
+  if(uart == NULL || data == NULL || len == 0 || uart->hal_handle.hdmatx == NULL)
+  {
+    return -1;
+  }
+
+  // 数据可能位于写回cache的AXI SRAM，启动DMA前写回
+  DRV_System_CacheClean(data, len);
+
+  // DE在发送完成回调（TC中断）中复位
+  uart_de_assert(uart);
+  if(HAL_UART_Transmit_DMA(&uart->hal_handle, data, len) != HAL_OK)
   {
+    uart_de_deassert(uart);
     return -1;
   }
 
-  return HAL_UART_Transmit_DMA(&uart->hal_handle, data, len) == HAL_OK ? 0 : -1;
+  uart->stats.tx_bytes += len;
+
+  return 0;
 }
 
 /**
@@ -398,6 +590,55 @@ void uart_flush_rx(uart_desc_t uart)
 }
 
 
+/**
+ * @brief   读取链路统计
+ *
+ * @param[in]   uart   UART描述符
+ * @param[out]  stats  统计快照
+ *
+ * @retval  0   成功
+ * @retval  -1  参数错误
+ */
+int uart_get_stats(uart_desc_t uart, uart_stats_t *stats)
+{
+  uint32_t primask;
+
+  if(uart == NULL || stats == NULL)
+  {
+    return -1;
+  }
+
+  // 关中断复制，保证各计数来自同一时刻
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = uart->stats;
+  __set_PRIMASK(primask);
+
+  return 0;
+}
+
+/**
+ * @brief   清除链路统计
+ *
+ * @param[in]   uart  UART描述符
+ *
+ * @return  None
+ */
+void uart_clear_stats(uart_desc_t uart)
+{
+  uint32_t primask;
+
+  if(uart == NULL)
+  {
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  memset(&uart->stats, 0, sizeof(uart->stats));
+  __set_PRIMASK(primask);
+}
+
 /**
  * @brief   printf底层输出函数
  *
@@ -409,104 +650,199 @@ void _putchar(char character)
 {
   if(uart2_rs485 != NULL)
   {
-    HAL_UART_Transmit(&uart2_rs485->hal_handle, (uint8_t *)&character, 1, 0xFFFF);
+    uart_transmit(uart2_rs485, (uint8_t *)&character, 1, 0xFFFF);
   }
 }
 
 
 /**
- * @brief   USART1中断服务函数
+ * @brief   发送完成回调（TC中断，最后一位已移出）
  *
- * @details 【生产者角色】在生产者-消费者模型中作为数据生产者
- *          
- *          工作流程：
- *          1. 检测IDLE中断（串口空闲，表示一帧数据接收完成）
- *          2. 计算DMA接收到的数据长度
- *          3. 将数据从DMA缓冲区写入环形缓冲区（生产数据）
- *          4. 重启DMA接收，准备下一帧
+ * @details GPIO方式RS485在此复位DE，换向间隔为中断响应时间
  *
- *          生产特点：
- *          - 运行在中断上下文（高优先级）
- *          - 快速写入，立即返回
- *          - 不关心消费者是否读取
- *          - 满了自动覆盖旧数据（覆盖模式）
+ * @param[in]   huart  UART句柄
+ *
+ * @return  None
+ */
+MEM_ITCM_CODE void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  uart_de_deassert(uart_from_handle(huart));
+}
+
+/**
+ * @brief   错误回调
+ *
+ * @details 发送DMA出错时HAL已结束发送（gState回到READY），复位DE释放总线
+ *
+ * @param[in]   huart  UART句柄
  *
- * @param   None
  * @return  None
  */
-void USART1_IRQHandler(void)
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
-  // 空闲中断处理（必须在HAL_UART_IRQHandler之前）
-  if(__HAL_UART_GET_FLAG(&uart1_rs232->hal_handle, UART_FLAG_IDLE) == SET)
+  if(huart->gState == HAL_UART_STATE_READY)
   {
-    __HAL_UART_CLEAR_IDLEFLAG(&uart1_rs232->hal_handle);
+    uart_de_deassert(uart_from_handle(huart));
+  }
+}
 
-    // 计算接收到的字节数
-    uint32_t recv_len = sizeof(Uart1_dma_rx_buf) - 
-                        __HAL_DMA_GET_COUNTER(uart1_rs232->hal_handle.hdmarx);
+/**
+ * @brief   接收数据写入环形缓冲区并累计统计（中断上下文）
+ *
+ * @param[in]   uart  UART描述符
+ * @param[in]   data  接收数据
+ * @param[in]   len   字节数
+ *
+ * @return  None
+ */
+static inline void uart_rx_push(uart_desc_t uart, const uint8_t *data, uint32_t len)
+{
+  uint32_t space = RingBuffer_GetFree(&uart->rx_ringbuf);
+  uint32_t used;
 
-    if(recv_len > 0 && recv_len <= sizeof(Uart1_dma_rx_buf))
-    {
-      // 将数据写入环形缓冲区
-      RingBuffer_Write(&uart1_rs232->rx_ringbuf, Uart1_dma_rx_buf, recv_len);
+  // 空间不足时环形缓冲区覆盖最旧数据，计为丢弃
+  if(len > space)
+  {
+    uart->stats.rx_dropped += len - space;
+  }
 
-      // 停止DMA接收
-      HAL_UART_DMAStop(&uart1_rs232->hal_handle);
+  RingBuffer_Write(&uart->rx_ringbuf, data, len);
+  uart->stats.rx_bytes += len;
 
-      // 重新启动DMA接收
-      HAL_UART_Receive_DMA(&uart1_rs232->hal_handle, Uart1_dma_rx_buf, sizeof(Uart1_dma_rx_buf));
-    }
+  used = RingBuffer_GetAvailable(&uart->rx_ringbuf);
+  if(used > uart->stats.rx_peak)
+  {
+    uart->stats.rx_peak = used;
   }
-
-  // 调用HAL库的中断处理函数
-  HAL_UART_IRQHandler(&uart1_rs232->hal_handle);
 }
 
 /**
- * @brief   USART2中断服务函数
+ * @brief   串口中断处理（各串口共用）
  *
  * @details 【生产者角色】在生产者-消费者模型中作为数据生产者
  *          
- *          工作流程：
+ *          工作流程（DMA接收）：
  *          1. 检测IDLE中断（串口空闲，表示一帧数据接收完成）
  *          2. 计算DMA接收到的数据长度
  *          3. 将数据从DMA缓冲区写入环形缓冲区（生产数据）
  *          4. 重启DMA接收，准备下一帧
  *
+ *          无接收DMA时读空接收FIFO（RXNE/FIFO阈值/IDLE中断），成批写入环形缓冲区。
+ *
  *          生产特点：
  *          - 运行在中断上下文（高优先级）
  *          - 快速写入，立即返回
  *          - 不关心消费者是否读取
- *          - 满了自动覆盖旧数据（覆盖模式）
+ *          - 满了自动覆盖旧数据（覆盖模式），覆盖的字节计入rx_dropped
+ *
+ *          线路错误（ORE/FE/NE/PE）在进入HAL处理前计数并清除。
+ *
+ * @param[in]   uart  UART描述符
  *
- * @param   None
  * @return  None
  */
-void USART2_IRQHandler(void)
+static MEM_ITCM_CODE void uart_irq(uart_desc_t uart)
 {
-  // 空闲中断处理（必须在HAL_UART_IRQHandler之前）
-  if(__HAL_UART_GET_FLAG(&uart2_rs485->hal_handle, UART_FLAG_IDLE) == SET)
+  UART_HandleTypeDef *huart = &uart->hal_handle;
+  uint32_t stamp = RunStats_IrqEnter();
+  uint32_t isr = huart->Instance->ISR;
+
+  // 线路错误计数后清除：HAL不再看到错误，DMA接收不会因ORE等被中止
+  if((isr & (USART_ISR_ORE | USART_ISR_FE | USART_ISR_NE | USART_ISR_PE)) != 0U)
+  {
+    uart->stats.ore += (isr & USART_ISR_ORE) ? 1U : 0U;
+    uart->stats.fe += (isr & USART_ISR_FE) ? 1U : 0U;
+    uart->stats.ne += (isr & USART_ISR_NE) ? 1U : 0U;
+    uart->stats.pe += (isr & USART_ISR_PE) ? 1U : 0U;
+    __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_OREF | UART_CLEAR_FEF | UART_CLEAR_NEF | UART_CLEAR_PEF);
+  }
+
+  if(uart->dma_rx == UART_DESC_NONE)
   {
-    __HAL_UART_CLEAR_IDLEFLAG(&uart2_rs485->hal_handle);
+    uint8_t batch[16];
+    uint32_t n;
+
+    if((isr & USART_ISR_IDLE) != 0U)
+    {
+      __HAL_UART_CLEAR_IDLEFLAG(huart);
+      uart->stats.rx_frames++;
+    }
+
+    // 读空接收FIFO（未使能FIFO时最多1字节），成批写入环形缓冲区
+    do
+    {
+      n = 0;
+      while(n < sizeof(batch) && __HAL_UART_GET_FLAG(huart, UART_FLAG_RXFNE) == SET)
+      {
+        batch[n++] = (uint8_t)huart->Instance->RDR;
+      }
+      if(n > 0)
+      {
+        uart_rx_push(uart, batch, n);
+      }
+    } while(n == sizeof(batch));
+  }
+  else if((isr & USART_ISR_IDLE) != 0U)
+  {
+    // 空闲中断处理（必须在HAL_UART_IRQHandler之前）
+    __HAL_UART_CLEAR_IDLEFLAG(huart);
 
     // 计算接收到的字节数
-    uint32_t recv_len = sizeof(Uart2_dma_rx_buf) - 
-                        __HAL_DMA_GET_COUNTER(uart2_rs485->hal_handle.hdmarx);
+    uint32_t recv_len = uart->dma_rx_len - __HAL_DMA_GET_COUNTER(huart->hdmarx);
 
-    if(recv_len > 0 && recv_len <= sizeof(Uart2_dma_rx_buf))
+    if(recv_len > 0 && recv_len <= uart->dma_rx_len)
     {
       // 将数据写入环形缓冲区
-      RingBuffer_Write(&uart2_rs485->rx_ringbuf, Uart2_dma_rx_buf, recv_len);
+      uart_rx_push(uart, uart->dma_rx_buf, recv_len);
+      uart->stats.rx_frames++;
 
       // 停止DMA接收
-      HAL_UART_DMAStop(&uart2_rs485->hal_handle);
+      HAL_UART_DMAStop(huart);
 
       // 重新启动DMA接收
-      HAL_UART_Receive_DMA(&uart2_rs485->hal_handle, Uart2_dma_rx_buf, sizeof(Uart2_dma_rx_buf));
+      HAL_UART_Receive_DMA(huart, uart->dma_rx_buf, uart->dma_rx_len);
     }
   }
 
   // 调用HAL库的中断处理函数
-  HAL_UART_IRQHandler(&uart2_rs485->hal_handle);
+  HAL_UART_IRQHandler(huart);
+
+  if(uart->stat != UART_DESC_NONE)
+  {
+    RunStats_IrqExit((uint8_t)uart->stat, stamp);
+  }
 }
 
+/**
+ * @brief   串口中断分发
+ *
+ * @param[in]   index  分发编号（s_uart_instances下标）
+ *
+ * @return  None
+ */
+static MEM_ITCM_CODE void uart_dispatch(uint32_t index)
+{
+  if(s_uart_ports[index] != NULL)
+  {
+    uart_irq(s_uart_ports[index]);
+  }
+}
+
+/**
+ * @brief 定义串口中断服务函数，按分发编号调用共用处理
+ */
+#define UART_IRQ_HANDLER(handler, index) \
+  MEM_ITCM_CODE void handler(void)       \
+  {                                      \
+    uart_dispatch(index);                \
+  }
+
+UART_IRQ_HANDLER(USART1_IRQHandler, 0)
+UART_IRQ_HANDLER(USART2_IRQHandler, 1)
+UART_IRQ_HANDLER(USART3_IRQHandler, 2)
+UART_IRQ_HANDLER(UART4_IRQHandler, 3)
+UART_IRQ_HANDLER(UART5_IRQHandler, 4)
+UART_IRQ_HANDLER(USART6_IRQHandler, 5)
+UART_IRQ_HANDLER(UART7_IRQHandler, 6)
+UART_IRQ_HANDLER(UART8_IRQHandler, 7)
+UART_IRQ_HANDLER(LPUART1_IRQHandler, 8)
@@ -3,14 +3,44 @@
  * @author  Dylan
  * @date    2026-01-15
  * @brief   串口描述符定义
+ *
+ * @details 引脚、复用功能、中断、DMA请求与接收缓冲区均由描述符给出，
+ *          驱动按描述符完成时钟、引脚、DMA与中断配置，新增串口只需在board.c
+ *          中增加一个描述符（使用DMA时在board_dma_requests中增加对应请求）。
+ *          支持USART1/2/3/6、UART4/5/7/8与LPUART1（LPUART1只能使用BDMA）。
+ *
+ *          FIFO方式：无接收DMA时以接收FIFO阈值中断成批读取，帧尾不足阈值的
+ *          部分由IDLE中断读取；中断发送由HAL按发送FIFO阈值成批填充，
+ *          适合短报文、低速串口，省出DMA流。
+ *
+ *          RS485方向控制：硬件DE由外设在起始位前/停止位后按de_assert/de_deassert
+ *          自动翻转，换向间隔不超过2位时间；GPIO方式在发送完成（TC）后立即复位DE，
+ *          换向间隔为中断响应时间，两者均小于一个字符时间。
  */
 
 #ifndef DRV_UART_DESC_H
 #define DRV_UART_DESC_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "stm32h7xx_hal.h"
 #include "ringbuffer.h"
+#include "drv_uart.h"
+
+/**
+ * @brief 描述符中不使用DMA或不计入运行时统计
+ */
+#define UART_DESC_NONE      (-1)
+
+/**
+ * @brief RS485收发方向控制方式
+ */
+typedef enum
+{
+  UART_RS485_NONE = 0,                /**< 不控制（RS232或自动换向收发器） */
+  UART_RS485_HW,                      /**< 硬件DE（DEM）：de_pin为串口RTS/DE引脚，由外设自动翻转 */
+  UART_RS485_GPIO                     /**< GPIO：发送前置位，TC中断中复位 */
+} uart_rs485_t;
 
 /**
  * @brief 串口描述符结构体
@@ -19,10 +49,31 @@ struct uart_desc
 {
   USART_TypeDef *instance;            /**< 串口实例 */
   uint32_t baudrate;                  /**< 波特率 */
+  GPIO_TypeDef *tx_port;              /**< TX引脚端口 */
+  uint16_t tx_pin;                    /**< TX引脚 */
+  GPIO_TypeDef *rx_port;              /**< RX引脚端口 */
+  uint16_t rx_pin;                    /**< RX引脚 */
+  uint8_t af;                         /**< 引脚复用功能（GPIO_AFx_xxx） */
+  IRQn_Type irqn;                     /**< 串口中断号 */
+  uint8_t irq_priority;               /**< 串口中断抢占优先级 */
+  int8_t stat;                        /**< 运行时统计中断编号（board_irq_t），UART_DESC_NONE不统计 */
+  int8_t dma_rx;                      /**< 接收DMA请求编号（board_dma_t），UART_DESC_NONE逐字节中断接收 */
+  int8_t dma_tx;                      /**< 发送DMA请求编号（board_dma_t），UART_DESC_NONE不支持DMA发送 */
+  uint8_t *dma_rx_buf;                /**< DMA接收缓冲区（DMA可访问的D2/AXI SRAM） */
+  uint16_t dma_rx_len;                /**< DMA接收缓冲区长度 */
+  bool fifo;                          /**< 使能16字节收发FIFO */
+  uint32_t rx_fifo_threshold;         /**< 接收FIFO中断阈值（UART_RXFIFO_THRESHOLD_x_y） */
+  uint32_t tx_fifo_threshold;         /**< 发送FIFO中断阈值（UART_TXFIFO_THRESHOLD_x_y） */
+  uart_rs485_t rs485;                 /**< RS485方向控制方式 */
+  GPIO_TypeDef *de_port;              /**< DE引脚端口（高电平发送） */
+  uint16_t de_pin;                    /**< DE引脚 */
+  uint8_t de_assert;                  /**< 硬件DE：起始位前DE提前置位时间（采样时钟数0-31，16倍过采样时1/16位） */
+  uint8_t de_deassert;                /**< 硬件DE：停止位后DE保持时间（采样时钟数0-31） */
   UART_HandleTypeDef hal_handle;      /**< 串口HAL句柄 */
+  DMA_HandleTypeDef hdma_rx;          /**< 接收DMA句柄 */
+  DMA_HandleTypeDef hdma_tx;          /**< 发送DMA句柄 */
   RingBuffer_t rx_ringbuf;            /**< 接收环形缓冲区 */
+  uart_stats_t stats;                 /**< 链路统计（中断中累计） */
 };
 
-typedef struct uart_desc *uart_desc_t;
-
 #endif /* DRV_UART_DESC_H */
@@ -55,19 +55,22 @@ extern uint32_t SystemCoreClock;
 #define configTICK_RATE_HZ ((TickType_t)1000)       // 滴答定时器频率
 #define configMAX_PRIORITIES (56)                   // 最大优先级数
 #define configMINIMAL_STACK_SIZE ((uint16_t)256)    // 最小堆栈大小
-#define configTOTAL_HEAP_SIZE ((size_t)(64 * 1024)) // 总堆栈大小
+#define configSUPPORT_STATIC_ALLOCATION 1           // 静态分配：任务/队列/事件标志及IDLE、定时器任务内存由应用提供(rtos_static.h)
+#define configSUPPORT_DYNAMIC_ALLOCATION 1          // 保留动态分配接口，运行时应无堆分配(栈/堆报告alloc应为0)
+#define configTOTAL_HEAP_SIZE ((size_t)(4 * 1024))  // DTCM区域堆大小(静态分配后仅作兜底，其余区域见heap_region.h)
 #define configMAX_TASK_NAME_LEN (16)                // 任务名称长度
 #define configUSE_TRACE_FACILITY 1                  // 使用跟踪功能
 #define configUSE_16_BIT_TICKS 0                    // 使用16位滴答定时器
 #define configIDLE_SHOULD_YIELD 1                   // 空闲任务应该让出CPU时间
 #define configUSE_MUTEXES 1                         // 使用互斥量
 #define configQUEUE_REGISTRY_SIZE 8                 // 队列注册大小
-#define configCHECK_FOR_STACK_OVERFLOW 0            // 检查堆栈溢出
+#define configCHECK_FOR_STACK_OVERFLOW 2            // 检查堆栈溢出(栈指针越界+栈底标记)
 #define configUSE_RECURSIVE_MUTEXES 1               // 使用递归互斥量
-#define configUSE_MALLOC_FAILED_HOOK 0              // 使用内存分配失败钩子
+#define configUSE_MALLOC_FAILED_HOOK 1              // 使用内存分配失败钩子
 #define configUSE_APPLICATION_TASK_TAG 0            // 使用应用程序任务标签
 #define configUSE_COUNTING_SEMAPHORES 1             // 使用计数信号量
-#define configGENERATE_RUN_TIME_STATS 0             // 生成运行时统计信息
+#define configGENERATE_RUN_TIME_STATS 1             // 生成运行时统计信息
+#define configRUN_TIME_COUNTER_TYPE uint64_t        // 运行时计数器类型(DWT CYCCNT扩展为64位)
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0   // 使用端口优化任务选择
 
 /* Software timer definitions. */
@@ -96,6 +99,16 @@ to exclude the API function. */
 #define INCLUDE_uxTaskGetStackHighWaterMark 1
 #define INCLUDE_xTaskGetCurrentTaskHandle 1
 #define INCLUDE_eTaskGetState 1
+#define INCLUDE_xTaskGetIdleTaskHandle 1
+
+/* Run time stats: DWT CYCCNT (core clock) extended to 64 bits by the
+runstats module, see common/runstats/runstats.h. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+extern void RunStats_Start(void);
+extern uint64_t RunStats_GetCycles64(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() RunStats_Start()     // 调度器启动时作为第一个窗口起点
+#define portGET_RUN_TIME_COUNTER_VALUE() RunStats_GetCycles64()       // 64位周期计数
 
 /*
  * The CMSIS-RTOS V2 defines 56 priorities (0-55).
@@ -0,0 +1,76 @@
+/**
+ * @file    mem_region.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   RAM区域放置宏
+ *
+ * @details 将变量放入指定RAM区域，GCC与Keil AC5使用同一写法，
+ *          宏写在声明符之后：static uint8_t buf[256] MEM_AXI;
+ *
+ *          | 宏        | 区域              | GCC段      | Keil执行区 | 用途                     |
+ *          |-----------|-------------------|------------|------------|--------------------------|
+ *          | MEM_DTCM  | DTCM 128KB        | .bss/.data | RW_IRAM1   | 任务栈、控制块、CPU专用  |
+ *          | MEM_AXI   | AXI SRAM(D1) 512KB| .ram_d1    | RW_IRAM2   | DMA缓冲区、大块数据      |
+ *          | MEM_D2    | SRAM1-3(D2) 288KB | .ram_d2    | RW_RAM_D2  | 外设DMA缓冲区、冷数据    |
+ *          | MEM_D3    | SRAM4(D3) 64KB    | .ram_d3    | RW_RAM_D3  | BDMA缓冲区               |
+ *
+ *          | MEM_NOINIT| DTCM              | .noinit    | RW_NOINIT  | 复位后保留的变量         |
+ *
+ *          DTCM不能被DMA1/DMA2访问，DMA缓冲区须放入AXI/D2/D3。
+ *          MPU将D2/D3设为非cache，DMA缓冲区优先放入D2；AXI为写回cache，
+ *          其中的DMA缓冲区须调用DRV_System_CacheClean()/DRV_System_CacheInvalidate()。
+ *          AXI/D2/D3为NOLOAD(UNINIT)段，启动文件不装载初值，
+ *          由DRV_System_Init()在PLL锁定后清零，变量不能带非零初值。
+ *          MEM_NOINIT变量不清零，复位后保留（如故障记录）。
+ *
+ *          MEM_ITCM_CODE将函数放入ITCM（零等待，不经过Flash加速器与I-Cache），
+ *          写在函数定义之前：MEM_ITCM_CODE void USART1_IRQHandler(void)。
+ *          ITCM代码在FLASH中保存副本，GCC由DRV_System_Init()复制，
+ *          Keil由分散加载完成，DRV_System_Init()之前不得调用。
+ *          与FLASH代码间的调用距离超出BL范围，由链接器插入长跳转。
+ */
+
+#ifndef MEM_REGION_H
+#define MEM_REGION_H
+
+/**
+ * @brief 各区域的段名（与链接脚本/分散加载文件一致）
+ */
+#if defined(__CC_ARM)
+#define MEM_SECTION_AXI         "RAM_AXI"
+#define MEM_SECTION_D2          "RAM_D2"
+#define MEM_SECTION_D3          "RAM_D3"
+#define MEM_SECTION_NOINIT      "NOINIT"
+#define MEM_SECTION_ITCM        "ITCM_TEXT"
+#else
+#define MEM_SECTION_AXI         ".ram_d1"
+#define MEM_SECTION_D2          ".ram_d2"
+#define MEM_SECTION_D3          ".ram_d3"
+#define MEM_SECTION_NOINIT      ".noinit"
+#define MEM_SECTION_ITCM        ".itcm_text"
+#endif
+
+/**
+ * @brief 区域内变量按32字节（cache行）对齐，DMA缓冲区维护cache时不会波及相邻变量
+ * @note  AC5中不带初值的变量指定section后归入RW（初值存于FLASH），
+ *        须加zero_init才归入ZI，不占用加载区
+ */
+#if defined(__CC_ARM)
+#define MEM_REGION(name)        __attribute__((aligned(32), section(name), zero_init))
+#define MEM_NOINIT              __attribute__((aligned(8), section(MEM_SECTION_NOINIT), zero_init))
+#else
+#define MEM_REGION(name)        __attribute__((aligned(32), section(name)))
+#define MEM_NOINIT              __attribute__((aligned(8), section(MEM_SECTION_NOINIT)))
+#endif
+
+#define MEM_DTCM                __attribute__((aligned(8)))
+#define MEM_AXI                 MEM_REGION(MEM_SECTION_AXI)
+#define MEM_D2                  MEM_REGION(MEM_SECTION_D2)
+#define MEM_D3                  MEM_REGION(MEM_SECTION_D3)
+
+/**
+ * @brief ITCM函数，noinline防止被内联回FLASH中的调用者
+ */
+#define MEM_ITCM_CODE           __attribute__((noinline, section(MEM_SECTION_ITCM)))
+
+#endif /* MEM_REGION_H */
@@ -0,0 +1,76 @@
+/**
+ * @file    rtos_static.h
+ * @author  Dylan
+ * @date    2026-10-18
+ * @brief   RTOS对象静态定义宏
+ *
+ * @details 任务、消息队列、事件标志的控制块与存储区在编译期定义并放入指定区域，
+ *          经CMSIS-RTOS2属性结构（cb_mem/stack_mem/mq_mem）交给内核，运行时不从堆分配：
+ *
+ *          RTOS_THREAD_DEFINE(s_blink_task, 128 * 4, MEM_DTCM);
+ *          const osThreadAttr_t attr = {.name = "Blink", RTOS_THREAD_MEM(s_blink_task)};
+ *
+ *          configSUPPORT_STATIC_ALLOCATION为0时宏退化为只给出大小，对象由堆分配，
+ *          应用代码无需修改。栈按8字节对齐（AAPCS要求）。
+ */
+
+#ifndef RTOS_STATIC_H
+#define RTOS_STATIC_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "mem_region.h"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+/**
+ * @brief 任务：控制块name_tcb与栈name_stack（size字节）
+ * @note  RTOS_THREAD_STACK/RTOS_THREAD_DEPTH供直接调用xTaskCreateStatic或内核任务内存回调使用
+ */
+#define RTOS_THREAD_DEFINE(name, size, region)                                \
+  static StaticTask_t name##_tcb region;                                      \
+  static uint64_t name##_stack[((size) + 7U) / 8U] region
+#define RTOS_THREAD_MEM(name)                                                 \
+  .cb_mem = &name##_tcb, .cb_size = sizeof(name##_tcb),                       \
+  .stack_mem = name##_stack, .stack_size = sizeof(name##_stack)
+#define RTOS_THREAD_STACK(name)   ((StackType_t *)name##_stack)
+#define RTOS_THREAD_DEPTH(name)   ((uint32_t)(sizeof(name##_stack) / (sizeof(StackType_t))))
+
+/**
+ * @brief 消息队列：控制块name_qcb与存储区name_mq（count条 × msg_size字节）
+ */
+#define RTOS_QUEUE_DEFINE(name, count, msg_size, region)                      \
+  static StaticQueue_t name##_qcb region;                                     \
+  static uint8_t name##_mq[(count) * (msg_size)] region
+#define RTOS_QUEUE_MEM(name)                                                  \
+  .cb_mem = &name##_qcb, .cb_size = sizeof(name##_qcb),                       \
+  .mq_mem = name##_mq, .mq_size = sizeof(name##_mq)
+
+/**
+ * @brief 事件标志：控制块name_ecb
+ */
+#define RTOS_EVENT_DEFINE(name, region)                                       \
+  static StaticEventGroup_t name##_ecb region
+#define RTOS_EVENT_MEM(name)                                                  \
+  .cb_mem = &name##_ecb, .cb_size = sizeof(name##_ecb)
+
+#else
+
+#define RTOS_THREAD_DEFINE(name, size, region)                                \
+  enum { name##_stack_size = (size) }
+#define RTOS_THREAD_MEM(name)                                                 \
+  .stack_size = name##_stack_size
+
+#define RTOS_QUEUE_DEFINE(name, count, msg_size, region)                      \
+  enum { name##_mq_size = (count) * (msg_size) }
+#define RTOS_QUEUE_MEM(name)                                                  \
+  .cb_mem = NULL
+
+#define RTOS_EVENT_DEFINE(name, region)                                       \
+  enum { name##_ecb_unused }
+#define RTOS_EVENT_MEM(name)                                                  \
+  .cb_mem = NULL
+
+#endif
+
+#endif /* RTOS_STATIC_H */
@@ -25,6 +25,7 @@ extern "C" {
 #define HAL_RCC_MODULE_ENABLED
 #define HAL_TIM_MODULE_ENABLED
 #define HAL_UART_MODULE_ENABLED
+#define HAL_MDMA_MODULE_ENABLED
 
 /* ########################## HSE/HSI Values adaptation ##################### */
 #if !defined(HSE_VALUE)
@@ -138,6 +139,9 @@ extern "C" {
 #include "stm32h7xx_hal_uart.h"
 #include "stm32h7xx_hal_uart_ex.h"
 #endif
+#if defined(HAL_MDMA_MODULE_ENABLED)
+#include "stm32h7xx_hal_mdma.h"
+#endif
 
 /* ########################## Assert Definition ##############################
  */